@@ -86,6 +86,7 @@ class TankerConan(ConanFile):
         self.requires("jsonformoderncpp/3.4.0@tanker/testing", private=private)
         self.requires("libsodium/1.0.18@tanker/testing", private=private)
         self.requires("tconcurrent/0.30.0@tanker/stable", private=private)
+        self.requires("zlib/1.2.11@conan/stable", private=private)
         # Hack to be able to import libc++{abi}.a later on
         if self.settings.os == "iOS":
             self.requires("libc++/9.0@tanker/testing", private=private)
@@ -174,6 +175,7 @@ class TankerConan(ConanFile):
                 "tankertrustchain",
                 "tankeridentity",
                 "tankercrypto",
+                "tankerencoding",
                 "tankerserialization",
                 "tankererrors",
                 "tankerlog",
@@ -0,0 +1,134 @@
+#include <benchmark/benchmark.h>
+
+#include <Tanker/AsyncCore.hpp>
+#include <Tanker/Compute.hpp>
+#include <Tanker/Functional/TrustchainFixture.hpp>
+
+#include <Helpers/Await.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace Tanker;
+using namespace Tanker::Functional;
+
+namespace
+{
+std::atomic<std::uint64_t> allocationCount{0};
+}
+
+// Counts the allocations of the whole bench binary, on every thread
+void* operator new(std::size_t size)
+{
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (auto const p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+AsyncCore& allocationsCore()
+{
+  static auto const core = [] {
+    auto user = TrustchainFixture::getTrustchain().makeUser(UserType::New);
+    auto device = user.makeDevice();
+    return AWAIT(device.open());
+  }();
+  return *core;
+}
+
+std::vector<std::uint8_t> encryptedOfSize(std::size_t clearSize)
+{
+  auto const encrypted =
+      allocationsCore()
+          .encrypt(std::vector<std::uint8_t>(clearSize, 'a'))
+          .get();
+  // the first decryption puts the key in the cache
+  allocationsCore().decrypt(encrypted).get();
+  return encrypted;
+}
+
+template <typename F>
+void countAllocations(benchmark::State& state, F&& f)
+{
+  auto const before = allocationCount.load();
+  for (auto _ : state)
+    f();
+  state.counters["allocsPerCall"] =
+      static_cast<double>(allocationCount.load() - before) /
+      state.iterations();
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+}
+
+/// What: decrypt range(0) bytes whose key is cached
+/// PostCond: allocsPerCall counts the allocations of one call, on all threads
+static void asynccore_decrypt_cached_allocations(benchmark::State& state)
+{
+  auto& core = allocationsCore();
+  auto const encrypted = encryptedOfSize(state.range(0));
+  std::vector<std::uint8_t> decrypted(
+      AsyncCore::decryptedSize(encrypted).get());
+  countAllocations(state,
+                   [&] { core.decrypt(decrypted.data(), encrypted).get(); });
+}
+BENCHMARK(asynccore_decrypt_cached_allocations)->Arg(1024)->Arg(4096);
+
+/// What: same as asynccore_decrypt_cached_allocations, through the coroutine
+/// used when the key is not cached
+static void asynccore_decrypt_coroutine_allocations(benchmark::State& state)
+{
+  auto& core = allocationsCore();
+  auto const encrypted = encryptedOfSize(state.range(0));
+  std::vector<std::uint8_t> decrypted(
+      AsyncCore::decryptedSize(encrypted).get());
+  // offloading every call disables the inline path
+  auto const threshold = Compute::minOffloadedBytes();
+  Compute::setMinOffloadedBytes(0);
+  countAllocations(state,
+                   [&] { core.decrypt(decrypted.data(), encrypted).get(); });
+  Compute::setMinOffloadedBytes(threshold);
+}
+BENCHMARK(asynccore_decrypt_coroutine_allocations)->Arg(1024)->Arg(4096);
+
+/// What: encrypt range(0) bytes with an EncryptionSession coroutine
+static void encryption_session_encrypt_allocations(benchmark::State& state)
+{
+  auto session = allocationsCore().makeEncryptionSession().get();
+  std::vector<std::uint8_t> const clearData(state.range(0), 'a');
+  std::vector<std::uint8_t> encrypted(
+      EncryptionSession::encryptedSize(clearData.size()));
+  countAllocations(state, [&] {
+    AWAIT(session.encrypt(encrypted.data(), clearData));
+  });
+}
+BENCHMARK(encryption_session_encrypt_allocations)->Arg(1024)->Arg(4096);
+
+/// What: encrypt range(0) bytes with EncryptionSession::encryptSync
+static void encryption_session_encrypt_sync_allocations(
+    benchmark::State& state)
+{
+  auto session = allocationsCore().makeEncryptionSession().get();
+  std::vector<std::uint8_t> const clearData(state.range(0), 'a');
+  std::vector<std::uint8_t> encrypted(
+      EncryptionSession::encryptedSize(clearData.size()));
+  countAllocations(state, [&] {
+    session.encryptSync(encrypted.data(), clearData);
+  });
+}
+BENCHMARK(encryption_session_encrypt_sync_allocations)->Arg(1024)->Arg(4096);
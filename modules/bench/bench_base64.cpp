@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/Encoding/Base64.hpp>
+
+#include <cppcodec/base64_rfc4648.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+// A serialized block weighs between ~150 bytes (key publish to user) and
+// ~400 bytes (device creation v3), a user group addition to 1000 members is
+// around 200KB.
+std::vector<std::vector<std::uint8_t>> makeBlocks(std::size_t nbBlocks,
+                                                  std::size_t blockSize)
+{
+  std::vector<std::vector<std::uint8_t>> blocks(
+      nbBlocks, std::vector<std::uint8_t>(blockSize));
+  for (auto& block : blocks)
+    Tanker::Crypto::randomFill(block);
+  return blocks;
+}
+
+std::vector<std::string> encodeBlocks(
+    std::vector<std::vector<std::uint8_t>> const& blocks)
+{
+  std::vector<std::string> encoded;
+  encoded.reserve(blocks.size());
+  for (auto const& block : blocks)
+    encoded.push_back(Tanker::Encoding::base64Encode(block));
+  return encoded;
+}
+
+void setBytesProcessed(benchmark::State& state)
+{
+  state.SetBytesProcessed(state.iterations() * state.range(0) *
+                          state.range(1));
+}
+}
+
+/// What: base64 encode a block list with cppcodec
+static void base64_encode_blocks_cppcodec(benchmark::State& state)
+{
+  auto const blocks = makeBlocks(state.range(0), state.range(1));
+  for (auto _ : state)
+    for (auto const& block : blocks)
+      benchmark::DoNotOptimize(cppcodec::base64_rfc4648::encode(block));
+  setBytesProcessed(state);
+}
+
+/// What: base64 encode a block list with Tanker::Encoding
+static void base64_encode_blocks(benchmark::State& state)
+{
+  auto const blocks = makeBlocks(state.range(0), state.range(1));
+  for (auto _ : state)
+    for (auto const& block : blocks)
+      benchmark::DoNotOptimize(Tanker::Encoding::base64Encode(block));
+  setBytesProcessed(state);
+}
+
+/// What: base64 decode a server block list with cppcodec
+static void base64_decode_blocks_cppcodec(benchmark::State& state)
+{
+  auto const encoded = encodeBlocks(makeBlocks(state.range(0), state.range(1)));
+  for (auto _ : state)
+    for (auto const& block : encoded)
+      benchmark::DoNotOptimize(cppcodec::base64_rfc4648::decode(block));
+  setBytesProcessed(state);
+}
+
+/// What: base64 decode a server block list with Tanker::Encoding, reusing the
+/// same output buffer like fromBlocksToServerEntries does
+static void base64_decode_blocks(benchmark::State& state)
+{
+  auto const encoded = encodeBlocks(makeBlocks(state.range(0), state.range(1)));
+  std::vector<std::uint8_t> buffer(state.range(1));
+  for (auto _ : state)
+    for (auto const& block : encoded)
+      benchmark::DoNotOptimize(Tanker::Encoding::base64Decode(block, buffer));
+  setBytesProcessed(state);
+}
+
+#define TANKER_BASE64_BENCHMARK(name)                          \
+  BENCHMARK(name)                                              \
+      ->ArgNames({"blocks", "blockSize"})                      \
+      ->Args({100, 150})                                       \
+      ->Args({1000, 150})                                      \
+      ->Args({1000, 400})                                      \
+      ->Args({10000, 150})                                     \
+      ->Args({1, 200000})                                      \
+      ->Unit(benchmark::kMicrosecond)
+
+TANKER_BASE64_BENCHMARK(base64_encode_blocks_cppcodec);
+TANKER_BASE64_BENCHMARK(base64_encode_blocks);
+TANKER_BASE64_BENCHMARK(base64_decode_blocks_cppcodec);
+TANKER_BASE64_BENCHMARK(base64_decode_blocks);
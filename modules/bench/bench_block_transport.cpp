@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+
+#include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/Encoding/Base64.hpp>
+#include <Tanker/Network/Compression.hpp>
+#include <Tanker/Serialization/Serialization.hpp>
+#include <Tanker/Trustchain/Action.hpp>
+#include <Tanker/Trustchain/Actions/KeyPublish/ToUser.hpp>
+#include <Tanker/Trustchain/BlockFrame.hpp>
+#include <Tanker/Trustchain/ClientEntry.hpp>
+#include <Tanker/Trustchain/ServerEntry.hpp>
+
+#include <Helpers/Buffers.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace Tanker;
+
+namespace
+{
+// Key publishes, the blocks of a "get key publishes" reply. Client blocks are
+// server blocks with a zero index.
+std::vector<std::vector<std::uint8_t>> makeKeyPublishes(std::size_t count)
+{
+  auto const keyPair = Crypto::makeSignatureKeyPair();
+  auto const trustchainId = make<Trustchain::TrustchainId>("trustchain id");
+  auto const author = make<Crypto::Hash>("author");
+  std::vector<std::vector<std::uint8_t>> blocks;
+  blocks.reserve(count);
+  for (auto i = 0u; i < count; ++i)
+  {
+    Trustchain::Action const action = Trustchain::Actions::KeyPublishToUser{
+        make<Crypto::PublicEncryptionKey>("recipient key"),
+        Crypto::getRandom<Trustchain::ResourceId>(),
+        make<Crypto::SealedSymmetricKey>("sealed key")};
+    blocks.push_back(Serialization::serialize(Trustchain::ClientEntry::create(
+        trustchainId, author, action, keyPair.privateKey)));
+  }
+  return blocks;
+}
+
+std::string jsonReply(std::vector<std::vector<std::uint8_t>> const& blocks)
+{
+  auto reply = nlohmann::json::array();
+  for (auto const& block : blocks)
+    reply.push_back(Encoding::base64Encode(block));
+  return reply.dump();
+}
+
+void setCounters(benchmark::State& state, std::size_t wireBytes)
+{
+  state.counters["wire_bytes"] = wireBytes;
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * wireBytes);
+}
+}
+
+/// What: serve blocks as a json array of base64 blocks and decode them into
+/// ServerEntries, the text transport
+/// PostCond: wire_bytes is the size of the reply
+static void block_transport_json(benchmark::State& state)
+{
+  auto const blocks = makeKeyPublishes(state.range(0));
+  std::size_t wireBytes = 0;
+  for (auto _ : state)
+  {
+    auto const message = jsonReply(blocks);
+    wireBytes = message.size();
+    benchmark::DoNotOptimize(
+        Trustchain::fromJsonBlocksToServerEntries(message));
+  }
+  setCounters(state, wireBytes);
+}
+BENCHMARK(block_transport_json)
+    ->ArgName("blocks")
+    ->Arg(1)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+/// What: serve blocks as a block frame and decode them into ServerEntries,
+/// the binary transport
+/// PostCond: wire_bytes is the size of the reply
+static void block_transport_binary(benchmark::State& state)
+{
+  auto const blocks = makeKeyPublishes(state.range(0));
+  std::size_t wireBytes = 0;
+  for (auto _ : state)
+  {
+    std::vector<gsl::span<std::uint8_t const>> spans;
+    spans.reserve(blocks.size());
+    for (auto const& block : blocks)
+      spans.push_back(block);
+    auto const frame = Trustchain::frameBlocks(spans);
+    wireBytes = frame.size();
+    benchmark::DoNotOptimize(
+        Trustchain::fromBinaryBlocksToServerEntries(frame));
+  }
+  setCounters(state, wireBytes);
+}
+BENCHMARK(block_transport_binary)
+    ->ArgName("blocks")
+    ->Arg(1)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+/// What: compress and decompress a json block list reply, like
+/// Network::CompressingConnection does for the payloads above its threshold
+/// PostCond: wire_bytes is the size of the compressed reply and ratio its
+/// compression ratio
+static void block_transport_json_deflate(benchmark::State& state)
+{
+  auto const message = jsonReply(makeKeyPublishes(state.range(0)));
+  auto const reply = gsl::make_span(message).as_span<std::uint8_t const>();
+  std::size_t wireBytes = 0;
+  for (auto _ : state)
+  {
+    auto const compressed = Network::compressPayload(reply, 0);
+    wireBytes = compressed.size();
+    benchmark::DoNotOptimize(Network::decompressPayload(compressed));
+  }
+  setCounters(state, wireBytes);
+  state.counters["ratio"] =
+      static_cast<double>(message.size()) / std::max<std::size_t>(wireBytes, 1);
+}
+BENCHMARK(block_transport_json_deflate)
+    ->ArgName("blocks")
+    ->Arg(1)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,216 @@
+#include <benchmark/benchmark.h>
+
+#include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/DataStore/Connection.hpp>
+#include <Tanker/DataStore/ConnectionProfile.hpp>
+#include <Tanker/DataStore/DatabaseFactory.hpp>
+#include <Tanker/DataStore/ResourceKeyLog.hpp>
+#include <Tanker/DbModels/ResourceKeys.hpp>
+#include <Tanker/Trustchain/ResourceId.hpp>
+
+#include <Helpers/Await.hpp>
+#include <Helpers/UniquePath.hpp>
+
+#include <sqlpp11/parameter.h>
+#include <sqlpp11/sqlite3/insert_or.h>
+#include <sqlpp11/sqlpp11.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Tanker;
+using Tanker::DataStore::ConnectionProfile;
+
+namespace
+{
+constexpr std::uint64_t resourceKeyCount = 1000000;
+
+using ResourceKeysTable = DbModels::resource_keys::resource_keys;
+
+Trustchain::ResourceId resourceIdOf(std::uint64_t index)
+{
+  Trustchain::ResourceId id;
+  for (auto i = 0u; i < sizeof(index); ++i)
+    id[i] = static_cast<std::uint8_t>(index >> (i * 8));
+  return id;
+}
+
+ConnectionProfile profileOf(benchmark::State const& state)
+{
+  return static_cast<ConnectionProfile>(state.range(0));
+}
+
+char const* labelOf(ConnectionProfile profile)
+{
+  return profile == ConnectionProfile::WriteAheadLog ? "wal" : "default";
+}
+
+// Creates, once per profile, a database holding resourceKeyCount resource
+// keys and returns its path.
+std::string populatedDatabase(ConnectionProfile profile)
+{
+  static std::map<ConnectionProfile, UniquePath> paths;
+
+  auto const [it, inserted] = paths.try_emplace(profile, "bench_datastore");
+  auto const dbPath = it->second.path + "/bench.db";
+  if (!inserted)
+    return dbPath;
+
+  // let the migration create the tables
+  AWAIT(DataStore::createDatabase(dbPath, {}, false, profile));
+
+  auto db = DataStore::createConnection(dbPath, {}, false, profile);
+  ResourceKeysTable tab{};
+  auto insert = db->prepare(sqlpp::sqlite3::insert_or_ignore_into(tab).set(
+      tab.mac = parameter(tab.mac),
+      tab.resource_key = parameter(tab.resource_key)));
+  auto const key = Crypto::makeSymmetricKey();
+  auto transaction = start_transaction(*db);
+  for (std::uint64_t i = 0; i < resourceKeyCount; ++i)
+  {
+    auto const id = resourceIdOf(i);
+    insert.params.mac = std::vector<std::uint8_t>(id.begin(), id.end());
+    insert.params.resource_key =
+        std::vector<std::uint8_t>(key.begin(), key.end());
+    (*db)(insert);
+  }
+  transaction.commit();
+  return dbPath;
+}
+
+// Same as populatedDatabase, for the ResourceKeyLog backend
+DataStore::ResourceKeyLog& populatedLog()
+{
+  static UniquePath dir("bench_datastore");
+  static DataStore::ResourceKeyLog log(dir.path + "/bench.rkeys",
+                                       Crypto::makeSymmetricKey());
+
+  auto const key = Crypto::makeSymmetricKey();
+  for (auto i = log.size(); i < resourceKeyCount; ++i)
+    AWAIT_VOID(log.putResourceKey(resourceIdOf(i), key));
+  return log;
+}
+
+// Same as populatedDatabase, for the in-memory database
+DataStore::ADatabase& populatedMemoryDatabase()
+{
+  static auto const db = [] {
+    auto db = AWAIT(DataStore::createDatabase(DataStore::ephemeralDbPath));
+    auto const key = Crypto::makeSymmetricKey();
+    for (std::uint64_t i = 0; i < resourceKeyCount; ++i)
+      AWAIT_VOID(db->putResourceKey(resourceIdOf(i), key));
+    return db;
+  }();
+  return *db;
+}
+}
+
+/// What: find a resource key among 1M with a query built and parsed on every
+/// call, like Database used to
+static void datastore_find_resource_key_unprepared(benchmark::State& state)
+{
+  auto const profile = profileOf(state);
+  auto db = DataStore::createConnection(
+      populatedDatabase(profile), {}, true, profile);
+  ResourceKeysTable tab{};
+  std::uint64_t index = 0;
+  for (auto _ : state)
+  {
+    auto const id = resourceIdOf(index++ * 7919 % resourceKeyCount);
+    auto rows =
+        (*db)(select(tab.resource_key).from(tab).where(tab.mac == id.base()));
+    benchmark::DoNotOptimize(rows.empty());
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(labelOf(profile));
+}
+BENCHMARK(datastore_find_resource_key_unprepared)->Arg(0)->Arg(1);
+
+/// What: find a resource key among 1M through Database, with its prepared
+/// statement and thread hop
+static void datastore_find_resource_key(benchmark::State& state)
+{
+  auto const profile = profileOf(state);
+  auto const db = AWAIT(
+      DataStore::createDatabase(populatedDatabase(profile), {}, true, profile));
+  std::uint64_t index = 0;
+  for (auto _ : state)
+  {
+    auto const id = resourceIdOf(index++ * 7919 % resourceKeyCount);
+    benchmark::DoNotOptimize(AWAIT(db->findResourceKey(id)));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(labelOf(profile));
+}
+BENCHMARK(datastore_find_resource_key)->Arg(0)->Arg(1);
+
+/// What: insert new resource keys in a database holding 1M, one transaction
+/// per key like the SDK does
+static void datastore_put_resource_key(benchmark::State& state)
+{
+  auto const profile = profileOf(state);
+  auto const db = AWAIT(
+      DataStore::createDatabase(populatedDatabase(profile), {}, true, profile));
+  auto const key = Crypto::makeSymmetricKey();
+  // do not collide with previous runs on the same database
+  static std::uint64_t index = resourceKeyCount;
+  for (auto _ : state)
+    AWAIT_VOID(db->putResourceKey(resourceIdOf(index++), key));
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(labelOf(profile));
+}
+BENCHMARK(datastore_put_resource_key)->Arg(0)->Arg(1);
+
+/// What: find a resource key among 1M in the memory-mapped ResourceKeyLog
+static void datastore_log_find_resource_key(benchmark::State& state)
+{
+  auto& log = populatedLog();
+  std::uint64_t index = 0;
+  for (auto _ : state)
+  {
+    auto const id = resourceIdOf(index++ * 7919 % resourceKeyCount);
+    benchmark::DoNotOptimize(AWAIT(log.findResourceKey(id)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(datastore_log_find_resource_key);
+
+/// What: append new resource keys to a ResourceKeyLog holding 1M
+static void datastore_log_put_resource_key(benchmark::State& state)
+{
+  auto& log = populatedLog();
+  auto const key = Crypto::makeSymmetricKey();
+  static std::uint64_t index = resourceKeyCount;
+  for (auto _ : state)
+    AWAIT_VOID(log.putResourceKey(resourceIdOf(index++), key));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(datastore_log_put_resource_key);
+
+/// What: find a resource key among 1M in the in-memory database
+static void datastore_memory_find_resource_key(benchmark::State& state)
+{
+  auto& db = populatedMemoryDatabase();
+  std::uint64_t index = 0;
+  for (auto _ : state)
+  {
+    auto const id = resourceIdOf(index++ * 7919 % resourceKeyCount);
+    benchmark::DoNotOptimize(AWAIT(db.findResourceKey(id)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(datastore_memory_find_resource_key);
+
+/// What: insert new resource keys in the in-memory database holding 1M
+static void datastore_memory_put_resource_key(benchmark::State& state)
+{
+  auto& db = populatedMemoryDatabase();
+  auto const key = Crypto::makeSymmetricKey();
+  static std::uint64_t index = resourceKeyCount;
+  for (auto _ : state)
+    AWAIT_VOID(db.putResourceKey(resourceIdOf(index++), key));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(datastore_memory_put_resource_key);
@@ -0,0 +1,456 @@
+#include <benchmark/benchmark.h>
+
+#include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/DataStore/ADatabase.hpp>
+#include <Tanker/Groups/IAccessor.hpp>
+#include <Tanker/Groups/Updater.hpp>
+#include <Tanker/ProvisionalUsers/IAccessor.hpp>
+#include <Tanker/ReceiveKey.hpp>
+#include <Tanker/ResourceKeys/Store.hpp>
+#include <Tanker/Share.hpp>
+#include <Tanker/Trustchain/Actions/KeyPublish.hpp>
+#include <Tanker/Users/ILocalUserAccessor.hpp>
+#include <Tanker/Users/IRequester.hpp>
+#include <Tanker/Users/IUserAccessor.hpp>
+#include <Tanker/Users/LocalUser.hpp>
+#include <Tanker/Users/Updater.hpp>
+#include <Tanker/Users/UserAccessor.hpp>
+
+#include <Helpers/Await.hpp>
+#include <Helpers/Entries.hpp>
+
+#include "TrustchainGenerator.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Benchmarks of the SDK algorithms on trustchains made by the
+// TrustchainGenerator: the requesters and accessors are stubs answering from
+// memory, nothing goes through the network.
+
+using namespace Tanker;
+
+namespace
+{
+// Answers every getUsers with the same entries
+class UserRequesterStub : public Users::IRequester
+{
+public:
+  explicit UserRequesterStub(std::vector<Trustchain::ServerEntry> entries)
+    : _entries(std::move(entries))
+  {
+  }
+
+  tc::cotask<std::vector<Trustchain::ServerEntry>> getMe() override
+  {
+    TC_RETURN(_entries);
+  }
+
+  tc::cotask<std::vector<Trustchain::ServerEntry>> getUsers(
+      gsl::span<Trustchain::UserId const>) override
+  {
+    TC_RETURN(_entries);
+  }
+
+  tc::cotask<std::vector<Trustchain::ServerEntry>> getUsers(
+      gsl::span<Trustchain::DeviceId const>) override
+  {
+    TC_RETURN(_entries);
+  }
+
+  tc::cotask<std::vector<Trustchain::ServerEntry>> getKeyPublishes(
+      gsl::span<Trustchain::ResourceId const>) override
+  {
+    TC_RETURN(std::vector<Trustchain::ServerEntry>{});
+  }
+
+  tc::cotask<void> authenticate(Trustchain::TrustchainId const&,
+                                Trustchain::UserId const&,
+                                Crypto::SignatureKeyPair const&) override
+  {
+    TC_RETURN();
+  }
+
+  tc::cotask<std::vector<
+      std::tuple<Crypto::PublicSignatureKey, Crypto::PublicEncryptionKey>>>
+  getPublicProvisionalIdentities(gsl::span<Email const>) override
+  {
+    TC_RETURN((std::vector<std::tuple<Crypto::PublicSignatureKey,
+                                      Crypto::PublicEncryptionKey>>{}));
+  }
+
+private:
+  std::vector<Trustchain::ServerEntry> _entries;
+};
+
+// Finds devices among the ones it was given
+class UserAccessorStub : public Users::IUserAccessor
+{
+public:
+  explicit UserAccessorStub(std::vector<Users::Device> devices)
+    : _devices(std::move(devices))
+  {
+  }
+
+  tc::cotask<PullResult> pull(gsl::span<Trustchain::UserId const>) override
+  {
+    TC_RETURN(PullResult{});
+  }
+
+  tc::cotask<BasicPullResult<Users::Device, Trustchain::DeviceId>> pull(
+      gsl::span<Trustchain::DeviceId const> deviceIds) override
+  {
+    BasicPullResult<Users::Device, Trustchain::DeviceId> result;
+    for (auto const& id : deviceIds)
+    {
+      auto const it = std::find_if(
+          _devices.begin(), _devices.end(), [&](auto const& device) {
+            return device.id() == id;
+          });
+      if (it != _devices.end())
+        result.found.push_back(*it);
+      else
+        result.notFound.push_back(id);
+    }
+    TC_RETURN(result);
+  }
+
+  tc::cotask<std::vector<ProvisionalUsers::PublicUser>> pullProvisional(
+      gsl::span<Identity::PublicProvisionalIdentity const>) override
+  {
+    TC_RETURN(std::vector<ProvisionalUsers::PublicUser>{});
+  }
+
+private:
+  std::vector<Users::Device> _devices;
+};
+
+class LocalUserAccessorStub : public Users::ILocalUserAccessor
+{
+public:
+  explicit LocalUserAccessorStub(Users::LocalUser localUser)
+    : _localUser(std::move(localUser))
+  {
+  }
+
+  Users::LocalUser const& get() const override
+  {
+    return _localUser;
+  }
+
+  tc::cotask<Users::LocalUser const&> pull() override
+  {
+    TC_RETURN(_localUser);
+  }
+
+  tc::cotask<std::optional<Crypto::EncryptionKeyPair>> pullUserKeyPair(
+      Crypto::PublicEncryptionKey const& publicUserKey) override
+  {
+    TC_RETURN(_localUser.findKeyPair(publicUserKey));
+  }
+
+private:
+  Users::LocalUser _localUser;
+};
+
+// Only knows the key pair of one group
+class GroupAccessorStub : public Groups::IAccessor
+{
+public:
+  explicit GroupAccessorStub(
+      std::optional<Crypto::EncryptionKeyPair> keyPair = std::nullopt)
+    : _keyPair(std::move(keyPair))
+  {
+  }
+
+  tc::cotask<InternalGroupPullResult> getInternalGroups(
+      std::vector<Trustchain::GroupId> const& groupIds) override
+  {
+    TC_RETURN((InternalGroupPullResult{{}, groupIds}));
+  }
+
+  tc::cotask<PublicEncryptionKeyPullResult> getPublicEncryptionKeys(
+      std::vector<Trustchain::GroupId> const& groupIds) override
+  {
+    TC_RETURN((PublicEncryptionKeyPullResult{{}, groupIds}));
+  }
+
+  tc::cotask<std::optional<Crypto::EncryptionKeyPair>> getEncryptionKeyPair(
+      Crypto::PublicEncryptionKey const& publicEncryptionKey) override
+  {
+    if (_keyPair && _keyPair->publicKey == publicEncryptionKey)
+      TC_RETURN(_keyPair);
+    TC_RETURN(std::nullopt);
+  }
+
+private:
+  std::optional<Crypto::EncryptionKeyPair> _keyPair;
+};
+
+// The user has no provisional identity
+class ProvisionalUsersAccessorStub : public ProvisionalUsers::IAccessor
+{
+public:
+  tc::cotask<std::optional<ProvisionalUserKeys>> pullEncryptionKeys(
+      Crypto::PublicSignatureKey const&,
+      Crypto::PublicSignatureKey const&) override
+  {
+    TC_RETURN(std::nullopt);
+  }
+
+  tc::cotask<std::optional<ProvisionalUserKeys>> findEncryptionKeysFromCache(
+      Crypto::PublicSignatureKey const&,
+      Crypto::PublicSignatureKey const&) override
+  {
+    TC_RETURN(std::nullopt);
+  }
+
+  tc::cotask<void> refreshKeys() override
+  {
+    TC_RETURN();
+  }
+};
+
+Test::Generator& generator()
+{
+  static Test::Generator generator;
+  return generator;
+}
+
+// Created once per device count, like the other fixtures below
+Test::User const& userWithDevices(std::int64_t deviceCount)
+{
+  static std::map<std::int64_t, Test::User> users;
+
+  auto it = users.find(deviceCount);
+  if (it == users.end())
+  {
+    auto user = generator().makeUser(fmt::format("devices{}", deviceCount));
+    for (auto i = 1; i < deviceCount; ++i)
+      user.addDevice();
+    it = users.emplace(deviceCount, std::move(user)).first;
+  }
+  return it->second;
+}
+
+struct GroupHistory
+{
+  Test::User author;
+  std::vector<Trustchain::ServerEntry> entries;
+};
+
+// A group created by its author alone, to which memberCount users are added
+// 10 at a time
+GroupHistory const& groupWithMembers(std::int64_t memberCount)
+{
+  static std::map<std::int64_t, GroupHistory> groups;
+
+  auto it = groups.find(memberCount);
+  if (it == groups.end())
+  {
+    auto author = generator().makeUser(fmt::format("author{}", memberCount));
+    auto const& authorDevice = author.devices().front();
+    auto group = author.makeGroup();
+    std::vector<Test::User> addition;
+    for (auto i = 0; i < memberCount; ++i)
+    {
+      addition.push_back(
+          generator().makeUser(fmt::format("member{}-{}", memberCount, i)));
+      if (addition.size() == 10 || i == memberCount - 1)
+      {
+        group.addUsers(authorDevice, addition);
+        addition.clear();
+      }
+    }
+    it = groups
+             .emplace(memberCount,
+                      GroupHistory{
+                          author,
+                          Test::Generator::makeEntryList(group.entries())})
+             .first;
+  }
+  return it->second;
+}
+
+struct KeyHistory
+{
+  Test::User user;
+  std::vector<Trustchain::ClientEntry> entries;
+};
+
+// A user whose key was rotated by keyCount - 1 device revocations
+KeyHistory const& userWithKeys(std::int64_t keyCount)
+{
+  static std::map<std::int64_t, KeyHistory> users;
+
+  auto it = users.find(keyCount);
+  if (it == users.end())
+  {
+    auto user = generator().makeUser(fmt::format("keys{}", keyCount));
+    auto entries = user.entries();
+    for (auto i = 1; i < keyCount; ++i)
+    {
+      auto& target = user.addDevice();
+      entries.push_back(target.entry);
+      entries.push_back(user.revokeDevice(target));
+    }
+    it = users.emplace(keyCount, KeyHistory{user, std::move(entries)}).first;
+  }
+  return it->second;
+}
+}
+
+/// What: pull a user with range(0) devices and verify its blocks
+/// PostCond: the user is found with all its devices
+static void offline_user_accessor_pull(benchmark::State& state)
+{
+  auto const& user = userWithDevices(state.range(0));
+  UserRequesterStub requester(generator().makeEntryList({user}));
+  Users::UserAccessor userAccessor(generator().context(), &requester);
+  std::vector<Trustchain::UserId> const ids{user.id()};
+  for (auto _ : state)
+  {
+    auto const result = AWAIT(userAccessor.pull(ids));
+    benchmark::DoNotOptimize(result.found.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["devices"] = static_cast<double>(state.range(0));
+}
+BENCHMARK(offline_user_accessor_pull)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+/// What: verify and apply the blocks of a group of range(0) members, added 10
+/// at a time, as a member of the group
+/// PostCond: the group is an internal group
+static void offline_group_updater_process_entries(benchmark::State& state)
+{
+  auto const& history = groupWithMembers(state.range(0));
+  LocalUserAccessorStub localUserAccessor(history.author);
+  UserAccessorStub userAccessor(
+      {history.author.devices().begin(), history.author.devices().end()});
+  ProvisionalUsersAccessorStub provisionalUsersAccessor;
+  for (auto _ : state)
+  {
+    auto const group =
+        AWAIT(GroupUpdater::processGroupEntries(localUserAccessor,
+                                                userAccessor,
+                                                provisionalUsersAccessor,
+                                                std::nullopt,
+                                                history.entries));
+    benchmark::DoNotOptimize(group->index());
+  }
+  state.SetItemsProcessed(state.iterations() * history.entries.size());
+  state.counters["members"] = static_cast<double>(state.range(0));
+  state.counters["blocks"] = static_cast<double>(history.entries.size());
+}
+BENCHMARK(offline_group_updater_process_entries)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000);
+
+/// What: make the key publishes sharing range(0) resources with range(1)
+/// users
+/// PostCond: one signed block per resource and recipient
+static void offline_share_generate_blocks(benchmark::State& state)
+{
+  auto const& sender = userWithDevices(1).devices().front();
+  auto const signer = sender.signer();
+
+  ResourceKeys::KeysResult resourceKeys;
+  for (auto i = 0; i < state.range(0); ++i)
+  {
+    resourceKeys.emplace_back(Crypto::makeSymmetricKey(),
+                              Crypto::getRandom<Trustchain::ResourceId>());
+  }
+  Share::KeyRecipients recipients;
+  for (auto i = 0; i < state.range(1); ++i)
+  {
+    recipients.recipientUserKeys.push_back(
+        Crypto::makeEncryptionKeyPair().publicKey);
+  }
+
+  for (auto _ : state)
+  {
+    auto const blocks =
+        Share::generateShareBlocks(generator().context().id(),
+                                   sender.id(),
+                                   signer,
+                                   resourceKeys,
+                                   recipients);
+    benchmark::DoNotOptimize(blocks.data());
+  }
+  auto const blocks = state.range(0) * state.range(1);
+  state.SetItemsProcessed(state.iterations() * blocks);
+  state.counters["blocks"] = static_cast<double>(blocks);
+}
+BENCHMARK(offline_share_generate_blocks)
+    ->Args({1, 1})
+    ->Args({1, 100})
+    ->Args({100, 1})
+    ->Args({10, 10})
+    ->Args({100, 100});
+
+/// What: decrypt a key publish and store its resource key, shared to the user
+/// when range(0) is 0, to one of its groups otherwise
+/// PostCond: the resource key is in the store
+static void offline_receive_key(benchmark::State& state)
+{
+  auto const toGroup = state.range(0) != 0;
+  auto const& sender = userWithDevices(1).devices().front();
+  auto const& receiver = userWithKeys(1).user;
+  auto const group = receiver.makeGroup();
+  Test::Resource const resource;
+  auto const entry = Trustchain::clientToServerEntry(
+      toGroup ? generator().shareWith(sender, group, resource) :
+                generator().shareWith(sender, receiver, resource));
+  auto const& keyPublish =
+      entry.action().get<Trustchain::Actions::KeyPublish>();
+
+  auto const db =
+      AWAIT(DataStore::createDatabase(DataStore::ephemeralDbPath));
+  ResourceKeys::Store resourceKeyStore(db.get());
+  LocalUserAccessorStub localUserAccessor(receiver);
+  GroupAccessorStub groupAccessor(group.currentEncKp());
+  ProvisionalUsersAccessorStub provisionalUsersAccessor;
+  for (auto _ : state)
+  {
+    AWAIT_VOID(ReceiveKey::decryptAndStoreKey(resourceKeyStore,
+                                              localUserAccessor,
+                                              groupAccessor,
+                                              provisionalUsersAccessor,
+                                              keyPublish));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(toGroup ? "group" : "user");
+}
+BENCHMARK(offline_receive_key)->Arg(0)->Arg(1);
+
+/// What: decrypt the range(0) user keys sealed in the history of a device
+/// PostCond: every user key is recovered
+static void offline_recover_user_keys(benchmark::State& state)
+{
+  auto const& history = userWithKeys(state.range(0));
+  auto const& device = history.user.devices().front();
+  auto const sealedKeys = std::get<1>(Users::Updater::processUserSealedKeys(
+      device.keys(),
+      generator().context(),
+      Test::Generator::makeEntryList(history.entries)));
+  for (auto _ : state)
+  {
+    auto const userKeys = Users::Updater::recoverUserKeys(
+        device.keys().encryptionKeyPair, sealedKeys);
+    benchmark::DoNotOptimize(userKeys.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["keys"] = static_cast<double>(state.range(0));
+}
+BENCHMARK(offline_recover_user_keys)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
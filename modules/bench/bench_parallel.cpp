@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <Tanker/AsyncCore.hpp>
+#include <Tanker/Compute.hpp>
+#include <Tanker/Functional/TrustchainFixture.hpp>
+
+#include <Helpers/Await.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace Tanker;
+using namespace Tanker::Functional;
+
+namespace
+{
+constexpr std::size_t clearSize = 64 * 1024;
+
+// One session shared by every benchmark thread
+AsyncCore& sharedCore()
+{
+  static auto const core = [] {
+    auto user = TrustchainFixture::getTrustchain().makeUser(UserType::New);
+    auto device = user.makeDevice();
+    return AWAIT(device.open());
+  }();
+  return *core;
+}
+
+std::vector<std::uint8_t> const& encryptedData()
+{
+  static auto const encrypted =
+      sharedCore().encrypt(std::vector<std::uint8_t>(clearSize, 'a')).get();
+  return encrypted;
+}
+
+void applyThreshold(benchmark::State const& state)
+{
+  // 0 offloads every call, the default keeps 64 KiB calls on the executor
+  Compute::setMinOffloadedBytes(state.range(0) ? 0 : 1024 * 1024);
+}
+}
+
+/// What: decrypt 64 KiB buffers with one AsyncCore from several threads
+/// PreCond: range(0) is 1 when the crypto of each call runs on the compute
+/// pool, 0 when it runs on the executor
+static void asynccore_parallel_decrypt(benchmark::State& state)
+{
+  auto& core = sharedCore();
+  auto const& encrypted = encryptedData();
+  applyThreshold(state);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(core.decrypt(encrypted).get());
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * clearSize);
+}
+BENCHMARK(asynccore_parallel_decrypt)
+    ->Arg(0)
+    ->Arg(1)
+    ->ThreadRange(1, std::max(std::thread::hardware_concurrency(), 1u))
+    ->UseRealTime();
+
+/// What: encrypt 64 KiB buffers with one EncryptionSession from several
+/// threads
+/// PreCond: same range(0) as asynccore_parallel_decrypt
+static void asynccore_parallel_session_encrypt(benchmark::State& state)
+{
+  static auto session = sharedCore().makeEncryptionSession().get();
+  std::vector<std::uint8_t> const clearData(clearSize, 'a');
+  std::vector<std::uint8_t> encrypted(
+      EncryptionSession::encryptedSize(clearSize));
+  applyThreshold(state);
+  for (auto _ : state)
+  {
+    AWAIT(session.encrypt(encrypted.data(), clearData));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * clearSize);
+}
+BENCHMARK(asynccore_parallel_session_encrypt)
+    ->Arg(0)
+    ->Arg(1)
+    ->ThreadRange(1, std::max(std::thread::hardware_concurrency(), 1u))
+    ->UseRealTime();
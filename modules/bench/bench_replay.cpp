@@ -0,0 +1,234 @@
+#include <benchmark/benchmark.h>
+
+#include <Tanker/AsyncCore.hpp>
+#include <Tanker/DataStore/ADatabase.hpp>
+#include <Tanker/Encoding/Base64.hpp>
+#include <Tanker/FakeServer/Server.hpp>
+#include <Tanker/Identity/PublicIdentity.hpp>
+#include <Tanker/Identity/SecretPermanentIdentity.hpp>
+#include <Tanker/Network/ConnectionFactory.hpp>
+#include <Tanker/Types/SUserId.hpp>
+
+#include <Helpers/JsonFile.hpp>
+#include <Helpers/UniquePath.hpp>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Tanker;
+
+namespace
+{
+auto const TMP_PATH = "testtmp";
+
+struct AsyncCoreDeleter
+{
+  void operator()(AsyncCore* core) const
+  {
+    core->destroy().get();
+  }
+};
+
+using AsyncCorePtr = std::unique_ptr<AsyncCore, AsyncCoreDeleter>;
+
+AsyncCorePtr makeCore(Trustchain::TrustchainId const& trustchainId,
+                      std::string const& storagePath)
+{
+  return AsyncCorePtr(new AsyncCore(
+      "replay",
+      Network::SdkInfo{"sdk-native-bench", trustchainId, "0.0.1"},
+      storagePath));
+}
+
+// A capture and what is needed to run the captured session again: the
+// storage of its device before the capture, the identity of its user and the
+// resources it decrypted
+struct Scenario
+{
+  std::string capturePath;
+  std::string storagePath;
+  std::string identity;
+  Trustchain::TrustchainId trustchainId;
+  std::vector<std::vector<std::uint8_t>> resources;
+};
+
+Scenario loadScenario(std::string const& path)
+{
+  auto const json = loadJson(path);
+  Scenario scenario;
+  scenario.capturePath = json.at("capture").get<std::string>();
+  scenario.storagePath = json.at("storage").get<std::string>();
+  scenario.identity = json.at("identity").get<std::string>();
+  scenario.trustchainId = Encoding::base64Decode<Trustchain::TrustchainId>(
+      json.at("trustchain_id").get<std::string>());
+  for (auto const& resource : json.at("resources"))
+  {
+    scenario.resources.push_back(
+        Encoding::base64Decode(resource.get<std::string>()));
+  }
+  return scenario;
+}
+
+struct RecordedScenario
+{
+  UniquePath captureDir{TMP_PATH};
+  UniquePath storage{TMP_PATH};
+  Scenario scenario;
+};
+
+// Records a user with several devices who decrypts resources shared with
+// them directly and through a group that grew over time
+Scenario const& recordScenario()
+{
+  static RecordedScenario recorded;
+  FakeServer::Server server({std::chrono::milliseconds{5}});
+  server.install();
+
+  auto const makeIdentity = [&](std::string const& userId) {
+    return to_string(Identity::createIdentity(
+        server.trustchainId(),
+        server.trustchainKeyPair().privateKey,
+        obfuscateUserId(SUserId{userId}, server.trustchainId())));
+  };
+  auto const registerUser = [&](std::string const& identity,
+                                std::string const& storagePath) {
+    auto core = makeCore(server.trustchainId(), storagePath);
+    core->start(identity).get();
+    auto const verificationKey = core->generateVerificationKey().get();
+    core->registerIdentity(verificationKey).get();
+    return std::make_pair(std::move(core), verificationKey);
+  };
+
+  auto& scenario = recorded.scenario;
+  scenario.capturePath = recorded.captureDir.path + "/capture.jsonl";
+  scenario.storagePath = recorded.storage.path;
+  scenario.identity = makeIdentity("alice");
+  scenario.trustchainId = server.trustchainId();
+
+  UniquePath aliceStorage(TMP_PATH);
+  auto [alice, aliceVerificationKey] =
+      registerUser(scenario.identity, aliceStorage.path);
+  alice.reset();
+  copyFiles(aliceStorage.path, scenario.storagePath);
+  for (auto i = 0; i < 4; ++i)
+  {
+    auto device = makeCore(server.trustchainId(), DataStore::ephemeralDbPath);
+    device->start(scenario.identity).get();
+    device->verifyIdentity(aliceVerificationKey).get();
+  }
+
+  auto const bobIdentity = makeIdentity("bob");
+  auto bob = registerUser(bobIdentity, DataStore::ephemeralDbPath).first;
+  // only the members of a group can add members to it
+  auto const groupId =
+      bob->createGroup(
+             {SPublicIdentity{Identity::getPublicIdentity(bobIdentity)},
+              SPublicIdentity{Identity::getPublicIdentity(scenario.identity)}})
+          .get();
+  for (auto i = 0; i < 4; ++i)
+  {
+    auto const identity = makeIdentity(fmt::format("member{}", i));
+    registerUser(identity, DataStore::ephemeralDbPath);
+    bob->updateGroupMembers(
+           groupId, {SPublicIdentity{Identity::getPublicIdentity(identity)}})
+        .get();
+  }
+  std::vector<std::uint8_t> const clearData(1024, 'a');
+  for (auto i = 0; i < 10; ++i)
+  {
+    scenario.resources.push_back(bob->encrypt(clearData, {}, {groupId}).get());
+    scenario.resources.push_back(
+        bob->encrypt(clearData,
+                     {SPublicIdentity{
+                         Identity::getPublicIdentity(scenario.identity)}})
+            .get());
+  }
+  bob.reset();
+
+  Network::ConnectionFactory::record(scenario.capturePath);
+  auto recordedAlice = makeCore(server.trustchainId(), aliceStorage.path);
+  recordedAlice->start(scenario.identity).get();
+  for (auto const& resource : scenario.resources)
+    recordedAlice->decrypt(resource).get();
+  recordedAlice.reset();
+  Network::ConnectionFactory::stopRecording();
+  server.uninstall();
+  return scenario;
+}
+
+// From the json file in TANKER_BENCH_REPLAY_SCENARIO, with the keys capture,
+// storage, identity, trustchain_id and resources, or recorded once against a
+// fake server
+Scenario const& scenario()
+{
+  static auto const& scenario = []() -> Scenario const& {
+    if (auto const path = std::getenv("TANKER_BENCH_REPLAY_SCENARIO"))
+    {
+      static auto const loaded = loadScenario(path);
+      return loaded;
+    }
+    return recordScenario();
+  }();
+  return scenario;
+}
+
+double milliseconds(std::chrono::steady_clock::duration d)
+{
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+}
+
+/// What: start the session of a capture and decrypt its resources, the
+/// replies come from the capture, at full speed when range(0) is 0 and with
+/// the recorded server timings when it is 1
+/// PostCond: start_ms and decrypt_ms are the latencies of each operation
+static void replay_session(benchmark::State& state)
+{
+  auto const& s = scenario();
+  Network::ConnectionFactory::replay(s.capturePath,
+                                     state.range(0) ?
+                                         Network::ReplayTiming::Original :
+                                         Network::ReplayTiming::FullSpeed);
+  std::chrono::steady_clock::duration start{};
+  std::chrono::steady_clock::duration decrypt{};
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    UniquePath storage(TMP_PATH);
+    copyFiles(s.storagePath, storage.path);
+    auto core = makeCore(s.trustchainId, storage.path);
+    state.ResumeTiming();
+
+    auto const before = std::chrono::steady_clock::now();
+    core->start(s.identity).get();
+    auto const started = std::chrono::steady_clock::now();
+    for (auto const& resource : s.resources)
+      core->decrypt(resource).get();
+    decrypt += std::chrono::steady_clock::now() - started;
+    start += started - before;
+
+    state.PauseTiming();
+    core.reset();
+    state.ResumeTiming();
+  }
+  Network::ConnectionFactory::setCreator({});
+  state.counters["start_ms"] = benchmark::Counter(
+      milliseconds(start), benchmark::Counter::kAvgIterations);
+  state.counters["decrypt_ms"] = benchmark::Counter(
+      milliseconds(decrypt) / s.resources.size(),
+      benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(replay_session)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/Crypto/SigningContext.hpp>
+#include <Tanker/Trustchain/Action.hpp>
+#include <Tanker/Trustchain/Actions/KeyPublish/ToUser.hpp>
+#include <Tanker/Trustchain/ClientEntry.hpp>
+
+#include <Helpers/Buffers.hpp>
+
+using namespace Tanker;
+
+namespace
+{
+Trustchain::Action makeKeyPublish()
+{
+  return Trustchain::Actions::KeyPublishToUser{
+      make<Crypto::PublicEncryptionKey>("recipient key"),
+      make<Trustchain::ResourceId>("resource id"),
+      make<Crypto::SealedSymmetricKey>("sealed key")};
+}
+}
+
+/// What: sign a block hash with crypto_sign_detached
+static void sign_hash_crypto_sign(benchmark::State& state)
+{
+  auto const keyPair = Crypto::makeSignatureKeyPair();
+  auto const hash = make<Crypto::Hash>("block hash");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Crypto::sign(hash, keyPair.privateKey));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(sign_hash_crypto_sign);
+
+/// What: sign a block hash with a SigningContext
+static void sign_hash_signing_context(benchmark::State& state)
+{
+  auto const keyPair = Crypto::makeSignatureKeyPair();
+  Crypto::SigningContext const signer(keyPair.privateKey);
+  auto const hash = make<Crypto::Hash>("block hash");
+  for (auto _ : state)
+    benchmark::DoNotOptimize(signer.sign(hash));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(sign_hash_signing_context);
+
+/// What: create key publish blocks signed with the private key, like the share
+/// fan-out did
+static void create_key_publish_private_key(benchmark::State& state)
+{
+  auto const keyPair = Crypto::makeSignatureKeyPair();
+  auto const trustchainId = make<Trustchain::TrustchainId>("trustchain id");
+  auto const author = make<Crypto::Hash>("author");
+  auto const action = makeKeyPublish();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Trustchain::ClientEntry::create(
+        trustchainId, author, action, keyPair.privateKey));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(create_key_publish_private_key);
+
+/// What: create key publish blocks signed with the device SigningContext
+static void create_key_publish_signing_context(benchmark::State& state)
+{
+  auto const keyPair = Crypto::makeSignatureKeyPair();
+  Crypto::SigningContext const signer(keyPair.privateKey);
+  auto const trustchainId = make<Trustchain::TrustchainId>("trustchain id");
+  auto const author = make<Crypto::Hash>("author");
+  auto const action = makeKeyPublish();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        Trustchain::ClientEntry::create(trustchainId, author, action, signer));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(create_key_publish_signing_context);
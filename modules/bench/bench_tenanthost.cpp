@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <Tanker/Functional/TrustchainFixture.hpp>
+#include <Tanker/TenantHost.hpp>
+#include <Tanker/Types/Passphrase.hpp>
+
+#include <Helpers/Await.hpp>
+#include <Helpers/UniquePath.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace Tanker;
+using namespace Tanker::Functional;
+
+namespace
+{
+auto const password = Passphrase{"tenant password"};
+
+// 0 where /proc is not available
+std::int64_t residentBytes()
+{
+#ifdef __linux__
+  std::ifstream statm("/proc/self/statm");
+  std::int64_t size = 0;
+  std::int64_t resident = 0;
+  statm >> size >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif
+}
+
+TenantHost makeHost(std::string const& storagePath,
+                    TenantHost::Options options = {})
+{
+  auto& trustchain = TrustchainFixture::getTrustchain();
+  Network::SdkInfo info{"sdk-native-bench", trustchain.id, "0.0.1"};
+  return TenantHost(trustchain.url, std::move(info), storagePath, options);
+}
+
+struct Tenants
+{
+  UniquePath storage{"bench_tenanthost"};
+  std::vector<std::string> identities;
+};
+
+// Registers tenantCount identities in a host storage, once
+Tenants const& registeredTenants(std::size_t tenantCount)
+{
+  static Tenants tenants;
+
+  auto& trustchain = TrustchainFixture::getTrustchain();
+  auto host = makeHost(tenants.storage.path);
+  while (tenants.identities.size() < tenantCount)
+  {
+    auto const user = trustchain.makeUser(UserType::New);
+    AWAIT(host.open(user.identity, password));
+    tenants.identities.push_back(user.identity);
+  }
+  return tenants;
+}
+
+TenantHost::Options unbounded()
+{
+  return {1000000, std::chrono::hours(1)};
+}
+}
+
+/// What: start range(0) registered tenants in a TenantHost
+/// PostCond: counters give the memory held by each resident tenant
+static void tenant_host_resident_memory(benchmark::State& state)
+{
+  auto const tenantCount = static_cast<std::size_t>(state.range(0));
+  auto const& tenants = registeredTenants(tenantCount);
+
+  for (auto _ : state)
+  {
+    auto host = makeHost(tenants.storage.path, unbounded());
+    auto const before = residentBytes();
+    for (auto i = 0u; i < tenantCount; ++i)
+      AWAIT(host.open(tenants.identities[i]));
+    state.counters["bytesPerTenant"] =
+        static_cast<double>(residentBytes() - before) / tenantCount;
+  }
+  state.SetItemsProcessed(state.iterations() * tenantCount);
+}
+BENCHMARK(tenant_host_resident_memory)
+    ->Arg(10)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/// What: open a tenant that is already resident
+static void tenant_host_open_resident(benchmark::State& state)
+{
+  auto const& tenants = registeredTenants(10);
+  auto host = makeHost(tenants.storage.path, unbounded());
+  for (auto const& identity : tenants.identities)
+    AWAIT(host.open(identity));
+
+  std::size_t index = 0;
+  for (auto _ : state)
+  {
+    auto const& identity = tenants.identities[index++ % 10];
+    benchmark::DoNotOptimize(AWAIT(host.open(identity)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(tenant_host_open_resident);
@@ -0,0 +1,421 @@
+#include <Tanker/AsyncCore.hpp>
+#include <Tanker/DataStore/ADatabase.hpp>
+#include <Tanker/Errors/Exception.hpp>
+#include <Tanker/FakeServer/Server.hpp>
+#include <Tanker/Identity/PublicIdentity.hpp>
+#include <Tanker/Identity/SecretPermanentIdentity.hpp>
+#include <Tanker/Init.hpp>
+#include <Tanker/Log/LogHandler.hpp>
+#include <Tanker/Types/SUserId.hpp>
+
+#include <cppcodec/base64_rfc4648.hpp>
+#include <docopt/docopt.h>
+#include <fmt/format.h>
+#include <tconcurrent/async.hpp>
+#include <tconcurrent/async_wait.hpp>
+#include <tconcurrent/coroutine.hpp>
+#include <tconcurrent/future.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+using namespace Tanker;
+
+static const char USAGE[] =
+    R"(Tanker load generator
+
+    Runs N sessions in one process, sharing the executor and the thread pool
+    of the SDK, and makes them run a mix of operations at a target rate.
+
+    Usage:
+      bench_loadgen local [options]
+      bench_loadgen <trustchainurl> <trustchainid> --trustchain-private-key=<trustchainprivatekey> [options]
+      bench_loadgen --help
+
+    Options:
+      -h --help              Show this screen.
+      --clients=<n>          Number of sessions [default: 10]
+      --rate=<ops>           Operations per second in total [default: 100]
+      --duration=<seconds>   Duration of the load [default: 10]
+      --mix=<weights>        Weights of encrypt:decrypt:share:group [default: 4:4:1:1]
+      --size=<bytes>         Size of the encrypted data [default: 1024]
+      --latency=<ms>         Latency of the local server [default: 0]
+)";
+
+using MainArgs = std::map<std::string, docopt::value>;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+enum class Operation
+{
+  Encrypt,
+  Decrypt,
+  Share,
+  Group,
+};
+
+constexpr auto operationCount = 4;
+
+char const* operationNames[operationCount] = {
+    "encrypt",
+    "decrypt",
+    "share",
+    "group",
+};
+
+struct AsyncCoreDeleter
+{
+  void operator()(AsyncCore* core) const
+  {
+    core->destroy().get();
+  }
+};
+
+using AsyncCorePtr = std::unique_ptr<AsyncCore, AsyncCoreDeleter>;
+
+struct Endpoint
+{
+  std::string url;
+  std::string trustchainId;
+  std::string trustchainPrivateKey;
+};
+
+struct Options
+{
+  int clients;
+  double rate;
+  std::chrono::seconds duration;
+  std::vector<double> mix;
+  std::size_t size;
+};
+
+struct Client
+{
+  AsyncCorePtr core;
+  SPublicIdentity publicIdentity;
+  // shared with this client by the previous one, to decrypt
+  std::vector<std::uint8_t> received;
+  // encrypted by this client, to share
+  SResourceId resourceId;
+  // in microseconds, by operation
+  std::vector<double> latencies[operationCount];
+  std::uint64_t errors = 0;
+};
+
+struct Usage
+{
+  std::chrono::microseconds cpu{0};
+  // 0 where getrusage is not available
+  std::int64_t peakResidentBytes = 0;
+};
+
+Usage usage()
+{
+#ifdef __linux__
+  rusage r{};
+  getrusage(RUSAGE_SELF, &r);
+  auto const time = [](timeval const& t) {
+    return std::chrono::seconds(t.tv_sec) +
+           std::chrono::microseconds(t.tv_usec);
+  };
+  // ru_maxrss is in kilobytes on Linux
+  return {time(r.ru_utime) + time(r.ru_stime),
+          static_cast<std::int64_t>(r.ru_maxrss) * 1024};
+#else
+  return {};
+#endif
+}
+
+std::vector<double> parseMix(std::string const& mix)
+{
+  std::vector<double> weights;
+  std::istringstream in(mix);
+  std::string weight;
+  while (std::getline(in, weight, ':'))
+    weights.push_back(std::stod(weight));
+  if (weights.size() != operationCount)
+  {
+    throw std::runtime_error(
+        fmt::format("--mix needs {} weights, got {}", operationCount, mix));
+  }
+  return weights;
+}
+
+Options parseOptions(MainArgs const& args)
+{
+  Options options;
+  options.clients = static_cast<int>(args.at("--clients").asLong());
+  options.rate = std::stod(args.at("--rate").asString());
+  options.duration = std::chrono::seconds(args.at("--duration").asLong());
+  options.mix = parseMix(args.at("--mix").asString());
+  options.size = static_cast<std::size_t>(args.at("--size").asLong());
+  if (options.clients <= 0 || options.rate <= 0)
+    throw std::runtime_error("--clients and --rate must be positive");
+  return options;
+}
+
+// Registers a new user, with a user id unique to this run
+tc::cotask<void> registerClient(Endpoint const& endpoint,
+                                std::string userId,
+                                Client& client)
+{
+  auto const identity = Identity::createIdentity(
+      endpoint.trustchainId, endpoint.trustchainPrivateKey, SUserId{userId});
+  client.publicIdentity =
+      SPublicIdentity{Identity::getPublicIdentity(identity)};
+  client.core = AsyncCorePtr(new AsyncCore(
+      endpoint.url,
+      {"sdk-native-loadgen",
+       cppcodec::base64_rfc4648::decode<Trustchain::TrustchainId>(
+           endpoint.trustchainId),
+       "0.0.1"},
+      DataStore::ephemeralDbPath));
+  TC_AWAIT(client.core->start(identity));
+  auto const verificationKey = TC_AWAIT(client.core->generateVerificationKey());
+  TC_AWAIT(client.core->registerIdentity(verificationKey));
+}
+
+// Gives each client a resource of its own to share, and one shared by the
+// previous client to decrypt
+tc::cotask<void> prepareClient(std::vector<Client>& clients,
+                               std::size_t index,
+                               std::vector<std::uint8_t> const& clearData)
+{
+  auto& client = clients[index];
+  auto& next = clients[(index + 1) % clients.size()];
+  next.received =
+      TC_AWAIT(client.core->encrypt(clearData, {next.publicIdentity}));
+  auto const encrypted = TC_AWAIT(client.core->encrypt(clearData));
+  client.resourceId = TC_AWAIT(AsyncCore::getResourceId(encrypted));
+}
+
+tc::cotask<void> runOperation(Client& client,
+                              Operation operation,
+                              SPublicIdentity const& peer,
+                              std::vector<std::uint8_t> const& clearData)
+{
+  switch (operation)
+  {
+  case Operation::Encrypt:
+    TC_AWAIT(client.core->encrypt(clearData));
+    break;
+  case Operation::Decrypt:
+    TC_AWAIT(client.core->decrypt(client.received));
+    break;
+  case Operation::Share:
+    TC_AWAIT(client.core->share({client.resourceId}, {peer}, {}));
+    break;
+  case Operation::Group:
+    TC_AWAIT(client.core->createGroup({client.publicIdentity, peer}));
+    break;
+  }
+}
+
+// Each client keeps a fixed schedule: an operation starts at its scheduled
+// time, or as soon as the previous one is done when the client is late.
+// Latencies are measured from the scheduled start, so that a slow operation
+// also counts against the ones it delayed.
+tc::cotask<void> runClient(std::vector<Client>& clients,
+                           std::size_t index,
+                           Options const& options,
+                           std::vector<std::uint8_t> const& clearData)
+{
+  auto& client = clients[index];
+  std::mt19937 random(static_cast<std::mt19937::result_type>(index));
+  std::discrete_distribution<int> pickOperation(options.mix.begin(),
+                                                options.mix.end());
+  // any other client
+  std::uniform_int_distribution<std::size_t> pickPeer(
+      1, std::max<std::size_t>(clients.size() - 1, 1));
+
+  auto const interval =
+      std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(
+          options.clients / options.rate));
+  auto const begin =
+      Clock::now() + interval * static_cast<int>(index) / options.clients;
+  auto const end = begin + options.duration;
+  for (auto scheduled = begin; scheduled < end; scheduled += interval)
+  {
+    auto const now = Clock::now();
+    if (scheduled > now)
+      TC_AWAIT(tc::async_wait(scheduled - now));
+
+    auto const operation = static_cast<Operation>(pickOperation(random));
+    auto const& peer =
+        clients[(index + pickPeer(random)) % clients.size()].publicIdentity;
+    bool failed = false;
+    try
+    {
+      TC_AWAIT(runOperation(client, operation, peer, clearData));
+    }
+    catch (Errors::Exception const&)
+    {
+      failed = true;
+    }
+    if (failed)
+    {
+      ++client.errors;
+      continue;
+    }
+    client.latencies[static_cast<int>(operation)].push_back(
+        std::chrono::duration<double, std::micro>(Clock::now() - scheduled)
+            .count());
+  }
+}
+
+double percentile(std::vector<double> const& sorted, double q)
+{
+  if (sorted.empty())
+    return 0;
+  auto const rank = static_cast<std::size_t>(std::ceil(q * sorted.size()));
+  return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+void printLatencies(std::string const& name, std::vector<double> latencies)
+{
+  std::sort(latencies.begin(), latencies.end());
+  fmt::print("{:<8} {:>8} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f}\n",
+             name,
+             latencies.size(),
+             percentile(latencies, 0.5) / 1000,
+             percentile(latencies, 0.95) / 1000,
+             percentile(latencies, 0.99) / 1000,
+             percentile(latencies, 0.999) / 1000);
+}
+
+void report(std::vector<Client> const& clients,
+            Clock::duration elapsed,
+            Usage const& before,
+            Usage const& after)
+{
+  std::vector<double> all;
+  std::uint64_t errors = 0;
+  fmt::print("{:<8} {:>8} {:>10} {:>10} {:>10} {:>10}\n",
+             "op",
+             "count",
+             "p50 ms",
+             "p95 ms",
+             "p99 ms",
+             "p999 ms");
+  for (auto i = 0; i < operationCount; ++i)
+  {
+    std::vector<double> latencies;
+    for (auto const& client : clients)
+    {
+      latencies.insert(latencies.end(),
+                       client.latencies[i].begin(),
+                       client.latencies[i].end());
+    }
+    all.insert(all.end(), latencies.begin(), latencies.end());
+    printLatencies(operationNames[i], std::move(latencies));
+  }
+  printLatencies("all", all);
+  for (auto const& client : clients)
+    errors += client.errors;
+
+  auto const seconds = std::chrono::duration<double>(elapsed).count();
+  auto const operations = static_cast<double>(all.size());
+  fmt::print("\nthroughput: {:.1f} op/s\n", operations / seconds);
+  fmt::print("errors: {}\n", errors);
+  auto const cpu = std::chrono::duration<double, std::milli>(after.cpu -
+                                                            before.cpu);
+  fmt::print("cpu per op: {:.3f} ms\n",
+             operations ? cpu.count() / operations : 0.);
+  fmt::print("peak rss: {:.1f} MiB\n",
+             after.peakResidentBytes / (1024. * 1024.));
+}
+
+void run(Endpoint const& endpoint, Options const& options)
+{
+  std::vector<Client> clients(options.clients);
+  std::vector<std::uint8_t> const clearData(options.size, 'a');
+  auto const runId = std::random_device()();
+
+  auto const forEachClient = [&](auto&& f) {
+    std::vector<tc::future<void>> futures;
+    for (auto i = 0u; i < clients.size(); ++i)
+      futures.push_back(tc::async_resumable([&, i] { return f(i); }));
+    for (auto& future : futures)
+      future.get();
+  };
+
+  fmt::print("registering {} clients\n", clients.size());
+  forEachClient([&](std::size_t i) {
+    return registerClient(
+        endpoint, fmt::format("loadgen-{}-{}", runId, i), clients[i]);
+  });
+  forEachClient([&](std::size_t i) {
+    return prepareClient(clients, i, clearData);
+  });
+
+  fmt::print("running {} op/s for {}s\n\n",
+             options.rate,
+             options.duration.count());
+  auto const before = usage();
+  auto const start = Clock::now();
+  forEachClient([&](std::size_t i) {
+    return runClient(clients, i, options, clearData);
+  });
+  auto const elapsed = Clock::now() - start;
+  auto const after = usage();
+
+  report(clients, elapsed, before, after);
+}
+
+void log_handler(Log::Record const&)
+{
+}
+}
+
+int main(int argc, char** argv)
+{
+  auto const args = docopt::docopt(USAGE, {argv + 1, argv + argc}, true, "");
+
+  Tanker::init();
+  Tanker::Log::setLogHandler(&log_handler);
+  try
+  {
+    auto const options = parseOptions(args);
+    if (args.at("local").asBool())
+    {
+      FakeServer::Server server(
+          {std::chrono::milliseconds(args.at("--latency").asLong())});
+      server.install();
+      run({"local",
+           cppcodec::base64_rfc4648::encode(server.trustchainId()),
+           cppcodec::base64_rfc4648::encode(
+               server.trustchainKeyPair().privateKey)},
+          options);
+    }
+    else
+    {
+      run({args.at("<trustchainurl>").asString(),
+           args.at("<trustchainid>").asString(),
+           args.at("--trustchain-private-key").asString()},
+          options);
+    }
+  }
+  catch (std::exception const& e)
+  {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
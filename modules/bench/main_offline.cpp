@@ -0,0 +1,20 @@
+#include <Tanker/Init.hpp>
+
+#include <Tanker/Log/LogHandler.hpp>
+
+#include <benchmark/benchmark.h>
+
+static void log_handler(Tanker::Log::Record const&)
+{
+}
+
+// Unlike main.cpp, needs no server: the offline benchmarks block on the
+// default executor, which nothing else uses
+int main(int argc, char** argv)
+{
+  Tanker::init();
+  Tanker::Log::setLogHandler(&log_handler);
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -119,6 +119,8 @@ T generichash(gsl::span<uint8_t const> data)
   return hash;
 }
 
+// hash.size() must be 16
+void generichash16(gsl::span<uint8_t const> data, gsl::span<uint8_t> hash);
 std::vector<uint8_t> generichash16(gsl::span<uint8_t const> data);
 void randomFill(gsl::span<uint8_t> data);
 
@@ -158,6 +160,21 @@ gsl::span<uint8_t const> encryptAead(SymmetricKey const& key,
                                      gsl::span<uint8_t const> clearData,
                                      gsl::span<uint8_t const> associatedData);
 
+// encryptedData.size() must be encryptedSize(clearData.size())
+// returns the Mac
+gsl::span<uint8_t const> encryptAead(SymmetricKey const& key,
+                                     AeadIv const& iv,
+                                     gsl::span<uint8_t> encryptedData,
+                                     gsl::span<uint8_t const> clearData,
+                                     gsl::span<uint8_t const> associatedData);
+
+// Generates a random IV and writes |--iv--|--encryptedData--| in aeadData.
+// aeadData.size() must be AeadIv::arraySize + encryptedSize(clearData.size())
+void encryptAead(SymmetricKey const& key,
+                 gsl::span<uint8_t> aeadData,
+                 gsl::span<uint8_t const> clearData,
+                 gsl::span<uint8_t const> ad);
+
 std::vector<uint8_t> encryptAead(SymmetricKey const& key,
                                  gsl::span<uint8_t const> clearData,
                                  gsl::span<uint8_t const> ad = {});
@@ -168,10 +185,28 @@ void decryptAead(SymmetricKey const& key,
                  gsl::span<uint8_t const> encryptedData,
                  gsl::span<uint8_t const> associatedData);
 
+// clearData.size() must be decryptedSize(encryptedData.size())
+void decryptAead(SymmetricKey const& key,
+                 AeadIv const& iv,
+                 gsl::span<uint8_t> clearData,
+                 gsl::span<uint8_t const> encryptedData,
+                 gsl::span<uint8_t const> associatedData);
+
+// aeadData is |--iv--|--encryptedData--|
+// clearData.size() must be decryptedSize(aeadData.size() - AeadIv::arraySize)
+void decryptAead(SymmetricKey const& key,
+                 gsl::span<uint8_t> clearData,
+                 gsl::span<uint8_t const> aeadData,
+                 gsl::span<uint8_t const> ad);
+
 std::vector<uint8_t> decryptAead(SymmetricKey const& key,
                                  gsl::span<uint8_t const> data,
                                  gsl::span<uint8_t const> ad = {});
 
+// iv.size() must be AeadIv::arraySize
+void deriveIv(AeadIv const& ivSeed,
+              uint64_t const number,
+              gsl::span<uint8_t> iv);
 AeadIv deriveIv(AeadIv const& ivSeed, uint64_t const number);
 
 template <typename OutputContainer = std::vector<uint8_t>>
@@ -206,6 +241,11 @@ OutputContainer asymDecrypt(gsl::span<uint8_t const> cipherData,
   return res;
 }
 
+// cipherData.size() must be clearData.size() + crypto_box_SEALBYTES
+void sealEncrypt(gsl::span<uint8_t const> clearData,
+                 gsl::span<uint8_t> cipherData,
+                 PublicEncryptionKey const& recipientKey);
+
 template <typename OutputContainer = std::vector<uint8_t>>
 OutputContainer sealEncrypt(gsl::span<uint8_t const> clearData,
                             PublicEncryptionKey const& recipientKey)
@@ -228,6 +268,11 @@ Sealed<T> sealEncrypt(T const& clearData,
   return res;
 }
 
+// clearData.size() must be cipherData.size() - crypto_box_SEALBYTES
+void sealDecrypt(gsl::span<uint8_t const> cipherData,
+                 gsl::span<uint8_t> clearData,
+                 EncryptionKeyPair const& recipientKeyPair);
+
 template <typename OutputContainer = std::vector<uint8_t>>
 OutputContainer sealDecrypt(gsl::span<uint8_t const> cipherData,
                             EncryptionKeyPair const& recipientKeyPair)
@@ -1,8 +1,8 @@
 #pragma once
 
 #include <Tanker/Crypto/IsCryptographicType.hpp>
+#include <Tanker/Encoding/Base64.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
 #include <nlohmann/json_fwd.hpp>
 
 #include <string>
@@ -18,14 +18,14 @@ struct adl_serializer<
   template <typename Json>
   static void to_json(Json& j, CryptoType const& value)
   {
-    j = cppcodec::base64_rfc4648::encode(value);
+    j = ::Tanker::Encoding::base64Encode(value);
   }
 
   template <typename Json>
   static CryptoType from_json(Json const& j)
   {
-    return cppcodec::base64_rfc4648::decode<CryptoType>(
-        j.template get<std::string>());
+    return ::Tanker::Encoding::base64Decode<CryptoType>(
+        j.template get_ref<std::string const&>());
   }
 
   template <typename Json>
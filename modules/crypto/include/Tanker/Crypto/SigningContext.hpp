@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Tanker/Crypto/PrivateSignatureKey.hpp>
+#include <Tanker/Crypto/PublicSignatureKey.hpp>
+#include <Tanker/Crypto/Signature.hpp>
+
+#include <gsl-lite.hpp>
+
+#include <cstdint>
+
+namespace Tanker
+{
+namespace Crypto
+{
+// Ed25519 signer for a key that signs many messages.
+//
+// crypto_sign_detached hashes the private key on every call to get the secret
+// scalar and the nonce prefix. This class does it once and keeps them in
+// memory allocated with sodium_malloc: guard pages around, locked, read-only
+// and wiped on destruction.
+//
+// Signatures are identical to the ones produced by Crypto::sign.
+class SigningContext
+{
+public:
+  explicit SigningContext(PrivateSignatureKey const& privateKey);
+  ~SigningContext();
+
+  SigningContext(SigningContext const&) = delete;
+  SigningContext& operator=(SigningContext const&) = delete;
+  SigningContext(SigningContext&& other) noexcept;
+  SigningContext& operator=(SigningContext&& other) noexcept;
+
+  PublicSignatureKey const& publicKey() const;
+
+  Signature sign(gsl::span<std::uint8_t const> data) const;
+
+private:
+  struct ExpandedKey;
+
+  PublicSignatureKey _publicKey;
+  ExpandedKey* _expandedKey;
+};
+}
+}
@@ -19,6 +19,21 @@ namespace Tanker
 {
 namespace Crypto
 {
+namespace
+{
+void checkOutputSize(std::size_t size, std::size_t expected)
+{
+  if (size != expected)
+  {
+    throw Errors::formatEx(
+        Errc::InvalidBufferSize,
+        TFMT("invalid output buffer size: got {:d}, expected {:d}"),
+        size,
+        expected);
+  }
+}
+}
+
 namespace detail
 {
 void generichash_impl(gsl::span<uint8_t> hash, gsl::span<uint8_t const> data)
@@ -97,11 +112,38 @@ void sealEncryptImpl(gsl::span<uint8_t const> clearData,
 }
 }
 
-std::vector<uint8_t> generichash16(gsl::span<uint8_t const> data)
+void sealEncrypt(gsl::span<uint8_t const> clearData,
+                 gsl::span<uint8_t> cipherData,
+                 PublicEncryptionKey const& recipientKey)
 {
-  std::vector<uint8_t> hash(crypto_generichash_BYTES_MIN);
+  checkOutputSize(cipherData.size(), clearData.size() + crypto_box_SEALBYTES);
+  detail::sealEncryptImpl(clearData, cipherData, recipientKey);
+}
+
+void sealDecrypt(gsl::span<uint8_t const> cipherData,
+                 gsl::span<uint8_t> clearData,
+                 EncryptionKeyPair const& recipientKeyPair)
+{
+  if (cipherData.size() < crypto_box_SEALBYTES)
+  {
+    throw Errors::Exception(Errc::InvalidSealedDataSize,
+                            "truncated sealed buffer");
+  }
+  checkOutputSize(clearData.size(), cipherData.size() - crypto_box_SEALBYTES);
+  detail::sealDecryptImpl(cipherData, clearData, recipientKeyPair);
+}
+
+void generichash16(gsl::span<uint8_t const> data, gsl::span<uint8_t> hash)
+{
+  checkOutputSize(hash.size(), crypto_generichash_BYTES_MIN);
   crypto_generichash(
       hash.data(), hash.size(), data.data(), data.size(), nullptr, 0);
+}
+
+std::vector<uint8_t> generichash16(gsl::span<uint8_t const> data)
+{
+  std::vector<uint8_t> hash(crypto_generichash_BYTES_MIN);
+  generichash16(data, hash);
   return hash;
 }
 
@@ -236,20 +278,41 @@ std::size_t decryptedSize(ConstAeadSpans const& aead)
   return aead.encryptedData.size() - aead.mac.size();
 }
 
-std::vector<uint8_t> encryptAead(SymmetricKey const& key,
-                                 gsl::span<uint8_t const> clearData,
-                                 gsl::span<uint8_t const> ad)
+gsl::span<uint8_t const> encryptAead(SymmetricKey const& key,
+                                     AeadIv const& iv,
+                                     gsl::span<uint8_t> encryptedData,
+                                     gsl::span<uint8_t const> clearData,
+                                     gsl::span<uint8_t const> associatedData)
 {
-  auto ptr = std::vector<uint8_t>(Crypto::AeadIv::arraySize + clearData.size() +
-                                  Crypto::Mac::arraySize);
-  auto aeadBuffer = makeAeadBuffer<uint8_t>(ptr);
+  checkOutputSize(encryptedData.size(), encryptedSize(clearData.size()));
+  return encryptAead(
+      key, iv.data(), encryptedData.data(), clearData, associatedData);
+}
+
+void encryptAead(SymmetricKey const& key,
+                 gsl::span<uint8_t> aeadData,
+                 gsl::span<uint8_t const> clearData,
+                 gsl::span<uint8_t const> ad)
+{
+  checkOutputSize(aeadData.size(),
+                  AeadIv::arraySize + encryptedSize(clearData.size()));
+  auto aeadBuffer = makeAeadBuffer(aeadData);
   Crypto::randomFill(aeadBuffer.iv);
   encryptAead(key,
               aeadBuffer.iv.data(),
               aeadBuffer.encryptedData.data(),
               clearData,
               ad);
-  return ptr;
+}
+
+std::vector<uint8_t> encryptAead(SymmetricKey const& key,
+                                 gsl::span<uint8_t const> clearData,
+                                 gsl::span<uint8_t const> ad)
+{
+  std::vector<uint8_t> res(AeadIv::arraySize +
+                           encryptedSize(clearData.size()));
+  encryptAead(key, res, clearData, ad);
+  return res;
 }
 
 void decryptAead(SymmetricKey const& key,
@@ -272,6 +335,32 @@ void decryptAead(SymmetricKey const& key,
     throw Exception(Errc::AeadDecryptionFailed, "MAC verification failed");
 }
 
+void decryptAead(SymmetricKey const& key,
+                 AeadIv const& iv,
+                 gsl::span<uint8_t> clearData,
+                 gsl::span<uint8_t const> encryptedData,
+                 gsl::span<uint8_t const> associatedData)
+{
+  checkOutputSize(clearData.size(), decryptedSize(encryptedData.size()));
+  decryptAead(key, iv.data(), clearData.data(), encryptedData, associatedData);
+}
+
+void decryptAead(SymmetricKey const& key,
+                 gsl::span<uint8_t> clearData,
+                 gsl::span<uint8_t const> aeadData,
+                 gsl::span<uint8_t const> ad)
+{
+  if (aeadData.size() < AeadIv::arraySize + aeadOverhead)
+    throw Exception(Errc::InvalidEncryptedDataSize);
+  auto const aeadBuffer = makeAeadBuffer(aeadData);
+  checkOutputSize(clearData.size(), decryptedSize(aeadBuffer));
+  decryptAead(key,
+              aeadBuffer.iv.data(),
+              clearData.data(),
+              aeadBuffer.encryptedData,
+              ad);
+}
+
 std::vector<uint8_t> decryptAead(SymmetricKey const& key,
                                  gsl::span<uint8_t const> aeadData,
                                  gsl::span<uint8_t const> ad)
@@ -283,16 +372,26 @@ std::vector<uint8_t> decryptAead(SymmetricKey const& key,
   return res;
 }
 
-AeadIv deriveIv(AeadIv const& ivSeed, uint64_t const number)
+void deriveIv(AeadIv const& ivSeed,
+              uint64_t const number,
+              gsl::span<uint8_t> iv)
 {
-  auto pointer = reinterpret_cast<uint8_t const*>(&number);
-  auto const numberSize = sizeof(number);
+  checkOutputSize(iv.size(), AeadIv::arraySize);
+
+  // same as hashing ivSeed || number, without building the concatenation
+  crypto_generichash_state state;
+  crypto_generichash_init(&state, nullptr, 0, iv.size());
+  crypto_generichash_update(&state, ivSeed.data(), ivSeed.size());
+  crypto_generichash_update(
+      &state, reinterpret_cast<uint8_t const*>(&number), sizeof(number));
+  crypto_generichash_final(&state, iv.data(), iv.size());
+}
 
-  std::vector<uint8_t> toHash;
-  toHash.reserve(numberSize + AeadIv::arraySize);
-  toHash.insert(toHash.end(), ivSeed.begin(), ivSeed.end());
-  toHash.insert(toHash.end(), pointer, pointer + numberSize);
-  return generichash<AeadIv>(gsl::make_span(toHash.data(), toHash.size()));
+AeadIv deriveIv(AeadIv const& ivSeed, uint64_t const number)
+{
+  AeadIv iv;
+  deriveIv(ivSeed, number, iv);
+  return iv;
 }
 
 Hash prehashPassword(std::string password)
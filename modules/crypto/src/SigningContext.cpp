@@ -0,0 +1,143 @@
+#include <Tanker/Crypto/SigningContext.hpp>
+
+#include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/Crypto/Init.hpp>
+#include <Tanker/Errors/AssertionError.hpp>
+
+#include <sodium/crypto_core_ed25519.h>
+#include <sodium/crypto_hash_sha512.h>
+#include <sodium/crypto_scalarmult_ed25519.h>
+#include <sodium/crypto_sign_ed25519.h>
+#include <sodium/utils.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace Tanker
+{
+namespace Crypto
+{
+namespace
+{
+using HashState = crypto_hash_sha512_state;
+using WideScalar =
+    std::array<std::uint8_t, crypto_core_ed25519_NONREDUCEDSCALARBYTES>;
+
+void reduce(std::uint8_t* scalar, WideScalar const& wideScalar)
+{
+  crypto_core_ed25519_scalar_reduce(scalar, wideScalar.data());
+}
+}
+
+struct SigningContext::ExpandedKey
+{
+  // secret scalar, clamped and reduced mod L
+  std::uint8_t scalar[crypto_core_ed25519_SCALARBYTES];
+  std::uint8_t prefix[crypto_core_ed25519_SCALARBYTES];
+};
+
+SigningContext::SigningContext(PrivateSignatureKey const& privateKey)
+  : _publicKey(derivePublicKey(privateKey)), _expandedKey(nullptr)
+{
+  // sodium_malloc relies on values computed by sodium_init
+  init();
+  _expandedKey = static_cast<ExpandedKey*>(sodium_malloc(sizeof(ExpandedKey)));
+  if (!_expandedKey)
+    throw std::bad_alloc();
+
+  // this is the expansion done by crypto_sign_detached, see RFC 8032 5.1.5
+  WideScalar az;
+  crypto_hash_sha512(
+      az.data(), privateKey.data(), crypto_sign_ed25519_SEEDBYTES);
+  az[0] &= 248;
+  az[31] &= 127;
+  az[31] |= 64;
+  std::copy(az.begin() + crypto_core_ed25519_SCALARBYTES,
+            az.end(),
+            _expandedKey->prefix);
+  std::fill(az.begin() + crypto_core_ed25519_SCALARBYTES, az.end(), 0);
+  reduce(_expandedKey->scalar, az);
+  sodium_memzero(az.data(), az.size());
+
+  sodium_mprotect_readonly(_expandedKey);
+}
+
+SigningContext::~SigningContext()
+{
+  // sodium_free wipes the memory before releasing it
+  if (_expandedKey)
+    sodium_free(_expandedKey);
+}
+
+SigningContext::SigningContext(SigningContext&& other) noexcept
+  : _publicKey(other._publicKey),
+    _expandedKey(std::exchange(other._expandedKey, nullptr))
+{
+}
+
+SigningContext& SigningContext::operator=(SigningContext&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (_expandedKey)
+      sodium_free(_expandedKey);
+    _publicKey = other._publicKey;
+    _expandedKey = std::exchange(other._expandedKey, nullptr);
+  }
+  return *this;
+}
+
+PublicSignatureKey const& SigningContext::publicKey() const
+{
+  return _publicKey;
+}
+
+Signature SigningContext::sign(gsl::span<std::uint8_t const> data) const
+{
+  assert(_expandedKey);
+
+  HashState state;
+  WideScalar hash;
+  std::array<std::uint8_t, crypto_core_ed25519_SCALARBYTES> nonce;
+  Signature signature;
+  auto const R = signature.data();
+  auto const S = signature.data() + crypto_core_ed25519_BYTES;
+
+  // r = H(prefix || M) mod L
+  crypto_hash_sha512_init(&state);
+  crypto_hash_sha512_update(
+      &state, _expandedKey->prefix, sizeof(_expandedKey->prefix));
+  crypto_hash_sha512_update(&state, data.data(), data.size());
+  crypto_hash_sha512_final(&state, hash.data());
+  reduce(nonce.data(), hash);
+
+  // R = rB, only fails for r = 0, which a hash output reduces to with a
+  // negligible probability
+  if (crypto_scalarmult_ed25519_base_noclamp(R, nonce.data()) != 0)
+  {
+    sodium_memzero(nonce.data(), nonce.size());
+    sodium_memzero(hash.data(), hash.size());
+    sodium_memzero(&state, sizeof(state));
+    throw Errors::AssertionError("cannot compute the signature nonce point");
+  }
+
+  // S = H(R || A || M) * a + r mod L
+  crypto_hash_sha512_init(&state);
+  crypto_hash_sha512_update(&state, R, crypto_core_ed25519_BYTES);
+  crypto_hash_sha512_update(&state, _publicKey.data(), _publicKey.size());
+  crypto_hash_sha512_update(&state, data.data(), data.size());
+  crypto_hash_sha512_final(&state, hash.data());
+  reduce(S, hash);
+  crypto_core_ed25519_scalar_mul(S, S, _expandedKey->scalar);
+  crypto_core_ed25519_scalar_add(S, S, nonce.data());
+
+  sodium_memzero(nonce.data(), nonce.size());
+  sodium_memzero(hash.data(), hash.size());
+  sodium_memzero(&state, sizeof(state));
+  return signature;
+}
+}
+}
@@ -0,0 +1,92 @@
+#include <Tanker/Crypto/Crypto.hpp>
+
+#include <Helpers/Buffers.hpp>
+
+#include <doctest.h>
+#include <gsl-lite.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace Tanker;
+using namespace Tanker::Crypto;
+
+namespace
+{
+std::atomic<std::size_t> allocationCount{0};
+}
+
+// Counts every allocation made by this test executable. The array and nothrow
+// forms end up calling this one.
+void* operator new(std::size_t size)
+{
+  ++allocationCount;
+  if (auto const p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+TEST_CASE("span overloads do not allocate")
+{
+  auto const key = makeSymmetricKey();
+  auto const seed = getRandom<AeadIv>();
+  auto const keyPair = makeEncryptionKeyPair();
+  // same layout as a stream chunk
+  std::vector<std::uint8_t> clear(1024 * 1024 - 40);
+  randomFill(clear);
+  std::vector<std::uint8_t> encrypted(encryptedSize(clear.size()));
+  std::vector<std::uint8_t> decrypted(clear.size());
+  std::vector<std::uint8_t> aead(AeadIv::arraySize + encrypted.size());
+  std::vector<std::uint8_t> sealed(SymmetricKey::arraySize +
+                                   crypto_box_SEALBYTES);
+  SymmetricKey unsealed;
+  std::vector<std::uint8_t> hash(16);
+
+  auto const processChunk = [&](std::uint64_t index) {
+    auto const iv = deriveIv(seed, index);
+    encryptAead(key, iv, encrypted, clear, {});
+    decryptAead(key, deriveIv(seed, index), decrypted, encrypted, {});
+    encryptAead(key, aead, clear, {});
+    decryptAead(key, decrypted, aead, {});
+    sealEncrypt(key, sealed, keyPair.publicKey);
+    sealDecrypt(sealed, unsealed, keyPair);
+    generichash16(clear, hash);
+  };
+
+  // warm up, libsodium picks its implementations on first use
+  processChunk(0);
+
+  auto const before = allocationCount.load();
+  for (std::uint64_t index = 1; index < 16; ++index)
+    processChunk(index);
+  auto const allocations = allocationCount.load() - before;
+
+  CHECK(allocations == 0);
+  CHECK(decrypted == clear);
+  CHECK(unsealed == key);
+}
+
+TEST_CASE("allocation counter sees the allocating overloads")
+{
+  auto const key = makeSymmetricKey();
+  auto const clear = make_buffer("clear data");
+
+  auto const before = allocationCount.load();
+  auto const encrypted = encryptAead(key, clear);
+  CHECK(allocationCount.load() > before);
+  CHECK(decryptAead(key, encrypted) == clear);
+}
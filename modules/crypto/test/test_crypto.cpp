@@ -3,6 +3,7 @@
 #include <Tanker/Crypto/Format/Format.hpp>
 #include <Tanker/Crypto/Hash.hpp>
 #include <Tanker/Crypto/Json/Json.hpp>
+#include <Tanker/Crypto/SigningContext.hpp>
 
 #include <Helpers/Buffers.hpp>
 #include <Helpers/Errors.hpp>
@@ -13,8 +14,10 @@
 #include <gsl-lite.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace Tanker;
@@ -145,6 +148,56 @@ TEST_CASE("aead")
     CHECK(ivOne != ivTwo);
     CHECK(ivOne != iv);
   }
+
+  SUBCASE("it should derive an IV from the hash of the seed and the index")
+  {
+    auto const seed = make<AeadIv>("iv seed");
+    std::uint64_t const index = 42;
+    std::vector<uint8_t> toHash(seed.begin(), seed.end());
+    auto const indexBytes = reinterpret_cast<uint8_t const*>(&index);
+    toHash.insert(toHash.end(), indexBytes, indexBytes + sizeof(index));
+
+    AeadIv iv;
+    deriveIv(seed, index, iv);
+    CHECK(iv == generichash<AeadIv>(toHash));
+    CHECK(deriveIv(seed, index) == iv);
+  }
+
+  SUBCASE("it should encrypt/decrypt a buffer in caller-provided spans")
+  {
+    std::vector<uint8_t> aeadData(AeadIv::arraySize +
+                                  encryptedSize(buf.size()));
+    encryptAead(key, aeadData, buf, {});
+    CHECK(gsl::make_span(decryptAead(key, aeadData, {})) == buf);
+
+    std::vector<uint8_t> decryptedBuffer(buf.size());
+    decryptAead(key, decryptedBuffer, aeadData, {});
+    CHECK(gsl::make_span(decryptedBuffer) == buf);
+
+    auto const iv = makeAeadBuffer<uint8_t const>(aeadData).iv;
+    std::vector<uint8_t> encryptedBuffer(encryptedSize(buf.size()));
+    encryptAead(key, AeadIv{iv}, encryptedBuffer, buf, {});
+    CHECK(std::equal(encryptedBuffer.begin(),
+                     encryptedBuffer.end(),
+                     aeadData.begin() + AeadIv::arraySize));
+
+    std::fill(decryptedBuffer.begin(), decryptedBuffer.end(), 0);
+    decryptAead(key, AeadIv{iv}, decryptedBuffer, encryptedBuffer, {});
+    CHECK(gsl::make_span(decryptedBuffer) == buf);
+  }
+
+  SUBCASE("it should throw when the output span has the wrong size")
+  {
+    std::vector<uint8_t> tooSmall(encryptedSize(buf.size()) - 1);
+    TANKER_CHECK_THROWS_WITH_CODE(
+        encryptAead(key, AeadIv{}, tooSmall, buf, {}),
+        Errc::InvalidBufferSize);
+    TANKER_CHECK_THROWS_WITH_CODE(encryptAead(key, tooSmall, buf, {}),
+                                  Errc::InvalidBufferSize);
+    std::vector<uint8_t> iv(AeadIv::arraySize + 1);
+    TANKER_CHECK_THROWS_WITH_CODE(deriveIv(AeadIv{}, 0, iv),
+                                  Errc::InvalidBufferSize);
+  }
 }
 
 TEST_CASE("asymmetric")
@@ -226,6 +279,37 @@ TEST_CASE("asymmetric")
   }
 }
 
+TEST_CASE("SigningContext")
+{
+  auto const keyPair = makeSignatureKeyPair();
+  SigningContext const context(keyPair.privateKey);
+
+  SUBCASE("it should derive the public key")
+  {
+    CHECK(context.publicKey() == keyPair.publicKey);
+  }
+
+  SUBCASE("it should produce the same signatures as sign")
+  {
+    for (auto const& message :
+         {""s, "a"s, "short message"s, std::string(1000, 'x')})
+    {
+      auto const data = Tanker::make_buffer(message);
+      auto const signature = context.sign(data);
+      CHECK(signature == sign(data, keyPair.privateKey));
+      CHECK(verify(data, signature, keyPair.publicKey));
+    }
+  }
+
+  SUBCASE("it should still sign after being moved")
+  {
+    auto const data = Tanker::make_buffer("signed by ..."s);
+    SigningContext original(keyPair.privateKey);
+    SigningContext const moved(std::move(original));
+    CHECK(moved.sign(data) == sign(data, keyPair.privateKey));
+  }
+}
+
 TEST_CASE("asymmetric seal")
 {
   auto const buf = gsl::make_span("Test buffer").as_span<uint8_t const>();
@@ -248,6 +332,22 @@ TEST_CASE("asymmetric seal")
     CHECK(gsl::make_span(dec) == buf);
   }
 
+  SUBCASE("it should encrypt/decrypt a buffer in caller-provided spans")
+  {
+    std::vector<uint8_t> enc(buf.size() + crypto_box_SEALBYTES);
+    sealEncrypt(buf, enc, bobKeyPair.publicKey);
+    std::vector<uint8_t> dec(buf.size());
+    sealDecrypt(enc, dec, bobKeyPair);
+
+    CHECK(gsl::make_span(dec) == buf);
+
+    dec.push_back(0);
+    TANKER_CHECK_THROWS_WITH_CODE(sealDecrypt(enc, dec, bobKeyPair),
+                                  Errc::InvalidBufferSize);
+    TANKER_CHECK_THROWS_WITH_CODE(sealEncrypt(buf, dec, bobKeyPair.publicKey),
+                                  Errc::InvalidBufferSize);
+  }
+
   SUBCASE("it should fail to decrypt a corrupted buffer")
   {
     auto enc = sealEncrypt(buf, bobKeyPair.publicKey);
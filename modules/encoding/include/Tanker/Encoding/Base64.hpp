@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Tanker/Encoding/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+#include <Tanker/Format/Format.hpp>
+
+#include <gsl-lite.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace Tanker
+{
+namespace Encoding
+{
+namespace detail
+{
+template <typename T, typename = void>
+struct has_static_size : std::false_type
+{
+};
+
+// cryptographic types and ids specialize std::tuple_size
+template <typename T>
+struct has_static_size<T, std::void_t<decltype(std::tuple_size<T>::value)>>
+  : std::true_type
+{
+};
+}
+
+// RFC 4648 base64, padded. SSE4.1 and AVX2 kernels are selected at runtime
+// when the CPU supports them, with a scalar fallback.
+
+std::size_t base64EncodedSize(std::size_t decodedSize);
+// Exact decoded size, taking padding into account.
+// Throws if the input length is not a multiple of 4.
+std::size_t base64DecodedSize(std::string_view encoded);
+
+// encoded.size() must be base64EncodedSize(decoded.size())
+void base64Encode(gsl::span<std::uint8_t const> decoded,
+                  gsl::span<char> encoded);
+// decoded.size() must be at least base64DecodedSize(encoded)
+// Returns the number of bytes written.
+std::size_t base64Decode(std::string_view encoded,
+                         gsl::span<std::uint8_t> decoded);
+
+std::string base64Encode(gsl::span<std::uint8_t const> decoded);
+std::string base64Encode(std::string_view decoded);
+
+template <typename T = std::vector<std::uint8_t>>
+T base64Decode(std::string_view encoded)
+{
+  auto const size = base64DecodedSize(encoded);
+  T ret;
+  if constexpr (detail::has_static_size<T>::value)
+  {
+    if (size != ret.size())
+    {
+      throw Errors::formatEx(Errc::InvalidBufferSize,
+                             TFMT("invalid size for decoded base64 buffer: "
+                                  "got {:d}, expected {:d}"),
+                             size,
+                             ret.size());
+    }
+  }
+  else
+  {
+    ret.resize(size);
+  }
+  base64Decode(encoded,
+               gsl::make_span(reinterpret_cast<std::uint8_t*>(ret.data()),
+                              ret.size()));
+  return ret;
+}
+}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <system_error>
+#include <type_traits>
+
+namespace Tanker
+{
+namespace Encoding
+{
+enum class Errc
+{
+  InvalidBase64 = 1,
+  InvalidBufferSize,
+};
+
+std::error_code make_error_code(Errc) noexcept;
+}
+}
+
+namespace std
+{
+template <>
+struct is_error_code_enum<::Tanker::Encoding::Errc> : std::true_type
+{
+};
+}
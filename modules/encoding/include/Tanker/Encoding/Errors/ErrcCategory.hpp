@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+#include <system_error>
+
+namespace Tanker
+{
+namespace Encoding
+{
+namespace detail
+{
+class ErrcCategory : public std::error_category
+{
+public:
+  char const* name() const noexcept override final
+  {
+    return "Encoding";
+  }
+
+  std::string message(int c) const override final;
+  std::error_condition default_error_condition(int c) const
+      noexcept override final;
+};
+}
+
+extern inline detail::ErrcCategory const& ErrcCategory()
+{
+  static detail::ErrcCategory c;
+  return c;
+}
+}
+}
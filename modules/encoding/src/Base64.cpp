@@ -0,0 +1,236 @@
+#include <Tanker/Encoding/Base64.hpp>
+
+#include <Tanker/Encoding/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+
+#include "Base64Simd.hpp"
+
+#include <array>
+
+namespace Tanker
+{
+namespace Encoding
+{
+namespace
+{
+constexpr char alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr std::uint8_t invalid = 0xff;
+
+constexpr std::array<std::uint8_t, 256> makeDecodeTable()
+{
+  std::array<std::uint8_t, 256> table{};
+  for (auto& value : table)
+    value = invalid;
+  for (auto i = 0u; i < 64; ++i)
+    table[static_cast<unsigned char>(alphabet[i])] = i;
+  return table;
+}
+
+constexpr auto decodeTable = makeDecodeTable();
+
+std::size_t encodeScalar(std::uint8_t const* in, std::size_t inSize, char* out)
+{
+  std::size_t consumed = 0;
+  for (; inSize - consumed >= 3; consumed += 3)
+  {
+    auto const n = (in[consumed] << 16) | (in[consumed + 1] << 8) |
+                   in[consumed + 2];
+    *out++ = alphabet[(n >> 18) & 0x3f];
+    *out++ = alphabet[(n >> 12) & 0x3f];
+    *out++ = alphabet[(n >> 6) & 0x3f];
+    *out++ = alphabet[n & 0x3f];
+  }
+  return consumed;
+}
+
+std::size_t decodeScalar(char const* in, std::size_t inSize, std::uint8_t* out)
+{
+  std::size_t consumed = 0;
+  for (; consumed < inSize; consumed += 4)
+  {
+    auto const a = decodeTable[static_cast<unsigned char>(in[consumed])];
+    auto const b = decodeTable[static_cast<unsigned char>(in[consumed + 1])];
+    auto const c = decodeTable[static_cast<unsigned char>(in[consumed + 2])];
+    auto const d = decodeTable[static_cast<unsigned char>(in[consumed + 3])];
+    // invalid chars are the only ones with the high bits set
+    if ((a | b | c | d) & 0xc0)
+      break;
+    auto const n = (a << 18) | (b << 12) | (c << 6) | d;
+    *out++ = static_cast<std::uint8_t>(n >> 16);
+    *out++ = static_cast<std::uint8_t>(n >> 8);
+    *out++ = static_cast<std::uint8_t>(n);
+  }
+  return consumed;
+}
+
+struct Kernels
+{
+  detail::EncodeKernel encode;
+  detail::DecodeKernel decode;
+};
+
+std::size_t noopEncode(std::uint8_t const*, std::size_t, char*)
+{
+  return 0;
+}
+
+std::size_t noopDecode(char const*, std::size_t, std::uint8_t*)
+{
+  return 0;
+}
+
+Kernels selectKernels()
+{
+#if TANKER_ENCODING_HAS_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return {detail::base64EncodeAvx2, detail::base64DecodeAvx2};
+  if (__builtin_cpu_supports("sse4.1"))
+    return {detail::base64EncodeSse41, detail::base64DecodeSse41};
+#endif
+  return {noopEncode, noopDecode};
+}
+
+Kernels const& kernels()
+{
+  static auto const k = selectKernels();
+  return k;
+}
+
+[[noreturn]] void throwInvalidChar(std::size_t pos)
+{
+  throw Errors::formatEx(Errc::InvalidBase64,
+                         TFMT("invalid character at position {:d}"),
+                         pos);
+}
+}
+
+std::size_t base64EncodedSize(std::size_t decodedSize)
+{
+  return (decodedSize + 2) / 3 * 4;
+}
+
+std::size_t base64DecodedSize(std::string_view encoded)
+{
+  if (encoded.size() % 4 != 0)
+  {
+    throw Errors::formatEx(Errc::InvalidBase64,
+                           TFMT("invalid base64 length: {:d}"),
+                           encoded.size());
+  }
+  if (encoded.empty())
+    return 0;
+  auto const padding = (encoded.back() == '=') +
+                       (encoded.size() >= 2 && encoded.back() == '=' &&
+                        encoded[encoded.size() - 2] == '=');
+  return encoded.size() / 4 * 3 - padding;
+}
+
+void base64Encode(gsl::span<std::uint8_t const> decoded,
+                  gsl::span<char> encoded)
+{
+  if (encoded.size() != base64EncodedSize(decoded.size()))
+  {
+    throw Errors::formatEx(Errc::InvalidBufferSize,
+                           TFMT("invalid size for base64 output buffer: got "
+                                "{:d}, expected {:d}"),
+                           encoded.size(),
+                           base64EncodedSize(decoded.size()));
+  }
+
+  auto in = decoded.data();
+  auto out = encoded.data();
+  auto const inSize = static_cast<std::size_t>(decoded.size());
+
+  auto consumed = kernels().encode(in, inSize, out);
+  consumed +=
+      encodeScalar(in + consumed, inSize - consumed, out + consumed / 3 * 4);
+
+  out += consumed / 3 * 4;
+  switch (inSize - consumed)
+  {
+  case 1:
+    *out++ = alphabet[in[consumed] >> 2];
+    *out++ = alphabet[(in[consumed] & 0x03) << 4];
+    *out++ = '=';
+    *out++ = '=';
+    break;
+  case 2:
+    *out++ = alphabet[in[consumed] >> 2];
+    *out++ = alphabet[((in[consumed] & 0x03) << 4) | (in[consumed + 1] >> 4)];
+    *out++ = alphabet[(in[consumed + 1] & 0x0f) << 2];
+    *out++ = '=';
+    break;
+  }
+}
+
+std::size_t base64Decode(std::string_view encoded,
+                         gsl::span<std::uint8_t> decoded)
+{
+  auto const decodedSize = base64DecodedSize(encoded);
+  if (static_cast<std::size_t>(decoded.size()) < decodedSize)
+  {
+    throw Errors::formatEx(Errc::InvalidBufferSize,
+                           TFMT("base64 output buffer is too small: got {:d}, "
+                                "expected at least {:d}"),
+                           decoded.size(),
+                           decodedSize);
+  }
+  if (encoded.empty())
+    return 0;
+
+  auto const in = encoded.data();
+  auto const out = decoded.data();
+  // the last quad may hold padding, it is always handled separately
+  auto const bodySize = encoded.size() - 4;
+
+  auto consumed = kernels().decode(in, bodySize, out);
+  consumed +=
+      decodeScalar(in + consumed, bodySize - consumed, out + consumed / 4 * 3);
+  if (consumed != bodySize)
+  {
+    auto pos = consumed;
+    while (decodeTable[static_cast<unsigned char>(in[pos])] != invalid)
+      ++pos;
+    throwInvalidChar(pos);
+  }
+
+  auto const last = in + bodySize;
+  auto written = bodySize / 4 * 3;
+  auto const tailSize = decodedSize - written;
+  std::uint32_t n = 0;
+  for (auto i = 0u; i < 4; ++i)
+  {
+    auto const value = decodeTable[static_cast<unsigned char>(last[i])];
+    if (value == invalid)
+    {
+      // padding is only allowed in trailing positions
+      if (last[i] != '=' || i <= tailSize)
+        throwInvalidChar(bodySize + i);
+      continue;
+    }
+    n |= value << (18 - 6 * i);
+  }
+  out[written++] = static_cast<std::uint8_t>(n >> 16);
+  if (tailSize > 1)
+    out[written++] = static_cast<std::uint8_t>(n >> 8);
+  if (tailSize > 2)
+    out[written++] = static_cast<std::uint8_t>(n);
+  return written;
+}
+
+std::string base64Encode(gsl::span<std::uint8_t const> decoded)
+{
+  std::string ret(base64EncodedSize(decoded.size()), '\0');
+  base64Encode(decoded, gsl::make_span(ret.data(), ret.size()));
+  return ret;
+}
+
+std::string base64Encode(std::string_view decoded)
+{
+  return base64Encode(gsl::make_span(
+      reinterpret_cast<std::uint8_t const*>(decoded.data()), decoded.size()));
+}
+}
+}
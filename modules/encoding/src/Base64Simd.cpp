@@ -0,0 +1,237 @@
+#include "Base64Simd.hpp"
+
+#if TANKER_ENCODING_HAS_X86_SIMD
+
+#include <immintrin.h>
+
+// Vectorized base64 codec, after Wojciech Muła and Daniel Lemire's
+// "Faster Base64 Encoding and Decoding Using AVX2 Instructions".
+//
+// Functions are compiled for their target ISA with function attributes so that
+// the rest of the library keeps the default flags. Callers must check CPU
+// support before calling them.
+
+#define TANKER_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TANKER_TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace Tanker
+{
+namespace Encoding
+{
+namespace detail
+{
+namespace
+{
+// Lookup tables, duplicated over both 128-bit lanes for AVX2 loads.
+alignas(32) std::int8_t const encodeShuffle[32] = {
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+    1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10};
+alignas(32) std::int8_t const encodeOffsets[32] = {
+    65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+    65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0};
+alignas(32) std::int8_t const decodeLutLo[32] = {
+    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+    0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+    0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a};
+alignas(32) std::int8_t const decodeLutHi[32] = {
+    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10};
+alignas(32) std::int8_t const decodeLutRoll[32] = {
+    0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0};
+alignas(32) std::int8_t const decodeShuffle[32] = {
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1};
+
+TANKER_TARGET_SSE41 __m128i load128(std::int8_t const* table)
+{
+  return _mm_load_si128(reinterpret_cast<__m128i const*>(table));
+}
+
+TANKER_TARGET_AVX2 __m256i load256(std::int8_t const* table)
+{
+  return _mm256_load_si256(reinterpret_cast<__m256i const*>(table));
+}
+
+// Spreads 12 input bytes to 16 lanes holding one 6-bit index each.
+TANKER_TARGET_SSE41 __m128i encodeReshuffle(__m128i in)
+{
+  in = _mm_shuffle_epi8(in, load128(encodeShuffle));
+  auto const t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  auto const t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  auto const t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  auto const t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
+
+// Maps 6-bit indices to ASCII by adding a per-range offset.
+TANKER_TARGET_SSE41 __m128i encodeTranslate(__m128i in)
+{
+  auto indices = _mm_subs_epu8(in, _mm_set1_epi8(51));
+  auto const mask = _mm_cmpgt_epi8(in, _mm_set1_epi8(25));
+  indices = _mm_sub_epi8(indices, mask);
+  return _mm_add_epi8(in, _mm_shuffle_epi8(load128(encodeOffsets), indices));
+}
+
+// Returns false if any char is outside of the alphabet, otherwise converts
+// chars to their 6-bit value.
+TANKER_TARGET_SSE41 bool decodeTranslate(__m128i& block)
+{
+  auto const mask2f = _mm_set1_epi8(0x2f);
+  auto const hiNibbles = _mm_and_si128(_mm_srli_epi32(block, 4), mask2f);
+  auto const loNibbles = _mm_and_si128(block, mask2f);
+  auto const hi = _mm_shuffle_epi8(load128(decodeLutHi), hiNibbles);
+  auto const lo = _mm_shuffle_epi8(load128(decodeLutLo), loNibbles);
+  if (!_mm_testz_si128(lo, hi))
+    return false;
+  auto const eq2f = _mm_cmpeq_epi8(block, mask2f);
+  auto const roll =
+      _mm_shuffle_epi8(load128(decodeLutRoll), _mm_add_epi8(eq2f, hiNibbles));
+  block = _mm_add_epi8(block, roll);
+  return true;
+}
+
+// Packs 16 6-bit values into 12 bytes, left in the low part of the register.
+TANKER_TARGET_SSE41 __m128i decodeReshuffle(__m128i in)
+{
+  auto const mergedPairs = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+  auto const out = _mm_madd_epi16(mergedPairs, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(out, load128(decodeShuffle));
+}
+
+TANKER_TARGET_AVX2 __m256i encodeReshuffle(__m256i in)
+{
+  in = _mm256_shuffle_epi8(in, load256(encodeShuffle));
+  auto const t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+  auto const t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+  auto const t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+  auto const t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+  return _mm256_or_si256(t1, t3);
+}
+
+TANKER_TARGET_AVX2 __m256i encodeTranslate(__m256i in)
+{
+  auto indices = _mm256_subs_epu8(in, _mm256_set1_epi8(51));
+  auto const mask = _mm256_cmpgt_epi8(in, _mm256_set1_epi8(25));
+  indices = _mm256_sub_epi8(indices, mask);
+  return _mm256_add_epi8(in,
+                         _mm256_shuffle_epi8(load256(encodeOffsets), indices));
+}
+
+TANKER_TARGET_AVX2 bool decodeTranslate(__m256i& block)
+{
+  auto const mask2f = _mm256_set1_epi8(0x2f);
+  auto const hiNibbles = _mm256_and_si256(_mm256_srli_epi32(block, 4), mask2f);
+  auto const loNibbles = _mm256_and_si256(block, mask2f);
+  auto const hi = _mm256_shuffle_epi8(load256(decodeLutHi), hiNibbles);
+  auto const lo = _mm256_shuffle_epi8(load256(decodeLutLo), loNibbles);
+  if (!_mm256_testz_si256(lo, hi))
+    return false;
+  auto const eq2f = _mm256_cmpeq_epi8(block, mask2f);
+  auto const roll = _mm256_shuffle_epi8(load256(decodeLutRoll),
+                                        _mm256_add_epi8(eq2f, hiNibbles));
+  block = _mm256_add_epi8(block, roll);
+  return true;
+}
+
+// Packs 32 6-bit values into 24 contiguous bytes.
+TANKER_TARGET_AVX2 __m256i decodeReshuffle(__m256i in)
+{
+  auto const mergedPairs =
+      _mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140));
+  auto out = _mm256_madd_epi16(mergedPairs, _mm256_set1_epi32(0x00011000));
+  out = _mm256_shuffle_epi8(out, load256(decodeShuffle));
+  return _mm256_permutevar8x32_epi32(out,
+                                     _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+}
+}
+
+TANKER_TARGET_SSE41 std::size_t base64EncodeSse41(std::uint8_t const* in,
+                                                  std::size_t inSize,
+                                                  char* out)
+{
+  std::size_t consumed = 0;
+  // each round reads 16 bytes but only encodes 12 of them
+  while (inSize - consumed >= 16)
+  {
+    auto const block =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + consumed));
+    auto const encoded = encodeTranslate(encodeReshuffle(block));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), encoded);
+    consumed += 12;
+    out += 16;
+  }
+  return consumed;
+}
+
+TANKER_TARGET_SSE41 std::size_t base64DecodeSse41(char const* in,
+                                                  std::size_t inSize,
+                                                  std::uint8_t* out)
+{
+  std::size_t consumed = 0;
+  // each round writes 16 bytes, only 12 of them are meaningful. Keeping 24
+  // chars of input in reserve guarantees the output has room for the extra 4
+  // bytes whatever the padding.
+  while (inSize - consumed >= 24)
+  {
+    auto block =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + consumed));
+    if (!decodeTranslate(block))
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), decodeReshuffle(block));
+    consumed += 16;
+    out += 12;
+  }
+  return consumed;
+}
+
+TANKER_TARGET_AVX2 std::size_t base64EncodeAvx2(std::uint8_t const* in,
+                                                std::size_t inSize,
+                                                char* out)
+{
+  std::size_t consumed = 0;
+  // each round reads 28 bytes (two overlapping 16 bytes loads) and encodes 24
+  while (inSize - consumed >= 32)
+  {
+    auto const lo =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + consumed));
+    auto const hi =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + consumed + 12));
+    auto const block =
+        _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    auto const encoded = encodeTranslate(encodeReshuffle(block));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), encoded);
+    consumed += 24;
+    out += 32;
+  }
+  return consumed + base64EncodeSse41(in + consumed, inSize - consumed, out);
+}
+
+TANKER_TARGET_AVX2 std::size_t base64DecodeAvx2(char const* in,
+                                                std::size_t inSize,
+                                                std::uint8_t* out)
+{
+  std::size_t consumed = 0;
+  // each round writes 32 bytes, only 24 of them are meaningful, see
+  // base64DecodeSse41 for the input reserve
+  while (inSize - consumed >= 48)
+  {
+    auto block =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + consumed));
+    if (!decodeTranslate(block))
+      break;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                        decodeReshuffle(block));
+    consumed += 32;
+    out += 24;
+  }
+  return consumed + base64DecodeSse41(in + consumed, inSize - consumed, out);
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+#define TANKER_ENCODING_HAS_X86_SIMD 1
+#else
+#define TANKER_ENCODING_HAS_X86_SIMD 0
+#endif
+
+namespace Tanker
+{
+namespace Encoding
+{
+namespace detail
+{
+// Kernels process as many whole blocks as they safely can and return the
+// number of input bytes consumed. The caller finishes the job with the scalar
+// implementation, which also deals with padding and reports errors.
+//
+// Encoders consume multiples of 3 bytes and write consumed / 3 * 4 chars.
+// Decoders consume multiples of 4 chars and write consumed / 4 * 3 bytes, they
+// stop at the first block containing a non-alphabet char (padding included).
+using EncodeKernel = std::size_t (*)(std::uint8_t const* in,
+                                     std::size_t inSize,
+                                     char* out);
+using DecodeKernel = std::size_t (*)(char const* in,
+                                     std::size_t inSize,
+                                     std::uint8_t* out);
+
+#if TANKER_ENCODING_HAS_X86_SIMD
+std::size_t base64EncodeSse41(std::uint8_t const* in,
+                              std::size_t inSize,
+                              char* out);
+std::size_t base64DecodeSse41(char const* in,
+                              std::size_t inSize,
+                              std::uint8_t* out);
+std::size_t base64EncodeAvx2(std::uint8_t const* in,
+                             std::size_t inSize,
+                             char* out);
+std::size_t base64DecodeAvx2(char const* in,
+                             std::size_t inSize,
+                             std::uint8_t* out);
+#endif
+}
+}
+}
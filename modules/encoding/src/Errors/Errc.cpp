@@ -0,0 +1,14 @@
+#include <Tanker/Encoding/Errors/Errc.hpp>
+
+#include <Tanker/Encoding/Errors/ErrcCategory.hpp>
+
+namespace Tanker
+{
+namespace Encoding
+{
+std::error_code make_error_code(Errc c) noexcept
+{
+  return {static_cast<int>(c), ErrcCategory()};
+}
+}
+}
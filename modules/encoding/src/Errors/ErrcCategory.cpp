@@ -0,0 +1,38 @@
+#include <Tanker/Encoding/Errors/ErrcCategory.hpp>
+
+#include <Tanker/Encoding/Errors/Errc.hpp>
+#include <Tanker/Errors/Errc.hpp>
+
+namespace Tanker
+{
+namespace Encoding
+{
+namespace detail
+{
+std::string ErrcCategory::message(int c) const
+{
+  switch (static_cast<Errc>(c))
+  {
+  case Errc::InvalidBase64:
+    return "invalid base64";
+  case Errc::InvalidBufferSize:
+    return "invalid buffer size";
+  default:
+    return "unknown error";
+  }
+}
+
+std::error_condition ErrcCategory::default_error_condition(int c) const noexcept
+{
+  switch (static_cast<Errc>(c))
+  {
+  case Errc::InvalidBase64:
+  case Errc::InvalidBufferSize:
+    return make_error_condition(Errors::Errc::InvalidArgument);
+  default:
+    return std::error_condition(c, *this);
+  }
+}
+}
+}
+}
@@ -0,0 +1,121 @@
+#include <Tanker/Encoding/Base64.hpp>
+
+#include <Tanker/Encoding/Errors/Errc.hpp>
+
+#include <Helpers/Buffers.hpp>
+#include <Helpers/Errors.hpp>
+
+#include <cppcodec/base64_rfc4648.hpp>
+#include <doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace Tanker;
+using namespace Tanker::Encoding;
+
+namespace
+{
+// covers every tail size for the scalar path, and enough blocks to go
+// through both vectorized kernels
+std::vector<std::uint8_t> makeBuffer(std::size_t size)
+{
+  std::vector<std::uint8_t> buffer(size);
+  for (auto i = 0u; i < size; ++i)
+    buffer[i] = static_cast<std::uint8_t>(i * 37 + 11);
+  return buffer;
+}
+}
+
+TEST_CASE("base64 sizes are computed correctly")
+{
+  CHECK(base64EncodedSize(0) == 0);
+  CHECK(base64EncodedSize(1) == 4);
+  CHECK(base64EncodedSize(3) == 4);
+  CHECK(base64EncodedSize(4) == 8);
+
+  CHECK(base64DecodedSize("") == 0);
+  CHECK(base64DecodedSize("QQ==") == 1);
+  CHECK(base64DecodedSize("QUI=") == 2);
+  CHECK(base64DecodedSize("QUJD") == 3);
+  TANKER_CHECK_THROWS_WITH_CODE(base64DecodedSize("QUJ"),
+                                Errc::InvalidBase64);
+}
+
+TEST_CASE("base64 encodes RFC 4648 test vectors")
+{
+  CHECK(base64Encode(make_buffer("")) == "");
+  CHECK(base64Encode(make_buffer("f")) == "Zg==");
+  CHECK(base64Encode(make_buffer("fo")) == "Zm8=");
+  CHECK(base64Encode(make_buffer("foo")) == "Zm9v");
+  CHECK(base64Encode(make_buffer("foob")) == "Zm9vYg==");
+  CHECK(base64Encode(make_buffer("fooba")) == "Zm9vYmE=");
+  CHECK(base64Encode(make_buffer("foobar")) == "Zm9vYmFy");
+}
+
+TEST_CASE("base64 decodes RFC 4648 test vectors")
+{
+  CHECK(base64Decode<std::string>("") == "");
+  CHECK(base64Decode<std::string>("Zg==") == "f");
+  CHECK(base64Decode<std::string>("Zm8=") == "fo");
+  CHECK(base64Decode<std::string>("Zm9v") == "foo");
+  CHECK(base64Decode<std::string>("Zm9vYg==") == "foob");
+  CHECK(base64Decode<std::string>("Zm9vYmE=") == "fooba");
+  CHECK(base64Decode<std::string>("Zm9vYmFy") == "foobar");
+}
+
+TEST_CASE("base64 matches cppcodec on buffers of any size")
+{
+  for (auto size = 0u; size < 300; ++size)
+  {
+    auto const buffer = makeBuffer(size);
+    auto const expected = cppcodec::base64_rfc4648::encode(buffer);
+
+    auto const encoded = base64Encode(buffer);
+    REQUIRE(encoded == expected);
+    REQUIRE(base64Decode(encoded) == buffer);
+  }
+}
+
+TEST_CASE("base64 decodes into a caller-provided span")
+{
+  auto const buffer = makeBuffer(1000);
+  auto const encoded = base64Encode(buffer);
+
+  std::vector<std::uint8_t> decoded(2000);
+  auto const written = base64Decode(encoded, decoded);
+  CHECK(written == buffer.size());
+  decoded.resize(written);
+  CHECK(decoded == buffer);
+
+  std::vector<std::uint8_t> tooSmall(buffer.size() - 1);
+  TANKER_CHECK_THROWS_WITH_CODE(base64Decode(encoded, tooSmall),
+                                Errc::InvalidBufferSize);
+}
+
+TEST_CASE("base64 decodes into fixed size types")
+{
+  using Array = std::array<std::uint8_t, 4>;
+
+  CHECK(base64Decode<Array>("AQIDBA==") == Array{1, 2, 3, 4});
+  TANKER_CHECK_THROWS_WITH_CODE(base64Decode<Array>("AQID"),
+                                Errc::InvalidBufferSize);
+}
+
+TEST_CASE("base64 rejects invalid input")
+{
+  TANKER_CHECK_THROWS_WITH_CODE(base64Decode("A"), Errc::InvalidBase64);
+  TANKER_CHECK_THROWS_WITH_CODE(base64Decode("===="), Errc::InvalidBase64);
+  TANKER_CHECK_THROWS_WITH_CODE(base64Decode("A==="), Errc::InvalidBase64);
+  TANKER_CHECK_THROWS_WITH_CODE(base64Decode("QQ=A"), Errc::InvalidBase64);
+  TANKER_CHECK_THROWS_WITH_CODE(base64Decode("Q*=="), Errc::InvalidBase64);
+  TANKER_CHECK_THROWS_WITH_CODE(base64Decode("Zm9v\nZm9v"),
+                                Errc::InvalidBase64);
+
+  // an invalid char deep inside a buffer long enough for vectorized kernels
+  auto encoded = base64Encode(makeBuffer(300));
+  encoded[150] = '-';
+  TANKER_CHECK_THROWS_WITH_CODE(base64Decode(encoded), Errc::InvalidBase64);
+}
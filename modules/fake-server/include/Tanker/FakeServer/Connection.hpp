@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Tanker/FakeServer/Server.hpp>
+#include <Tanker/Network/AConnection.hpp>
+
+#include <tconcurrent/coroutine.hpp>
+#include <tconcurrent/task_auto_canceler.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Tanker::FakeServer
+{
+// A connection to an in-process Server. Emits wait for the latency and
+// bandwidth of the server options before they are served. Server events are
+// handled on the executor, like those of a socket.
+class Connection : public Network::AConnection
+{
+public:
+  Connection(Connection const&) = delete;
+  Connection(Connection&&) = delete;
+  Connection& operator=(Connection const&) = delete;
+  Connection& operator=(Connection&&) = delete;
+
+  Connection(Server* server, std::string id);
+  ~Connection();
+
+  bool isOpen() const override;
+  void connect() override;
+  void close() override;
+  std::string id() const override;
+
+  tc::cotask<std::string> emit(std::string const& eventName,
+                               std::string const& data) override;
+
+  bool canEmitBinary() const override;
+  tc::cotask<std::vector<std::uint8_t>> emitBinary(
+      std::string const& eventName,
+      std::vector<std::uint8_t> const& data) override;
+
+  void on(std::string const& message, Handler handler) override;
+
+private:
+  Server* _server;
+  std::string const _id;
+  bool _open = false;
+  ConnectionState _state;
+  std::map<std::string, Handler> _handlers;
+
+  void push(std::string const& eventName, std::string const& data);
+
+  // last, the handlers of pushed events use the other members
+  tc::task_auto_canceler _taskCanceler;
+};
+}
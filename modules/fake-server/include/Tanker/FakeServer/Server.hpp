@@ -0,0 +1,209 @@
+#pragma once
+
+#include <Tanker/Crypto/EncryptionKeyPair.hpp>
+#include <Tanker/Crypto/PublicEncryptionKey.hpp>
+#include <Tanker/Crypto/PublicSignatureKey.hpp>
+#include <Tanker/Crypto/SealedPrivateEncryptionKey.hpp>
+#include <Tanker/Crypto/SignatureKeyPair.hpp>
+#include <Tanker/Network/AConnection.hpp>
+#include <Tanker/Trustchain/DeviceId.hpp>
+#include <Tanker/Trustchain/GroupId.hpp>
+#include <Tanker/Trustchain/ResourceId.hpp>
+#include <Tanker/Trustchain/ServerEntry.hpp>
+#include <Tanker/Trustchain/TrustchainId.hpp>
+#include <Tanker/Trustchain/UserId.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Tanker::FakeServer
+{
+struct Options
+{
+  // added to every emit
+  std::chrono::milliseconds latency{0};
+  // request and reply bytes transferred per second, 0 is unlimited
+  std::uint64_t bytesPerSecond = 0;
+};
+
+// What the server knows about one connection
+struct ConnectionState
+{
+  std::string challenge;
+  std::optional<Trustchain::UserId> userId;
+  // blocks are exchanged as Trustchain::frameBlocks() frames
+  bool binaryBlocks = false;
+  // see Network::CompressingConnection
+  bool compression = false;
+  std::size_t compressionThreshold = 0;
+  // see Tanker::Subscriptions
+  std::set<Trustchain::UserId> watchedUsers;
+  std::set<Trustchain::GroupId> watchedGroups;
+  bool watchesClaims = false;
+  // Sends an event on the connection, it must not wait for the event to be
+  // handled
+  std::function<void(std::string const& eventName, std::string const& data)>
+      push;
+};
+
+// In-process stand-in for the Tanker server, for load tests and benchmarks
+// that must not depend on the network.
+//
+// It owns a trustchain and serves the socket.io events of Client and the
+// Requesters from memory: blocks are stored and indexed as they are pushed,
+// and the block requests get the same replies as from the real server.
+// Pushed blocks are not verified, the SDK verifies them when it pulls them.
+// Email verification codes are not checked either, any code is accepted.
+// The connections that subscribed get an event when a device is created or
+// revoked, when members are added to a group, or when a provisional identity
+// is claimed.
+//
+// The server must outlive its connections. It can be used from any thread.
+class Server
+{
+public:
+  explicit Server(Options options = {});
+  ~Server();
+
+  Server(Server const&) = delete;
+  Server(Server&&) = delete;
+  Server& operator=(Server const&) = delete;
+  Server& operator=(Server&&) = delete;
+
+  Trustchain::TrustchainId const& trustchainId() const;
+  Crypto::SignatureKeyPair const& trustchainKeyPair() const;
+  Options const& options() const;
+
+  Network::ConnectionPtr makeConnection();
+  // Makes Network::ConnectionFactory connect the SDK sessions to this server,
+  // until uninstall() is called or the server is destroyed. Installing
+  // another server or creator replaces this one.
+  void install();
+  void uninstall();
+
+  // Returns the reply of the real server to eventName, a json document. It
+  // also answers the batches of Network::BatchingConnection.
+  std::string handle(ConnectionState& state,
+                     std::string const& eventName,
+                     std::string const& data);
+  // Returns the reply to a binary emit, once the connection negotiated the
+  // binary blocks: a block frame, or a json document for errors and acks.
+  // It also answers the compressed emits of Network::CompressingConnection.
+  std::vector<std::uint8_t> handleBinary(ConnectionState& state,
+                                         std::string const& eventName,
+                                         std::vector<std::uint8_t> const& data);
+
+  // Forgets the subscriptions of a connection. It must be called before its
+  // state is destroyed.
+  void disconnect(ConnectionState& state);
+
+  std::size_t blockCount() const;
+
+private:
+  struct Device
+  {
+    Trustchain::UserId userId;
+    Crypto::PublicSignatureKey publicSignatureKey;
+    // the last user key sealed for this device
+    std::optional<Crypto::SealedPrivateEncryptionKey> sealedUserKey;
+  };
+
+  struct User
+  {
+    std::vector<std::size_t> blocks;
+    std::vector<std::size_t> claims;
+    // the last one is the current user key
+    std::vector<Crypto::PublicEncryptionKey> userKeys;
+    std::string encryptedVerificationKey;
+    // verification methods by type, with their request
+    std::map<std::string, nlohmann::json> verificationMethods;
+  };
+
+  struct Group
+  {
+    std::vector<std::size_t> blocks;
+    std::set<Trustchain::UserId> members;
+    std::set<Crypto::PublicEncryptionKey> memberUserKeys;
+    std::set<Crypto::PublicSignatureKey> provisionalMembers;
+  };
+
+  struct ProvisionalIdentity
+  {
+    Crypto::SignatureKeyPair signatureKeyPair;
+    Crypto::EncryptionKeyPair encryptionKeyPair;
+  };
+
+  std::vector<std::uint8_t> handleCompressed(
+      ConnectionState& state, std::vector<std::uint8_t> const& data);
+  std::string dispatch(ConnectionState& state,
+                       std::string const& eventName,
+                       std::string const& data);
+  std::size_t addBlock(std::vector<std::uint8_t> const& clientBlock);
+  void indexBlock(std::size_t index, Trustchain::ServerEntry const& entry);
+  // Sends the events about a new block to the connections that subscribed
+  void notify(Trustchain::ServerEntry const& entry) const;
+  std::string serveBlocks(std::vector<std::size_t> const& indexes) const;
+  std::vector<std::uint8_t> serveBinaryBlocks(
+      std::vector<std::size_t> const& indexes) const;
+  bool canRead(Trustchain::UserId const& userId,
+               Trustchain::ServerEntry const& keyPublish) const;
+  bool isGroupMember(Trustchain::UserId const& userId,
+                     Group const& group) const;
+  ProvisionalIdentity& provisionalIdentity(std::string const& hashedEmail);
+
+  nlohmann::json createUser(nlohmann::json const& request);
+  nlohmann::json userStatus(nlohmann::json const& request) const;
+  nlohmann::json authenticate(ConnectionState& state,
+                              nlohmann::json const& request) const;
+  nlohmann::json subscribe(ConnectionState& state,
+                           nlohmann::json const& request);
+  nlohmann::json lastUserKey(nlohmann::json const& request) const;
+  nlohmann::json verificationKey(nlohmann::json const& request) const;
+  nlohmann::json setVerificationMethod(nlohmann::json const& request);
+  nlohmann::json verificationMethods(nlohmann::json const& request) const;
+  nlohmann::json publicProvisionalIdentities(nlohmann::json const& request);
+  nlohmann::json provisionalIdentityKeys(ConnectionState const& state,
+                                         std::string const& eventName,
+                                         nlohmann::json const& request);
+  // sorted, without duplicates
+  std::vector<std::size_t> blockIndexes(ConnectionState const& state,
+                                        std::string const& eventName,
+                                        nlohmann::json const& request) const;
+
+  Options const _options;
+  Crypto::SignatureKeyPair const _trustchainKeyPair;
+  Trustchain::TrustchainId _trustchainId;
+  // the handle of the ConnectionFactory creator
+  std::optional<std::size_t> _installed;
+
+  mutable std::mutex _mutex;
+  // the block at index i is at i - 1, in base64 and raw
+  std::vector<std::string> _blocks;
+  std::vector<std::vector<std::uint8_t>> _rawBlocks;
+  std::vector<Trustchain::ServerEntry> _entries;
+  std::map<Trustchain::UserId, User> _users;
+  std::map<Trustchain::DeviceId, Device> _devices;
+  std::map<Crypto::PublicSignatureKey, Trustchain::DeviceId> _deviceKeys;
+  std::map<Crypto::PublicEncryptionKey, Trustchain::UserId> _userKeyOwners;
+  std::map<Trustchain::GroupId, Group> _groups;
+  std::map<Crypto::PublicEncryptionKey, Trustchain::GroupId> _groupKeys;
+  std::map<Trustchain::ResourceId, std::vector<std::size_t>> _keyPublishes;
+  // the provisional identities claimed by each user, by app signature key
+  std::map<Trustchain::UserId, std::set<Crypto::PublicSignatureKey>>
+      _claimedProvisionalKeys;
+  // by hashed email
+  std::map<std::string, ProvisionalIdentity> _provisionalIdentities;
+  // the connections that subscribed to something
+  std::set<ConnectionState*> _subscribers;
+};
+}
@@ -0,0 +1,133 @@
+#include <Tanker/FakeServer/Connection.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+
+#include <tconcurrent/async.hpp>
+#include <tconcurrent/async_wait.hpp>
+
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace Tanker::FakeServer
+{
+namespace
+{
+std::chrono::microseconds transferTime(Options const& options,
+                                       std::size_t bytes)
+{
+  if (options.bytesPerSecond == 0)
+    return std::chrono::microseconds{0};
+  return std::chrono::microseconds{bytes * 1'000'000 /
+                                   options.bytesPerSecond};
+}
+}
+
+Connection::Connection(Server* server, std::string id)
+  : _server(server), _id(std::move(id))
+{
+  _state.push = [this](std::string const& eventName, std::string const& data) {
+    push(eventName, data);
+  };
+}
+
+Connection::~Connection()
+{
+  _server->disconnect(_state);
+}
+
+bool Connection::isOpen() const
+{
+  return _open;
+}
+
+void Connection::connect()
+{
+  _open = true;
+  if (connected)
+    connected();
+}
+
+void Connection::close()
+{
+  _open = false;
+  _server->disconnect(_state);
+}
+
+std::string Connection::id() const
+{
+  return _id;
+}
+
+tc::cotask<std::string> Connection::emit(std::string const& eventName,
+                                         std::string const& data)
+{
+  if (!_open)
+  {
+    throw Errors::formatEx(Errors::Errc::NetworkError,
+                           "emit on a closed connection: {}",
+                           eventName);
+  }
+  auto const& options = _server->options();
+  auto const requestDelay =
+      options.latency / 2 + transferTime(options, data.size());
+  if (requestDelay.count())
+    TC_AWAIT(tc::async_wait(requestDelay));
+  auto reply = _server->handle(_state, eventName, data);
+  auto const replyDelay = options.latency - options.latency / 2 +
+                          transferTime(options, reply.size());
+  if (replyDelay.count())
+    TC_AWAIT(tc::async_wait(replyDelay));
+  TC_RETURN(std::move(reply));
+}
+
+bool Connection::canEmitBinary() const
+{
+  return true;
+}
+
+tc::cotask<std::vector<std::uint8_t>> Connection::emitBinary(
+    std::string const& eventName, std::vector<std::uint8_t> const& data)
+{
+  if (!_open)
+  {
+    throw Errors::formatEx(Errors::Errc::NetworkError,
+                           "emit on a closed connection: {}",
+                           eventName);
+  }
+  auto const& options = _server->options();
+  auto const requestDelay =
+      options.latency / 2 + transferTime(options, data.size());
+  if (requestDelay.count())
+    TC_AWAIT(tc::async_wait(requestDelay));
+  auto reply = _server->handleBinary(_state, eventName, data);
+  auto const replyDelay = options.latency - options.latency / 2 +
+                          transferTime(options, reply.size());
+  if (replyDelay.count())
+    TC_AWAIT(tc::async_wait(replyDelay));
+  TC_RETURN(std::move(reply));
+}
+
+void Connection::on(std::string const& message, Handler handler)
+{
+  _handlers[message] = std::move(handler);
+}
+
+void Connection::push(std::string const& eventName, std::string const& data)
+{
+  _taskCanceler.add(tc::async([this, eventName, data] {
+    auto const it = _handlers.find(eventName);
+    if (it == _handlers.end())
+      return;
+    // like a socket, the connection outlives the failures of its handlers
+    try
+    {
+      it->second(data);
+    }
+    catch (std::exception const&)
+    {
+    }
+  }));
+}
+}
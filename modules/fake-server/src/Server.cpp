@@ -0,0 +1,842 @@
+#include <Tanker/FakeServer/Server.hpp>
+
+#include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/Crypto/Json/Json.hpp>
+#include <Tanker/Encoding/Base64.hpp>
+#include <Tanker/FakeServer/Connection.hpp>
+#include <Tanker/Network/Compression.hpp>
+#include <Tanker/Network/ConnectionFactory.hpp>
+#include <Tanker/Serialization/Serialization.hpp>
+#include <Tanker/Serialization/Varint.hpp>
+#include <Tanker/Trustchain/Action.hpp>
+#include <Tanker/Trustchain/BlockFrame.hpp>
+#include <Tanker/Trustchain/ClientEntry.hpp>
+#include <Tanker/Trustchain/ComputeHash.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+using namespace Tanker::Trustchain;
+using namespace Tanker::Trustchain::Actions;
+
+namespace Tanker::FakeServer
+{
+namespace
+{
+// Becomes an error reply, code is one of the server error codes Client knows
+class ServerError : public std::runtime_error
+{
+public:
+  ServerError(std::string code, std::string const& message)
+    : std::runtime_error(message), code(std::move(code))
+  {
+  }
+
+  std::string code;
+};
+
+std::string errorReply(std::string const& code, std::string const& message)
+{
+  return nlohmann::json{{"error", {{"code", code}, {"message", message}}}}
+      .dump();
+}
+
+std::vector<std::uint8_t> makeRootBlock(
+    Crypto::PublicSignatureKey const& publicSignatureKey)
+{
+  TrustchainCreation const action{publicSignatureKey};
+  auto const payload = Serialization::serialize(action);
+  auto const hash = computeHash(action.nature(), Crypto::Hash{}, payload);
+  return Serialization::serialize(ClientEntry{TrustchainId{hash},
+                                              Crypto::Hash{},
+                                              action.nature(),
+                                              payload,
+                                              hash,
+                                              Crypto::Signature{}});
+}
+
+// Client blocks are server blocks with a zero index: the version and the
+// index both take one byte
+std::vector<std::uint8_t> withIndex(
+    std::vector<std::uint8_t> const& clientBlock, std::size_t index)
+{
+  std::vector<std::uint8_t> block(clientBlock.size() - 1 +
+                                  Serialization::varint_size(index));
+  block[0] = clientBlock[0];
+  auto const it = Serialization::varint_write(block.data() + 1, index);
+  std::copy(clientBlock.begin() + 2, clientBlock.end(), it);
+  return block;
+}
+
+std::vector<std::uint8_t> bytes(std::string const& json)
+{
+  return {json.begin(), json.end()};
+}
+
+bool isBlocksRequest(std::string const& eventName)
+{
+  return eventName == "get my user blocks" || eventName == "get users blocks" ||
+         eventName == "get key publishes" || eventName == "get groups blocks" ||
+         eventName == "get my claim blocks";
+}
+
+std::string verificationType(nlohmann::json const& verification)
+{
+  if (verification.contains("hashed_passphrase"))
+    return "passphrase";
+  if (verification.contains("hashed_email"))
+    return "email";
+  if (verification.contains("oidc_id_token"))
+    return "oidc_id_token";
+  return "verificationKey";
+}
+
+std::atomic<std::uint64_t> connectionCount{0};
+}
+
+Server::Server(Options options)
+  : _options(options), _trustchainKeyPair(Crypto::makeSignatureKeyPair())
+{
+  auto const index = addBlock(makeRootBlock(_trustchainKeyPair.publicKey));
+  _trustchainId = TrustchainId{_entries[index - 1].hash()};
+}
+
+Server::~Server()
+{
+  uninstall();
+}
+
+TrustchainId const& Server::trustchainId() const
+{
+  return _trustchainId;
+}
+
+Crypto::SignatureKeyPair const& Server::trustchainKeyPair() const
+{
+  return _trustchainKeyPair;
+}
+
+Options const& Server::options() const
+{
+  return _options;
+}
+
+Network::ConnectionPtr Server::makeConnection()
+{
+  return std::make_unique<Connection>(
+      this, fmt::format("fake-server-{}", ++connectionCount));
+}
+
+void Server::install()
+{
+  _installed = Network::ConnectionFactory::setCreator(
+      [this](std::string const&) { return makeConnection(); });
+}
+
+void Server::uninstall()
+{
+  if (!_installed)
+    return;
+  Network::ConnectionFactory::resetCreator(*_installed);
+  _installed.reset();
+}
+
+std::size_t Server::blockCount() const
+{
+  std::scoped_lock lock(_mutex);
+  return _blocks.size();
+}
+
+std::size_t Server::addBlock(std::vector<std::uint8_t> const& clientBlock)
+{
+  auto const index = _blocks.size() + 1;
+  auto block = withIndex(clientBlock, index);
+  auto entry = Serialization::deserialize<ServerEntry>(block);
+  if (!_entries.empty() && entry.trustchainId() != _trustchainId)
+    throw ServerError("invalid_body", "block of another trustchain");
+  if (!_entries.empty() &&
+      entry.action().holds_alternative<TrustchainCreation>())
+    throw ServerError("invalid_body", "the trustchain already has a root");
+  indexBlock(index, entry);
+  notify(entry);
+  _blocks.push_back(Encoding::base64Encode(block));
+  _rawBlocks.push_back(std::move(block));
+  _entries.push_back(std::move(entry));
+  return index;
+}
+
+void Server::notify(ServerEntry const& entry) const
+{
+  if (_subscribers.empty())
+    return;
+  auto const pushTo = [&](auto const& isWatched,
+                          std::string const& eventName,
+                          nlohmann::json const& data) {
+    auto const payload = data.dump();
+    for (auto const state : _subscribers)
+    {
+      if (state->push && isWatched(*state))
+        state->push(eventName, payload);
+    }
+  };
+  auto const watchesUser = [](UserId const& userId) {
+    return [userId](ConnectionState const& state) {
+      return state.watchedUsers.count(userId) > 0;
+    };
+  };
+
+  auto const& action = entry.action();
+  if (auto const dc = action.get_if<DeviceCreation>())
+  {
+    pushTo(watchesUser(dc->userId()),
+           "device created",
+           {{"user_id", dc->userId()}});
+  }
+  else if (auto const dr = action.get_if<DeviceRevocation>())
+  {
+    // the revocation is indexed, the device exists
+    auto const& userId = _devices.at(dr->deviceId()).userId;
+    pushTo(watchesUser(userId), "device revoked", {{"user_id", userId}});
+  }
+  else if (auto const uga = action.get_if<UserGroupAddition>())
+  {
+    auto const& groupId = uga->groupId();
+    pushTo(
+        [&](ConnectionState const& state) {
+          return state.watchedGroups.count(groupId) > 0;
+        },
+        "group members added",
+        {{"group_id", groupId}});
+  }
+  else if (auto const pic = action.get_if<ProvisionalIdentityClaim>())
+  {
+    auto const& userId = pic->userId();
+    pushTo(
+        [&](ConnectionState const& state) {
+          return state.watchesClaims && state.userId == userId;
+        },
+        "provisional identity claimed",
+        {{"user_id", userId}});
+  }
+}
+
+void Server::disconnect(ConnectionState& state)
+{
+  std::scoped_lock lock(_mutex);
+  _subscribers.erase(&state);
+  state.watchedUsers.clear();
+  state.watchedGroups.clear();
+  state.watchesClaims = false;
+}
+
+void Server::indexBlock(std::size_t index, ServerEntry const& entry)
+{
+  auto const& action = entry.action();
+  if (auto const dc = action.get_if<DeviceCreation>())
+  {
+    auto& user = _users[dc->userId()];
+    user.blocks.push_back(index);
+    auto& device = _devices[DeviceId{entry.hash()}];
+    device.userId = dc->userId();
+    device.publicSignatureKey = dc->publicSignatureKey();
+    _deviceKeys[dc->publicSignatureKey()] = DeviceId{entry.hash()};
+    if (auto const v3 = dc->get_if<DeviceCreation::v3>())
+    {
+      device.sealedUserKey = v3->sealedPrivateUserEncryptionKey();
+      if (user.userKeys.empty() ||
+          user.userKeys.back() != v3->publicUserEncryptionKey())
+        user.userKeys.push_back(v3->publicUserEncryptionKey());
+      _userKeyOwners[v3->publicUserEncryptionKey()] = dc->userId();
+    }
+  }
+  else if (auto const dr = action.get_if<DeviceRevocation>())
+  {
+    auto const deviceIt = _devices.find(dr->deviceId());
+    if (deviceIt == _devices.end())
+      throw ServerError("device_not_found", "revoking an unknown device");
+    auto const userId = deviceIt->second.userId;
+    auto& user = _users[userId];
+    user.blocks.push_back(index);
+    if (auto const v2 = dr->get_if<DeviceRevocation::v2>())
+    {
+      user.userKeys.push_back(v2->publicEncryptionKey());
+      _userKeyOwners[v2->publicEncryptionKey()] = userId;
+      for (auto const& [deviceId, sealedKey] : v2->sealedUserKeysForDevices())
+        _devices[deviceId].sealedUserKey = sealedKey;
+    }
+  }
+  else if (auto const kp = action.get_if<KeyPublish>())
+  {
+    _keyPublishes[kp->resourceId()].push_back(index);
+  }
+  else if (auto const ugc = action.get_if<UserGroupCreation>())
+  {
+    GroupId const groupId{ugc->publicSignatureKey()};
+    auto& group = _groups[groupId];
+    group.blocks.push_back(index);
+    _groupKeys[ugc->publicEncryptionKey()] = groupId;
+    if (auto const v1 = ugc->get_if<UserGroupCreation::v1>())
+    {
+      for (auto const& [userKey, sealedKey] :
+           v1->sealedPrivateEncryptionKeysForUsers())
+        group.memberUserKeys.insert(userKey);
+    }
+    else if (auto const v2 = ugc->get_if<UserGroupCreation::v2>())
+    {
+      for (auto const& member : v2->members())
+        group.members.insert(member.userId());
+      for (auto const& member : v2->provisionalMembers())
+        group.provisionalMembers.insert(member.appPublicSignatureKey());
+    }
+  }
+  else if (auto const uga = action.get_if<UserGroupAddition>())
+  {
+    auto const groupIt = _groups.find(uga->groupId());
+    if (groupIt == _groups.end())
+      throw ServerError("invalid_body", "adding members to an unknown group");
+    auto& group = groupIt->second;
+    group.blocks.push_back(index);
+    if (auto const v1 = uga->get_if<UserGroupAddition::v1>())
+    {
+      for (auto const& [userKey, sealedKey] :
+           v1->sealedPrivateEncryptionKeysForUsers())
+        group.memberUserKeys.insert(userKey);
+    }
+    else if (auto const v2 = uga->get_if<UserGroupAddition::v2>())
+    {
+      for (auto const& member : v2->members())
+        group.members.insert(member.userId());
+      for (auto const& member : v2->provisionalMembers())
+        group.provisionalMembers.insert(member.appPublicSignatureKey());
+    }
+  }
+  else if (auto const pic = action.get_if<ProvisionalIdentityClaim>())
+  {
+    _users[pic->userId()].claims.push_back(index);
+    _claimedProvisionalKeys[pic->userId()].insert(
+        pic->appSignaturePublicKey());
+  }
+}
+
+std::string Server::serveBlocks(std::vector<std::size_t> const& indexes) const
+{
+  auto blocks = nlohmann::json::array();
+  for (auto const index : indexes)
+    blocks.push_back(_blocks[index - 1]);
+  return blocks.dump();
+}
+
+std::vector<std::uint8_t> Server::serveBinaryBlocks(
+    std::vector<std::size_t> const& indexes) const
+{
+  std::vector<gsl::span<std::uint8_t const>> blocks;
+  blocks.reserve(indexes.size());
+  for (auto const index : indexes)
+    blocks.push_back(_rawBlocks[index - 1]);
+  return frameBlocks(blocks);
+}
+
+bool Server::isGroupMember(UserId const& userId, Group const& group) const
+{
+  if (group.members.count(userId))
+    return true;
+  auto const userIt = _users.find(userId);
+  if (userIt != _users.end())
+  {
+    for (auto const& userKey : userIt->second.userKeys)
+    {
+      if (group.memberUserKeys.count(userKey))
+        return true;
+    }
+  }
+  auto const claimsIt = _claimedProvisionalKeys.find(userId);
+  if (claimsIt != _claimedProvisionalKeys.end())
+  {
+    for (auto const& appKey : claimsIt->second)
+    {
+      if (group.provisionalMembers.count(appKey))
+        return true;
+    }
+  }
+  return false;
+}
+
+// Like the real server, only the key publishes the user can decrypt are
+// served
+bool Server::canRead(UserId const& userId, ServerEntry const& entry) const
+{
+  auto const& keyPublish = entry.action().get<KeyPublish>();
+  if (auto const toUser = keyPublish.get_if<KeyPublish::ToUser>())
+  {
+    auto const ownerIt =
+        _userKeyOwners.find(toUser->recipientPublicEncryptionKey());
+    return ownerIt != _userKeyOwners.end() && ownerIt->second == userId;
+  }
+  if (auto const toGroup = keyPublish.get_if<KeyPublish::ToUserGroup>())
+  {
+    auto const groupIt =
+        _groupKeys.find(toGroup->recipientPublicEncryptionKey());
+    return groupIt != _groupKeys.end() &&
+           isGroupMember(userId, _groups.at(groupIt->second));
+  }
+  if (auto const toProvisional =
+          keyPublish.get_if<KeyPublish::ToProvisionalUser>())
+  {
+    auto const claimsIt = _claimedProvisionalKeys.find(userId);
+    return claimsIt != _claimedProvisionalKeys.end() &&
+           claimsIt->second.count(toProvisional->appPublicSignatureKey());
+  }
+  return false;
+}
+
+Server::ProvisionalIdentity& Server::provisionalIdentity(
+    std::string const& hashedEmail)
+{
+  auto it = _provisionalIdentities.find(hashedEmail);
+  if (it == _provisionalIdentities.end())
+  {
+    it = _provisionalIdentities
+             .emplace(hashedEmail,
+                      ProvisionalIdentity{Crypto::makeSignatureKeyPair(),
+                                          Crypto::makeEncryptionKeyPair()})
+             .first;
+  }
+  return it->second;
+}
+
+nlohmann::json Server::createUser(nlohmann::json const& request)
+{
+  auto const userId = request.at("user_id").get<UserId>();
+  if (_users.count(userId))
+    throw ServerError("conflict", "the user already exists");
+  addBlock(Encoding::base64Decode(
+      request.at("user_creation_block").get<std::string>()));
+  addBlock(Encoding::base64Decode(
+      request.at("first_device_block").get<std::string>()));
+  auto& user = _users.at(userId);
+  user.encryptedVerificationKey =
+      request.at("encrypted_unlock_key").get<std::string>();
+  auto const& verification = request.at("verification");
+  user.verificationMethods[verificationType(verification)] = verification;
+  return nlohmann::json::object();
+}
+
+nlohmann::json Server::userStatus(nlohmann::json const& request) const
+{
+  auto const userId = request.at("user_id").get<UserId>();
+  auto const deviceKeyIt =
+      _deviceKeys.find(request.at("device_public_signature_key")
+                           .get<Crypto::PublicSignatureKey>());
+  auto const deviceExists =
+      deviceKeyIt != _deviceKeys.end() &&
+      _devices.at(deviceKeyIt->second).userId == userId;
+  return {{"device_exists", deviceExists},
+          {"user_exists", _users.count(userId) > 0},
+          {"last_reset", ""}};
+}
+
+nlohmann::json Server::authenticate(ConnectionState& state,
+                                    nlohmann::json const& request) const
+{
+  auto const userId = request.at("user_id").get<UserId>();
+  auto const publicKey =
+      request.at("public_signature_key").get<Crypto::PublicSignatureKey>();
+  auto const deviceKeyIt = _deviceKeys.find(publicKey);
+  if (deviceKeyIt == _deviceKeys.end() ||
+      _devices.at(deviceKeyIt->second).userId != userId)
+    throw ServerError("device_not_found", "unknown device");
+  if (state.challenge.empty() ||
+      !Crypto::verify(
+          gsl::make_span(state.challenge).as_span<std::uint8_t const>(),
+          request.at("signature").get<Crypto::Signature>(),
+          publicKey))
+    throw ServerError("invalid_body", "invalid challenge signature");
+  state.challenge.clear();
+  state.userId = userId;
+  return nlohmann::json::object();
+}
+
+nlohmann::json Server::subscribe(ConnectionState& state,
+                                 nlohmann::json const& request)
+{
+  for (auto const& userId :
+       request.value("user_ids", std::vector<UserId>{}))
+    state.watchedUsers.insert(userId);
+  for (auto const& groupId :
+       request.value("group_ids", std::vector<GroupId>{}))
+    state.watchedGroups.insert(groupId);
+  if (request.value("claims", false))
+    state.watchesClaims = true;
+  _subscribers.insert(&state);
+  return nlohmann::json::object();
+}
+
+nlohmann::json Server::lastUserKey(nlohmann::json const& request) const
+{
+  auto const deviceKeyIt =
+      _deviceKeys.find(request.at("device_public_signature_key")
+                           .get<Crypto::PublicSignatureKey>());
+  if (deviceKeyIt == _deviceKeys.end())
+    throw ServerError("device_not_found", "unknown device");
+  auto const& device = _devices.at(deviceKeyIt->second);
+  if (!device.sealedUserKey)
+    throw ServerError("device_not_found", "the device has no user key");
+  return {{"encrypted_private_user_key", *device.sealedUserKey},
+          {"device_id", deviceKeyIt->second}};
+}
+
+nlohmann::json Server::verificationKey(nlohmann::json const& request) const
+{
+  auto const userIt = _users.find(request.at("user_id").get<UserId>());
+  if (userIt == _users.end())
+    throw ServerError("verification_key_not_found", "unknown user");
+  auto const& user = userIt->second;
+  auto const& verification = request.at("verification");
+  auto const type = verificationType(verification);
+  auto const methodIt = user.verificationMethods.find(type);
+  if (methodIt == user.verificationMethods.end())
+    throw ServerError("verification_method_not_set", type);
+  if (type == "passphrase" && methodIt->second.at("hashed_passphrase") !=
+                                  verification.at("hashed_passphrase"))
+    throw ServerError("invalid_passphrase", "invalid passphrase");
+  if (type == "email" &&
+      methodIt->second.at("hashed_email") != verification.at("hashed_email"))
+    throw ServerError("invalid_verification_code", "invalid email");
+  return {{"encrypted_verification_key", user.encryptedVerificationKey}};
+}
+
+nlohmann::json Server::setVerificationMethod(nlohmann::json const& request)
+{
+  auto const userIt = _users.find(request.at("user_id").get<UserId>());
+  if (userIt == _users.end())
+    throw ServerError("invalid_body", "unknown user");
+  auto const& verification = request.at("verification");
+  userIt->second.verificationMethods[verificationType(verification)] =
+      verification;
+  return nlohmann::json::object();
+}
+
+nlohmann::json Server::verificationMethods(nlohmann::json const& request) const
+{
+  auto methods = nlohmann::json::array();
+  auto const userIt = _users.find(request.at("user_id").get<UserId>());
+  if (userIt != _users.end())
+  {
+    for (auto const& [type, verification] :
+         userIt->second.verificationMethods)
+    {
+      nlohmann::json method{{"type", type}};
+      if (type == "email")
+        method["encrypted_email"] = verification.at("encrypted_email");
+      methods.push_back(std::move(method));
+    }
+  }
+  return {{"verification_methods", std::move(methods)}};
+}
+
+nlohmann::json Server::publicProvisionalIdentities(
+    nlohmann::json const& request)
+{
+  auto identities = nlohmann::json::array();
+  for (auto const& email : request)
+  {
+    auto const& identity =
+        provisionalIdentity(email.at("hashed_email").get<std::string>());
+    identities.push_back(
+        {{"signature_public_key", identity.signatureKeyPair.publicKey},
+         {"encryption_public_key", identity.encryptionKeyPair.publicKey}});
+  }
+  return identities;
+}
+
+nlohmann::json Server::provisionalIdentityKeys(ConnectionState const& state,
+                                               std::string const& eventName,
+                                               nlohmann::json const& request)
+{
+  std::string hashedEmail;
+  if (eventName == "get verified provisional identity")
+  {
+    // the email must be one of the verification methods of the user
+    hashedEmail = request.at("verification_method")
+                      .at("hashed_email")
+                      .get<std::string>();
+    auto const& methods = _users.at(*state.userId).verificationMethods;
+    auto const emailIt = methods.find("email");
+    if (emailIt == methods.end() ||
+        emailIt->second.at("hashed_email") != hashedEmail)
+      return nlohmann::json::object();
+  }
+  else
+  {
+    hashedEmail =
+        request.at("verification").at("hashed_email").get<std::string>();
+  }
+  auto const identityIt = _provisionalIdentities.find(hashedEmail);
+  if (identityIt == _provisionalIdentities.end())
+    return nlohmann::json::object();
+  auto const& identity = identityIt->second;
+  return {
+      {"signature_public_key", identity.signatureKeyPair.publicKey},
+      {"signature_private_key", identity.signatureKeyPair.privateKey},
+      {"encryption_public_key", identity.encryptionKeyPair.publicKey},
+      {"encryption_private_key", identity.encryptionKeyPair.privateKey},
+  };
+}
+
+std::vector<std::size_t> Server::blockIndexes(
+    ConnectionState const& state,
+    std::string const& eventName,
+    nlohmann::json const& request) const
+{
+  auto const& me = *state.userId;
+  // the root block comes first in the replies about users
+  std::vector<std::size_t> indexes;
+  if (eventName == "get my user blocks")
+  {
+    indexes = _users.at(me).blocks;
+    indexes.push_back(1);
+  }
+  else if (eventName == "get users blocks")
+  {
+    std::vector<UserId> userIds;
+    if (request.contains("user_ids"))
+      userIds = request.at("user_ids").get<std::vector<UserId>>();
+    for (auto const& deviceId :
+         request.value("device_ids", std::vector<DeviceId>{}))
+    {
+      auto const deviceIt = _devices.find(deviceId);
+      if (deviceIt != _devices.end())
+        userIds.push_back(deviceIt->second.userId);
+    }
+    for (auto const& userId : userIds)
+    {
+      auto const userIt = _users.find(userId);
+      if (userIt != _users.end())
+        indexes.insert(indexes.end(),
+                       userIt->second.blocks.begin(),
+                       userIt->second.blocks.end());
+    }
+    indexes.push_back(1);
+  }
+  else if (eventName == "get key publishes")
+  {
+    for (auto const& resourceId :
+         request.at("resource_ids").get<std::vector<ResourceId>>())
+    {
+      auto const it = _keyPublishes.find(resourceId);
+      if (it == _keyPublishes.end())
+        continue;
+      for (auto const index : it->second)
+      {
+        if (canRead(me, _entries[index - 1]))
+          indexes.push_back(index);
+      }
+    }
+  }
+  else if (eventName == "get groups blocks")
+  {
+    std::vector<GroupId> groupIds;
+    if (request.contains("groups_ids"))
+      groupIds = request.at("groups_ids").get<std::vector<GroupId>>();
+    if (request.contains("group_public_key"))
+    {
+      auto const it = _groupKeys.find(
+          request.at("group_public_key").get<Crypto::PublicEncryptionKey>());
+      if (it != _groupKeys.end())
+        groupIds.push_back(it->second);
+    }
+    for (auto const& groupId : groupIds)
+    {
+      auto const it = _groups.find(groupId);
+      if (it != _groups.end())
+        indexes.insert(
+            indexes.end(), it->second.blocks.begin(), it->second.blocks.end());
+    }
+  }
+  else if (eventName == "get my claim blocks")
+  {
+    indexes = _users.at(me).claims;
+  }
+  std::sort(indexes.begin(), indexes.end());
+  indexes.erase(std::unique(indexes.begin(), indexes.end()), indexes.end());
+  return indexes;
+}
+
+std::string Server::handle(ConnectionState& state,
+                           std::string const& eventName,
+                           std::string const& data)
+{
+  std::scoped_lock lock(_mutex);
+  if (eventName != "batch")
+    return dispatch(state, eventName, data);
+
+  // see Network::BatchingConnection
+  auto replies = nlohmann::json::array();
+  try
+  {
+    for (auto const& emit : nlohmann::json::parse(data))
+    {
+      replies.push_back(dispatch(state,
+                                 emit.at("event").get<std::string>(),
+                                 emit.at("data").get<std::string>()));
+    }
+  }
+  catch (std::exception const& e)
+  {
+    return errorReply("invalid_body", e.what());
+  }
+  return replies.dump();
+}
+
+std::string Server::dispatch(ConnectionState& state,
+                             std::string const& eventName,
+                             std::string const& data)
+{
+  try
+  {
+    if (eventName == "push block")
+    {
+      addBlock(Encoding::base64Decode(data));
+      return "{}";
+    }
+    auto const request = nlohmann::json::parse(data);
+    if (eventName == "push keys")
+    {
+      for (auto const& block : request)
+        addBlock(Encoding::base64Decode(block.get<std::string>()));
+      return "{}";
+    }
+    if (eventName == "binary blocks")
+    {
+      state.binaryBlocks =
+          request.at("version").get<int>() == blockFrameVersion;
+      return nlohmann::json{{"binary_blocks", state.binaryBlocks}}.dump();
+    }
+    if (eventName == "compression")
+    {
+      auto const methods =
+          request.at("methods").get<std::vector<std::string>>();
+      state.compression =
+          std::find(methods.begin(), methods.end(), "deflate") !=
+          methods.end();
+      state.compressionThreshold = request.at("threshold").get<std::size_t>();
+      if (!state.compression)
+        return nlohmann::json::object().dump();
+      return nlohmann::json{{"compression", "deflate"}}.dump();
+    }
+    if (eventName == "get user status")
+      return userStatus(request).dump();
+    if (eventName == "create user 2")
+      return createUser(request).dump();
+    if (eventName == "request auth challenge")
+    {
+      state.challenge = fmt::format(
+          "\U0001F512 Auth Challenge. 1234567890.{}",
+          Encoding::base64Encode(Crypto::getRandom<Crypto::Hash>()));
+      return nlohmann::json{{"challenge", state.challenge}}.dump();
+    }
+    if (eventName == "authenticate device")
+      return authenticate(state, request).dump();
+    if (eventName == "last user key")
+      return lastUserKey(request).dump();
+    if (eventName == "get verification key")
+      return verificationKey(request).dump();
+    if (eventName == "set verification method")
+      return setVerificationMethod(request).dump();
+    if (eventName == "get verification methods")
+      return verificationMethods(request).dump();
+    if (eventName == "get public provisional identities")
+      return publicProvisionalIdentities(request).dump();
+
+    // the other events are about the user of the connection
+    if (!state.userId)
+      throw ServerError("invalid_body", "the connection is not authenticated");
+    if (eventName == "subscribe")
+      return subscribe(state, request).dump();
+    if (eventName == "get verified provisional identity" ||
+        eventName == "get provisional identity")
+      return provisionalIdentityKeys(state, eventName, request).dump();
+    if (isBlocksRequest(eventName))
+      return serveBlocks(blockIndexes(state, eventName, request));
+    throw ServerError("internal_error", "unknown event: " + eventName);
+  }
+  catch (ServerError const& e)
+  {
+    return errorReply(e.code, e.what());
+  }
+  catch (std::exception const& e)
+  {
+    return errorReply("invalid_body", e.what());
+  }
+}
+
+std::vector<std::uint8_t> Server::handleBinary(
+    ConnectionState& state,
+    std::string const& eventName,
+    std::vector<std::uint8_t> const& data)
+{
+  if (eventName == "compressed")
+    return handleCompressed(state, data);
+
+  std::scoped_lock lock(_mutex);
+  try
+  {
+    if (!state.binaryBlocks)
+      throw ServerError("invalid_body", "binary blocks were not negotiated");
+    if (eventName == "push block" || eventName == "push keys")
+    {
+      for (auto const& block : unframeBlocks(data))
+        addBlock(std::vector<std::uint8_t>(block.begin(), block.end()));
+      return bytes("{}");
+    }
+    // block requests are json, their replies are frames
+    if (!state.userId)
+      throw ServerError("invalid_body", "the connection is not authenticated");
+    if (isBlocksRequest(eventName))
+    {
+      return serveBinaryBlocks(
+          blockIndexes(state, eventName, nlohmann::json::parse(data)));
+    }
+    throw ServerError("internal_error", "unknown binary event: " + eventName);
+  }
+  catch (ServerError const& e)
+  {
+    return bytes(errorReply(e.code, e.what()));
+  }
+  catch (std::exception const& e)
+  {
+    return bytes(errorReply("invalid_body", e.what()));
+  }
+}
+
+std::vector<std::uint8_t> Server::handleCompressed(
+    ConnectionState& state, std::vector<std::uint8_t> const& data)
+{
+  std::vector<std::uint8_t> reply;
+  try
+  {
+    if (!state.compression)
+      throw ServerError("invalid_body", "compression was not negotiated");
+    auto const emit = Network::unpackCompressedEmit(data);
+    auto const payload = Network::decompressPayload(emit.compressedData);
+    if (emit.binary)
+      reply = handleBinary(state, emit.eventName, payload);
+    else
+      reply = bytes(handle(
+          state, emit.eventName, std::string(payload.begin(), payload.end())));
+  }
+  catch (ServerError const& e)
+  {
+    reply = bytes(errorReply(e.code, e.what()));
+  }
+  catch (std::exception const& e)
+  {
+    reply = bytes(errorReply("invalid_body", e.what()));
+  }
+  return Network::compressPayload(reply, state.compressionThreshold);
+}
+}
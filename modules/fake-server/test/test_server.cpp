@@ -0,0 +1,233 @@
+#include <Tanker/FakeServer/Server.hpp>
+
+#include <Tanker/AsyncCore.hpp>
+#include <Tanker/Core.hpp>
+#include <Tanker/DataStore/ADatabase.hpp>
+#include <Tanker/Identity/PublicIdentity.hpp>
+#include <Tanker/Identity/SecretPermanentIdentity.hpp>
+#include <Tanker/Network/ConnectionFactory.hpp>
+#include <Tanker/Status.hpp>
+#include <Tanker/Types/SUserId.hpp>
+
+#include <Helpers/Await.hpp>
+#include <Helpers/Buffers.hpp>
+#include <Helpers/UniquePath.hpp>
+
+#include <doctest.h>
+
+#include <nlohmann/json.hpp>
+#include <tconcurrent/async.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+using namespace Tanker;
+using namespace std::chrono_literals;
+
+namespace
+{
+// destroy() deletes the session
+AsyncCore* makeCore(FakeServer::Server const& server,
+                    std::string const& storagePath = DataStore::ephemeralDbPath)
+{
+  return new AsyncCore(
+      "fake-server",
+      Network::SdkInfo{"sdk-native-test", server.trustchainId(), "0.0.1"},
+      storagePath);
+}
+
+std::string makeIdentity(FakeServer::Server const& server,
+                         std::string const& userId)
+{
+  return to_string(
+      Identity::createIdentity(server.trustchainId(),
+                               server.trustchainKeyPair().privateKey,
+                               obfuscateUserId(SUserId{userId},
+                                               server.trustchainId())));
+}
+}
+
+TEST_CASE("the fake server serves the sessions of two users")
+{
+  FakeServer::Server server;
+  server.install();
+
+  auto const aliceIdentity = makeIdentity(server, "alice");
+  auto const bobIdentity = makeIdentity(server, "bob");
+
+  auto alice = makeCore(server);
+  REQUIRE(alice->start(aliceIdentity).get() ==
+          Status::IdentityRegistrationNeeded);
+  alice->registerIdentity(alice->generateVerificationKey().get()).get();
+  REQUIRE(alice->status() == Status::Ready);
+
+  auto bob = makeCore(server);
+  REQUIRE(bob->start(bobIdentity).get() == Status::IdentityRegistrationNeeded);
+  auto const bobVerificationKey = bob->generateVerificationKey().get();
+  bob->registerIdentity(bobVerificationKey).get();
+
+  auto const clearData = make_buffer("my clear data");
+  auto const encrypted =
+      alice
+          ->encrypt(clearData,
+                    {SPublicIdentity{Identity::getPublicIdentity(bobIdentity)}})
+          .get();
+  CHECK(bob->decrypt(encrypted).get() == clearData);
+
+  SUBCASE("a second device of a user gets the user key")
+  {
+    auto bobLaptop = makeCore(server);
+    REQUIRE(bobLaptop->start(bobIdentity).get() ==
+            Status::IdentityVerificationNeeded);
+    bobLaptop->verifyIdentity(bobVerificationKey).get();
+    CHECK(bobLaptop->decrypt(encrypted).get() == clearData);
+    bobLaptop->destroy().get();
+  }
+
+  bob->destroy().get();
+  alice->destroy().get();
+}
+
+TEST_CASE("a nuked device does not decrypt with its cached keys")
+{
+  FakeServer::Server server;
+  server.install();
+
+  auto core = std::make_unique<Core>(
+      "fake-server",
+      Network::SdkInfo{"sdk-native-test", server.trustchainId(), "0.0.1"},
+      DataStore::ephemeralDbPath);
+  REQUIRE(AWAIT(core->start(makeIdentity(server, "alice"))) ==
+          Status::IdentityRegistrationNeeded);
+  AWAIT_VOID(core->registerIdentity(AWAIT(core->generateVerificationKey())));
+
+  auto const clearData = make_buffer("my clear data");
+  auto const encrypted = AWAIT(core->encrypt(clearData));
+  CHECK(AWAIT(core->decrypt(encrypted)) == clearData);
+  REQUIRE(core->findCachedKey(encrypted));
+
+  AWAIT_VOID(core->nukeDatabase());
+  CHECK_FALSE(core->findCachedKey(encrypted));
+
+  tc::async([&] { core.reset(); }).get();
+}
+
+TEST_CASE("install makes ConnectionFactory connect to the fake server")
+{
+  FakeServer::Server server;
+  Network::SdkInfo const info{"sdk-native-test", server.trustchainId(), ""};
+
+  server.install();
+  CHECK(Network::ConnectionFactory::create("https://example.com", info)
+            ->id()
+            .rfind("fake-server-", 0) == 0);
+
+  server.uninstall();
+  CHECK(Network::ConnectionFactory::create("https://example.com", info)
+            ->id()
+            .rfind("fake-server-", 0) != 0);
+}
+
+TEST_CASE("uninstall leaves the connections of another server")
+{
+  FakeServer::Server server;
+  FakeServer::Server otherServer;
+  Network::SdkInfo const info{"sdk-native-test", server.trustchainId(), ""};
+
+  server.install();
+  otherServer.install();
+  server.uninstall();
+  CHECK(Network::ConnectionFactory::create("https://example.com", info)
+            ->id()
+            .rfind("fake-server-", 0) == 0);
+  otherServer.uninstall();
+}
+
+TEST_CASE("fake server connections wait for the latency")
+{
+  FakeServer::Server server({50ms});
+  auto const connection = server.makeConnection();
+  connection->connect();
+
+  auto const before = std::chrono::steady_clock::now();
+  auto const reply = tc::async_resumable([&]() -> tc::cotask<std::string> {
+                       TC_RETURN(TC_AWAIT(connection->emit("unknown", "{}")));
+                     }).get();
+  CHECK(std::chrono::steady_clock::now() - before >= 50ms);
+  CHECK(nlohmann::json::parse(reply).at("error").at("code") ==
+        "internal_error");
+}
+
+TEST_CASE("a session recorded against the fake server can be replayed")
+{
+  FakeServer::Server server;
+  server.install();
+
+  auto const aliceIdentity = makeIdentity(server, "alice");
+  auto const bobIdentity = makeIdentity(server, "bob");
+  auto const alicePublicIdentity =
+      SPublicIdentity{Identity::getPublicIdentity(aliceIdentity)};
+  UniquePath aliceStorage("testtmp");
+  UniquePath snapshot("testtmp");
+
+  auto alice = makeCore(server, aliceStorage.path);
+  alice->start(aliceIdentity).get();
+  alice->registerIdentity(alice->generateVerificationKey().get()).get();
+  alice->destroy().get();
+  copyFiles(aliceStorage.path, snapshot.path);
+
+  auto bob = makeCore(server);
+  bob->start(bobIdentity).get();
+  bob->registerIdentity(bob->generateVerificationKey().get()).get();
+  auto const clearData = make_buffer("my clear data");
+  auto const encrypted = bob->encrypt(clearData, {alicePublicIdentity}).get();
+  bob->destroy().get();
+
+  // sessions create their connection when they are constructed
+  UniquePath captureDir("testtmp");
+  auto const capturePath = captureDir.path + "/capture.jsonl";
+  Network::ConnectionFactory::record(capturePath);
+  auto recordedAlice = makeCore(server, aliceStorage.path);
+  recordedAlice->start(aliceIdentity).get();
+  CHECK(recordedAlice->decrypt(encrypted).get() == clearData);
+  recordedAlice->destroy().get();
+  Network::ConnectionFactory::stopRecording();
+  server.uninstall();
+
+  // no server: the replies come from the capture
+  Network::ConnectionFactory::replay(capturePath,
+                                     Network::ReplayTiming::FullSpeed);
+  UniquePath replayStorage("testtmp");
+  copyFiles(snapshot.path, replayStorage.path);
+  auto replayedAlice = makeCore(server, replayStorage.path);
+  REQUIRE(replayedAlice->start(aliceIdentity).get() == Status::Ready);
+  CHECK(replayedAlice->decrypt(encrypted).get() == clearData);
+  replayedAlice->destroy().get();
+  Network::ConnectionFactory::setCreator({});
+}
+
+TEST_CASE("the fake server answers each emit of a batch")
+{
+  FakeServer::Server server;
+  auto const connection = server.makeConnection();
+  connection->connect();
+
+  auto const batch = nlohmann::json::array({
+      {{"event", "unknown 1"}, {"data", "{}"}},
+      {{"event", "unknown 2"}, {"data", "{}"}},
+  });
+  auto const reply = tc::async_resumable([&]() -> tc::cotask<std::string> {
+                       TC_RETURN(TC_AWAIT(
+                           connection->emit("batch", batch.dump())));
+                     }).get();
+
+  auto const replies = nlohmann::json::parse(reply);
+  REQUIRE(replies.size() == 2);
+  for (auto const& emitReply : replies)
+  {
+    CHECK(nlohmann::json::parse(emitReply.get<std::string>())
+              .at("error")
+              .at("code") == "internal_error");
+  }
+}
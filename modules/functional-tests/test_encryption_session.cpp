@@ -10,6 +10,8 @@
 
 #include "CheckDecrypt.hpp"
 
+#include <algorithm>
+
 using namespace Tanker;
 using Tanker::Functional::TrustchainFixture;
 
@@ -55,4 +57,34 @@ TEST_SUITE("Encryption sessions")
     REQUIRE(TC_AWAIT(
         checkDecrypt(bobDevices, {std::make_tuple(clearData, encryptedData)})));
   }
+
+  TEST_CASE_FIXTURE(TrustchainFixture,
+                    "decryptSync would block until the session key is cached")
+  {
+    auto alice = trustchain.makeUser();
+    auto aliceDevice = alice.makeDevice();
+    auto aliceSession = TC_AWAIT(aliceDevice.open());
+
+    auto bob = trustchain.makeUser();
+    auto bobDevice = bob.makeDevice();
+    auto bobSession = TC_AWAIT(bobDevice.open());
+
+    auto encSess =
+        TC_AWAIT(aliceSession->makeEncryptionSession({bob.spublicIdentity()}));
+
+    auto const clearData = make_buffer("my clear data is clear");
+    std::vector<uint8_t> encryptedData(
+        EncryptionSession::encryptedSize(clearData.size()));
+    encSess.encryptSync(encryptedData.data(), clearData);
+
+    std::vector<uint8_t> decryptedData(
+        EncryptionSession::decryptedSize(encryptedData));
+    CHECK_FALSE(
+        bobSession->decryptSync(decryptedData.data(), encryptedData).get());
+
+    TC_AWAIT(bobSession->decrypt(decryptedData.data(), encryptedData));
+    std::fill(decryptedData.begin(), decryptedData.end(), 0);
+    CHECK(bobSession->decryptSync(decryptedData.data(), encryptedData).get());
+    CHECK(decryptedData == clearData);
+  }
 }
@@ -0,0 +1,93 @@
+#include <Tanker/Functional/TrustchainFixture.hpp>
+
+#include <Tanker/Core.hpp>
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Status.hpp>
+#include <Tanker/TenantHost.hpp>
+#include <Tanker/Types/Passphrase.hpp>
+
+#include <Helpers/Buffers.hpp>
+#include <Helpers/Errors.hpp>
+#include <Helpers/UniquePath.hpp>
+
+#include <doctest.h>
+
+#include <chrono>
+
+using namespace Tanker;
+using Tanker::Functional::TrustchainFixture;
+using Tanker::Functional::UserType;
+
+namespace
+{
+auto const password = Passphrase{"tenant password"};
+
+Network::SdkInfo sdkInfo(Functional::Trustchain const& trustchain)
+{
+  return {"sdk-native-test", trustchain.id, "0.0.1"};
+}
+}
+
+TEST_SUITE_BEGIN("TenantHost");
+
+TEST_CASE_FIXTURE(TrustchainFixture, "it registers tenants on first open")
+{
+  UniquePath storage("testtmp");
+  TenantHost host(trustchain.url, sdkInfo(trustchain), storage.path);
+  auto alice = trustchain.makeUser(UserType::New);
+
+  TANKER_CHECK_THROWS_WITH_CODE(TC_AWAIT(host.open(alice.identity)),
+                                Errors::Errc::PreconditionFailed);
+  auto const core = TC_AWAIT(host.open(alice.identity, password));
+  CHECK(core->status() == Status::Ready);
+  CHECK(TC_AWAIT(host.open(alice.identity)) == core);
+  CHECK(host.stats().residentTenants == 1);
+}
+
+TEST_CASE_FIXTURE(TrustchainFixture,
+                  "it stops the least recently used tenant to make room")
+{
+  UniquePath storage("testtmp");
+  TenantHost host(trustchain.url,
+                  sdkInfo(trustchain),
+                  storage.path,
+                  TenantHost::Options{2, std::chrono::minutes(5)});
+  auto alice = trustchain.makeUser(UserType::New);
+  auto bob = trustchain.makeUser(UserType::New);
+  auto charlie = trustchain.makeUser(UserType::New);
+
+  auto const clearData = make_buffer("my clear data is clear");
+  auto const encryptedData = TC_AWAIT(
+      TC_AWAIT(host.open(alice.identity, password))->encrypt(clearData));
+  TC_AWAIT(host.open(bob.identity, password));
+
+  auto const charlieCore = TC_AWAIT(host.open(charlie.identity, password));
+  CHECK(host.stats().residentTenants == 2);
+  CHECK(host.stats().evictions == 1);
+
+  // alice's device is kept on disk, she only has to be started again
+  auto const aliceCore = TC_AWAIT(host.open(alice.identity));
+  CHECK(TC_AWAIT(aliceCore->decrypt(encryptedData)) == clearData);
+  CHECK(host.stats().loads == 4);
+}
+
+TEST_CASE_FIXTURE(TrustchainFixture, "it keeps the tenants in use")
+{
+  UniquePath storage("testtmp");
+  TenantHost host(trustchain.url,
+                  sdkInfo(trustchain),
+                  storage.path,
+                  TenantHost::Options{1, std::chrono::seconds(0)});
+  auto alice = trustchain.makeUser(UserType::New);
+  auto bob = trustchain.makeUser(UserType::New);
+
+  auto const aliceCore = TC_AWAIT(host.open(alice.identity, password));
+  TC_AWAIT(host.open(bob.identity, password));
+  CHECK(host.stats().residentTenants == 2);
+
+  host.evictIdle();
+  CHECK(host.stats().residentTenants == 1);
+  CHECK(aliceCore->status() == Status::Ready);
+}
+
+TEST_SUITE_END();
@@ -1,9 +1,9 @@
 #pragma once
 
+#include <Tanker/Encoding/Errors/ErrcCategory.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Identity/Errors/Errc.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
 #include <nlohmann/json.hpp>
 
 namespace Tanker
@@ -26,8 +26,10 @@ I extract(std::string const& token)
   {
     throw Errors::formatEx(Errc::InvalidFormat, "json deserialization failed");
   }
-  catch (cppcodec::parse_error const&)
+  catch (Errors::Exception const& e)
   {
+    if (e.errorCode().category() != Encoding::ErrcCategory())
+      throw;
     throw Errors::formatEx(Errc::InvalidFormat,
                            "base64 deserialization failed");
   }
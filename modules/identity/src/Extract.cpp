@@ -1,5 +1,7 @@
 #include <Tanker/Identity/Extract.hpp>
 
+#include <Tanker/Encoding/Base64.hpp>
+
 using namespace Tanker::Errors;
 
 namespace Tanker
@@ -10,7 +12,7 @@ namespace detail
 {
 nlohmann::json extract(std::string const& token)
 {
-  return nlohmann::json::parse(cppcodec::base64_rfc4648::decode(token));
+  return nlohmann::json::parse(Encoding::base64Decode(token));
 }
 }
 }
@@ -1,9 +1,9 @@
 #include <Tanker/Identity/PublicPermanentIdentity.hpp>
 
+#include <Tanker/Encoding/Base64.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Identity/Errors/Errc.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
 #include <nlohmann/json.hpp>
 
 namespace Tanker
@@ -40,7 +40,7 @@ void to_json(nlohmann::json& j, PublicPermanentIdentity const& identity)
 
 std::string to_string(PublicPermanentIdentity const& identity)
 {
-  return cppcodec::base64_rfc4648::encode(nlohmann::json(identity).dump());
+  return Encoding::base64Encode(nlohmann::json(identity).dump());
 }
 }
 }
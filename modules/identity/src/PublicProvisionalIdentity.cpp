@@ -1,10 +1,10 @@
 #include <Tanker/Identity/PublicProvisionalIdentity.hpp>
 
+#include <Tanker/Encoding/Base64.hpp>
 #include <Tanker/Errors/AssertionError.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Identity/Errors/Errc.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
 
@@ -33,9 +33,9 @@ void from_json(nlohmann::json const& j, PublicProvisionalIdentity& identity)
       j.at("trustchain_id").get<Trustchain::TrustchainId>(),
       TargetType::Email,
       j.at("value").get<std::string>(),
-      cppcodec::base64_rfc4648::decode<Crypto::PublicSignatureKey>(
+      Encoding::base64Decode<Crypto::PublicSignatureKey>(
           j.at("public_signature_key").get<std::string>()),
-      cppcodec::base64_rfc4648::decode<Crypto::PublicEncryptionKey>(
+      Encoding::base64Decode<Crypto::PublicEncryptionKey>(
           j.at("public_encryption_key").get<std::string>()),
   };
 }
@@ -53,14 +53,14 @@ void to_json(nlohmann::json& j, PublicProvisionalIdentity const& identity)
   j["trustchain_id"] = identity.trustchainId;
   j["target"] = "email";
   j["public_signature_key"] =
-      cppcodec::base64_rfc4648::encode(identity.appSignaturePublicKey);
+      Encoding::base64Encode(identity.appSignaturePublicKey);
   j["public_encryption_key"] =
-      cppcodec::base64_rfc4648::encode(identity.appEncryptionPublicKey);
+      Encoding::base64Encode(identity.appEncryptionPublicKey);
 }
 
 std::string to_string(PublicProvisionalIdentity const& identity)
 {
-  return cppcodec::base64_rfc4648::encode(nlohmann::json(identity).dump());
+  return Encoding::base64Encode(nlohmann::json(identity).dump());
 }
 }
 }
@@ -1,5 +1,6 @@
 #include <Tanker/Identity/SecretPermanentIdentity.hpp>
 
+#include <Tanker/Encoding/Base64.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Identity/Errors/Errc.hpp>
 #include <Tanker/Identity/Extract.hpp>
@@ -8,8 +9,6 @@
 #include <Tanker/Trustchain/TrustchainId.hpp>
 #include <Tanker/Trustchain/UserId.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
-
 namespace Tanker
 {
 namespace Identity
@@ -42,11 +41,10 @@ std::string createIdentity(std::string const& trustchainIdParam,
     throw Errors::Exception(Errc::InvalidTrustchainPrivateKey);
 
   auto const trustchainId =
-      cppcodec::base64_rfc4648::decode<Trustchain::TrustchainId>(
-          trustchainIdParam);
+      Encoding::base64Decode<Trustchain::TrustchainId>(trustchainIdParam);
   return to_string(createIdentity(
       trustchainId,
-      cppcodec::base64_rfc4648::decode<Tanker::Crypto::PrivateSignatureKey>(
+      Encoding::base64Decode<Tanker::Crypto::PrivateSignatureKey>(
           trustchainPrivateKey),
       Tanker::obfuscateUserId(userId, trustchainId)));
 }
@@ -66,7 +64,7 @@ std::string upgradeUserToken(std::string const& strustchainId,
                              std::string const& suserToken)
 {
   auto const trustchainId =
-      cppcodec::base64_rfc4648::decode<Trustchain::TrustchainId>(strustchainId);
+      Encoding::base64Decode<Trustchain::TrustchainId>(strustchainId);
   auto const userId = Tanker::obfuscateUserId(suserId, trustchainId);
   auto const userToken = extract<UserToken>(suserToken);
   return to_string(upgradeUserToken(trustchainId, userId, userToken));
@@ -106,7 +104,7 @@ void to_json(nlohmann::json& j, SecretPermanentIdentity const& identity)
 
 std::string to_string(SecretPermanentIdentity const& identity)
 {
-  return cppcodec::base64_rfc4648::encode(nlohmann::json(identity).dump());
+  return Encoding::base64Encode(nlohmann::json(identity).dump());
 }
 }
 }
@@ -3,12 +3,12 @@
 #include <Tanker/Crypto/Hash.hpp>
 #include <Tanker/Crypto/Signature.hpp>
 #include <Tanker/Crypto/SignatureKeyPair.hpp>
+#include <Tanker/Encoding/Base64.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Identity/Errors/Errc.hpp>
 #include <Tanker/Identity/Utils.hpp>
 #include <Tanker/Trustchain/TrustchainId.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
 #include <nlohmann/json.hpp>
 
 #include <stdexcept>
@@ -30,13 +30,12 @@ std::string generateUserToken(std::string const& trustchainIdString,
     throw Errors::Exception(Errc::InvalidTrustchainPrivateKey);
 
   auto const trustchainId =
-      cppcodec::base64_rfc4648::decode<Trustchain::TrustchainId>(
-          trustchainIdString);
-  return cppcodec::base64_rfc4648::encode(
+      Encoding::base64Decode<Trustchain::TrustchainId>(trustchainIdString);
+  return Encoding::base64Encode(
       nlohmann::json(
           generateUserToken(
-              cppcodec::base64_rfc4648::decode<
-                  Tanker::Crypto::PrivateSignatureKey>(trustchainPrivateKey),
+              Encoding::base64Decode<Tanker::Crypto::PrivateSignatureKey>(
+                  trustchainPrivateKey),
               Tanker::obfuscateUserId(userId, trustchainId)))
           .dump());
 }
@@ -2,9 +2,11 @@
 
 #include <tconcurrent/coroutine.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Tanker
 {
@@ -23,6 +25,13 @@ public:
   virtual tc::cotask<std::string> emit(std::string const& eventName,
                                        std::string const& data) = 0;
 
+  // Emits data as a binary attachment. A binary reply is returned as is, a
+  // string reply as its bytes. Connections that cannot carry attachments
+  // return false from canEmitBinary() and throw from emitBinary().
+  virtual bool canEmitBinary() const;
+  virtual tc::cotask<std::vector<std::uint8_t>> emitBinary(
+      std::string const& eventName, std::vector<std::uint8_t> const& data);
+
   virtual void on(std::string const& message, Handler handler) = 0;
   virtual ~AConnection() = default;
 
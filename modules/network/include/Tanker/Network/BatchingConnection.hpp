@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Tanker/Network/AConnection.hpp>
+#include <Tanker/Network/Negotiation.hpp>
+
+#include <tconcurrent/coroutine.hpp>
+#include <tconcurrent/promise.hpp>
+#include <tconcurrent/task_auto_canceler.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Tanker
+{
+namespace Network
+{
+// Gathers the emits issued in the same executor tick and sends them as one
+// "batch" emit, whose data is a json array of {"event": name, "data": data}
+// and whose reply is the json array of their replies, in the same order.
+//
+// A single emit is sent as is. When the server replies to a batch with
+// anything else than an array of replies, e.g. an error because it does not
+// know the event, the batch is sent again emit by emit and the connection
+// stops batching. Until a batch succeeded, batches are negotiations, see
+// Negotiation.hpp: when one is not answered in time, the connection stops
+// batching too, but its emits fail with a NetworkError since the server may
+// still apply them.
+class BatchingConnection : public AConnection
+{
+public:
+  struct Metrics
+  {
+    std::uint64_t batches;
+    std::uint64_t batchedEmits;
+    std::uint64_t largestBatch;
+    // emits sent alone, because no other emit came in the same tick or the
+    // server does not support batches
+    std::uint64_t unbatchedEmits;
+  };
+
+  explicit BatchingConnection(
+      ConnectionPtr connection,
+      std::chrono::milliseconds negotiationTimeout = defaultNegotiationTimeout);
+
+  bool isOpen() const override;
+  void connect() override;
+  void close() override;
+  std::string id() const override;
+
+  tc::cotask<std::string> emit(std::string const& eventName,
+                               std::string const& data) override;
+
+  bool canEmitBinary() const override;
+  tc::cotask<std::vector<std::uint8_t>> emitBinary(
+      std::string const& eventName,
+      std::vector<std::uint8_t> const& data) override;
+
+  void on(std::string const& message, Handler handler) override;
+
+  // Of all the batching connections
+  static Metrics metrics();
+
+private:
+  struct PendingEmit
+  {
+    std::string eventName;
+    std::string data;
+    tc::promise<std::string> promise;
+  };
+
+  ConnectionPtr _connection;
+  std::chrono::milliseconds const _negotiationTimeout;
+  bool _batchSupported = true;
+  // once a batch succeeded, they are no longer bounded by the negotiation
+  // timeout
+  bool _batchConfirmed = false;
+  std::vector<PendingEmit> _pending;
+  tc::task_auto_canceler _taskCanceler;
+
+  tc::cotask<void> flush();
+  void emitAlone(PendingEmit pendingEmit);
+};
+}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Tanker
+{
+namespace Network
+{
+// One exchange of a recorded connection, an emit and its reply or an event
+// received by an on() handler
+struct CaptureRecord
+{
+  enum class Kind
+  {
+    Emit,
+    Event,
+  };
+
+  Kind kind;
+  // emitBinary() data and reply, the request and reply are base64 encoded
+  bool binary;
+  // the index of the connection in the capture, by creation order
+  std::size_t connection;
+  std::string eventName;
+  // the data of the emit, empty for events
+  std::string request;
+  // the reply of the emit, the data of the event
+  std::string reply;
+  // since the creation of the connection
+  std::chrono::microseconds start;
+  // from the emit to the reply, zero for events
+  std::chrono::microseconds duration;
+};
+
+void to_json(nlohmann::json& j, CaptureRecord const& record);
+void from_json(nlohmann::json const& j, CaptureRecord& record);
+
+// Appends records to a capture file, one json document per line. It can be
+// shared by the connections of several sessions.
+//
+// The exchanges are written as they are, secrets included: the replies hold
+// the encrypted user keys and the provisional identity private keys, which
+// the TLS of the connection protects otherwise. Captures must be kept as
+// safe as the devices of their users.
+class CaptureWriter
+{
+public:
+  explicit CaptureWriter(std::string const& path);
+
+  // Writes the creation of a connection, which may never emit anything, and
+  // returns its index
+  std::size_t newConnection(bool canEmitBinary);
+  void write(CaptureRecord const& record);
+
+private:
+  std::mutex _mutex;
+  std::ofstream _file;
+  std::size_t _connectionCount = 0;
+};
+
+// The records of a capture file, by connection
+class Capture
+{
+public:
+  explicit Capture(std::string const& path);
+
+  std::size_t connectionCount() const;
+  std::vector<CaptureRecord> const& connection(std::size_t index) const;
+  bool canEmitBinary(std::size_t index) const;
+
+private:
+  struct Connection
+  {
+    // unset in the captures written before connections were recorded, it
+    // then tells whether the connection sent binary emits
+    std::optional<bool> canEmitBinary;
+    std::vector<CaptureRecord> records;
+  };
+
+  std::vector<Connection> _connections;
+};
+
+enum class ReplayTiming
+{
+  // every reply waits for the duration of the recorded emit
+  Original,
+  FullSpeed,
+};
+}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <Tanker/Network/AConnection.hpp>
+#include <Tanker/Network/Negotiation.hpp>
+
+#include <gsl-lite.hpp>
+#include <tconcurrent/coroutine.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Tanker
+{
+namespace Network
+{
+// Compresses the emits and their replies, once the server agreed to with a
+// "compression" emit, see Negotiation.hpp. Each emit is then sent as a
+// "compressed" binary emit, see CompressedEmit, and each side compresses the
+// payloads above the threshold it was given.
+//
+// The large replies are the block lists, where the json framing, the base64
+// and the trustchain ids repeated in each block compress well.
+class CompressingConnection : public AConnection
+{
+public:
+  struct Metrics
+  {
+    // the payloads sent and received compressed
+    std::uint64_t compressedPayloads;
+    std::uint64_t uncompressedBytes;
+    std::uint64_t compressedBytes;
+    // the payloads under the threshold, or that do not compress
+    std::uint64_t skippedPayloads;
+    std::chrono::nanoseconds compressionTime;
+    std::chrono::nanoseconds decompressionTime;
+
+    // uncompressedBytes / compressedBytes, 0 before the first compression
+    double ratio() const;
+  };
+
+  static constexpr std::size_t defaultThreshold = 1024;
+
+  explicit CompressingConnection(
+      ConnectionPtr connection,
+      std::size_t threshold = defaultThreshold,
+      std::chrono::milliseconds negotiationTimeout = defaultNegotiationTimeout);
+
+  bool isOpen() const override;
+  void connect() override;
+  void close() override;
+  std::string id() const override;
+
+  tc::cotask<std::string> emit(std::string const& eventName,
+                               std::string const& data) override;
+
+  bool canEmitBinary() const override;
+  tc::cotask<std::vector<std::uint8_t>> emitBinary(
+      std::string const& eventName,
+      std::vector<std::uint8_t> const& data) override;
+
+  void on(std::string const& message, Handler handler) override;
+
+  // Of all the compressing connections
+  static Metrics metrics();
+
+private:
+  enum class Negotiation
+  {
+    Unknown,
+    Negotiating,
+    Supported,
+    Unsupported,
+  };
+
+  ConnectionPtr _connection;
+  std::size_t const _threshold;
+  std::chrono::milliseconds const _negotiationTimeout;
+  // negotiated again after each reconnection
+  Negotiation _negotiation = Negotiation::Unknown;
+
+  tc::cotask<bool> useCompression();
+  tc::cotask<std::vector<std::uint8_t>> emitCompressed(
+      bool binary,
+      std::string const& eventName,
+      gsl::span<std::uint8_t const> data);
+};
+}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <gsl-lite.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Tanker
+{
+namespace Network
+{
+// The payloads of CompressingConnection: a method byte, then the payload as
+// is, or its varint size and its zlib stream
+enum class CompressionMethod : std::uint8_t
+{
+  None,
+  Deflate,
+};
+
+// The size announced by a compressed payload is checked before allocating:
+// it must be at most maxDecompressedSize, and at most maxDeflateRatio times
+// the size of the zlib stream, the best ratio deflate can achieve.
+constexpr std::size_t maxDecompressedSize = 64 * 1024 * 1024;
+constexpr std::size_t maxDeflateRatio = 1032;
+
+// Payloads smaller than threshold are not compressed, nor those that do not
+// get smaller or are larger than maxDecompressedSize
+std::vector<std::uint8_t> compressPayload(gsl::span<std::uint8_t const> payload,
+                                          std::size_t threshold);
+std::vector<std::uint8_t> decompressPayload(
+    gsl::span<std::uint8_t const> compressed);
+CompressionMethod compressionMethod(gsl::span<std::uint8_t const> compressed);
+
+// An emit sent through a "compressed" binary emit: a byte telling if it is a
+// binary emit, the varint size of its event name, its event name, then its
+// compressed data. The reply of the "compressed" emit is its compressed reply.
+struct CompressedEmit
+{
+  bool binary;
+  std::string eventName;
+  std::vector<std::uint8_t> compressedData;
+};
+
+std::vector<std::uint8_t> packCompressedEmit(CompressedEmit const& emit);
+CompressedEmit unpackCompressedEmit(gsl::span<std::uint8_t const> packed);
+}
+}
@@ -9,7 +9,9 @@
 
 #include <sio_client.h>
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace Tanker
 {
@@ -34,6 +36,11 @@ public:
   tc::cotask<std::string> emit(std::string const& eventName,
                                std::string const& data) override;
 
+  bool canEmitBinary() const override;
+  tc::cotask<std::vector<std::uint8_t>> emitBinary(
+      std::string const& eventName,
+      std::vector<std::uint8_t> const& data) override;
+
   void on(std::string const& message, AConnection::Handler handler) override;
 
 private:
@@ -1,16 +1,41 @@
 #pragma once
 
 #include <Tanker/Network/AConnection.hpp>
+#include <Tanker/Network/Capture.hpp>
 #include <Tanker/Network/SdkInfo.hpp>
 
+#include <cstddef>
+#include <functional>
+#include <string>
+
 namespace Tanker
 {
 namespace Network
 {
 struct ConnectionFactory
 {
+  using Creator = std::function<ConnectionPtr(std::string const& url)>;
+
   static ConnectionPtr create(std::string url, SdkInfo info);
   static ConnectionPtr create(std::string url, std::string context);
+
+  // Replaces the connections of the SDK sessions, created by the SdkInfo
+  // overload, e.g. with an in-process server. Admin connections are not
+  // affected. An empty creator restores the socket.io connections. Returns
+  // the handle of the creator for resetCreator().
+  static std::size_t setCreator(Creator creator);
+  // Restores the socket.io connections, unless another creator replaced the
+  // one of handle since
+  static void resetCreator(std::size_t handle);
+
+  // Writes the exchanges of the SDK sessions connections to a capture file,
+  // whatever created them, until stopRecording() is called. The capture holds
+  // secrets in plain text, see CaptureWriter.
+  static void record(std::string const& capturePath);
+  static void stopRecording();
+  // Sets a creator that replays the connections of a capture in the order
+  // they were created, and starts over after the last one
+  static void replay(std::string const& capturePath, ReplayTiming timing);
 };
 }
 }
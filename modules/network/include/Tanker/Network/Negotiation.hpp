@@ -0,0 +1,77 @@
+#pragma once
+
+#include <tconcurrent/async.hpp>
+#include <tconcurrent/async_wait.hpp>
+#include <tconcurrent/coroutine.hpp>
+#include <tconcurrent/promise.hpp>
+#include <tconcurrent/task_auto_canceler.hpp>
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace Tanker
+{
+namespace Network
+{
+// The optional features of the protocol are negotiated with an emit that
+// servers which do not know the feature may never reply to. The negotiation
+// then gives up after a timeout, and the feature is unsupported.
+inline constexpr std::chrono::milliseconds defaultNegotiationTimeout{5000};
+
+namespace detail
+{
+template <typename T>
+struct NegotiationState
+{
+  tc::promise<std::optional<T>> promise;
+  bool done = false;
+};
+}
+
+// Returns the reply of emit, or nullopt when it did not come before timeout.
+// The errors of emit are rethrown.
+template <typename T>
+tc::cotask<std::optional<T>> negotiate(
+    std::function<tc::cotask<T>()> const& emit,
+    std::chrono::milliseconds timeout)
+{
+  auto const state = std::make_shared<detail::NegotiationState<T>>();
+  auto future = state->promise.get_future();
+
+  tc::task_auto_canceler canceler;
+  canceler.add(tc::async_resumable([state, &emit]() -> tc::cotask<void> {
+    std::exception_ptr error;
+    try
+    {
+      auto reply = TC_AWAIT(emit());
+      if (!state->done)
+      {
+        state->done = true;
+        state->promise.set_value(std::move(reply));
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    if (error && !state->done)
+    {
+      state->done = true;
+      state->promise.set_exception(error);
+    }
+  }));
+  canceler.add(tc::async_resumable([state, timeout]() -> tc::cotask<void> {
+    TC_AWAIT(tc::async_wait(timeout));
+    if (state->done)
+      TC_RETURN();
+    state->done = true;
+    state->promise.set_value(std::nullopt);
+  }));
+  TC_RETURN(TC_AWAIT(std::move(future)));
+}
+}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Tanker/Network/AConnection.hpp>
+#include <Tanker/Network/Capture.hpp>
+
+#include <tconcurrent/coroutine.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace Tanker
+{
+namespace Network
+{
+// Forwards everything to another connection and writes the emits, their
+// replies and the received events to a capture
+class RecordingConnection : public AConnection
+{
+public:
+  RecordingConnection(ConnectionPtr connection,
+                      std::shared_ptr<CaptureWriter> writer);
+
+  bool isOpen() const override;
+  void connect() override;
+  void close() override;
+  std::string id() const override;
+
+  tc::cotask<std::string> emit(std::string const& eventName,
+                               std::string const& data) override;
+
+  bool canEmitBinary() const override;
+  tc::cotask<std::vector<std::uint8_t>> emitBinary(
+      std::string const& eventName,
+      std::vector<std::uint8_t> const& data) override;
+
+  void on(std::string const& message, Handler handler) override;
+
+private:
+  ConnectionPtr _connection;
+  std::shared_ptr<CaptureWriter> _writer;
+  std::size_t const _index;
+  std::chrono::steady_clock::time_point const _created;
+
+  std::chrono::microseconds sinceCreation() const;
+};
+}
+}
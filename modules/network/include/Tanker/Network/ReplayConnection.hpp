@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Tanker/Network/AConnection.hpp>
+#include <Tanker/Network/Capture.hpp>
+
+#include <tconcurrent/coroutine.hpp>
+#include <tconcurrent/task_auto_canceler.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Tanker
+{
+namespace Network
+{
+// Serves the replies of one connection of a capture, without a server.
+//
+// Emits get the reply of the first emit of the capture with the same event
+// name and kind, text or binary, that has not been served yet, so that
+// concurrent emits can complete in another order than when they were
+// recorded. The events received after an emit are delivered to the on()
+// handlers once that emit is served.
+class ReplayConnection : public AConnection
+{
+public:
+  ReplayConnection(std::shared_ptr<Capture const> capture,
+                   std::size_t connection,
+                   ReplayTiming timing);
+
+  bool isOpen() const override;
+  void connect() override;
+  void close() override;
+  std::string id() const override;
+
+  tc::cotask<std::string> emit(std::string const& eventName,
+                               std::string const& data) override;
+
+  bool canEmitBinary() const override;
+  tc::cotask<std::vector<std::uint8_t>> emitBinary(
+      std::string const& eventName,
+      std::vector<std::uint8_t> const& data) override;
+
+  void on(std::string const& message, Handler handler) override;
+
+private:
+  std::shared_ptr<Capture const> _capture;
+  std::vector<CaptureRecord> const& _records;
+  std::size_t const _connection;
+  ReplayTiming const _timing;
+  bool _open = false;
+  std::vector<bool> _served;
+  std::map<std::string, Handler> _handlers;
+  tc::task_auto_canceler _taskCanceler;
+
+  // marks the first emit of the capture that matches as served
+  std::size_t serve(std::string const& eventName, bool binary);
+  void deliverEventsFrom(std::size_t index);
+};
+}
+}
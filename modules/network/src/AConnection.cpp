@@ -0,0 +1,23 @@
+#include <Tanker/Network/AConnection.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+
+namespace Tanker
+{
+namespace Network
+{
+bool AConnection::canEmitBinary() const
+{
+  return false;
+}
+
+tc::cotask<std::vector<std::uint8_t>> AConnection::emitBinary(
+    std::string const& eventName, std::vector<std::uint8_t> const&)
+{
+  throw Errors::formatEx(Errors::Errc::InternalError,
+                         "this connection cannot emit binary data: {}",
+                         eventName);
+}
+}
+}
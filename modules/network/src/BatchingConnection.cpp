@@ -0,0 +1,224 @@
+#include <Tanker/Network/BatchingConnection.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+#include <Tanker/Log/Log.hpp>
+#include <Tanker/Network/Negotiation.hpp>
+
+#include <nlohmann/json.hpp>
+#include <tconcurrent/async.hpp>
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <utility>
+
+TLOG_CATEGORY(BatchingConnection);
+
+namespace Tanker
+{
+namespace Network
+{
+namespace
+{
+std::atomic<std::uint64_t> batchCount{0};
+std::atomic<std::uint64_t> batchedEmitCount{0};
+std::atomic<std::uint64_t> largestBatchSize{0};
+std::atomic<std::uint64_t> unbatchedEmitCount{0};
+
+void recordBatch(std::uint64_t size)
+{
+  batchCount.fetch_add(1, std::memory_order_relaxed);
+  batchedEmitCount.fetch_add(size, std::memory_order_relaxed);
+  auto largest = largestBatchSize.load(std::memory_order_relaxed);
+  while (largest < size && !largestBatchSize.compare_exchange_weak(
+                               largest, size, std::memory_order_relaxed))
+    ;
+}
+
+std::optional<std::vector<std::string>> parseReplies(std::string const& reply,
+                                                     std::size_t count)
+{
+  auto const json = nlohmann::json::parse(reply, nullptr, false);
+  if (!json.is_array() || json.size() != count)
+    return std::nullopt;
+  std::vector<std::string> replies;
+  replies.reserve(count);
+  for (auto const& item : json)
+  {
+    if (!item.is_string())
+      return std::nullopt;
+    replies.push_back(item.get<std::string>());
+  }
+  return replies;
+}
+}
+
+BatchingConnection::BatchingConnection(
+    ConnectionPtr connection, std::chrono::milliseconds negotiationTimeout)
+  : _connection(std::move(connection)), _negotiationTimeout(negotiationTimeout)
+{
+  _connection->connected = [this] {
+    if (connected)
+      connected();
+  };
+  _connection->reconnected = [this] {
+    if (reconnected)
+      reconnected();
+  };
+}
+
+bool BatchingConnection::isOpen() const
+{
+  return _connection->isOpen();
+}
+
+void BatchingConnection::connect()
+{
+  _connection->connect();
+}
+
+void BatchingConnection::close()
+{
+  _connection->close();
+}
+
+std::string BatchingConnection::id() const
+{
+  return _connection->id();
+}
+
+bool BatchingConnection::canEmitBinary() const
+{
+  return _connection->canEmitBinary();
+}
+
+// binary emits carry blocks, they are large enough to be sent alone
+tc::cotask<std::vector<std::uint8_t>> BatchingConnection::emitBinary(
+    std::string const& eventName, std::vector<std::uint8_t> const& data)
+{
+  TC_RETURN(TC_AWAIT(_connection->emitBinary(eventName, data)));
+}
+
+void BatchingConnection::on(std::string const& message, Handler handler)
+{
+  _connection->on(message, std::move(handler));
+}
+
+tc::cotask<std::string> BatchingConnection::emit(std::string const& eventName,
+                                                 std::string const& data)
+{
+  if (!_batchSupported)
+  {
+    unbatchedEmitCount.fetch_add(1, std::memory_order_relaxed);
+    TC_RETURN(TC_AWAIT(_connection->emit(eventName, data)));
+  }
+  tc::promise<std::string> promise;
+  auto future = promise.get_future();
+  _pending.push_back({eventName, data, std::move(promise)});
+  // the emits of the other coroutines that run in this tick join the batch
+  if (_pending.size() == 1)
+  {
+    _taskCanceler.add(tc::async_resumable(
+        [this]() -> tc::cotask<void> { TC_AWAIT(flush()); }));
+  }
+  TC_RETURN(TC_AWAIT(std::move(future)));
+}
+
+void BatchingConnection::emitAlone(PendingEmit pendingEmit)
+{
+  unbatchedEmitCount.fetch_add(1, std::memory_order_relaxed);
+  _taskCanceler.add(tc::async_resumable(
+      [this, pendingEmit = std::move(pendingEmit)]() mutable
+      -> tc::cotask<void> {
+        try
+        {
+          pendingEmit.promise.set_value(TC_AWAIT(
+              _connection->emit(pendingEmit.eventName, pendingEmit.data)));
+        }
+        catch (...)
+        {
+          pendingEmit.promise.set_exception(std::current_exception());
+        }
+      }));
+}
+
+tc::cotask<void> BatchingConnection::flush()
+{
+  auto batch = std::move(_pending);
+  _pending.clear();
+  if (batch.size() == 1 || !_batchSupported)
+  {
+    for (auto& pendingEmit : batch)
+      emitAlone(std::move(pendingEmit));
+    TC_RETURN();
+  }
+
+  auto request = nlohmann::json::array();
+  for (auto const& pendingEmit : batch)
+  {
+    request.push_back(
+        {{"event", pendingEmit.eventName}, {"data", pendingEmit.data}});
+  }
+  auto const data = request.dump();
+  std::function<tc::cotask<std::string>()> const emitBatch =
+      [&]() -> tc::cotask<std::string> {
+    TC_RETURN(TC_AWAIT(_connection->emit("batch", data)));
+  };
+  std::optional<std::string> reply;
+  std::exception_ptr error;
+  try
+  {
+    if (_batchConfirmed)
+      reply = TC_AWAIT(emitBatch());
+    else
+      reply = TC_AWAIT(negotiate(emitBatch, _negotiationTimeout));
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+  if (error)
+  {
+    for (auto& pendingEmit : batch)
+      pendingEmit.promise.set_exception(error);
+    TC_RETURN();
+  }
+
+  if (!reply)
+  {
+    // the server may still apply the batch, sending its emits again could
+    // apply them twice
+    TINFO("the server did not answer a batch, falling back to emits");
+    _batchSupported = false;
+    auto const timedOut = std::make_exception_ptr(Errors::formatEx(
+        Errors::Errc::NetworkError, "the server did not answer a batch"));
+    for (auto& pendingEmit : batch)
+      pendingEmit.promise.set_exception(timedOut);
+    TC_RETURN();
+  }
+  auto const replies = parseReplies(*reply, batch.size());
+  if (!replies)
+  {
+    TINFO("batches are not supported by the server, falling back to emits");
+    _batchSupported = false;
+    for (auto& pendingEmit : batch)
+      emitAlone(std::move(pendingEmit));
+    TC_RETURN();
+  }
+  _batchConfirmed = true;
+  recordBatch(batch.size());
+  for (auto i = 0u; i < batch.size(); ++i)
+    batch[i].promise.set_value((*replies)[i]);
+}
+
+BatchingConnection::Metrics BatchingConnection::metrics()
+{
+  return {batchCount.load(),
+          batchedEmitCount.load(),
+          largestBatchSize.load(),
+          unbatchedEmitCount.load()};
+}
+}
+}
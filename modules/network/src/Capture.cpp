@@ -0,0 +1,140 @@
+#include <Tanker/Network/Capture.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Tanker
+{
+namespace Network
+{
+// Short keys keep the captures of long sessions small, e.g.
+// {"cx":0,"emit":"get my user blocks","req":"...","rep":"[...]","t":12,"d":80}
+// The creation of a connection is {"cx":0,"new":{"bin":true}}.
+void to_json(nlohmann::json& j, CaptureRecord const& record)
+{
+  j["cx"] = record.connection;
+  j["t"] = record.start.count();
+  if (record.kind == CaptureRecord::Kind::Emit)
+  {
+    j["emit"] = record.eventName;
+    j["req"] = record.request;
+    j["d"] = record.duration.count();
+    if (record.binary)
+      j["bin"] = true;
+  }
+  else
+  {
+    j["on"] = record.eventName;
+  }
+  j["rep"] = record.reply;
+}
+
+void from_json(nlohmann::json const& j, CaptureRecord& record)
+{
+  record.connection = j.at("cx").get<std::size_t>();
+  record.start = std::chrono::microseconds{j.at("t").get<std::int64_t>()};
+  record.reply = j.at("rep").get<std::string>();
+  if (j.contains("emit"))
+  {
+    record.kind = CaptureRecord::Kind::Emit;
+    record.binary = j.value("bin", false);
+    record.eventName = j.at("emit").get<std::string>();
+    record.request = j.at("req").get<std::string>();
+    record.duration = std::chrono::microseconds{j.at("d").get<std::int64_t>()};
+  }
+  else
+  {
+    record.kind = CaptureRecord::Kind::Event;
+    record.binary = false;
+    record.eventName = j.at("on").get<std::string>();
+    record.request.clear();
+    record.duration = std::chrono::microseconds{0};
+  }
+}
+
+CaptureWriter::CaptureWriter(std::string const& path) : _file(path)
+{
+  if (!_file)
+  {
+    throw Errors::formatEx(
+        Errors::Errc::IOError, "cannot open capture file {}", path);
+  }
+}
+
+std::size_t CaptureWriter::newConnection(bool canEmitBinary)
+{
+  std::scoped_lock lock(_mutex);
+  auto const index = _connectionCount++;
+  _file << nlohmann::json{{"cx", index}, {"new", {{"bin", canEmitBinary}}}}
+        << '\n';
+  _file.flush();
+  return index;
+}
+
+void CaptureWriter::write(CaptureRecord const& record)
+{
+  auto const line = nlohmann::json(record).dump();
+  std::scoped_lock lock(_mutex);
+  _file << line << '\n';
+  // the capture must be usable even if the process is killed
+  _file.flush();
+}
+
+Capture::Capture(std::string const& path)
+{
+  std::ifstream file(path);
+  if (!file)
+  {
+    throw Errors::formatEx(
+        Errors::Errc::IOError, "cannot open capture file {}", path);
+  }
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line.empty())
+      continue;
+    auto const json = nlohmann::json::parse(line);
+    auto const index = json.at("cx").get<std::size_t>();
+    // the connections that never emitted are kept, replays create the
+    // connections in the same order as the capture
+    if (index >= _connections.size())
+      _connections.resize(index + 1);
+    auto& connection = _connections[index];
+    if (json.contains("new"))
+      connection.canEmitBinary = json.at("new").at("bin").get<bool>();
+    else
+      connection.records.push_back(json.get<CaptureRecord>());
+  }
+  if (_connections.empty())
+  {
+    throw Errors::formatEx(
+        Errors::Errc::InvalidArgument, "empty capture file {}", path);
+  }
+}
+
+std::size_t Capture::connectionCount() const
+{
+  return _connections.size();
+}
+
+std::vector<CaptureRecord> const& Capture::connection(std::size_t index) const
+{
+  return _connections.at(index).records;
+}
+
+bool Capture::canEmitBinary(std::size_t index) const
+{
+  auto const& connection = _connections.at(index);
+  if (connection.canEmitBinary)
+    return *connection.canEmitBinary;
+  return std::any_of(connection.records.begin(),
+                     connection.records.end(),
+                     [](auto const& record) { return record.binary; });
+}
+}
+}
@@ -0,0 +1,204 @@
+#include <Tanker/Network/CompressingConnection.hpp>
+
+#include <Tanker/Log/Log.hpp>
+#include <Tanker/Network/Compression.hpp>
+#include <Tanker/Network/Negotiation.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+TLOG_CATEGORY(CompressingConnection);
+
+namespace Tanker
+{
+namespace Network
+{
+namespace
+{
+std::atomic<std::uint64_t> compressedPayloadCount{0};
+std::atomic<std::uint64_t> uncompressedByteCount{0};
+std::atomic<std::uint64_t> compressedByteCount{0};
+std::atomic<std::uint64_t> skippedPayloadCount{0};
+std::atomic<std::int64_t> compressionNanoseconds{0};
+std::atomic<std::int64_t> decompressionNanoseconds{0};
+
+void recordPayload(std::size_t uncompressedSize,
+                   gsl::span<std::uint8_t const> compressed,
+                   std::atomic<std::int64_t>& nanoseconds,
+                   std::chrono::steady_clock::duration elapsed)
+{
+  nanoseconds.fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+      std::memory_order_relaxed);
+  if (compressionMethod(compressed) == CompressionMethod::None)
+  {
+    skippedPayloadCount.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  compressedPayloadCount.fetch_add(1, std::memory_order_relaxed);
+  uncompressedByteCount.fetch_add(uncompressedSize, std::memory_order_relaxed);
+  compressedByteCount.fetch_add(compressed.size(), std::memory_order_relaxed);
+}
+
+std::vector<std::uint8_t> compress(gsl::span<std::uint8_t const> payload,
+                                   std::size_t threshold)
+{
+  auto const before = std::chrono::steady_clock::now();
+  auto compressed = compressPayload(payload, threshold);
+  recordPayload(payload.size(),
+                compressed,
+                compressionNanoseconds,
+                std::chrono::steady_clock::now() - before);
+  return compressed;
+}
+
+std::vector<std::uint8_t> decompress(gsl::span<std::uint8_t const> compressed)
+{
+  auto const before = std::chrono::steady_clock::now();
+  auto payload = decompressPayload(compressed);
+  recordPayload(payload.size(),
+                compressed,
+                decompressionNanoseconds,
+                std::chrono::steady_clock::now() - before);
+  return payload;
+}
+}
+
+double CompressingConnection::Metrics::ratio() const
+{
+  if (compressedBytes == 0)
+    return 0;
+  return static_cast<double>(uncompressedBytes) / compressedBytes;
+}
+
+CompressingConnection::CompressingConnection(
+    ConnectionPtr connection,
+    std::size_t threshold,
+    std::chrono::milliseconds negotiationTimeout)
+  : _connection(std::move(connection)),
+    _threshold(threshold),
+    _negotiationTimeout(negotiationTimeout)
+{
+  _connection->connected = [this] {
+    if (connected)
+      connected();
+  };
+  _connection->reconnected = [this] {
+    // the server may have changed
+    _negotiation = Negotiation::Unknown;
+    if (reconnected)
+      reconnected();
+  };
+}
+
+bool CompressingConnection::isOpen() const
+{
+  return _connection->isOpen();
+}
+
+void CompressingConnection::connect()
+{
+  _connection->connect();
+}
+
+void CompressingConnection::close()
+{
+  _connection->close();
+}
+
+std::string CompressingConnection::id() const
+{
+  return _connection->id();
+}
+
+bool CompressingConnection::canEmitBinary() const
+{
+  return _connection->canEmitBinary();
+}
+
+void CompressingConnection::on(std::string const& message, Handler handler)
+{
+  _connection->on(message, std::move(handler));
+}
+
+tc::cotask<bool> CompressingConnection::useCompression()
+{
+  if (_negotiation == Negotiation::Unknown)
+  {
+    if (!_connection->canEmitBinary())
+      TC_RETURN(false);
+    // the emits made during the negotiation are not compressed
+    _negotiation = Negotiation::Negotiating;
+    auto const request =
+        nlohmann::json{{"methods", {"deflate"}}, {"threshold", _threshold}}
+            .dump();
+    std::optional<std::string> reply;
+    try
+    {
+      reply = TC_AWAIT(negotiate<std::string>(
+          [&]() -> tc::cotask<std::string> {
+            TC_RETURN(TC_AWAIT(_connection->emit("compression", request)));
+          },
+          _negotiationTimeout));
+    }
+    catch (...)
+    {
+      _negotiation = Negotiation::Unknown;
+      throw;
+    }
+    // servers that do not know the event reply with an error, or not at all
+    auto const json = reply ? nlohmann::json::parse(*reply, nullptr, false) :
+                              nlohmann::json();
+    auto const supported =
+        json.is_object() && json.value("compression", "") == "deflate";
+    if (!supported)
+      TINFO("compression is not supported by the server");
+    _negotiation =
+        supported ? Negotiation::Supported : Negotiation::Unsupported;
+  }
+  TC_RETURN(_negotiation == Negotiation::Supported);
+}
+
+tc::cotask<std::vector<std::uint8_t>> CompressingConnection::emitCompressed(
+    bool binary,
+    std::string const& eventName,
+    gsl::span<std::uint8_t const> data)
+{
+  auto const reply = TC_AWAIT(_connection->emitBinary(
+      "compressed",
+      packCompressedEmit({binary, eventName, compress(data, _threshold)})));
+  TC_RETURN(decompress(reply));
+}
+
+tc::cotask<std::string> CompressingConnection::emit(
+    std::string const& eventName, std::string const& data)
+{
+  if (!TC_AWAIT(useCompression()))
+    TC_RETURN(TC_AWAIT(_connection->emit(eventName, data)));
+  auto const reply = TC_AWAIT(emitCompressed(
+      false, eventName, gsl::make_span(data).as_span<std::uint8_t const>()));
+  TC_RETURN(std::string(reply.begin(), reply.end()));
+}
+
+tc::cotask<std::vector<std::uint8_t>> CompressingConnection::emitBinary(
+    std::string const& eventName, std::vector<std::uint8_t> const& data)
+{
+  if (!TC_AWAIT(useCompression()))
+    TC_RETURN(TC_AWAIT(_connection->emitBinary(eventName, data)));
+  TC_RETURN(TC_AWAIT(emitCompressed(true, eventName, data)));
+}
+
+CompressingConnection::Metrics CompressingConnection::metrics()
+{
+  return {compressedPayloadCount.load(),
+          uncompressedByteCount.load(),
+          compressedByteCount.load(),
+          skippedPayloadCount.load(),
+          std::chrono::nanoseconds{compressionNanoseconds.load()},
+          std::chrono::nanoseconds{decompressionNanoseconds.load()}};
+}
+}
+}
@@ -0,0 +1,131 @@
+#include <Tanker/Network/Compression.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+#include <Tanker/Serialization/Varint.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+
+namespace Tanker
+{
+namespace Network
+{
+namespace
+{
+std::vector<std::uint8_t> uncompressed(gsl::span<std::uint8_t const> payload)
+{
+  std::vector<std::uint8_t> compressed(1 + payload.size());
+  compressed[0] = static_cast<std::uint8_t>(CompressionMethod::None);
+  std::copy(payload.begin(), payload.end(), compressed.begin() + 1);
+  return compressed;
+}
+}
+
+std::vector<std::uint8_t> compressPayload(gsl::span<std::uint8_t const> payload,
+                                          std::size_t threshold)
+{
+  if (static_cast<std::size_t>(payload.size()) < threshold ||
+      static_cast<std::size_t>(payload.size()) > maxDecompressedSize)
+    return uncompressed(payload);
+
+  auto const headerSize = 1 + Serialization::varint_size(payload.size());
+  auto streamSize = compressBound(payload.size());
+  std::vector<std::uint8_t> compressed(headerSize + streamSize);
+  compressed[0] = static_cast<std::uint8_t>(CompressionMethod::Deflate);
+  Serialization::varint_write(compressed.data() + 1, payload.size());
+  if (compress2(compressed.data() + headerSize,
+                &streamSize,
+                payload.data(),
+                payload.size(),
+                Z_DEFAULT_COMPRESSION) != Z_OK)
+  {
+    throw Errors::Exception(Errors::Errc::InternalError,
+                            "could not compress a payload");
+  }
+  // sealed keys and signatures are random bytes
+  if (headerSize + streamSize >= static_cast<std::size_t>(payload.size()) + 1)
+    return uncompressed(payload);
+  compressed.resize(headerSize + streamSize);
+  return compressed;
+}
+
+CompressionMethod compressionMethod(gsl::span<std::uint8_t const> compressed)
+{
+  if (compressed.empty())
+  {
+    throw Errors::Exception(Errors::Errc::InvalidArgument,
+                            "empty compressed payload");
+  }
+  switch (static_cast<CompressionMethod>(compressed[0]))
+  {
+  case CompressionMethod::None:
+    return CompressionMethod::None;
+  case CompressionMethod::Deflate:
+    return CompressionMethod::Deflate;
+  }
+  throw Errors::formatEx(Errors::Errc::InvalidArgument,
+                         "unknown compression method: {}",
+                         compressed[0]);
+}
+
+std::vector<std::uint8_t> decompressPayload(
+    gsl::span<std::uint8_t const> compressed)
+{
+  if (compressionMethod(compressed) == CompressionMethod::None)
+    return {compressed.begin() + 1, compressed.end()};
+
+  auto const [size, stream] = Serialization::varint_read(compressed.subspan(1));
+  if (size > maxDecompressedSize ||
+      size > static_cast<std::size_t>(stream.size()) * maxDeflateRatio)
+  {
+    throw Errors::formatEx(Errors::Errc::InternalError,
+                           "compressed payload announces {} bytes out of {}",
+                           size,
+                           stream.size());
+  }
+  std::vector<std::uint8_t> payload(size);
+  uLongf payloadSize = payload.size();
+  if (uncompress(payload.data(), &payloadSize, stream.data(), stream.size()) !=
+          Z_OK ||
+      payloadSize != payload.size())
+  {
+    throw Errors::Exception(Errors::Errc::InvalidArgument,
+                            "corrupted compressed payload");
+  }
+  return payload;
+}
+
+std::vector<std::uint8_t> packCompressedEmit(CompressedEmit const& emit)
+{
+  std::vector<std::uint8_t> packed(
+      1 + Serialization::varint_size(emit.eventName.size()) +
+      emit.eventName.size() + emit.compressedData.size());
+  packed[0] = emit.binary;
+  auto it =
+      Serialization::varint_write(packed.data() + 1, emit.eventName.size());
+  it = std::copy(emit.eventName.begin(), emit.eventName.end(), it);
+  std::copy(emit.compressedData.begin(), emit.compressedData.end(), it);
+  return packed;
+}
+
+CompressedEmit unpackCompressedEmit(gsl::span<std::uint8_t const> packed)
+{
+  if (packed.empty())
+  {
+    throw Errors::Exception(Errors::Errc::InvalidArgument,
+                            "empty compressed emit");
+  }
+  auto const [nameSize, rest] = Serialization::varint_read(packed.subspan(1));
+  if (static_cast<std::size_t>(rest.size()) < nameSize)
+  {
+    throw Errors::Exception(Errors::Errc::InvalidArgument,
+                            "truncated compressed emit");
+  }
+  return {packed[0] != 0,
+          std::string(rest.begin(), rest.begin() + nameSize),
+          std::vector<std::uint8_t>(rest.begin() + nameSize, rest.end())};
+}
+}
+}
@@ -13,6 +13,7 @@
 #include <tconcurrent/promise.hpp>
 
 #include <exception>
+#include <memory>
 #include <utility>
 
 #include <Tanker/Tracer/FuncTracer.hpp>
@@ -158,5 +159,45 @@ tc::cotask<std::string> Connection::emit(std::string const& eventName,
       });
   TC_RETURN(TC_AWAIT(std::move(future)));
 }
+
+bool Connection::canEmitBinary() const
+{
+  return true;
+}
+
+tc::cotask<std::vector<std::uint8_t>> Connection::emitBinary(
+    std::string const& eventName, std::vector<std::uint8_t> const& data)
+{
+  SCOPE_TIMER(fmt::format("emit binary {}", eventName), Net);
+  TDEBUG("{}::emitBinary({}, {} bytes)",
+         _client.get_sessionid(),
+         eventName,
+         data.size());
+  tc::promise<std::vector<std::uint8_t>> prom;
+  auto future = prom.get_future();
+  this->_client.socket()->emit(
+      eventName,
+      sio::message::list(sio::binary_message::create(
+          std::make_shared<std::string const>(data.begin(), data.end()))),
+      [prom = std::move(prom)](sio::message::list const& msg) mutable {
+        try
+        {
+          std::shared_ptr<std::string const> reply;
+          if (msg.size() > 0 && msg[0]->get_flag() == sio::message::flag_binary)
+            reply = msg[0]->get_binary();
+          else if (msg.size() > 0 &&
+                   msg[0]->get_flag() == sio::message::flag_string)
+            reply = std::make_shared<std::string const>(msg[0]->get_string());
+          prom.set_value(reply ? std::vector<std::uint8_t>(reply->begin(),
+                                                           reply->end()) :
+                                 std::vector<std::uint8_t>{});
+        }
+        catch (...)
+        {
+          prom.set_exception(std::current_exception());
+        }
+      });
+  TC_RETURN(TC_AWAIT(std::move(future)));
+}
 }
 }
@@ -1,24 +1,53 @@
 #include <Tanker/Network/ConnectionFactory.hpp>
 
+#include <Tanker/Network/RecordingConnection.hpp>
+#include <Tanker/Network/ReplayConnection.hpp>
 #ifndef EMSCRIPTEN
 #include <Tanker/Network/Connection.hpp>
 #else
 #include <Tanker/Network/JsConnection.hpp>
 #endif
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 namespace Tanker
 {
 namespace Network
 {
-ConnectionPtr ConnectionFactory::create(std::string url,
-                                        SdkInfo info)
+namespace
 {
+std::mutex creatorMutex;
+ConnectionFactory::Creator creator;
+std::size_t creatorHandle = 0;
+std::shared_ptr<CaptureWriter> recorder;
+
+ConnectionPtr createSdkConnection(std::string url, SdkInfo info)
+{
+  {
+    std::scoped_lock lock(creatorMutex);
+    if (creator)
+      return creator(url);
+  }
 #ifndef EMSCRIPTEN
   return std::make_unique<Connection>(std::move(url), std::move(info));
 #else
   return std::make_unique<JsConnection>(url);
 #endif
 }
+}
+
+ConnectionPtr ConnectionFactory::create(std::string url,
+                                        SdkInfo info)
+{
+  auto connection = createSdkConnection(std::move(url), std::move(info));
+  std::scoped_lock lock(creatorMutex);
+  if (recorder)
+    return std::make_unique<RecordingConnection>(std::move(connection),
+                                                 recorder);
+  return connection;
+}
 
 ConnectionPtr ConnectionFactory::create(std::string url,
                                         std::string context)
@@ -29,5 +58,45 @@ ConnectionPtr ConnectionFactory::create(std::string url,
   return std::make_unique<JsConnection>(url);
 #endif
 }
+
+std::size_t ConnectionFactory::setCreator(Creator newCreator)
+{
+  std::scoped_lock lock(creatorMutex);
+  creator = std::move(newCreator);
+  return ++creatorHandle;
+}
+
+void ConnectionFactory::resetCreator(std::size_t handle)
+{
+  std::scoped_lock lock(creatorMutex);
+  if (handle != creatorHandle)
+    return;
+  creator = nullptr;
+  ++creatorHandle;
+}
+
+void ConnectionFactory::record(std::string const& capturePath)
+{
+  auto writer = std::make_shared<CaptureWriter>(capturePath);
+  std::scoped_lock lock(creatorMutex);
+  recorder = std::move(writer);
+}
+
+void ConnectionFactory::stopRecording()
+{
+  std::scoped_lock lock(creatorMutex);
+  recorder.reset();
+}
+
+void ConnectionFactory::replay(std::string const& capturePath,
+                               ReplayTiming timing)
+{
+  auto const capture = std::make_shared<Capture const>(capturePath);
+  auto const created = std::make_shared<std::atomic<std::size_t>>(0);
+  setCreator([=](std::string const&) {
+    return std::make_unique<ReplayConnection>(
+        capture, (*created)++ % capture->connectionCount(), timing);
+  });
+}
 }
 }
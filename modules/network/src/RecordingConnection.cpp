@@ -0,0 +1,107 @@
+#include <Tanker/Network/RecordingConnection.hpp>
+
+#include <Tanker/Encoding/Base64.hpp>
+
+#include <utility>
+
+namespace Tanker
+{
+namespace Network
+{
+RecordingConnection::RecordingConnection(ConnectionPtr connection,
+                                         std::shared_ptr<CaptureWriter> writer)
+  : _connection(std::move(connection)),
+    _writer(std::move(writer)),
+    _index(_writer->newConnection(_connection->canEmitBinary())),
+    _created(std::chrono::steady_clock::now())
+{
+  _connection->connected = [this] {
+    if (connected)
+      connected();
+  };
+  _connection->reconnected = [this] {
+    if (reconnected)
+      reconnected();
+  };
+}
+
+bool RecordingConnection::isOpen() const
+{
+  return _connection->isOpen();
+}
+
+void RecordingConnection::connect()
+{
+  _connection->connect();
+}
+
+void RecordingConnection::close()
+{
+  _connection->close();
+}
+
+std::string RecordingConnection::id() const
+{
+  return _connection->id();
+}
+
+std::chrono::microseconds RecordingConnection::sinceCreation() const
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - _created);
+}
+
+tc::cotask<std::string> RecordingConnection::emit(std::string const& eventName,
+                                                  std::string const& data)
+{
+  auto const start = sinceCreation();
+  auto reply = TC_AWAIT(_connection->emit(eventName, data));
+  _writer->write({CaptureRecord::Kind::Emit,
+                  false,
+                  _index,
+                  eventName,
+                  data,
+                  reply,
+                  start,
+                  sinceCreation() - start});
+  TC_RETURN(std::move(reply));
+}
+
+bool RecordingConnection::canEmitBinary() const
+{
+  return _connection->canEmitBinary();
+}
+
+tc::cotask<std::vector<std::uint8_t>> RecordingConnection::emitBinary(
+    std::string const& eventName, std::vector<std::uint8_t> const& data)
+{
+  auto const start = sinceCreation();
+  auto reply = TC_AWAIT(_connection->emitBinary(eventName, data));
+  _writer->write({CaptureRecord::Kind::Emit,
+                  true,
+                  _index,
+                  eventName,
+                  Encoding::base64Encode(data),
+                  Encoding::base64Encode(reply),
+                  start,
+                  sinceCreation() - start});
+  TC_RETURN(std::move(reply));
+}
+
+void RecordingConnection::on(std::string const& message, Handler handler)
+{
+  _connection->on(
+      message, [this, message, handler = std::move(handler)](auto const& data) {
+        _writer->write({CaptureRecord::Kind::Event,
+                        false,
+                        _index,
+                        message,
+                        {},
+                        data,
+                        sinceCreation(),
+                        std::chrono::microseconds{0}});
+        handler(data);
+      });
+}
+}
+}
@@ -0,0 +1,131 @@
+#include <Tanker/Network/ReplayConnection.hpp>
+
+#include <Tanker/Encoding/Base64.hpp>
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+#include <Tanker/Log/Log.hpp>
+
+#include <fmt/format.h>
+#include <tconcurrent/async.hpp>
+#include <tconcurrent/async_wait.hpp>
+
+#include <exception>
+#include <utility>
+
+TLOG_CATEGORY(ReplayConnection);
+
+namespace Tanker
+{
+namespace Network
+{
+ReplayConnection::ReplayConnection(std::shared_ptr<Capture const> capture,
+                                   std::size_t connection,
+                                   ReplayTiming timing)
+  : _capture(std::move(capture)),
+    _records(_capture->connection(connection)),
+    _connection(connection),
+    _timing(timing),
+    _served(_records.size(), false)
+{
+}
+
+bool ReplayConnection::isOpen() const
+{
+  return _open;
+}
+
+void ReplayConnection::connect()
+{
+  _open = true;
+  if (connected)
+    connected();
+  deliverEventsFrom(0);
+}
+
+void ReplayConnection::close()
+{
+  _open = false;
+}
+
+std::string ReplayConnection::id() const
+{
+  return fmt::format("replay-{}", _connection);
+}
+
+std::size_t ReplayConnection::serve(std::string const& eventName, bool binary)
+{
+  std::size_t index = 0;
+  while (index < _records.size() &&
+         (_served[index] || _records[index].kind != CaptureRecord::Kind::Emit ||
+          _records[index].binary != binary ||
+          _records[index].eventName != eventName))
+    ++index;
+  if (index == _records.size())
+  {
+    throw Errors::formatEx(Errors::Errc::InternalError,
+                           "replay diverged from the capture: no emit {} left "
+                           "on connection {}",
+                           eventName,
+                           _connection);
+  }
+  _served[index] = true;
+  return index;
+}
+
+tc::cotask<std::string> ReplayConnection::emit(std::string const& eventName,
+                                               std::string const&)
+{
+  auto const index = serve(eventName, false);
+  auto const& record = _records[index];
+  if (_timing == ReplayTiming::Original && record.duration.count())
+    TC_AWAIT(tc::async_wait(record.duration));
+  deliverEventsFrom(index + 1);
+  TC_RETURN(record.reply);
+}
+
+bool ReplayConnection::canEmitBinary() const
+{
+  return _capture->canEmitBinary(_connection);
+}
+
+tc::cotask<std::vector<std::uint8_t>> ReplayConnection::emitBinary(
+    std::string const& eventName, std::vector<std::uint8_t> const&)
+{
+  auto const index = serve(eventName, true);
+  auto const& record = _records[index];
+  if (_timing == ReplayTiming::Original && record.duration.count())
+    TC_AWAIT(tc::async_wait(record.duration));
+  deliverEventsFrom(index + 1);
+  TC_RETURN(Encoding::base64Decode(record.reply));
+}
+
+void ReplayConnection::deliverEventsFrom(std::size_t index)
+{
+  for (; index < _records.size() &&
+         _records[index].kind == CaptureRecord::Kind::Event;
+       ++index)
+  {
+    auto const& record = _records[index];
+    auto const handlerIt = _handlers.find(record.eventName);
+    if (handlerIt == _handlers.end())
+      continue;
+    _taskCanceler.add(
+        tc::async([handler = handlerIt->second, data = record.reply] {
+          try
+          {
+            handler(data);
+          }
+          catch (std::exception const& e)
+          {
+            TERROR("Error in handling replayed signal: {}", e.what());
+          }
+        }));
+  }
+}
+
+void ReplayConnection::on(std::string const& message, Handler handler)
+{
+  _handlers[message] = std::move(handler);
+}
+}
+}
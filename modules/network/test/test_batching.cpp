@@ -0,0 +1,151 @@
+#include <Tanker/Network/BatchingConnection.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+
+#include <Helpers/Errors.hpp>
+
+#include <doctest.h>
+
+#include <nlohmann/json.hpp>
+#include <tconcurrent/async.hpp>
+#include <tconcurrent/async_wait.hpp>
+#include <tconcurrent/when.hpp>
+
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Tanker;
+using namespace std::chrono_literals;
+
+namespace
+{
+// Echoes the emits. It answers the batches with the data of their emits, or
+// does not know them and replies with an error, or never replies to them.
+class EchoConnection : public Network::AConnection
+{
+public:
+  bool isOpen() const override
+  {
+    return true;
+  }
+
+  void connect() override
+  {
+  }
+
+  void close() override
+  {
+  }
+
+  std::string id() const override
+  {
+    return "echo";
+  }
+
+  tc::cotask<std::string> emit(std::string const& eventName,
+                               std::string const& data) override
+  {
+    ++emitCount;
+    if (eventName == "batch")
+    {
+      if (answersBatches)
+      {
+        auto replies = nlohmann::json::array();
+        for (auto const& emit : nlohmann::json::parse(data))
+          replies.push_back(emit.at("data"));
+        TC_RETURN(replies.dump());
+      }
+      if (ignoresBatches)
+        TC_AWAIT(tc::async_wait(24h));
+      TC_RETURN(R"({"error":{"code":"internal_error","message":""}})");
+    }
+    TC_RETURN(data);
+  }
+
+  void on(std::string const&, Handler) override
+  {
+  }
+
+  int emitCount = 0;
+  bool answersBatches = false;
+  bool ignoresBatches = false;
+};
+
+// Emits all the events in the same tick
+std::vector<std::string> emitTogether(Network::AConnection& connection,
+                                      std::vector<std::string> const& events)
+{
+  return tc::async_resumable([&]() -> tc::cotask<std::vector<std::string>> {
+           std::vector<tc::future<std::string>> futures;
+           for (auto const& event : events)
+           {
+             futures.push_back(
+                 tc::async_resumable([&]() -> tc::cotask<std::string> {
+                   TC_RETURN(TC_AWAIT(connection.emit(event, event)));
+                 }));
+           }
+           auto done = TC_AWAIT(tc::when_all(std::make_move_iterator(
+                                                 futures.begin()),
+                                             std::make_move_iterator(
+                                                 futures.end())));
+           std::vector<std::string> replies;
+           for (auto& future : done)
+             replies.push_back(future.get());
+           TC_RETURN(replies);
+         })
+      .get();
+}
+}
+
+TEST_CASE("emits of the same tick are batched")
+{
+  auto echo = std::make_unique<EchoConnection>();
+  echo->answersBatches = true;
+  auto const& echoRef = *echo;
+  Network::BatchingConnection connection(std::move(echo));
+
+  auto const before = Network::BatchingConnection::metrics();
+  CHECK(emitTogether(connection, {"a", "b", "c"}) ==
+        std::vector<std::string>{"a", "b", "c"});
+  auto const after = Network::BatchingConnection::metrics();
+
+  CHECK(echoRef.emitCount == 1);
+  CHECK(after.batches == before.batches + 1);
+  CHECK(after.batchedEmits == before.batchedEmits + 3);
+  CHECK(after.largestBatch >= 3);
+}
+
+TEST_CASE("batches fall back to emits when the server does not support them")
+{
+  auto echo = std::make_unique<EchoConnection>();
+  auto const& echoRef = *echo;
+  Network::BatchingConnection connection(std::move(echo));
+
+  CHECK(emitTogether(connection, {"a", "b"}) ==
+        std::vector<std::string>{"a", "b"});
+  // the batch, then each emit
+  CHECK(echoRef.emitCount == 3);
+
+  CHECK(emitTogether(connection, {"c", "d"}) ==
+        std::vector<std::string>{"c", "d"});
+  CHECK(echoRef.emitCount == 5);
+}
+
+TEST_CASE("batching stops when the server never answers a batch")
+{
+  auto echo = std::make_unique<EchoConnection>();
+  echo->ignoresBatches = true;
+  auto const& echoRef = *echo;
+  Network::BatchingConnection connection(std::move(echo), 50ms);
+
+  // the emits of the unanswered batch are not sent again
+  TANKER_CHECK_THROWS_WITH_CODE(emitTogether(connection, {"a", "b"}),
+                                Errors::Errc::NetworkError);
+  CHECK(echoRef.emitCount == 1);
+  CHECK(emitTogether(connection, {"c", "d"}) ==
+        std::vector<std::string>{"c", "d"});
+  CHECK(echoRef.emitCount == 3);
+}
@@ -0,0 +1,46 @@
+#include <Tanker/Network/Compression.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Serialization/Varint.hpp>
+
+#include <Helpers/Errors.hpp>
+
+#include <doctest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Tanker;
+
+TEST_CASE("payloads under the threshold are not compressed")
+{
+  std::vector<std::uint8_t> const payload(2000, 'a');
+
+  auto const small = Network::compressPayload(payload, payload.size() + 1);
+  CHECK(Network::compressionMethod(small) == Network::CompressionMethod::None);
+  CHECK(Network::decompressPayload(small) == payload);
+
+  auto const compressed = Network::compressPayload(payload, payload.size());
+  CHECK(Network::compressionMethod(compressed) ==
+        Network::CompressionMethod::Deflate);
+  CHECK(compressed.size() < payload.size());
+  CHECK(Network::decompressPayload(compressed) == payload);
+}
+
+TEST_CASE("payloads announcing too large a size are not decompressed")
+{
+  auto const forge = [](std::uint32_t size) {
+    std::vector<std::uint8_t> forged(1 + Serialization::varint_size(size) + 16);
+    forged[0] = static_cast<std::uint8_t>(Network::CompressionMethod::Deflate);
+    Serialization::varint_write(forged.data() + 1, size);
+    return forged;
+  };
+
+  TANKER_CHECK_THROWS_WITH_CODE(
+      Network::decompressPayload(forge(Network::maxDecompressedSize + 1)),
+      Errors::Errc::InternalError);
+  // more than deflate can achieve from 16 bytes
+  TANKER_CHECK_THROWS_WITH_CODE(
+      Network::decompressPayload(forge(1024 * 1024)),
+      Errors::Errc::InternalError);
+}
@@ -47,6 +47,20 @@ enum tanker_log_level
   TANKER_LOG_ERROR,
 };
 
+enum tanker_resource_key_backend
+{
+  /*! The resource keys are kept in the session database. */
+  TANKER_RESOURCE_KEY_BACKEND_DATABASE,
+  /*!
+   * The resource keys are kept in a memory-mapped log next to the session
+   * database, for devices holding millions of keys. Ignored when
+   * writable_path is ":ephemeral:".
+   */
+  TANKER_RESOURCE_KEY_BACKEND_MAPPED_LOG,
+
+  TANKER_RESOURCE_KEY_BACKEND_LAST
+};
+
 typedef struct tanker tanker_t;
 typedef struct tanker_options tanker_options_t;
 typedef struct tanker_email_verification tanker_email_verification_t;
@@ -122,14 +136,32 @@ struct tanker_options
   uint8_t version;
   char const* app_id;        /*!< Must not be NULL. */
   char const* url;           /*!< Must not be NULL. */
-  char const* writable_path; /*!< Must not be NULL. */
+  /*! Must not be NULL. ":ephemeral:" keeps everything in memory. */
+  char const* writable_path;
   char const* sdk_type;      /*!< Must not be NULL. */
   char const* sdk_version;   /*!< Must not be NULL. */
+  /*!
+   * It takes a value from the enum tanker_resource_key_backend. Only read
+   * since version 3, version 2 always uses the database.
+   */
+  uint8_t resource_key_backend;
+  /*!
+   * The number of connections to the server, 0 means 1. This field and the
+   * following ones are only read since version 4.
+   */
+  uint8_t connection_pool_size;
+  uint8_t batching;      /*!< Non-zero to batch the requests. */
+  uint8_t compression;   /*!< Non-zero to compress the large requests. */
+  uint8_t binary_blocks; /*!< Non-zero to receive the blocks in binary. */
+  uint8_t subscriptions; /*!< Non-zero to be notified of user changes. */
+  /*! How long to wait for the server to accept a feature, 0 means 5000. */
+  uint32_t negotiation_timeout_ms;
 };
 
-#define TANKER_OPTIONS_INIT         \
-  {                                 \
-    2, NULL, NULL, NULL, NULL, NULL \
+#define TANKER_OPTIONS_INIT                                                \
+  {                                                                        \
+    4, NULL, NULL, NULL, NULL, NULL, TANKER_RESOURCE_KEY_BACKEND_DATABASE, \
+        0, 0, 0, 0, 0, 0                                                   \
   }
 
 struct tanker_email_verification
@@ -454,6 +486,20 @@ CTANKER_EXPORT tanker_future_t* tanker_decrypt(tanker_t* session,
                                                uint8_t const* data,
                                                uint64_t data_size);
 
+/*!
+ * Same as tanker_decrypt, for the calls that need no I/O: the resource key
+ * was used recently and \p data is not in a streaming format.
+ *
+ * \return An already ready expected. Its value is 1, cast to a void*, when
+ * \p decrypted_data holds the clear data. It is NULL when decrypting would
+ * block: nothing was written and tanker_decrypt must be used instead.
+ * \throws TANKER_ERROR_DECRYPTION_FAILED The buffer was corrupt or truncated
+ */
+CTANKER_EXPORT tanker_expected_t* tanker_decrypt_sync(tanker_t* session,
+                                                      uint8_t* decrypted_data,
+                                                      uint8_t const* data,
+                                                      uint64_t data_size);
+
 /*!
  * Share a symetric key of an encrypted data with other users.
  *
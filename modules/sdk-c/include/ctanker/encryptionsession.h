@@ -80,6 +80,23 @@ CTANKER_EXPORT tanker_future_t* tanker_encryption_session_encrypt(
     uint8_t const* data,
     uint64_t data_size);
 
+/*!
+ * Same as tanker_encryption_session_encrypt, without a future: the data is
+ * encrypted before the call returns.
+ *
+ * An encryption session needs no I/O to encrypt, so this call never blocks and
+ * never has to fall back to tanker_encryption_session_encrypt.
+ *
+ * \return An already ready expected of NULL.
+ * \throws TANKER_ERROR_PRECONDITION_FAILED the tanker session of \p session
+ * was stopped
+ */
+CTANKER_EXPORT tanker_expected_t* tanker_encryption_session_encrypt_sync(
+    tanker_encryption_session_t* session,
+    uint8_t* encrypted_data,
+    uint8_t const* data,
+    uint64_t data_size);
+
 /*!
  * Create an encryption stream for an encryption session
  * Use this stream with the tanker_stream_* APIs
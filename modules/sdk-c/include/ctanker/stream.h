@@ -14,6 +14,30 @@ extern "C" {
 typedef struct tanker_stream tanker_stream_t;
 typedef struct tanker_stream_read_operation tanker_stream_read_operation_t;
 
+enum tanker_stream_flags
+{
+  /*!
+   * The input callback is called inline, inside the coroutine that reads
+   * the stream on Tanker's thread, instead of being scheduled as a separate
+   * task. A callback that calls tanker_stream_read_operation_finish before
+   * returning completes the read without a context switch.
+   *
+   * Since it runs in a coroutine, such a callback:
+   * - must not block, nor wait for a tanker_future_t, which would deadlock
+   * - must not use much stack
+   * - must not call code that does not support running on a coroutine
+   *   stack, like some Android JNI calls
+   * It may still call tanker_stream_read_operation_finish later, from any
+   * thread, to complete the read asynchronously.
+   *
+   * tanker_stream_read also returns an already completed future when the
+   * read can be served from the stream's buffered output, the input callback
+   * is not called then. A read must not be started before the previous one
+   * completed.
+   */
+  TANKER_STREAM_SYNCHRONOUS_INPUT = 1 << 0,
+};
+
 /*!
  * Function pointer called whenever a tanker streams need to read input.
  *
@@ -46,6 +70,27 @@ CTANKER_EXPORT tanker_future_t* tanker_stream_encrypt(
     void* additional_data,
     tanker_encrypt_options_t const* options);
 
+/*!
+ * Create an encryption stream
+ *
+ * \param tanker A tanker_t* instance
+ * \param cb The input callback
+ * \param additional_data Additional data to give to cb
+ * \param options The encryption options
+ * \param flags A combination of the values of the enum tanker_stream_flags,
+ * see TANKER_STREAM_SYNCHRONOUS_INPUT for the constraints it puts on cb
+ *
+ * \pre tanker_status == TANKER_STATUS_READY
+ *
+ * \return A new stream encryptor, to be closed with tanker_stream_close
+ */
+CTANKER_EXPORT tanker_future_t* tanker_stream_encrypt_with_flags(
+    tanker_t* tanker,
+    tanker_stream_input_source_t cb,
+    void* additional_data,
+    tanker_encrypt_options_t const* options,
+    uint32_t flags);
+
 /*!
  * Create a decryption stream
  *
@@ -59,6 +104,24 @@ CTANKER_EXPORT tanker_future_t* tanker_stream_encrypt(
 CTANKER_EXPORT tanker_future_t* tanker_stream_decrypt(
     tanker_t* tanker, tanker_stream_input_source_t cb, void* additional_data);
 
+/*!
+ * Create a decryption stream
+ *
+ * \param tanker A tanker_t* instance
+ * \param cb The input callback
+ * \param additional_data Additional data to give to cb
+ * \param flags A combination of the values of the enum tanker_stream_flags,
+ * see TANKER_STREAM_SYNCHRONOUS_INPUT for the constraints it puts on cb
+ *
+ * \pre tanker_status == TANKER_STATUS_READY
+ * \return A new stream decryptor, to be closed with tanker_stream_close
+ */
+CTANKER_EXPORT tanker_future_t* tanker_stream_decrypt_with_flags(
+    tanker_t* tanker,
+    tanker_stream_input_source_t cb,
+    void* additional_data,
+    uint32_t flags);
+
 /*!
  * Finish a read operation
  *
@@ -86,6 +149,9 @@ CTANKER_EXPORT void tanker_stream_read_operation_finish(
  *
  * This avoids waiting for the user's buffer to perform a read
  *
+ * With TANKER_STREAM_SYNCHRONOUS_INPUT, the returned future is already
+ * completed when the stream has enough buffered output.
+ *
  * \return The number of bytes read
  */
 CTANKER_EXPORT tanker_future_t* tanker_stream_read(tanker_stream_t* stream,
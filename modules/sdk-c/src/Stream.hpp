@@ -4,6 +4,8 @@
 #include <Tanker/Types/SResourceId.hpp>
 #include <Tanker/task_canceler.hpp>
 
+#include <cstdint>
+
 inline auto wrapCallback(tanker_stream_input_source_t cb, void* additional_data)
 {
   return [=](std::uint8_t* out, std::int64_t n) -> tc::cotask<std::int64_t> {
@@ -24,9 +26,30 @@ inline auto wrapCallback(tanker_stream_input_source_t cb, void* additional_data)
   };
 }
 
+// Runs the C callback in place, in the reading coroutine. When the callback
+// finishes the operation before returning, the result is used without
+// suspending.
+inline auto wrapSynchronousCallback(tanker_stream_input_source_t cb,
+                                    void* additional_data)
+{
+  return [=](std::uint8_t* out, std::int64_t n) -> tc::cotask<std::int64_t> {
+    tc::promise<std::int64_t> p;
+    auto future = p.get_future();
+    cb(out,
+       n,
+       reinterpret_cast<tanker_stream_read_operation_t*>(&p),
+       additional_data);
+    if (future.is_ready())
+      TC_RETURN(future.get());
+    TC_RETURN(TC_AWAIT(std::move(future)));
+  };
+}
+
 struct tanker_stream
 {
   Tanker::Streams::InputSource inputSource;
+  // Only set for streams created with TANKER_STREAM_SYNCHRONOUS_INPUT
+  Tanker::Streams::BufferedReader readBuffered;
   Tanker::SResourceId resourceId;
   Tanker::task_canceler canceler;
 };
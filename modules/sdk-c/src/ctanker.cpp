@@ -2,21 +2,24 @@
 
 #include <Tanker/AsyncCore.hpp>
 #include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/Encoding/Base64.hpp>
 #include <Tanker/Errors/AssertionError.hpp>
 #include <Tanker/Errors/Errc.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Format/Format.hpp>
 #include <Tanker/Init.hpp>
+#include <Tanker/SessionOptions.hpp>
 #include <Tanker/Trustchain/TrustchainId.hpp>
 #include <Tanker/Unlock/Methods.hpp>
+#include <Tanker/Utils.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
 #include <tconcurrent/async.hpp>
 #include <tconcurrent/thread_pool.hpp>
 
 #include <ctanker/async/private/CFuture.hpp>
 #include <ctanker/private/Utils.hpp>
 
+#include <chrono>
 #include <string>
 #include <utility>
 
@@ -148,6 +151,17 @@ static_assert(
     TANKER_STATUS_LAST == 4,
     "Please update the status assertions above if you added a new status");
 
+// ResourceKeys
+
+STATIC_ENUM_CHECK(TANKER_RESOURCE_KEY_BACKEND_DATABASE,
+                  ResourceKeys::Backend::Database);
+STATIC_ENUM_CHECK(TANKER_RESOURCE_KEY_BACKEND_MAPPED_LOG,
+                  ResourceKeys::Backend::MappedLog);
+
+static_assert(TANKER_RESOURCE_KEY_BACKEND_LAST == 2,
+              "Please update the backend assertions above if you added a new "
+              "resource key backend");
+
 #undef STATIC_ENUM_CHECK
 }
 
@@ -169,13 +183,14 @@ tanker_future_t* tanker_create(const tanker_options_t* options)
       throw Exception(make_error_code(Errc::InvalidArgument),
                       "options is null");
     }
-    if (options->version != 2)
+    // version 2 has no resource_key_backend, version 3 no session options
+    if (options->version < 2 || options->version > 4)
     {
       throw Exception(
           make_error_code(Errc::InvalidArgument),
           fmt::format("Options version should be {:d} instead of {:d}",
                       options->version,
-                      2));
+                      4));
     }
     if (options->app_id == nullptr)
     {
@@ -202,22 +217,41 @@ tanker_future_t* tanker_create(const tanker_options_t* options)
                       "writable_path is null");
     }
 
-    try
+    SessionOptions sessionOptions;
+    if (options->version >= 3)
     {
-      auto const trustchainId =
-          cppcodec::base64_rfc4648::decode<Trustchain::TrustchainId>(
-              std::string(options->app_id));
-
-      return static_cast<void*>(
-          new AsyncCore(url,
-                        {options->sdk_type, trustchainId, options->sdk_version},
-                        options->writable_path));
+      if (options->resource_key_backend >= TANKER_RESOURCE_KEY_BACKEND_LAST)
+      {
+        throw Exception(make_error_code(Errc::InvalidArgument),
+                        fmt::format("unknown resource_key_backend {:d}",
+                                    options->resource_key_backend));
+      }
+      sessionOptions.resourceKeyBackend =
+          static_cast<ResourceKeys::Backend>(options->resource_key_backend);
     }
-    catch (cppcodec::parse_error const&)
+    if (options->version >= 4)
     {
-      throw Exception(make_error_code(Errc::InvalidArgument),
-                      "base64 deserialization failed");
+      if (options->connection_pool_size != 0)
+        sessionOptions.connectionPoolSize = options->connection_pool_size;
+      sessionOptions.batching = options->batching != 0;
+      sessionOptions.compression = options->compression != 0;
+      sessionOptions.binaryBlocks = options->binary_blocks != 0;
+      sessionOptions.subscriptions = options->subscriptions != 0;
+      if (options->negotiation_timeout_ms != 0)
+      {
+        sessionOptions.negotiationTimeout =
+            std::chrono::milliseconds(options->negotiation_timeout_ms);
+      }
     }
+
+    auto const trustchainId = base64DecodeArgument<Trustchain::TrustchainId>(
+        std::string_view(options->app_id));
+
+    return static_cast<void*>(
+        new AsyncCore(url,
+                      {options->sdk_type, trustchainId, options->sdk_version},
+                      options->writable_path,
+                      std::move(sessionOptions)));
   }));
 }
 
@@ -355,7 +389,7 @@ tanker_future_t* tanker_get_device_list(tanker_t* ctanker)
         for (auto const& device : deviceList)
         {
           cDevice->device_id =
-              duplicateString(cppcodec::base64_rfc4648::encode(device.id()));
+              duplicateString(Encoding::base64Encode(device.id()));
           cDevice->is_revoked = device.isRevoked();
           cDevice++;
         }
@@ -467,6 +501,19 @@ tanker_future_t* tanker_decrypt(tanker_t* ctanker,
       tanker->decrypt(decrypted_data, gsl::make_span(data, data_size)));
 }
 
+tanker_expected_t* tanker_decrypt_sync(tanker_t* ctanker,
+                                       uint8_t* decrypted_data,
+                                       uint8_t const* data,
+                                       uint64_t data_size)
+{
+  auto tanker = reinterpret_cast<AsyncCore*>(ctanker);
+  return makeFuture(
+      tanker->decryptSync(decrypted_data, gsl::make_span(data, data_size))
+          .and_then(tc::get_synchronous_executor(), [](bool decrypted) {
+            return reinterpret_cast<void*>(decrypted ? 1 : 0);
+          }));
+}
+
 tanker_future_t* tanker_share(tanker_t* ctanker,
                               char const* const* recipient_public_identities,
                               uint64_t nb_recipient_public_identities,
@@ -578,6 +625,6 @@ tanker_expected_t* tanker_prehash_password(char const* password)
     if (!password)
       throw formatEx(Errc::InvalidArgument, "password is null");
     return static_cast<void*>(duplicateString(
-        cppcodec::base64_rfc4648::encode(Crypto::prehashPassword(password))));
+        Encoding::base64Encode(Crypto::prehashPassword(password))));
   }));
 }
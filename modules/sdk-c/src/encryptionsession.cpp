@@ -1,6 +1,8 @@
 #include <ctanker/encryptionsession.h>
 
 #include <Tanker/AsyncCore.hpp>
+#include <Tanker/Compute.hpp>
+#include <Tanker/Encoding/Base64.hpp>
 
 #include "Stream.hpp"
 #include <ctanker/async/private/CFuture.hpp>
@@ -51,7 +53,7 @@ CTANKER_EXPORT tanker_expected_t* tanker_encryption_session_get_resource_id(
 {
   auto const session = reinterpret_cast<EncryptionSession*>(csession);
   auto resourceId =
-      cppcodec::base64_rfc4648::encode<SResourceId>(session->resourceId());
+      SResourceId{Encoding::base64Encode(session->resourceId())};
   return makeFuture(tc::make_ready_future(
       static_cast<void*>(duplicateString(resourceId.string()))));
 }
@@ -63,6 +65,13 @@ CTANKER_EXPORT tanker_future_t* tanker_encryption_session_encrypt(
     uint64_t data_size)
 {
   auto session = reinterpret_cast<EncryptionSession*>(csession);
+  // Small buffers are encrypted in place, without a coroutine nor a task
+  if (data_size < Compute::minOffloadedBytes())
+  {
+    return makeFuture(tc::sync([&] {
+      session->encryptSync(encrypted_data, gsl::make_span(data, data_size));
+    }));
+  }
   return makeFuture(session->canceler()->run([&]() mutable {
     return tc::async_resumable([=]() -> tc::cotask<void> {
       TC_AWAIT(
@@ -71,6 +80,19 @@ CTANKER_EXPORT tanker_future_t* tanker_encryption_session_encrypt(
   }));
 }
 
+CTANKER_EXPORT tanker_expected_t* tanker_encryption_session_encrypt_sync(
+    tanker_encryption_session_t* csession,
+    uint8_t* encrypted_data,
+    uint8_t const* data,
+    uint64_t data_size)
+{
+  auto session = reinterpret_cast<EncryptionSession*>(csession);
+  return makeFuture(tc::sync([&] {
+    session->encryptSync(encrypted_data, gsl::make_span(data, data_size));
+    return static_cast<void*>(nullptr);
+  }));
+}
+
 tanker_future_t* tanker_encryption_session_stream_encrypt(
     tanker_encryption_session_t* csession,
     tanker_stream_input_source_t cb,
@@ -85,7 +107,7 @@ tanker_future_t* tanker_encryption_session_stream_encrypt(
 
     auto c_stream = new tanker_stream;
     c_stream->resourceId =
-        SResourceId{cppcodec::base64_rfc4648::encode(encryptor.resourceId())};
+        SResourceId{Encoding::base64Encode(encryptor.resourceId())};
     c_stream->inputSource = std::move(encryptor);
     return static_cast<void*>(c_stream);
   }));
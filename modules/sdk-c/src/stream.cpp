@@ -1,19 +1,20 @@
 #include <ctanker/stream.h>
 
 #include <Tanker/AsyncCore.hpp>
+#include <Tanker/Encoding/Base64.hpp>
 #include <Tanker/Errors/Errc.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Streams/DecryptionStreamAdapter.hpp>
 #include <Tanker/Streams/EncryptionStream.hpp>
 #include <Tanker/Types/SResourceId.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
-
 #include "Stream.hpp"
 #include <ctanker/private/Utils.hpp>
 
 #include <ctanker/async/private/CFuture.hpp>
 
+#include <memory>
+
 using namespace Tanker;
 using namespace Tanker::Errors;
 
@@ -30,10 +31,38 @@ void tanker_stream_read_operation_finish(tanker_stream_read_operation_t* op,
     p->set_value(nb_read);
 }
 
+namespace
+{
+bool isSynchronous(uint32_t flags)
+{
+  return flags & TANKER_STREAM_SYNCHRONOUS_INPUT;
+}
+
+Streams::InputSource makeInputSource(tanker_stream_input_source_t cb,
+                                     void* additional_data,
+                                     uint32_t flags)
+{
+  if (isSynchronous(flags))
+    return wrapSynchronousCallback(cb, additional_data);
+  return wrapCallback(cb, additional_data);
+}
+}
+
 tanker_future_t* tanker_stream_encrypt(tanker_t* session,
                                        tanker_stream_input_source_t cb,
                                        void* additional_data,
                                        tanker_encrypt_options_t const* options)
+{
+  return tanker_stream_encrypt_with_flags(
+      session, cb, additional_data, options, 0);
+}
+
+tanker_future_t* tanker_stream_encrypt_with_flags(
+    tanker_t* session,
+    tanker_stream_input_source_t cb,
+    void* additional_data,
+    tanker_encrypt_options_t const* options,
+    uint32_t flags)
 {
   std::vector<SPublicIdentity> spublicIdentities{};
   std::vector<SGroupId> sgroupIds{};
@@ -56,15 +85,30 @@ tanker_future_t* tanker_stream_encrypt(tanker_t* session,
   auto tanker = reinterpret_cast<AsyncCore*>(session);
   return makeFuture(
       tanker
-          ->makeEncryptionStream(
-              wrapCallback(cb, additional_data), spublicIdentities, sgroupIds)
+          ->makeEncryptionStream(makeInputSource(cb, additional_data, flags),
+                                 spublicIdentities,
+                                 sgroupIds)
           .and_then(tc::get_synchronous_executor(),
-                    [](Streams::EncryptionStream encryptor) {
+                    [flags](Streams::EncryptionStream encryptor) {
                       auto c_stream = new tanker_stream;
-                      c_stream->resourceId =
-                          SResourceId{cppcodec::base64_rfc4648::encode(
-                              encryptor.resourceId())};
-                      c_stream->inputSource = std::move(encryptor);
+                      c_stream->resourceId = SResourceId{
+                          Encoding::base64Encode(encryptor.resourceId())};
+                      if (isSynchronous(flags))
+                      {
+                        auto const shared =
+                            std::make_shared<Streams::EncryptionStream>(
+                                std::move(encryptor));
+                        c_stream->inputSource = [shared](std::uint8_t* out,
+                                                         std::int64_t n) {
+                          return (*shared)(out, n);
+                        };
+                        c_stream->readBuffered = [shared](std::uint8_t* out,
+                                                          std::int64_t n) {
+                          return shared->readBuffered(out, n);
+                        };
+                      }
+                      else
+                        c_stream->inputSource = std::move(encryptor);
                       return static_cast<void*>(c_stream);
                     }));
 }
@@ -72,17 +116,40 @@ tanker_future_t* tanker_stream_encrypt(tanker_t* session,
 tanker_future_t* tanker_stream_decrypt(tanker_t* session,
                                        tanker_stream_input_source_t cb,
                                        void* data)
+{
+  return tanker_stream_decrypt_with_flags(session, cb, data, 0);
+}
+
+tanker_future_t* tanker_stream_decrypt_with_flags(
+    tanker_t* session,
+    tanker_stream_input_source_t cb,
+    void* data,
+    uint32_t flags)
 {
   auto tanker = reinterpret_cast<AsyncCore*>(session);
   return makeFuture(
-      tanker->makeDecryptionStream(wrapCallback(cb, data))
+      tanker->makeDecryptionStream(makeInputSource(cb, data, flags))
           .and_then(tc::get_synchronous_executor(),
-                    [](Streams::DecryptionStreamAdapter decryptor) {
+                    [flags](Streams::DecryptionStreamAdapter decryptor) {
                       auto c_stream = new tanker_stream;
-                      c_stream->resourceId =
-                          SResourceId{cppcodec::base64_rfc4648::encode(
-                              decryptor.resourceId())};
-                      c_stream->inputSource = std::move(decryptor);
+                      c_stream->resourceId = SResourceId{
+                          Encoding::base64Encode(decryptor.resourceId())};
+                      if (isSynchronous(flags))
+                      {
+                        auto const shared =
+                            std::make_shared<Streams::DecryptionStreamAdapter>(
+                                std::move(decryptor));
+                        c_stream->inputSource = [shared](std::uint8_t* out,
+                                                         std::int64_t n) {
+                          return (*shared)(out, n);
+                        };
+                        c_stream->readBuffered = [shared](std::uint8_t* out,
+                                                          std::int64_t n) {
+                          return shared->readBuffered(out, n);
+                        };
+                      }
+                      else
+                        c_stream->inputSource = std::move(decryptor);
                       return static_cast<void*>(c_stream);
                     }));
 }
@@ -91,6 +158,15 @@ tanker_future_t* tanker_stream_read(tanker_stream_t* stream,
                                     uint8_t* buffer,
                                     int64_t buffer_size)
 {
+  // served from the buffered output, without spawning a coroutine
+  if (stream->readBuffered)
+  {
+    if (auto const nbRead = stream->readBuffered(buffer, buffer_size))
+    {
+      return makeFuture(
+          tc::make_ready_future(reinterpret_cast<void*>(*nbRead)));
+    }
+  }
   return makeFuture(stream->canceler.run([&]() mutable {
     return tc::async_resumable([=]() -> tc::cotask<void*> {
       TC_RETURN(reinterpret_cast<void*>(
@@ -1,11 +1,14 @@
 #include <ctanker.h>
 #include <ctanker/admin.h>
 #include <ctanker/identity.h>
+#include <ctanker/stream.h>
 
 #include "config.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
 
 static void* future_get(tanker_future_t* future)
@@ -61,6 +64,103 @@ static void test_sign_up_sign_in(tanker_app_descriptor_t* app)
   future_get(tanker_destroy(tanker));
 }
 
+struct memory_input
+{
+  uint8_t const* data;
+  int64_t size;
+  int64_t position;
+};
+
+// Finishes the operation before returning, like a synchronous callback
+static void memory_read(uint8_t* buffer,
+                        int64_t buffer_size,
+                        tanker_stream_read_operation_t* operation,
+                        void* additional_data)
+{
+  struct memory_input* input = additional_data;
+  int64_t nb_read = input->size - input->position;
+  if (nb_read > buffer_size)
+    nb_read = buffer_size;
+  memcpy(buffer, input->data + input->position, nb_read);
+  input->position += nb_read;
+  tanker_stream_read_operation_finish(operation, nb_read);
+}
+
+// Reads the whole stream in small pieces, so that most reads are served
+// from its buffered output
+static int64_t read_stream(tanker_stream_t* stream,
+                           uint8_t* out,
+                           int64_t capacity)
+{
+  int64_t size = 0;
+  while (1)
+  {
+    int64_t to_read = capacity - size;
+    if (to_read > 1000)
+      to_read = 1000;
+    void* const result =
+        future_get(tanker_stream_read(stream, out + size, to_read));
+    int64_t const nb_read = (int64_t)(intptr_t)result;
+    if (nb_read == 0)
+      return size;
+    size += nb_read;
+  }
+}
+
+static void test_stream_flags(tanker_app_descriptor_t* app,
+                              char const* userId,
+                              uint32_t flags)
+{
+  tanker_options_t options = make_tanker_options(app);
+  options.writable_path = ":ephemeral:";
+  tanker_t* tanker = future_get(tanker_create(&options));
+
+  char const* identity =
+      future_get(tanker_create_identity(app->id, app->private_key, userId));
+
+  tanker_verification_t verification = TANKER_VERIFICATION_INIT;
+  verification.verification_method_type = TANKER_VERIFICATION_METHOD_PASSPHRASE;
+  verification.passphrase = "passphrase";
+
+  future_get(tanker_start(tanker, identity));
+  future_get(tanker_register_identity(tanker, &verification));
+
+  // spans several chunks of the stream
+  int64_t const clear_size = 2 * 1024 * 1024 + 42;
+  int64_t const capacity = clear_size + 4096;
+  uint8_t* clear = malloc(clear_size);
+  uint8_t* encrypted = malloc(capacity);
+  uint8_t* decrypted = malloc(capacity);
+  for (int64_t i = 0; i < clear_size; ++i)
+    clear[i] = (uint8_t)i;
+
+  struct memory_input clear_input = {clear, clear_size, 0};
+  tanker_stream_t* encryptor = future_get(tanker_stream_encrypt_with_flags(
+      tanker, memory_read, &clear_input, NULL, flags));
+  int64_t const encrypted_size = read_stream(encryptor, encrypted, capacity);
+  future_get(tanker_stream_close(encryptor));
+
+  struct memory_input encrypted_input = {encrypted, encrypted_size, 0};
+  tanker_stream_t* decryptor = future_get(tanker_stream_decrypt_with_flags(
+      tanker, memory_read, &encrypted_input, flags));
+  int64_t const decrypted_size = read_stream(decryptor, decrypted, capacity);
+  future_get(tanker_stream_close(decryptor));
+
+  if (decrypted_size != clear_size ||
+      memcmp(decrypted, clear, clear_size) != 0)
+  {
+    fprintf(stderr, "Error: stream with flags %u did not round trip\n", flags);
+    exit(1);
+  }
+
+  free(decrypted);
+  free(encrypted);
+  free(clear);
+  future_get(tanker_stop(tanker));
+  tanker_free_buffer(identity);
+  future_get(tanker_destroy(tanker));
+}
+
 int main(int argc, char* argv[])
 {
   tanker_admin_t* admin = future_get(
@@ -69,6 +169,8 @@ int main(int argc, char* argv[])
       future_get(tanker_admin_create_app(admin, "functest"));
 
   test_sign_up_sign_in(app);
+  test_stream_flags(app, "bob", 0);
+  test_stream_flags(app, "charlie", TANKER_STREAM_SYNCHRONOUS_INPUT);
 
   future_get(tanker_admin_delete_app(admin, app->id));
   tanker_admin_app_descriptor_free(app);
@@ -4,6 +4,7 @@
 #include <Tanker/Core.hpp>
 #include <Tanker/Log/LogHandler.hpp>
 #include <Tanker/Network/SdkInfo.hpp>
+#include <Tanker/SessionOptions.hpp>
 #include <Tanker/Status.hpp>
 #include <Tanker/Streams/DecryptionStreamAdapter.hpp>
 #include <Tanker/Streams/EncryptionStream.hpp>
@@ -48,7 +49,10 @@ public:
   AsyncCore& operator=(AsyncCore const&) = delete;
   AsyncCore& operator=(AsyncCore&&) = delete;
 
-  AsyncCore(std::string url, Network::SdkInfo info, std::string writablePath);
+  AsyncCore(std::string url,
+            Network::SdkInfo info,
+            std::string writablePath,
+            SessionOptions options = {});
   ~AsyncCore();
 
   tc::future<void> destroy();
@@ -70,6 +74,11 @@ public:
       std::vector<SGroupId> const& groupIds = {});
   tc::shared_future<void> decrypt(uint8_t* decryptedData,
                                   gsl::span<uint8_t const> encryptedData);
+  // Same as decrypt, when it needs no I/O: the result is true once
+  // decryptedData holds the clear data. It is false when the key is not
+  // cached or the buffer is in a streaming format, decrypt must be used then.
+  expected<bool> decryptSync(uint8_t* decryptedData,
+                             gsl::span<uint8_t const> encryptedData);
 
   tc::shared_future<std::vector<uint8_t>> encrypt(
       gsl::span<uint8_t const> clearData,
@@ -5,8 +5,11 @@
 #include <Tanker/EncryptedUserKey.hpp>
 #include <Tanker/Identity/SecretPermanentIdentity.hpp>
 #include <Tanker/Network/AConnection.hpp>
+#include <Tanker/Network/Negotiation.hpp>
+#include <Tanker/Retry.hpp>
 #include <Tanker/Trustchain/GroupId.hpp>
 #include <Tanker/Trustchain/ResourceId.hpp>
+#include <Tanker/Trustchain/ServerEntry.hpp>
 #include <Tanker/Trustchain/TrustchainId.hpp>
 #include <Tanker/Trustchain/UserId.hpp>
 #include <Tanker/Types/TankerSecretProvisionalIdentity.hpp>
@@ -17,6 +20,8 @@
 #include <tconcurrent/coroutine.hpp>
 #include <tconcurrent/task_auto_canceler.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -36,10 +41,27 @@ public:
   Client& operator=(Client const&) = delete;
   Client& operator=(Client&&) = delete;
 
-  using ConnectionHandler = std::function<void()>;
+  // Called with the index of the connection that reconnected, it must be
+  // authenticated again
+  using ConnectionHandler = std::function<void(std::size_t connection)>;
 
   Client(Network::ConnectionPtr conn, ConnectionHandler connectionHandler = {});
 
+  // When enabled, blocks are exchanged as Trustchain::frameBlocks() frames on
+  // the connections whose server agrees to, instead of json arrays of base64
+  // blocks. Off by default.
+  void setBinaryBlocksEnabled(bool enabled);
+  // How long the server has to accept a feature, see Network::negotiate()
+  void setNegotiationTimeout(std::chrono::milliseconds timeout);
+  std::chrono::milliseconds negotiationTimeout() const;
+
+  // Adds a connection to the pool, before start(). The first connection
+  // serves the small requests, the others serve the requests whose reply can
+  // weigh megabytes, like group blocks, so that these do not delay the
+  // requests queued behind them, like the key publishes of a decrypt.
+  void addConnection(Network::ConnectionPtr cx);
+  std::size_t connectionCount() const;
+
   void start();
   void close();
   void setConnectionHandler(ConnectionHandler handler);
@@ -51,12 +73,57 @@ public:
 
   tc::cotask<nlohmann::json> emit(std::string const& event,
                                   nlohmann::json const& data);
+  // On a given connection of the pool, e.g. to authenticate it
+  tc::cotask<nlohmann::json> emitOn(std::size_t connection,
+                                    std::string const& event,
+                                    nlohmann::json const& data);
+  // For events replying with a list of blocks. Blocks are decoded while the
+  // reply is parsed, a json document is only built for error replies.
+  tc::cotask<std::vector<Trustchain::ServerEntry>> emitForBlocks(
+      std::string const& event, nlohmann::json const& data);
+  // For events sending serialized blocks, "push block" and "push keys"
+  tc::cotask<void> pushBlocks(
+      std::string const& event,
+      std::vector<std::vector<std::uint8_t>> const& blocks);
+
+  // Handles an event sent by the server on the main connection
+  void on(std::string const& event, Network::AConnection::Handler handler);
 
   std::string connectionId() const;
 
+  // For the idempotent reads of the requesters. The circuit breaker is shared
+  // by all the reads of the client.
+  RetryPolicy readPolicy(
+      std::chrono::milliseconds hedgeAfter = std::chrono::milliseconds{0});
+  CircuitBreaker& circuitBreaker();
+
 private:
-  std::unique_ptr<Network::AConnection> _cx;
+  enum class BinaryBlocks
+  {
+    Unknown,
+    Negotiating,
+    Supported,
+    Unsupported,
+  };
+
+  struct Connection
+  {
+    Network::ConnectionPtr cx;
+    // negotiated again after each reconnection
+    BinaryBlocks binaryBlocks = BinaryBlocks::Unknown;
+    std::size_t pendingEmits = 0;
+  };
+
+  // the first one is the main connection
+  std::vector<Connection> _connections;
   ConnectionHandler _connectionHandler;
+  CircuitBreaker _circuitBreaker;
+  bool _binaryBlocksEnabled = false;
+  std::chrono::milliseconds _negotiationTimeout =
+      Network::defaultNegotiationTimeout;
+
+  std::size_t route(std::string const& event) const;
+  tc::cotask<bool> useBinaryBlocks(std::size_t connection);
 
   tc::task_auto_canceler _taskCanceler;
 };
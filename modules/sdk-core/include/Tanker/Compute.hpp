@@ -0,0 +1,115 @@
+#pragma once
+
+#include <tconcurrent/async.hpp>
+#include <tconcurrent/coroutine.hpp>
+#include <tconcurrent/thread_pool.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace Tanker
+{
+// Thread pool for CPU-heavy work: encrypting large buffers, sealing keys for
+// many recipients, verifying many blocks. Running it there keeps the executor
+// free for every other call.
+//
+// The awaiting coroutine suspends while the task runs. It is only resumed
+// once the task is done, even when it is canceled, so tasks may reference the
+// caller's data. They must copy the state that other calls on the executor
+// may change meanwhile, like the local user.
+//
+// Posting a task costs a few microseconds. Callers keep small work inline and
+// only offload above the thresholds below.
+namespace Compute
+{
+using Clock = std::chrono::steady_clock;
+
+// Encryption and decryption of buffers from this size are offloaded, 1 MiB
+// by default. Lowering it lets the independent calls of a busy session run
+// their crypto in parallel, 0 offloads all of them.
+std::size_t minOffloadedBytes();
+void setMinOffloadedBytes(std::size_t bytes);
+// Sealing keys or verifying blocks is offloaded from this count
+inline constexpr std::size_t minOffloadedItems = 64;
+
+struct Metrics
+{
+  std::uint64_t tasks;
+  // from the moment a task is posted to the moment a thread picks it up
+  Clock::duration queueTime;
+  Clock::duration executionTime;
+};
+
+// Must be called before the first task is offloaded. The pool has one thread
+// per core by default.
+void setThreadCount(std::size_t count);
+tc::thread_pool& pool();
+
+Metrics metrics();
+void recordTask(Clock::duration queueTime, Clock::duration executionTime);
+
+namespace detail
+{
+class TaskTimer
+{
+public:
+  explicit TaskTimer(Clock::time_point posted)
+    : _posted(posted), _started(Clock::now())
+  {
+  }
+
+  ~TaskTimer()
+  {
+    recordTask(_started - _posted, Clock::now() - _started);
+  }
+
+  TaskTimer(TaskTimer const&) = delete;
+  TaskTimer(TaskTimer&&) = delete;
+  TaskTimer& operator=(TaskTimer const&) = delete;
+  TaskTimer& operator=(TaskTimer&&) = delete;
+
+private:
+  Clock::time_point _posted;
+  Clock::time_point _started;
+};
+}
+
+// Runs f on the pool and returns its result
+template <typename F>
+tc::cotask<std::invoke_result_t<F>> run(F&& f)
+{
+  auto task = [posted = Clock::now(),
+               f = std::forward<F>(f)]() mutable -> std::invoke_result_t<F> {
+    detail::TaskTimer const timer(posted);
+    return f();
+  };
+  TC_RETURN(TC_AWAIT(tc::async(pool(), std::move(task))));
+}
+
+// Runs f on the pool when offload is true, inline otherwise
+template <typename F>
+tc::cotask<std::invoke_result_t<F>> runIf(bool offload, F&& f)
+{
+  if (!offload)
+    TC_RETURN(f());
+  TC_RETURN(TC_AWAIT(run(std::forward<F>(f))));
+}
+
+// Same as run, for an f returning a tc::cotask. The coroutine runs on the
+// pool until it completes.
+template <typename F>
+std::invoke_result_t<F> runResumable(F&& f)
+{
+  auto task = [posted = Clock::now(),
+               f = std::forward<F>(f)]() mutable -> std::invoke_result_t<F> {
+    detail::TaskTimer const timer(posted);
+    TC_RETURN(TC_AWAIT(f()));
+  };
+  TC_RETURN(
+      TC_AWAIT(tc::async_resumable(tc::executor(pool()), std::move(task))));
+}
+}
+}
@@ -3,7 +3,9 @@
 #include <Tanker/AttachResult.hpp>
 #include <Tanker/EncryptionSession.hpp>
 #include <Tanker/Network/SdkInfo.hpp>
+#include <Tanker/ResourceKeys/KeyCache.hpp>
 #include <Tanker/ResourceKeys/Store.hpp>
+#include <Tanker/SessionOptions.hpp>
 #include <Tanker/Streams/DecryptionStreamAdapter.hpp>
 #include <Tanker/Streams/EncryptionStream.hpp>
 #include <Tanker/Streams/InputSource.hpp>
@@ -20,6 +22,7 @@
 #include <tconcurrent/coroutine.hpp>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -33,7 +36,10 @@ public:
   using SessionClosedHandler = std::function<void()>;
 
   ~Core();
-  Core(std::string url, Network::SdkInfo info, std::string writablePath);
+  Core(std::string url,
+       Network::SdkInfo info,
+       std::string writablePath,
+       SessionOptions options = {});
 
   tc::cotask<Status> start(std::string const& identity);
   tc::cotask<void> registerIdentity(Unlock::Verification const& verification);
@@ -94,6 +100,12 @@ public:
 
   Status status() const;
 
+  // Key of encryptedData when it can be decrypted inline with
+  // Encryptor::decryptSync: the key is cached and the buffer is in a
+  // single-chunk format. nullopt otherwise. May be called from any thread.
+  std::optional<Crypto::SymmetricKey> findCachedKey(
+      gsl::span<uint8_t const> encryptedData) const;
+
   static Trustchain::ResourceId getResourceId(
       gsl::span<uint8_t const> encryptedData);
 
@@ -119,7 +131,11 @@ private:
   std::string _url;
   Network::SdkInfo _info;
   std::string _writablePath;
+  SessionOptions _options;
   SessionClosedHandler _sessionClosed;
   std::shared_ptr<Session> _session;
+  // the cache of the started session, accessed with std::atomic_load and
+  // std::atomic_store
+  std::shared_ptr<ResourceKeys::KeyCache> _resourceKeyCache;
 };
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Tanker/Crypto/SymmetricKey.hpp>
+#include <Tanker/DataStore/AResourceKeyStore.hpp>
+#include <Tanker/DataStore/ConnectionProfile.hpp>
 #include <Tanker/DeviceKeys.hpp>
 #include <Tanker/Entry.hpp>
 #include <Tanker/Groups/Group.hpp>
@@ -43,11 +45,10 @@ private:
   std::string _msg;
 };
 
-class ADatabase
+// putResourceKey and findResourceKey come from AResourceKeyStore
+class ADatabase : public AResourceKeyStore
 {
 public:
-  virtual ~ADatabase() = default;
-
   tc::cotask<void> inTransaction(std::function<tc::cotask<void>()> const& f);
 
   virtual tc::cotask<void> putUserPrivateKey(
@@ -62,12 +63,6 @@ public:
   virtual tc::cotask<void> setTrustchainPublicSignatureKey(
       Crypto::PublicSignatureKey const&) = 0;
 
-  virtual tc::cotask<void> putResourceKey(
-      Trustchain::ResourceId const& resourceId,
-      Crypto::SymmetricKey const& key) = 0;
-  virtual tc::cotask<std::optional<Crypto::SymmetricKey>> findResourceKey(
-      Trustchain::ResourceId const& resourceId) = 0;
-
   virtual tc::cotask<void> putProvisionalUserKeys(
       Crypto::PublicSignatureKey const& appPublicSigKey,
       Crypto::PublicSignatureKey const& tankerPublicSigKey,
@@ -103,9 +98,13 @@ protected:
 
 using DatabasePtr = std::unique_ptr<ADatabase>;
 
+// Database path, and writable path, selecting a MemoryDatabase
+inline constexpr char ephemeralDbPath[] = ":ephemeral:";
+
 tc::cotask<DatabasePtr> createDatabase(
     std::string const& dbPath,
     std::optional<Crypto::SymmetricKey> const& userSecret = {},
-    bool exclusive = true);
+    bool exclusive = true,
+    ConnectionProfile profile = ConnectionProfile::Default);
 }
 }
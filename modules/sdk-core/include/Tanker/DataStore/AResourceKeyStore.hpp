@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Tanker/Crypto/SymmetricKey.hpp>
+#include <Tanker/Trustchain/ResourceId.hpp>
+
+#include <optional>
+#include <tconcurrent/coroutine.hpp>
+
+namespace Tanker
+{
+namespace DataStore
+{
+// Where resource keys are kept. ADatabase implements it, and so do the
+// dedicated backends for devices holding too many keys for the database.
+class AResourceKeyStore
+{
+public:
+  virtual ~AResourceKeyStore() = default;
+
+  // Keys are never replaced, putting a key for a known resource id is a no-op
+  virtual tc::cotask<void> putResourceKey(
+      Trustchain::ResourceId const& resourceId,
+      Crypto::SymmetricKey const& key) = 0;
+  virtual tc::cotask<std::optional<Crypto::SymmetricKey>> findResourceKey(
+      Trustchain::ResourceId const& resourceId) = 0;
+};
+}
+}
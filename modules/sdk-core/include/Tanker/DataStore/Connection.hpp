@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Tanker/Crypto/SymmetricKey.hpp>
+#include <Tanker/DataStore/ConnectionProfile.hpp>
 
 #include <optional>
 #include <sqlpp11/sqlite3/connection.h>
@@ -16,9 +17,11 @@ namespace DataStore
 using Connection = sqlpp::sqlite3::connection;
 using ConnPtr = std::unique_ptr<sqlpp::sqlite3::connection>;
 
-ConnPtr createConnection(std::string const& dbPath,
-                         std::optional<Crypto::SymmetricKey> userSecret = {},
-                         bool exclusive = true);
+ConnPtr createConnection(
+    std::string const& dbPath,
+    std::optional<Crypto::SymmetricKey> userSecret = {},
+    bool exclusive = true,
+    ConnectionProfile profile = ConnectionProfile::Default);
 
 constexpr bool hasCipher()
 {
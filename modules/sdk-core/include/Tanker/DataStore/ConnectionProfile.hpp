@@ -0,0 +1,19 @@
+#pragma once
+
+namespace Tanker
+{
+namespace DataStore
+{
+enum class ConnectionProfile
+{
+  // synchronous=FULL, default cache, and the journal mode of the file: a
+  // rollback journal, unless the database was once opened with WriteAheadLog,
+  // since sqlite keeps the WAL mode in the file.
+  Default,
+  // write-ahead log, synchronous=NORMAL, bigger page cache and memory-mapped
+  // reads. A power loss can lose the last commits, but never corrupts the
+  // database.
+  WriteAheadLog,
+};
+}
+}
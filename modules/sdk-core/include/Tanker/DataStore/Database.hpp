@@ -9,16 +9,32 @@
 
 #include <Tanker/DataStore/Connection.hpp>
 
+#include <tconcurrent/thread_pool.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+
 namespace Tanker
 {
 namespace DataStore
 {
+// All sqlite calls run on a dedicated thread, coroutines only wait for their
+// completion. This keeps blocking I/O (fsync, large reads) off the executor.
+// The connection is opened there too, by migrate(), which must be called
+// before anything else. Transactions are pinned to the same thread.
+//
+// The hot lookups and inserts use statements prepared once after the
+// migration, instead of building and parsing the SQL on every call.
 class Database : public ADatabase
 {
 public:
   explicit Database(std::string const& dbPath,
                     std::optional<Crypto::SymmetricKey> const& userSecret,
-                    bool exclusive);
+                    bool exclusive,
+                    ConnectionProfile profile = ConnectionProfile::Default);
+  ~Database() override;
   tc::cotask<void> migrate();
 
   tc::cotask<void> putUserPrivateKey(
@@ -63,10 +79,27 @@ public:
   tc::cotask<void> nuke() override;
 
 private:
-  ConnPtr _db;
+  std::string _dbPath;
+  std::optional<Crypto::SymmetricKey> _userSecret;
+  bool _exclusive;
+  ConnectionProfile _profile;
+
+  struct Statements;
 
+  // only accessed from _dbThread
+  ConnPtr _db;
+  // declared after _db, statements must be finalized before the connection is
+  // closed
+  std::unique_ptr<Statements> _statements;
   std::vector<sqlpp::transaction_t<sqlpp::sqlite3::connection>> _transactions;
 
+  // must be declared last, so that it is joined before the connection is
+  // destroyed
+  tc::thread_pool _dbThread;
+
+  template <typename F>
+  tc::cotask<std::invoke_result_t<F>> runOnDbThread(F&& f);
+
   template <typename Table>
   int currentTableVersion();
   template <typename Table>
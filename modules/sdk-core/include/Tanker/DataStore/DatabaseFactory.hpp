@@ -13,6 +13,7 @@ namespace DataStore
 tc::cotask<DatabasePtr> createDatabase(
     std::string const& dbPath,
     std::optional<Crypto::SymmetricKey> const& userSecret,
-    bool exclusive);
+    bool exclusive,
+    ConnectionProfile profile);
 }
 }
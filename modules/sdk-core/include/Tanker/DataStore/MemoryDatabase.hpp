@@ -0,0 +1,114 @@
+#pragma once
+
+#include <Tanker/DataStore/ADatabase.hpp>
+
+#include <boost/container_hash/hash.hpp>
+#include <tconcurrent/coroutine.hpp>
+
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Tanker
+{
+namespace DataStore
+{
+// ADatabase kept in hash maps, for sessions that must not touch the disk
+// (stateless workers, benchmarks). Nothing survives the object, there is no
+// migration and no lock to take.
+//
+// A transaction copies the whole state, rollback restores the copy.
+class MemoryDatabase : public ADatabase
+{
+public:
+  tc::cotask<void> putUserPrivateKey(
+      Crypto::EncryptionKeyPair const& userKeyPair) override;
+  tc::cotask<void> putUserKeyPairs(
+      gsl::span<Crypto::EncryptionKeyPair const> userKeyPair) override;
+  tc::cotask<std::vector<Crypto::EncryptionKeyPair>> getUserKeyPairs() override;
+
+  tc::cotask<std::optional<Crypto::PublicSignatureKey>>
+  findTrustchainPublicSignatureKey() override;
+  tc::cotask<void> setTrustchainPublicSignatureKey(
+      Crypto::PublicSignatureKey const&) override;
+
+  tc::cotask<void> putResourceKey(Trustchain::ResourceId const& resourceId,
+                                  Crypto::SymmetricKey const& key) override;
+  tc::cotask<std::optional<Crypto::SymmetricKey>> findResourceKey(
+      Trustchain::ResourceId const& resourceId) override;
+
+  tc::cotask<void> putProvisionalUserKeys(
+      Crypto::PublicSignatureKey const& appPublicSigKey,
+      Crypto::PublicSignatureKey const& tankerPublicSigKey,
+      ProvisionalUserKeys const& provisionalUserKeys) override;
+  tc::cotask<std::optional<ProvisionalUserKeys>> findProvisionalUserKeys(
+      Crypto::PublicSignatureKey const& appPublicSigKey,
+      Crypto::PublicSignatureKey const& tankerPublicSigKey) override;
+  tc::cotask<std::optional<Tanker::ProvisionalUserKeys>>
+  findProvisionalUserKeysByAppPublicEncryptionKey(
+      Crypto::PublicEncryptionKey const& appPublicEncryptionKey) override;
+
+  tc::cotask<std::optional<DeviceKeys>> getDeviceKeys() override;
+  tc::cotask<void> setDeviceKeys(DeviceKeys const& deviceKeys) override;
+  tc::cotask<void> setDeviceId(Trustchain::DeviceId const& deviceId) override;
+  tc::cotask<std::optional<Trustchain::DeviceId>> getDeviceId() override;
+
+  tc::cotask<void> putInternalGroup(InternalGroup const& group) override;
+  tc::cotask<void> putExternalGroup(ExternalGroup const& group) override;
+  tc::cotask<std::optional<Group>> findGroupByGroupId(
+      Trustchain::GroupId const& groupId) override;
+  tc::cotask<std::optional<Group>> findGroupByGroupPublicEncryptionKey(
+      Crypto::PublicEncryptionKey const& publicEncryptionKey) override;
+
+  tc::cotask<void> nuke() override;
+
+private:
+  struct Hasher
+  {
+    template <typename T>
+    std::size_t operator()(T const& value) const
+    {
+      return boost::hash_range(value.begin(), value.end());
+    }
+
+    template <typename T, typename U>
+    std::size_t operator()(std::pair<T, U> const& value) const
+    {
+      auto seed = (*this)(value.first);
+      boost::hash_combine(seed, (*this)(value.second));
+      return seed;
+    }
+  };
+
+  template <typename Key, typename Value>
+  using Map = std::unordered_map<Key, Value, Hasher>;
+
+  struct State
+  {
+    // in insertion order, like the database rows
+    std::vector<Crypto::EncryptionKeyPair> userKeyPairs;
+    std::optional<Crypto::PublicSignatureKey> trustchainPublicSignatureKey;
+    Map<Trustchain::ResourceId, Crypto::SymmetricKey> resourceKeys;
+    Map<std::pair<Crypto::PublicSignatureKey, Crypto::PublicSignatureKey>,
+        ProvisionalUserKeys>
+        provisionalUserKeys;
+    Map<Crypto::PublicEncryptionKey, ProvisionalUserKeys>
+        provisionalUserKeysByAppEncKey;
+    std::optional<DeviceKeys> deviceKeys;
+    std::optional<Trustchain::DeviceId> deviceId;
+    Map<Trustchain::GroupId, Group> groups;
+    Map<Crypto::PublicEncryptionKey, Trustchain::GroupId> groupIdsByEncKey;
+  };
+
+  void putGroup(Group const& group);
+
+  tc::cotask<void> startTransaction() override;
+  tc::cotask<void> commitTransaction() override;
+  tc::cotask<void> rollbackTransaction() override;
+
+  State _state;
+  std::vector<State> _transactions;
+};
+}
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <Tanker/Crypto/SymmetricKey.hpp>
+#include <Tanker/DataStore/AResourceKeyStore.hpp>
+#include <Tanker/Trustchain/ResourceId.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <gsl-lite.hpp>
+#include <optional>
+#include <tconcurrent/coroutine.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace Tanker
+{
+namespace DataStore
+{
+// Resource key store for devices holding millions of keys.
+//
+// Keys are appended to a memory-mapped log of fixed-size records, each one
+// encrypted with a key derived from the user secret. A second mapped file
+// holds an open-addressing hash table from a keyed hash of the resource id to
+// the record index. The index only contains derived data: it is rebuilt from
+// the log when it is missing, damaged, or was not closed cleanly.
+//
+// Appends are left to the page cache. The log is synced when it is closed,
+// and the header then records how many records are known to be on disk. After
+// a crash, the records past that point are checked when opening and the log
+// is cut at the first one that does not decrypt: a power loss can lose the
+// keys of the last session but does not corrupt the log.
+//
+// The log is compacted when opening if it holds too many duplicate records or
+// too much unused capacity.
+//
+// The session database already holds the exclusive lock of the device, the
+// files are not locked again.
+class ResourceKeyLog : public AResourceKeyStore
+{
+public:
+  ResourceKeyLog(std::string const& path,
+                 Crypto::SymmetricKey const& userSecret);
+  ~ResourceKeyLog() override;
+
+  ResourceKeyLog(ResourceKeyLog const&) = delete;
+  ResourceKeyLog(ResourceKeyLog&&) = delete;
+  ResourceKeyLog& operator=(ResourceKeyLog const&) = delete;
+  ResourceKeyLog& operator=(ResourceKeyLog&&) = delete;
+
+  tc::cotask<void> putResourceKey(Trustchain::ResourceId const& resourceId,
+                                  Crypto::SymmetricKey const& key) override;
+  tc::cotask<std::optional<Crypto::SymmetricKey>> findResourceKey(
+      Trustchain::ResourceId const& resourceId) override;
+
+  std::uint64_t size() const;
+
+  // Removes every key
+  void clear();
+  // Rewrites the log without duplicate records and without the preallocated
+  // tail, and rebuilds the index at the smallest fitting size
+  void compact();
+
+private:
+  using IdHash = std::array<std::uint8_t, 16>;
+
+  struct MappedFile
+  {
+    std::string path;
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+
+    std::uint8_t* data() const;
+    std::uint64_t size() const;
+    // unmaps the file, resizes it, and maps it again
+    void remap(std::uint64_t size);
+    void unmap();
+  };
+
+  void open();
+  void openLog();
+  void openIndex();
+  void rebuildIndex(std::uint64_t capacity);
+  // syncs the log and marks every record as on disk
+  void markVerified();
+  // syncs the index before marking it clean
+  void setIndexClean(bool clean);
+  bool needsCompaction() const;
+
+  IdHash hashId(Trustchain::ResourceId const& resourceId) const;
+  std::uint8_t* record(std::uint64_t index) const;
+  bool decryptRecord(std::uint64_t index, gsl::span<std::uint8_t> clear) const;
+  std::uint64_t logCount() const;
+  std::uint64_t logCapacity() const;
+  std::uint64_t* slots() const;
+  std::uint64_t indexCount() const;
+  std::uint64_t indexCapacity() const;
+
+  // returns the index of the record holding idHash
+  std::optional<std::uint64_t> findRecord(IdHash const& idHash) const;
+  void indexRecord(std::uint64_t index);
+  void setLogCount(std::uint64_t count);
+  void setIndexCount(std::uint64_t count);
+
+  Crypto::SymmetricKey _encryptionKey;
+  Crypto::SymmetricKey _idKey;
+  IdHash _secretCheck;
+  MappedFile _log;
+  MappedFile _index;
+  mutable std::mutex _mutex;
+};
+}
+}
@@ -29,6 +29,10 @@ public:
       gsl::span<std::uint8_t const> encryptedData);
   tc::cotask<EncryptionMetadata> encrypt(
       std::uint8_t* encryptedData, gsl::span<std::uint8_t const> clearData);
+  // Same as encrypt, always inline. Encrypting with a session never needs
+  // I/O, so this never has to fall back to encrypt.
+  EncryptionMetadata encryptSync(std::uint8_t* encryptedData,
+                                 gsl::span<std::uint8_t const> clearData);
 
 private:
   void assertSession(const char* action) const;
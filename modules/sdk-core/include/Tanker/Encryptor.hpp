@@ -22,6 +22,14 @@ tc::cotask<void> decrypt(uint8_t* decryptedData,
 Trustchain::ResourceId extractResourceId(
     gsl::span<uint8_t const> encryptedData);
 
+// True when encryptedData is in one of the single-chunk formats, which
+// decryptSync handles, and is large enough to hold its header
+bool hasSynchronousFormat(gsl::span<uint8_t const> encryptedData);
+// Same as decrypt, without a coroutine and always inline
+void decryptSync(uint8_t* decryptedData,
+                 Crypto::SymmetricKey const& key,
+                 gsl::span<uint8_t const> encryptedData);
+
 tc::cotask<std::vector<uint8_t>> decryptFallbackAead(
     Crypto::SymmetricKey const& key, gsl::span<uint8_t const> encryptedData);
 }
@@ -26,6 +26,10 @@ public:
   static tc::cotask<void> decrypt(std::uint8_t* decryptedData,
                                   Crypto::SymmetricKey const& key,
                                   gsl::span<std::uint8_t const> encryptedData);
+  // Same as decrypt, for callers that are not in a coroutine
+  static void decryptSync(std::uint8_t* decryptedData,
+                          Crypto::SymmetricKey const& key,
+                          gsl::span<std::uint8_t const> encryptedData);
   static Trustchain::ResourceId extractResourceId(
       gsl::span<std::uint8_t const> encryptedData);
 };
@@ -30,6 +30,15 @@ public:
   static tc::cotask<void> decrypt(std::uint8_t* decryptedData,
                                   Crypto::SymmetricKey const& symmetricKey,
                                   gsl::span<std::uint8_t const> encryptedData);
+  // Same as encrypt and decrypt, for callers that are not in a coroutine
+  static EncryptionMetadata encryptSync(
+      std::uint8_t* encryptedData,
+      gsl::span<std::uint8_t const> clearData,
+      Trustchain::ResourceId const& resourceId,
+      Crypto::SymmetricKey const& key);
+  static void decryptSync(std::uint8_t* decryptedData,
+                          Crypto::SymmetricKey const& key,
+                          gsl::span<std::uint8_t const> encryptedData);
   static Trustchain::ResourceId extractResourceId(
       gsl::span<std::uint8_t const> encryptedData);
 };
@@ -11,6 +11,11 @@
 
 #include <optional>
 
+namespace Tanker
+{
+class Subscriptions;
+}
+
 namespace Tanker::Users
 {
 class ILocalUserAccessor;
@@ -27,7 +32,8 @@ public:
            Users::IUserAccessor* userAccessor,
            Store* groupstore,
            Users::ILocalUserAccessor* localUserAccessor,
-           ProvisionalUsers::IAccessor* provisionalUserAccessor);
+           ProvisionalUsers::IAccessor* provisionalUserAccessor,
+           Subscriptions* subscriptions = nullptr);
 
   Accessor() = delete;
   Accessor(Accessor const&) = delete;
@@ -49,6 +55,7 @@ private:
   Store* _groupStore;
   Users::ILocalUserAccessor* _localUserAccessor;
   ProvisionalUsers::IAccessor* _provisionalUserAccessor;
+  Subscriptions* _subscriptions;
 
   tc::cotask<void> fetch(gsl::span<Trustchain::GroupId const> groupIds);
   tc::cotask<Accessor::GroupPullResult> getGroups(
@@ -2,6 +2,7 @@
 
 #include <Tanker/Crypto/SealedSymmetricKey.hpp>
 #include <Tanker/Crypto/SignatureKeyPair.hpp>
+#include <Tanker/Crypto/SigningContext.hpp>
 #include <Tanker/Trustchain/Actions/UserGroupAddition.hpp>
 #include <Tanker/Trustchain/Actions/UserGroupCreation.hpp>
 #include <Tanker/Trustchain/ClientEntry.hpp>
@@ -21,7 +22,7 @@ Trustchain::ClientEntry createUserGroupCreationV1Entry(
             sealedPrivateEncryptionKeysForUsers,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey);
+    Crypto::SigningContext const& deviceSigner);
 
 Trustchain::ClientEntry createUserGroupCreationV2Entry(
     Crypto::SignatureKeyPair const& groupSignatureKeyPair,
@@ -31,7 +32,7 @@ Trustchain::ClientEntry createUserGroupCreationV2Entry(
         groupProvisionalMembers,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey);
+    Crypto::SigningContext const& deviceSigner);
 
 Trustchain::ClientEntry createUserGroupAdditionV1Entry(
     Crypto::SignatureKeyPair const& signatureKeyPair,
@@ -41,7 +42,7 @@ Trustchain::ClientEntry createUserGroupAdditionV1Entry(
             sealedPrivateEncryptionKeysForUsers,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey);
+    Crypto::SigningContext const& deviceSigner);
 
 Trustchain::ClientEntry createUserGroupAdditionV2Entry(
     Crypto::SignatureKeyPair const& groupSignatureKeyPair,
@@ -53,7 +54,7 @@ Trustchain::ClientEntry createUserGroupAdditionV2Entry(
         provisionalMembers,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey);
+    Crypto::SigningContext const& deviceSigner);
 
 Trustchain::ClientEntry createKeyPublishToGroupEntry(
     Crypto::SealedSymmetricKey const& symKey,
@@ -61,5 +62,5 @@ Trustchain::ClientEntry createKeyPublishToGroupEntry(
     Crypto::PublicEncryptionKey const& recipientPublicEncryptionKey,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey);
+    Crypto::SigningContext const& deviceSigner);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Tanker/Crypto/SigningContext.hpp>
 #include <Tanker/Groups/Group.hpp>
 #include <Tanker/Groups/IAccessor.hpp>
 #include <Tanker/ProvisionalUsers/PublicUser.hpp>
@@ -13,6 +14,7 @@
 #include <tconcurrent/coroutine.hpp>
 
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -48,7 +50,7 @@ Trustchain::ClientEntry makeUserGroupCreationEntry(
     Crypto::EncryptionKeyPair const& groupEncryptionKeyPair,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& privateSignatureKey);
+    Crypto::SigningContext const& deviceSigner);
 
 tc::cotask<SGroupId> create(
     Users::IUserAccessor& userAccessor,
@@ -56,7 +58,7 @@ tc::cotask<SGroupId> create(
     std::vector<SPublicIdentity> const& spublicIdentities,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& privateSignatureKey);
+    std::shared_ptr<Crypto::SigningContext const> deviceSigner);
 
 Trustchain::ClientEntry makeUserGroupAdditionEntry(
     std::vector<Users::User> const& memberUsers,
@@ -64,7 +66,7 @@ Trustchain::ClientEntry makeUserGroupAdditionEntry(
     InternalGroup const& group,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& privateSignatureKey);
+    Crypto::SigningContext const& deviceSigner);
 
 tc::cotask<void> updateMembers(
     Users::IUserAccessor& userAccessor,
@@ -74,5 +76,5 @@ tc::cotask<void> updateMembers(
     std::vector<SPublicIdentity> const& spublicIdentitiesToAdd,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& privateSignatureKey);
+    std::shared_ptr<Crypto::SigningContext const> deviceSigner);
 }
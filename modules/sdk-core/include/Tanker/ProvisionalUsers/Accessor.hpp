@@ -12,6 +12,7 @@ class ILocalUserAccessor;
 namespace Tanker
 {
 class ProvisionalUserKeysStore;
+class Subscriptions;
 }
 
 namespace Tanker::ProvisionalUsers
@@ -24,7 +25,8 @@ public:
   Accessor(IRequester* request,
            Users::IUserAccessor* userAccessor,
            Users::ILocalUserAccessor* localUser,
-           ProvisionalUserKeysStore* provisionalUserKeysStore);
+           ProvisionalUserKeysStore* provisionalUserKeysStore,
+           Subscriptions* subscriptions = nullptr);
 
   Accessor() = delete;
   Accessor(Accessor const&) = delete;
@@ -39,12 +41,17 @@ public:
       Crypto::PublicSignatureKey const& appPublicSigKey,
       Crypto::PublicSignatureKey const& tankerPublicSigKey) override;
 
+  // Pulls the claim blocks, unless the server told that none was added since
+  // the last time
   tc::cotask<void> refreshKeys() override;
+  // The next refreshKeys() pulls the claim blocks, e.g. after a claim
+  void invalidateKeys();
 
 private:
   IRequester* _requester;
   Users::IUserAccessor* _userAccessor;
   Users::ILocalUserAccessor* _localUserAccessor;
   ProvisionalUserKeysStore* _provisionalUserKeysStore;
+  Subscriptions* _subscriptions;
 };
 }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Tanker/Crypto/SymmetricKey.hpp>
+#include <Tanker/Trustchain/ResourceId.hpp>
+
+#include <boost/container_hash/hash.hpp>
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace Tanker::ResourceKeys
+{
+// Bounded in-memory cache of the resource keys used recently.
+//
+// Store reads it before the database and fills it with the keys it finds
+// there. It can be read from any thread: decrypting a small buffer whose key
+// is cached needs no coroutine and no executor.
+//
+// Like the stores, the first key put for a resource is kept. The least
+// recently used key is evicted when the cache is full.
+class KeyCache
+{
+public:
+  explicit KeyCache(std::size_t capacity = 4096);
+
+  KeyCache(KeyCache const&) = delete;
+  KeyCache(KeyCache&&) = delete;
+  KeyCache& operator=(KeyCache const&) = delete;
+  KeyCache& operator=(KeyCache&&) = delete;
+
+  std::size_t capacity() const;
+  std::size_t size() const;
+
+  std::optional<Crypto::SymmetricKey> find(
+      Trustchain::ResourceId const& resourceId);
+  void put(Trustchain::ResourceId const& resourceId,
+           Crypto::SymmetricKey const& key);
+  void clear();
+
+private:
+  struct Hasher
+  {
+    std::size_t operator()(Trustchain::ResourceId const& resourceId) const
+    {
+      return boost::hash_range(resourceId.begin(), resourceId.end());
+    }
+  };
+
+  struct Entry
+  {
+    Crypto::SymmetricKey key;
+    // most recently used first
+    std::list<Trustchain::ResourceId>::iterator lruPosition;
+  };
+
+  std::size_t _capacity;
+  std::list<Trustchain::ResourceId> _lru;
+  std::unordered_map<Trustchain::ResourceId, Entry, Hasher> _entries;
+  mutable std::mutex _mutex;
+};
+}
@@ -23,12 +23,21 @@ class SymmetricKey;
 
 namespace DataStore
 {
-class ADatabase;
+class AResourceKeyStore;
 }
 }
 
 namespace Tanker::ResourceKeys
 {
+class KeyCache;
+
+enum class Backend
+{
+  // the resource_keys table of the session database
+  Database,
+  // DataStore::ResourceKeyLog, next to the session database
+  MappedLog,
+};
 
 class Store
 {
@@ -38,7 +47,8 @@ public:
   Store& operator=(Store const&) = delete;
   Store& operator=(Store&&) = delete;
 
-  Store(DataStore::ADatabase* dbConn);
+  // cache is optional, it is read before dbConn when set
+  Store(DataStore::AResourceKeyStore* dbConn, KeyCache* cache = nullptr);
 
   tc::cotask<void> putKey(Trustchain::ResourceId const& resourceId,
                           Crypto::SymmetricKey const& key);
@@ -52,6 +62,7 @@ public:
       Trustchain::ResourceId const& resourceId) const;
 
 private:
-  DataStore::ADatabase* _db;
+  DataStore::AResourceKeyStore* _db;
+  KeyCache* _cache;
 };
 }
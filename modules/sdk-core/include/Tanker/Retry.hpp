@@ -1,9 +1,22 @@
 #pragma once
 
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+
+#include <tconcurrent/async.hpp>
+#include <tconcurrent/async_wait.hpp>
 #include <tconcurrent/coroutine.hpp>
+#include <tconcurrent/promise.hpp>
+#include <tconcurrent/task_auto_canceler.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <exception>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Tanker
@@ -11,6 +24,194 @@ namespace Tanker
 using DelayList = std::vector<std::chrono::milliseconds>;
 
 DelayList exponentialDelays(int retries);
+// Each delay is drawn between base and three times the previous one, capped,
+// so that the clients that failed together do not retry together
+DelayList decorrelatedJitterDelays(int retries,
+                                   std::chrono::milliseconds base,
+                                   std::chrono::milliseconds cap);
 tc::cotask<void> retry(std::function<tc::cotask<void>()> f,
                        DelayList const& delays);
+
+// Shared by the calls to one server. After failureThreshold network errors in
+// a row the circuit opens: calls fail fast with a NetworkError instead of
+// waiting for the server. After openDuration, one call goes through to probe
+// the server, its success closes the circuit.
+class CircuitBreaker
+{
+public:
+  struct Options
+  {
+    unsigned failureThreshold = 5;
+    std::chrono::milliseconds openDuration{2000};
+  };
+
+  explicit CircuitBreaker(Options options = {});
+
+  void throwIfOpen();
+  void recordSuccess();
+  void recordFailure();
+  // The attempt ended without telling whether the server is up, like when it
+  // is canceled: the next call probes again
+  void abandonProbe();
+  bool isOpen() const;
+
+private:
+  Options _options;
+  unsigned _failures = 0;
+  std::optional<std::chrono::steady_clock::time_point> _openedAt;
+  bool _probing = false;
+};
+
+// For idempotent reads, zero durations disable what they configure
+struct RetryPolicy
+{
+  // the waits between attempts that failed with a NetworkError
+  DelayList delays;
+  // the whole operation, waits included
+  std::chrono::milliseconds deadline{0};
+  // one attempt, the emits of a disconnected socket are never answered
+  std::chrono::milliseconds attemptTimeout{0};
+  // a second attempt starts when the first did not answer after this delay,
+  // the first reply wins
+  std::chrono::milliseconds hedgeAfter{0};
+  CircuitBreaker* circuitBreaker = nullptr;
+};
+
+namespace detail
+{
+using Clock = std::chrono::steady_clock;
+
+template <typename T>
+struct AttemptState
+{
+  tc::promise<T> promise;
+  bool done = false;
+  unsigned running = 0;
+};
+
+// Runs f, and a hedged copy of it, until one succeeds, both fail, or the
+// attempt times out
+template <typename T>
+tc::cotask<T> attempt(std::function<tc::cotask<T>()> const& f,
+                      RetryPolicy const& policy,
+                      Clock::time_point deadline)
+{
+  auto timeout = deadline;
+  if (policy.attemptTimeout.count())
+    timeout = std::min(timeout, Clock::now() + policy.attemptTimeout);
+  if (timeout == Clock::time_point::max() && !policy.hedgeAfter.count())
+    TC_RETURN(TC_AWAIT(f()));
+
+  auto const state = std::make_shared<AttemptState<T>>();
+  auto future = state->promise.get_future();
+  auto const run = [state, &f]() -> tc::cotask<void> {
+    ++state->running;
+    std::exception_ptr error;
+    try
+    {
+      auto result = TC_AWAIT(f());
+      if (!state->done)
+      {
+        state->done = true;
+        state->promise.set_value(std::move(result));
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    --state->running;
+    // the other attempt may still succeed
+    if (error && !state->done && state->running == 0)
+    {
+      state->done = true;
+      state->promise.set_exception(error);
+    }
+  };
+
+  tc::task_auto_canceler canceler;
+  canceler.add(tc::async_resumable(run));
+  if (policy.hedgeAfter.count())
+  {
+    canceler.add(tc::async_resumable([&]() -> tc::cotask<void> {
+      TC_AWAIT(tc::async_wait(policy.hedgeAfter));
+      if (!state->done)
+        TC_AWAIT(run());
+    }));
+  }
+  if (timeout != Clock::time_point::max())
+  {
+    canceler.add(tc::async_resumable([&]() -> tc::cotask<void> {
+      TC_AWAIT(tc::async_wait(std::max(
+          std::chrono::milliseconds{0},
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              timeout - Clock::now()))));
+      if (state->done)
+        TC_RETURN();
+      state->done = true;
+      state->promise.set_exception(std::make_exception_ptr(
+          Errors::Exception(Errors::Errc::NetworkError, "request timed out")));
+    }));
+  }
+  TC_RETURN(TC_AWAIT(std::move(future)));
+}
+
+template <typename>
+struct CotaskValue;
+
+template <typename T>
+struct CotaskValue<tc::cotask<T>>
+{
+  using type = T;
+};
+}
+
+// Retries f on network errors following policy, f must be idempotent
+template <typename F,
+          typename T = typename detail::CotaskValue<
+              std::invoke_result_t<F&>>::type>
+tc::cotask<T> retry(F&& f, RetryPolicy const& policy)
+{
+  std::function<tc::cotask<T>()> const function(std::forward<F>(f));
+  auto const deadline =
+      policy.deadline.count() ?
+          detail::Clock::now() + policy.deadline :
+          detail::Clock::time_point::max();
+  auto delay = policy.delays.begin();
+  while (true)
+  {
+    if (policy.circuitBreaker)
+      policy.circuitBreaker->throwIfOpen();
+    try
+    {
+      auto result = TC_AWAIT(detail::attempt(function, policy, deadline));
+      if (policy.circuitBreaker)
+        policy.circuitBreaker->recordSuccess();
+      TC_RETURN(std::move(result));
+    }
+    catch (Errors::Exception const& e)
+    {
+      if (e.errorCode() != Errors::Errc::NetworkError)
+      {
+        // the server replied
+        if (policy.circuitBreaker)
+          policy.circuitBreaker->recordSuccess();
+        throw;
+      }
+      if (policy.circuitBreaker)
+        policy.circuitBreaker->recordFailure();
+      if (delay == policy.delays.end() ||
+          detail::Clock::now() + *delay >= deadline)
+        throw;
+    }
+    catch (...)
+    {
+      if (policy.circuitBreaker)
+        policy.circuitBreaker->abandonProbe();
+      throw;
+    }
+    TC_AWAIT(tc::async_wait(*delay));
+    ++delay;
+  }
+}
 }
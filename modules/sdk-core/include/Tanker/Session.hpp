@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Tanker/DataStore/ADatabase.hpp>
+#include <Tanker/DataStore/ResourceKeyLog.hpp>
 #include <Tanker/EncryptionSession.hpp>
 #include <Tanker/Groups/Accessor.hpp>
 #include <Tanker/Groups/Requester.hpp>
@@ -12,6 +13,10 @@
 #include <Tanker/ProvisionalUsers/Requester.hpp>
 #include <Tanker/Pusher.hpp>
 #include <Tanker/ResourceKeys/Accessor.hpp>
+#include <Tanker/ResourceKeys/KeyCache.hpp>
+#include <Tanker/ResourceKeys/Store.hpp>
+#include <Tanker/SessionOptions.hpp>
+#include <Tanker/Subscriptions.hpp>
 #include <Tanker/Unlock/Requester.hpp>
 #include <Tanker/Users/LocalUserAccessor.hpp>
 #include <Tanker/Users/LocalUserStore.hpp>
@@ -20,6 +25,7 @@
 
 #include <tconcurrent/coroutine.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -42,11 +48,17 @@ public:
 
   struct Storage
   {
-    Storage(DataStore::DatabasePtr db);
+    Storage(
+        DataStore::DatabasePtr db,
+        std::unique_ptr<DataStore::ResourceKeyLog> resourceKeyLog = nullptr);
 
     DataStore::DatabasePtr db;
+    // null when resource keys are kept in db
+    std::unique_ptr<DataStore::ResourceKeyLog> resourceKeyLog;
     Users::LocalUserStore localUserStore;
     Groups::Store groupStore;
+    // shared with Core, which reads it from other threads
+    std::shared_ptr<ResourceKeys::KeyCache> resourceKeyCache;
     ResourceKeys::Store resourceKeyStore;
     ProvisionalUserKeysStore provisionalUserKeysStore;
   };
@@ -56,6 +68,7 @@ public:
     Accessors(Storage& storage,
               Pusher* pusher,
               Requesters* requesters,
+              Subscriptions* subscriptions,
               Users::LocalUserAccessor plocalUserAccessor);
     Users::LocalUserAccessor localUserAccessor;
     mutable Users::UserAccessor userAccessor;
@@ -65,7 +78,9 @@ public:
     ResourceKeys::Accessor resourceKeyAccessor;
   };
 
-  Session(std::string url, Network::SdkInfo info);
+  Session(std::string url,
+          Network::SdkInfo info,
+          SessionOptions const& options = {});
 
   Client& client();
 
@@ -95,10 +110,13 @@ public:
   tc::cotask<DeviceKeys> getDeviceKeys();
 
   tc::cotask<void> authenticate();
+  tc::cotask<void> authenticate(std::size_t connection);
   tc::cotask<void> finalizeOpening();
 
 private:
+  SessionOptions _options;
   std::unique_ptr<Client> _client;
+  Subscriptions _subscriptions;
   Pusher _pusher;
   Requesters _requesters;
   std::unique_ptr<Storage> _storage;
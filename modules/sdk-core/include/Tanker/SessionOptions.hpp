@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Tanker/Network/Negotiation.hpp>
+#include <Tanker/ResourceKeys/Store.hpp>
+
+#include <chrono>
+#include <cstddef>
+
+namespace Tanker
+{
+// The settings of one session. The optional features of the protocol are off
+// by default, only some servers support them.
+struct SessionOptions
+{
+  ResourceKeys::Backend resourceKeyBackend = ResourceKeys::Backend::Database;
+  // The number of connections, see Client::addConnection()
+  std::size_t connectionPoolSize = 1;
+  // See Network::BatchingConnection
+  bool batching = false;
+  // See Network::CompressingConnection
+  bool compression = false;
+  // See Client::setBinaryBlocksEnabled()
+  bool binaryBlocks = false;
+  // See Subscriptions
+  bool subscriptions = false;
+  // See Network::negotiate()
+  std::chrono::milliseconds negotiationTimeout =
+      Network::defaultNegotiationTimeout;
+};
+}
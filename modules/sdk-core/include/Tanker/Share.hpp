@@ -1,7 +1,7 @@
 #pragma once
 
-#include <Tanker/Crypto/PrivateSignatureKey.hpp>
 #include <Tanker/Crypto/PublicEncryptionKey.hpp>
+#include <Tanker/Crypto/SigningContext.hpp>
 #include <Tanker/ProvisionalUsers/PublicUser.hpp>
 #include <Tanker/ResourceKeys/KeysResult.hpp>
 #include <Tanker/Trustchain/ClientEntry.hpp>
@@ -15,6 +15,7 @@
 
 #include <gsl-lite.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace Tanker::Users
@@ -43,7 +44,7 @@ struct KeyRecipients
 Trustchain::ClientEntry makeKeyPublishToUser(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Crypto::PublicEncryptionKey const& recipientPublicEncryptionKey,
     Trustchain::ResourceId const& resourceId,
     Crypto::SymmetricKey const& resourceKey);
@@ -51,7 +52,7 @@ Trustchain::ClientEntry makeKeyPublishToUser(
 Trustchain::ClientEntry makeKeyPublishToGroup(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Crypto::PublicEncryptionKey const& recipientPublicEncryptionKey,
     Trustchain::ResourceId const& resourceId,
     Crypto::SymmetricKey const& resourceKey);
@@ -59,7 +60,7 @@ Trustchain::ClientEntry makeKeyPublishToGroup(
 Trustchain::ClientEntry makeKeyPublishToProvisionalUser(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     ProvisionalUsers::PublicUser const& recipientProvisionalUser,
     Trustchain::ResourceId const& resourceId,
     Crypto::SymmetricKey const& resourceKey);
@@ -73,19 +74,20 @@ tc::cotask<KeyRecipients> generateRecipientList(
 std::vector<Trustchain::ClientEntry> generateShareBlocks(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     ResourceKeys::KeysResult const& resourceKeys,
     KeyRecipients const& keyRecipients);
 
-tc::cotask<void> share(Users::IUserAccessor& userAccessor,
-                       Groups::IAccessor& groupAccessor,
-                       Trustchain::TrustchainId const& trustchainId,
-                       Trustchain::DeviceId const& deviceId,
-                       Crypto::PrivateSignatureKey const& signatureKey,
-                       Pusher& pusher,
-                       ResourceKeys::KeysResult const& resourceKeys,
-                       std::vector<SPublicIdentity> const& publicIdentities,
-                       std::vector<SGroupId> const& groupIds);
+tc::cotask<void> share(
+    Users::IUserAccessor& userAccessor,
+    Groups::IAccessor& groupAccessor,
+    Trustchain::TrustchainId const& trustchainId,
+    Trustchain::DeviceId const& deviceId,
+    std::shared_ptr<Crypto::SigningContext const> deviceSigner,
+    Pusher& pusher,
+    ResourceKeys::KeysResult const& resourceKeys,
+    std::vector<SPublicIdentity> const& publicIdentities,
+    std::vector<SGroupId> const& groupIds);
 
 }
 }
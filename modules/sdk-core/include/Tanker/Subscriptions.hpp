@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Tanker/Trustchain/GroupId.hpp>
+#include <Tanker/Trustchain/UserId.hpp>
+
+#include <boost/container/flat_set.hpp>
+#include <gsl-lite.hpp>
+#include <nlohmann/json_fwd.hpp>
+#include <tconcurrent/coroutine.hpp>
+
+#include <cstdint>
+
+namespace Tanker
+{
+class Client;
+
+// Tells which of the cached users and groups are up to date.
+//
+// The accessors subscribe to the users and groups they pull. The server then
+// sends an event when one of them changes: a device is created or revoked, or
+// members are added to a group. The changed user or group is stale until it
+// is pulled again. The provisional identities claimed by the user of the
+// session are tracked the same way.
+//
+// The server forgets the subscriptions of a lost connection, and the events
+// sent meanwhile are lost: everything is stale after a reconnection.
+class Subscriptions
+{
+public:
+  // Increases with each invalidation
+  using Generation = std::uint64_t;
+
+  // When disabled, nothing is ever fresh
+  Subscriptions(Client* client, bool enabled);
+
+  Subscriptions(Subscriptions const&) = delete;
+  Subscriptions(Subscriptions&&) = delete;
+  Subscriptions& operator=(Subscriptions const&) = delete;
+  Subscriptions& operator=(Subscriptions&&) = delete;
+
+  // Return the generation to give to markFresh() once the users, groups or
+  // claims are pulled. Pull after subscribing, or a change made in between
+  // is missed.
+  tc::cotask<Generation> subscribe(
+      gsl::span<Trustchain::UserId const> userIds);
+  tc::cotask<Generation> subscribe(
+      gsl::span<Trustchain::GroupId const> groupIds);
+  tc::cotask<Generation> subscribeToClaims();
+
+  // Do nothing when something was invalidated since generation
+  void markFresh(gsl::span<Trustchain::UserId const> userIds,
+                 Generation generation);
+  void markFresh(gsl::span<Trustchain::GroupId const> groupIds,
+                 Generation generation);
+  void markClaimsFresh(Generation generation);
+
+  bool isFresh(Trustchain::UserId const& userId) const;
+  bool isFresh(Trustchain::GroupId const& groupId) const;
+  bool areClaimsFresh() const;
+  bool enabled() const;
+
+  void invalidate(Trustchain::UserId const& userId);
+  void invalidate(Trustchain::GroupId const& groupId);
+  void invalidateClaims();
+  // When the main connection reconnected
+  void reset();
+
+private:
+  Client* _client;
+  bool _enabled;
+  Generation _generation = 0;
+
+  boost::container::flat_set<Trustchain::UserId> _subscribedUsers;
+  boost::container::flat_set<Trustchain::UserId> _freshUsers;
+  boost::container::flat_set<Trustchain::GroupId> _subscribedGroups;
+  boost::container::flat_set<Trustchain::GroupId> _freshGroups;
+  bool _claimsSubscribed = false;
+  bool _claimsFresh = false;
+  // The server did not answer a subscription, until the next reconnection
+  bool _subscribeUnanswered = false;
+
+  tc::cotask<bool> emitSubscribe(nlohmann::json const& request);
+};
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Tanker/Core.hpp>
+#include <Tanker/Network/SdkInfo.hpp>
+#include <Tanker/Unlock/Verification.hpp>
+
+#include <tconcurrent/coroutine.hpp>
+#include <tconcurrent/future.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace Tanker
+{
+// Hosts the sessions of many identities in one process, for servers acting on
+// behalf of their users.
+//
+// A tenant's session is started the first time it is opened and stopped once
+// it has been idle for idleTimeout, so only recently used tenants hold a
+// connection, a database file and their caches. At most maxResidentTenants
+// sessions are kept: opening another one first stops the least recently used
+// idle tenant. A stopped tenant leaves nothing in memory, its device stays in
+// its database under writablePath.
+//
+// Every session runs on the default executor, the host must be used from it
+// too. The server authenticates each connection as one device, so every
+// resident tenant still has its own connection.
+class TenantHost
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Options
+  {
+    std::size_t maxResidentTenants = 1000;
+    Clock::duration idleTimeout = std::chrono::minutes(5);
+  };
+
+  struct Stats
+  {
+    std::size_t residentTenants;
+    std::uint64_t loads;
+    std::uint64_t evictions;
+  };
+
+  TenantHost(std::string url,
+             Network::SdkInfo info,
+             std::string writablePath,
+             Options options = {});
+  ~TenantHost();
+
+  TenantHost(TenantHost const&) = delete;
+  TenantHost(TenantHost&&) = delete;
+  TenantHost& operator=(TenantHost const&) = delete;
+  TenantHost& operator=(TenantHost&&) = delete;
+
+  // Returns the ready session of identity, starting it if needed.
+  // verification is used to register or verify the identity on its first
+  // start on this host. A tenant is never evicted while the returned pointer
+  // is held.
+  tc::cotask<std::shared_ptr<Core>> open(
+      std::string const& identity,
+      std::optional<Unlock::Verification> const& verification = std::nullopt);
+
+  // Stops the tenants unused for longer than idleTimeout. open() already does
+  // it, call it when the host may be left unused for long.
+  void evictIdle();
+
+  Stats stats() const;
+
+private:
+  using LruList = std::list<std::string>;
+
+  struct Tenant
+  {
+    std::shared_ptr<Core> core;
+    tc::shared_future<void> started;
+    Clock::time_point lastUsed;
+    LruList::iterator lruPosition;
+  };
+
+  using Tenants = std::unordered_map<std::string, Tenant>;
+
+  bool isIdle(Tenant const& tenant) const;
+  void touch(Tenant& tenant);
+  LruList::iterator evict(Tenants::iterator it);
+  void makeRoom();
+  void forget(std::string const& identity, std::shared_ptr<Core> const& core);
+
+  std::string _url;
+  Network::SdkInfo _info;
+  std::string _writablePath;
+  Options _options;
+
+  Tenants _tenants;
+  // most recently used first
+  LruList _lru;
+  std::uint64_t _loads = 0;
+  std::uint64_t _evictions = 0;
+};
+}
@@ -3,6 +3,7 @@
 #include <Tanker/Crypto/EncryptedSymmetricKey.hpp>
 #include <Tanker/Crypto/EncryptionKeyPair.hpp>
 #include <Tanker/Crypto/SealedPrivateEncryptionKey.hpp>
+#include <Tanker/Crypto/SigningContext.hpp>
 #include <Tanker/Crypto/TwoTimesSealedSymmetricKey.hpp>
 #include <Tanker/Identity/Delegation.hpp>
 #include <Tanker/ProvisionalUsers/SecretUser.hpp>
@@ -45,7 +46,7 @@ Trustchain::ClientEntry createNewGhostDeviceEntry(
 Trustchain::ClientEntry revokeDeviceEntry(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& author,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Trustchain::DeviceId const& toBeRevoked,
     Crypto::PublicEncryptionKey const& publicEncryptionKey,
     Crypto::SealedPrivateEncryptionKey const& encryptedKeyForPreviousUserKey,
@@ -56,13 +57,13 @@ Trustchain::ClientEntry revokeDeviceEntry(
 Trustchain::ClientEntry revokeDeviceV1Entry(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& author,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Trustchain::DeviceId const& toBeRevoked);
 
 Trustchain::ClientEntry createProvisionalIdentityClaimEntry(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Trustchain::UserId const& userId,
     ProvisionalUsers::SecretUser const& provisionalUser,
     Crypto::EncryptionKeyPair const& userKeyPair);
@@ -70,7 +71,7 @@ Trustchain::ClientEntry createProvisionalIdentityClaimEntry(
 Trustchain::ClientEntry createKeyPublishToProvisionalUserEntry(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Crypto::PublicSignatureKey const& appPublicSignatureKey,
     Crypto::PublicSignatureKey const& tankerPublicSignatureKey,
     Trustchain::ResourceId const& resourceId,
@@ -79,7 +80,7 @@ Trustchain::ClientEntry createKeyPublishToProvisionalUserEntry(
 Trustchain::ClientEntry createKeyPublishToUserEntry(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Crypto::SealedSymmetricKey const& symKey,
     Trustchain::ResourceId const& resourceId,
     Crypto::PublicEncryptionKey const& recipientPublicEncryptionKey);
@@ -25,7 +25,7 @@ public:
       gsl::span<Trustchain::UserId const> userIds) = 0;
   virtual tc::cotask<std::vector<Trustchain::ServerEntry>> getUsers(
       gsl::span<Trustchain::DeviceId const> deviceIds) = 0;
-  virtual tc::cotask<std::vector<std::string>> getKeyPublishes(
+  virtual tc::cotask<std::vector<Trustchain::ServerEntry>> getKeyPublishes(
       gsl::span<Trustchain::ResourceId const> resourceIds) = 0;
   virtual tc::cotask<void> authenticate(
       Trustchain::TrustchainId const& trustchainId,
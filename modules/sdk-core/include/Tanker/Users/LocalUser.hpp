@@ -1,10 +1,12 @@
 #pragma once
 
 #include <Tanker/Crypto/EncryptionKeyPair.hpp>
+#include <Tanker/Crypto/SigningContext.hpp>
 #include <Tanker/DeviceKeys.hpp>
 #include <Tanker/Trustchain/DeviceId.hpp>
 #include <Tanker/Trustchain/UserId.hpp>
 
+#include <memory>
 #include <optional>
 
 namespace Tanker::Users
@@ -20,6 +22,9 @@ public:
   Trustchain::UserId const& userId() const;
   Trustchain::DeviceId const& deviceId() const;
   DeviceKeys const& deviceKeys() const;
+  // Signs blocks with the device signature key. Hold the pointer across
+  // awaits: a pull replaces the local user, and with it its signer.
+  std::shared_ptr<Crypto::SigningContext const> deviceSigner() const;
   Crypto::EncryptionKeyPair currentKeyPair() const;
   std::optional<Crypto::EncryptionKeyPair> findKeyPair(
       Crypto::PublicEncryptionKey const& publicKey) const;
@@ -29,6 +34,8 @@ private:
   Trustchain::UserId _userId;
   Trustchain::DeviceId _deviceId;
   DeviceKeys _deviceKeys;
+  // shared so that copies of the local user do not expand the key again
+  std::shared_ptr<Crypto::SigningContext const> _deviceSigner;
   std::vector<Crypto::EncryptionKeyPair> _userKeys;
 };
 }
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include <Tanker/Trustchain/UserId.hpp>
 #include <Tanker/Users/IRequester.hpp>
 
+#include <tconcurrent/task_auto_canceler.hpp>
+
+#include <cstddef>
+
 namespace Tanker
 {
 struct DeviceKeys;
@@ -26,12 +30,18 @@ public:
       gsl::span<Trustchain::UserId const> userIds) override;
   tc::cotask<std::vector<Trustchain::ServerEntry>> getUsers(
       gsl::span<Trustchain::DeviceId const> deviceIds) override;
-  tc::cotask<std::vector<std::string>> getKeyPublishes(
+  tc::cotask<std::vector<Trustchain::ServerEntry>> getKeyPublishes(
       gsl::span<Trustchain::ResourceId const> resourceIds) override;
   tc::cotask<void> authenticate(
       Trustchain::TrustchainId const& trustchainId,
       Trustchain::UserId const& userId,
       Crypto::SignatureKeyPair const& userSignatureKeyPair) override;
+  // Only one connection of the client, authenticate() does all of them
+  tc::cotask<void> authenticateConnection(
+      std::size_t connection,
+      Trustchain::TrustchainId const& trustchainId,
+      Trustchain::UserId const& userId,
+      Crypto::SignatureKeyPair const& userSignatureKeyPair);
 
   tc::cotask<std::vector<
       std::tuple<Crypto::PublicSignatureKey, Crypto::PublicEncryptionKey>>>
@@ -39,6 +49,8 @@ public:
 
 private:
   Client* _client;
+  // the authentications of the connections
+  tc::task_auto_canceler _taskCanceler;
 };
 }
 }
@@ -15,6 +15,11 @@
 #include <optional>
 #include <vector>
 
+namespace Tanker
+{
+class Subscriptions;
+}
+
 namespace Tanker::Users
 {
 using UsersMap = boost::container::flat_map<Trustchain::UserId, Users::User>;
@@ -23,7 +28,10 @@ using DevicesMap = boost::container::flat_map<Trustchain::DeviceId, Device>;
 class UserAccessor : public IUserAccessor
 {
 public:
-  UserAccessor(Trustchain::Context trustchainCtx, Users::IRequester* requester);
+  // Without subscriptions, users are pulled each time they are used
+  UserAccessor(Trustchain::Context trustchainCtx,
+               Users::IRequester* requester,
+               Subscriptions* subscriptions = nullptr);
 
   UserAccessor() = delete;
   UserAccessor(UserAccessor const&) = delete;
@@ -44,9 +52,20 @@ private:
       -> tc::cotask<UsersMap>;
   auto fetch(gsl::span<Trustchain::DeviceId const> deviceIds)
       -> tc::cotask<DevicesMap>;
+  auto fetchAndCache(std::vector<Trustchain::UserId> const& userIds)
+      -> tc::cotask<UsersMap>;
+  bool isFresh(Trustchain::UserId const& userId) const;
+  void evictStale();
 
 private:
   Trustchain::Context _context;
   Users::IRequester* _requester;
+  Subscriptions* _subscriptions;
+
+  // The users pulled while subscribed, and their devices. They are only
+  // used while Subscriptions says they are fresh, and evicted at the next
+  // fetch once they are not.
+  UsersMap _cachedUsers;
+  DevicesMap _cachedDevices;
 };
 }
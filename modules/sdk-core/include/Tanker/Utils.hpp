@@ -1,10 +1,10 @@
+#include <Tanker/Encoding/Base64.hpp>
+#include <Tanker/Encoding/Errors/ErrcCategory.hpp>
 #include <Tanker/Errors/Errc.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Trustchain/GroupId.hpp>
 #include <Tanker/Types/SGroupId.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
-
 #include <algorithm>
 #include <type_traits>
 #include <vector>
@@ -18,10 +18,12 @@ T base64DecodeArgument(String const& b64)
 
   try
   {
-    return cppcodec::base64_rfc4648::decode<T>(b64);
+    return Encoding::base64Decode<T>(b64);
   }
-  catch (cppcodec::parse_error const&)
+  catch (Exception const& e)
   {
+    if (e.errorCode().category() != Encoding::ErrcCategory())
+      throw;
     throw Exception(make_error_code(Errc::InvalidArgument),
                     "base64 deserialization failed");
   }
@@ -1,5 +1,7 @@
 #include <Tanker/AsyncCore.hpp>
 
+#include <Tanker/Compute.hpp>
+#include <Tanker/Encoding/Base64.hpp>
 #include <Tanker/Encryptor.hpp>
 #include <Tanker/Log/LogHandler.hpp>
 #include <Tanker/Status.hpp>
@@ -8,7 +10,6 @@
 #include <Tanker/Utils.hpp>
 #include <Tanker/Version.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
 #include <tconcurrent/async.hpp>
 #include <tconcurrent/coroutine.hpp>
 #include <tconcurrent/thread_pool.hpp>
@@ -33,8 +34,12 @@ auto makeEventHandler(task_canceler& tc, std::function<void()> cb)
 
 AsyncCore::AsyncCore(std::string url,
                      Network::SdkInfo info,
-                     std::string writablePath)
-  : _core(std::move(url), std::move(info), std::move(writablePath))
+                     std::string writablePath,
+                     SessionOptions options)
+  : _core(std::move(url),
+          std::move(info),
+          std::move(writablePath),
+          std::move(options))
 {
 }
 
@@ -97,11 +102,34 @@ tc::shared_future<void> AsyncCore::encrypt(
 tc::shared_future<void> AsyncCore::decrypt(
     uint8_t* decryptedData, gsl::span<uint8_t const> encryptedData)
 {
+  // No coroutine, task or executor round trip when the key is cached
+  auto const key = encryptedData.size() < Compute::minOffloadedBytes() ?
+                       _core.findCachedKey(encryptedData) :
+                       std::nullopt;
+  if (key)
+  {
+    return tc::sync([&] {
+             Encryptor::decryptSync(decryptedData, *key, encryptedData);
+           })
+        .to_shared();
+  }
   return runResumable([=]() -> tc::cotask<void> {
     TC_AWAIT(this->_core.decrypt(decryptedData, encryptedData));
   });
 }
 
+expected<bool> AsyncCore::decryptSync(uint8_t* decryptedData,
+                                      gsl::span<uint8_t const> encryptedData)
+{
+  return tc::sync([&] {
+    auto const key = _core.findCachedKey(encryptedData);
+    if (!key)
+      return false;
+    Encryptor::decryptSync(decryptedData, *key, encryptedData);
+    return true;
+  });
+}
+
 tc::shared_future<std::vector<uint8_t>> AsyncCore::encrypt(
     gsl::span<uint8_t const> clearData,
     std::vector<SPublicIdentity> const& publicIdentities,
@@ -115,6 +143,19 @@ tc::shared_future<std::vector<uint8_t>> AsyncCore::encrypt(
 tc::shared_future<std::vector<uint8_t>> AsyncCore::decrypt(
     gsl::span<uint8_t const> encryptedData)
 {
+  auto const key = encryptedData.size() < Compute::minOffloadedBytes() ?
+                       _core.findCachedKey(encryptedData) :
+                       std::nullopt;
+  if (key)
+  {
+    return tc::sync([&] {
+             std::vector<uint8_t> decryptedData(
+                 Encryptor::decryptedSize(encryptedData));
+             Encryptor::decryptSync(decryptedData.data(), *key, encryptedData);
+             return decryptedData;
+           })
+        .to_shared();
+  }
   return runResumable([=]() -> tc::cotask<std::vector<uint8_t>> {
     std::vector<uint8_t> decryptedData(Encryptor::decryptedSize(encryptedData));
     TC_AWAIT(_core.decrypt(decryptedData.data(), encryptedData));
@@ -192,7 +233,7 @@ tc::shared_future<SDeviceId> AsyncCore::deviceId() const
 {
   return _taskCanceler.run([&] {
     return tc::async([this] {
-      return SDeviceId(cppcodec::base64_rfc4648::encode(_core.deviceId()));
+      return SDeviceId(Encoding::base64Encode(_core.deviceId()));
     });
   });
 }
@@ -272,8 +313,8 @@ expected<SResourceId> AsyncCore::getResourceId(
     gsl::span<uint8_t const> encryptedData)
 {
   return tc::sync([&] {
-    return cppcodec::base64_rfc4648::encode<SResourceId>(
-        Core::getResourceId(encryptedData));
+    return SResourceId{
+        Encoding::base64Encode(Core::getResourceId(encryptedData))};
   });
 }
 
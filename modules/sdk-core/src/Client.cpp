@@ -1,10 +1,14 @@
 #include <Tanker/Client.hpp>
 
 #include <Tanker/Crypto/Json/Json.hpp>
+#include <Tanker/Encoding/Base64.hpp>
 #include <Tanker/EncryptedUserKey.hpp>
+#include <Tanker/Errors/Errc.hpp>
 #include <Tanker/Errors/ServerErrc.hpp>
 #include <Tanker/Format/Json.hpp>
 #include <Tanker/Log/Log.hpp>
+#include <Tanker/Network/Negotiation.hpp>
+#include <Tanker/Trustchain/BlockFrame.hpp>
 #include <Tanker/Trustchain/TrustchainId.hpp>
 #include <Tanker/Trustchain/UserId.hpp>
 #include <Tanker/Types/TankerSecretProvisionalIdentity.hpp>
@@ -12,15 +16,15 @@
 #include <Tanker/Tracer/FuncTracer.hpp>
 #include <Tanker/Tracer/ScopeTimer.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
-
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 using namespace Tanker::Errors;
 using namespace Tanker::Trustchain;
@@ -31,7 +35,6 @@ namespace Tanker
 {
 namespace
 {
-
 std::map<std::string, ServerErrc> const serverErrorMap{
     {"internal_error", ServerErrc::InternalError},
     {"invalid_body", ServerErrc::InvalidBody},
@@ -53,31 +56,152 @@ std::map<std::string, ServerErrc> const serverErrorMap{
     {"invalid_oidc_id_token", ServerErrc::InvalidVerificationCode},
     {"conflict", ServerErrc::Conflict},
 };
+
+void throwIfError(nlohmann::json const& message)
+{
+  auto const error_it = message.find("error");
+  if (error_it == message.end())
+    return;
+  auto const errorMessage = error_it->at("message").get<std::string>();
+  auto const code = error_it->at("code").get<std::string>();
+  auto const serverErrorIt = serverErrorMap.find(code);
+  if (serverErrorIt == serverErrorMap.end())
+    throw Errors::formatEx(
+        ServerErrc::UnknownError, "code: {}, message: {}", code, errorMessage);
+  throw Errors::Exception(serverErrorIt->second, errorMessage);
+}
+
+std::vector<std::uint8_t> toBytes(std::string const& s)
+{
+  return {s.begin(), s.end()};
+}
+
+// Error replies and acknowledgements are json documents
+void throwIfError(std::vector<std::uint8_t> const& reply)
+{
+  throwIfError(nlohmann::json::parse(reply));
+}
+
+// The events whose reply or request can weigh megabytes: the blocks of users
+// with long device histories, of large groups, and the key publishes of a
+// share to many recipients
+bool isBulk(std::string const& eventName)
+{
+  return eventName == "get users blocks" ||
+         eventName == "get my user blocks" ||
+         eventName == "get groups blocks" || eventName == "push keys";
+}
+
+class PendingEmit
+{
+public:
+  explicit PendingEmit(std::size_t& count) : _count(count)
+  {
+    ++_count;
+  }
+
+  PendingEmit(PendingEmit const&) = delete;
+  PendingEmit& operator=(PendingEmit const&) = delete;
+
+  ~PendingEmit()
+  {
+    --_count;
+  }
+
+private:
+  std::size_t& _count;
+};
+}
+
+void Client::setBinaryBlocksEnabled(bool enabled)
+{
+  _binaryBlocksEnabled = enabled;
+}
+
+void Client::setNegotiationTimeout(std::chrono::milliseconds timeout)
+{
+  _negotiationTimeout = timeout;
+}
+
+std::chrono::milliseconds Client::negotiationTimeout() const
+{
+  return _negotiationTimeout;
 }
 
 Client::Client(Network::ConnectionPtr cx, ConnectionHandler connectionHandler)
-  : _cx(std::move(cx)), _connectionHandler(std::move(connectionHandler))
+  : _connectionHandler(std::move(connectionHandler))
 {
-  _cx->reconnected = [this] {
+  addConnection(std::move(cx));
+}
+
+void Client::addConnection(Network::ConnectionPtr cx)
+{
+  auto const index = _connections.size();
+  cx->reconnected = [this, index] {
+    // the server may have changed
+    _connections[index].binaryBlocks = BinaryBlocks::Unknown;
     if (_connectionHandler)
-      _taskCanceler.add(tc::async([this]() { _connectionHandler(); }));
+    {
+      _taskCanceler.add(
+          tc::async([this, index]() { _connectionHandler(index); }));
+    }
   };
+  _connections.push_back({std::move(cx)});
+}
+
+std::size_t Client::connectionCount() const
+{
+  return _connections.size();
 }
 
 void Client::start()
 {
   FUNC_BEGIN("client connection", Net);
-  _cx->connect();
+  for (auto& connection : _connections)
+    connection.cx->connect();
 }
 
 void Client::close()
 {
-  _cx->close();
+  for (auto& connection : _connections)
+    connection.cx->close();
+}
+
+void Client::on(std::string const& eventName,
+                Network::AConnection::Handler handler)
+{
+  _connections.front().cx->on(eventName, std::move(handler));
 }
 
 std::string Client::connectionId() const
 {
-  return this->_cx->id();
+  return _connections.front().cx->id();
+}
+
+RetryPolicy Client::readPolicy(std::chrono::milliseconds hedgeAfter)
+{
+  using namespace std::chrono_literals;
+  return {decorrelatedJitterDelays(5, 20ms, 2s), 30s, 15s, hedgeAfter,
+          &_circuitBreaker};
+}
+
+CircuitBreaker& Client::circuitBreaker()
+{
+  return _circuitBreaker;
+}
+
+std::size_t Client::route(std::string const& eventName) const
+{
+  if (_connections.size() == 1 || !isBulk(eventName))
+    return 0;
+  // the least busy of the bulk connections
+  auto const it = std::min_element(
+      _connections.begin() + 1,
+      _connections.end(),
+      [](auto const& a, auto const& b) {
+        return a.pendingEmits < b.pendingEmits;
+      });
+  return it - _connections.begin();
 }
 
 void Client::setConnectionHandler(ConnectionHandler handler)
@@ -108,22 +232,129 @@ tc::cotask<EncryptedUserKey> Client::getLastUserKey(
 tc::cotask<nlohmann::json> Client::emit(std::string const& eventName,
                                         nlohmann::json const& data)
 {
-  auto const stringmessage = TC_AWAIT(_cx->emit(
+  TC_RETURN(TC_AWAIT(emitOn(route(eventName), eventName, data)));
+}
+
+tc::cotask<nlohmann::json> Client::emitOn(std::size_t connection,
+                                          std::string const& eventName,
+                                          nlohmann::json const& data)
+{
+  auto& cx = _connections.at(connection);
+  PendingEmit pending(cx.pendingEmits);
+  auto const stringmessage = TC_AWAIT(cx.cx->emit(
       eventName,
       eventName == "push block" ? data.get<std::string>() : data.dump()));
   TDEBUG("emit({:s}, {:j}) -> {:s}", eventName, data, stringmessage);
+  auto message = nlohmann::json::parse(stringmessage);
+  throwIfError(message);
+  TC_RETURN(message);
+}
+
+tc::cotask<bool> Client::useBinaryBlocks(std::size_t connection)
+{
+  auto& cx = _connections[connection];
+  if (cx.binaryBlocks == BinaryBlocks::Unknown)
+  {
+    if (!_binaryBlocksEnabled || !cx.cx->canEmitBinary())
+      TC_RETURN(false);
+    // the emits made during the negotiation use json
+    cx.binaryBlocks = BinaryBlocks::Negotiating;
+    auto supported = false;
+    try
+    {
+      auto const reply = TC_AWAIT(Network::negotiate<nlohmann::json>(
+          [&]() -> tc::cotask<nlohmann::json> {
+            TC_RETURN(TC_AWAIT(
+                emitOn(connection,
+                       "binary blocks",
+                       {{"version", Trustchain::blockFrameVersion}})));
+          },
+          _negotiationTimeout));
+      if (reply)
+        supported = reply->value("binary_blocks", false);
+      else
+        TINFO("the server did not answer the binary blocks negotiation");
+    }
+    catch (Errors::Exception const& e)
+    {
+      TINFO("binary blocks are not supported: {}", e.what());
+    }
+    cx.binaryBlocks =
+        supported ? BinaryBlocks::Supported : BinaryBlocks::Unsupported;
+  }
+  TC_RETURN(cx.binaryBlocks == BinaryBlocks::Supported);
+}
+
+tc::cotask<std::vector<Trustchain::ServerEntry>> Client::emitForBlocks(
+    std::string const& eventName, nlohmann::json const& data)
+{
+  auto const connection = route(eventName);
+  auto& cx = _connections[connection];
+  if (TC_AWAIT(useBinaryBlocks(connection)))
+  {
+    PendingEmit pending(cx.pendingEmits);
+    auto const reply =
+        TC_AWAIT(cx.cx->emitBinary(eventName, toBytes(data.dump())));
+    TDEBUG("emitBinary({:s}, {:j}) -> {:d} bytes",
+           eventName,
+           data,
+           reply.size());
+    // frames start with their version, not with a brace
+    if (!reply.empty() && reply.front() == '{')
+    {
+      throwIfError(reply);
+      throw Errors::formatEx(Errors::Errc::InternalError,
+                             "unexpected reply to {}",
+                             eventName);
+    }
+    TC_RETURN(Trustchain::fromBinaryBlocksToServerEntries(reply));
+  }
+
+  PendingEmit pending(cx.pendingEmits);
+  auto const stringmessage = TC_AWAIT(cx.cx->emit(eventName, data.dump()));
+  TDEBUG("emit({:s}, {:j}) -> {:d} bytes",
+         eventName,
+         data,
+         stringmessage.size());
+  if (auto entries = Trustchain::fromJsonBlocksToServerEntries(stringmessage))
+    TC_RETURN(std::move(*entries));
+
   auto const message = nlohmann::json::parse(stringmessage);
-  auto const error_it = message.find("error");
-  if (error_it != message.end())
+  throwIfError(message);
+  // not an error either, let the conversion report what is wrong
+  TC_RETURN(Trustchain::fromBlocksToServerEntries(
+      message.get<std::vector<std::string>>()));
+}
+
+tc::cotask<void> Client::pushBlocks(
+    std::string const& eventName,
+    std::vector<std::vector<std::uint8_t>> const& blocks)
+{
+  auto const connection = route(eventName);
+  if (TC_AWAIT(useBinaryBlocks(connection)))
   {
-    auto const message = error_it->at("message").get<std::string>();
-    auto const code = error_it->at("code").get<std::string>();
-    auto const serverErrorIt = serverErrorMap.find(code);
-    if (serverErrorIt == serverErrorMap.end())
-      throw Errors::formatEx(
-          ServerErrc::UnknownError, "code: {}, message: {}", code, message);
-    throw Errors::Exception(serverErrorIt->second, message);
+    auto& cx = _connections[connection];
+    std::vector<gsl::span<std::uint8_t const>> spans;
+    spans.reserve(blocks.size());
+    for (auto const& block : blocks)
+      spans.push_back(block);
+    PendingEmit pending(cx.pendingEmits);
+    throwIfError(TC_AWAIT(
+        cx.cx->emitBinary(eventName, Trustchain::frameBlocks(spans))));
+    TC_RETURN();
   }
-  TC_RETURN(message);
+
+  if (eventName == "push block")
+  {
+    assert(blocks.size() == 1);
+    TC_AWAIT(emitOn(
+        connection, eventName, Encoding::base64Encode(blocks.front())));
+    TC_RETURN();
+  }
+  std::vector<std::string> encoded;
+  encoded.reserve(blocks.size());
+  for (auto const& block : blocks)
+    encoded.push_back(Encoding::base64Encode(block));
+  TC_AWAIT(emitOn(connection, eventName, encoded));
 }
 }
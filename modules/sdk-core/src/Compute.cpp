@@ -0,0 +1,86 @@
+#include <Tanker/Compute.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Tanker
+{
+namespace Compute
+{
+namespace
+{
+std::mutex poolMutex;
+std::size_t threadCount = 0;
+std::unique_ptr<tc::thread_pool> computePool;
+
+std::atomic<std::size_t> minOffloadedByteCount{1024 * 1024};
+
+std::atomic<std::uint64_t> taskCount{0};
+std::atomic<Clock::rep> totalQueueTime{0};
+std::atomic<Clock::rep> totalExecutionTime{0};
+}
+
+void setThreadCount(std::size_t count)
+{
+  if (count == 0)
+  {
+    throw Errors::formatEx(Errors::Errc::InvalidArgument,
+                           "the compute pool needs at least one thread");
+  }
+
+  std::lock_guard<std::mutex> lock(poolMutex);
+  if (computePool)
+  {
+    throw Errors::formatEx(Errors::Errc::PreconditionFailed,
+                           "the compute pool is already started");
+  }
+  threadCount = count;
+}
+
+tc::thread_pool& pool()
+{
+  std::lock_guard<std::mutex> lock(poolMutex);
+  if (!computePool)
+  {
+    computePool = std::make_unique<tc::thread_pool>();
+    // hardware_concurrency returns 0 when it can't tell
+    auto const count = threadCount ?
+                           threadCount :
+                           std::max(std::thread::hardware_concurrency(), 1u);
+    computePool->start(count);
+  }
+  return *computePool;
+}
+
+std::size_t minOffloadedBytes()
+{
+  return minOffloadedByteCount.load(std::memory_order_relaxed);
+}
+
+void setMinOffloadedBytes(std::size_t bytes)
+{
+  minOffloadedByteCount.store(bytes, std::memory_order_relaxed);
+}
+
+Metrics metrics()
+{
+  return {taskCount.load(),
+          Clock::duration(totalQueueTime.load()),
+          Clock::duration(totalExecutionTime.load())};
+}
+
+void recordTask(Clock::duration queueTime, Clock::duration executionTime)
+{
+  taskCount.fetch_add(1, std::memory_order_relaxed);
+  totalQueueTime.fetch_add(queueTime.count(), std::memory_order_relaxed);
+  totalExecutionTime.fetch_add(executionTime.count(),
+                               std::memory_order_relaxed);
+}
+}
+}
@@ -34,6 +34,8 @@
 
 #include <fmt/format.h>
 
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 
@@ -45,11 +47,15 @@ namespace Tanker
 {
 Core::~Core() = default;
 
-Core::Core(std::string url, Network::SdkInfo info, std::string writablePath)
+Core::Core(std::string url,
+           Network::SdkInfo info,
+           std::string writablePath,
+           SessionOptions options)
   : _url(std::move(url)),
     _info(std::move(info)),
     _writablePath(std::move(writablePath)),
-    _session(std::make_shared<Session>(_url, _info))
+    _options(std::move(options)),
+    _session(std::make_shared<Session>(_url, _info, _options))
 {
 }
 
@@ -69,7 +75,8 @@ Status Core::status() const
 
 void Core::reset()
 {
-  _session = std::make_shared<Session>(_url, _info);
+  std::atomic_store(&_resourceKeyCache, {});
+  _session = std::make_shared<Session>(_url, _info, _options);
 }
 
 template <typename F>
@@ -115,6 +122,8 @@ tc::cotask<Status> Core::startImpl(std::string const& b64Identity)
   _session->setIdentity(
       Identity::extract<Identity::SecretPermanentIdentity>(b64Identity));
   _session->createStorage(_writablePath);
+  std::atomic_store(&_resourceKeyCache,
+                    _session->storage().resourceKeyCache);
   auto const deviceKeys = TC_AWAIT(_session->getDeviceKeys());
   auto const [deviceExists, userExists, unused] = TC_AWAIT(
       _session->requesters().userStatus(_session->trustchainId(),
@@ -234,12 +243,12 @@ tc::cotask<void> Core::encrypt(
 
   TC_AWAIT(_session->storage().resourceKeyStore.putKey(metadata.resourceId,
                                                        metadata.key));
-  auto const& localUser = _session->accessors().localUserAccessor.get();
+  auto const localUser = _session->accessors().localUserAccessor.get();
   TC_AWAIT(Share::share(_session->accessors().userAccessor,
                         _session->accessors().groupAccessor,
                         _session->trustchainId(),
                         localUser.deviceId(),
-                        localUser.deviceKeys().signatureKeyPair.privateKey,
+                        localUser.deviceSigner(),
                         _session->pusher(),
                         {{metadata.key, metadata.resourceId}},
                         spublicIdentitiesWithUs,
@@ -280,6 +289,17 @@ tc::cotask<std::vector<uint8_t>> Core::decrypt(
   TC_RETURN(std::move(decryptedData));
 }
 
+std::optional<Crypto::SymmetricKey> Core::findCachedKey(
+    gsl::span<uint8_t const> encryptedData) const
+{
+  if (!Encryptor::hasSynchronousFormat(encryptedData))
+    return std::nullopt;
+  auto const cache = std::atomic_load(&_resourceKeyCache);
+  if (!cache)
+    return std::nullopt;
+  return cache->find(Encryptor::extractResourceId(encryptedData));
+}
+
 Trustchain::DeviceId const& Core::deviceId() const
 {
   assertStatus(Status::Ready, "deviceId");
@@ -317,7 +337,7 @@ tc::cotask<void> Core::share(
                         _session->accessors().groupAccessor,
                         _session->trustchainId(),
                         localUser.deviceId(),
-                        localUser.deviceKeys().signatureKeyPair.privateKey,
+                        localUser.deviceSigner(),
                         _session->pusher(),
                         resourceKeys,
                         spublicIdentities,
@@ -328,14 +348,14 @@ tc::cotask<SGroupId> Core::createGroup(
     std::vector<SPublicIdentity> const& spublicIdentities)
 {
   assertStatus(Status::Ready, "createGroup");
-  auto const& localUser = _session->accessors().localUserAccessor.get();
+  auto const localUser = _session->accessors().localUserAccessor.get();
   auto const groupId = TC_AWAIT(Groups::Manager::create(
       _session->accessors().userAccessor,
       _session->pusher(),
       spublicIdentities,
       _session->trustchainId(),
       localUser.deviceId(),
-      localUser.deviceKeys().signatureKeyPair.privateKey));
+      localUser.deviceSigner()));
   TC_RETURN(groupId);
 }
 
@@ -346,7 +366,7 @@ tc::cotask<void> Core::updateGroupMembers(
   assertStatus(Status::Ready, "updateGroupMembers");
   auto const groupId = base64DecodeArgument<Trustchain::GroupId>(groupIdString);
 
-  auto const& localUser = _session->accessors().localUserAccessor.get();
+  auto const localUser = _session->accessors().localUserAccessor.get();
   TC_AWAIT(Groups::Manager::updateMembers(
       _session->accessors().userAccessor,
       _session->pusher(),
@@ -355,7 +375,7 @@ tc::cotask<void> Core::updateGroupMembers(
       spublicIdentitiesToAdd,
       _session->trustchainId(),
       localUser.deviceId(),
-      localUser.deviceKeys().signatureKeyPair.privateKey));
+      localUser.deviceSigner()));
 }
 
 tc::cotask<void> Core::setVerificationMethod(Unlock::Verification const& method)
@@ -467,7 +487,7 @@ tc::cotask<void> Core::verifyProvisionalIdentity(
 tc::cotask<void> Core::revokeDevice(Trustchain::DeviceId const& deviceId)
 {
   assertStatus(Status::Ready, "revokeDevice");
-  auto const& localUser =
+  auto const localUser =
       TC_AWAIT(_session->accessors().localUserAccessor.pull());
   TC_AWAIT(Revocation::revokeDevice(deviceId,
                                     _session->trustchainId(),
@@ -480,6 +500,10 @@ tc::cotask<void> Core::nukeDatabase()
 {
   assertStatus(Status::Ready, "nukeDatabase");
   TC_AWAIT(_session->storage().db->nuke());
+  if (auto const& resourceKeyLog = _session->storage().resourceKeyLog)
+    resourceKeyLog->clear();
+  // decryptSync reads the cache without checking the session
+  _session->storage().resourceKeyCache->clear();
 }
 
 Trustchain::ResourceId Core::getResourceId(
@@ -508,13 +532,13 @@ tc::cotask<Streams::EncryptionStream> Core::makeEncryptionStream(
 
   TC_AWAIT(_session->storage().resourceKeyStore.putKey(
       encryptor.resourceId(), encryptor.symmetricKey()));
-  auto const& localUser =
+  auto const localUser =
       TC_AWAIT(_session->accessors().localUserAccessor.pull());
   TC_AWAIT(Share::share(_session->accessors().userAccessor,
                         _session->accessors().groupAccessor,
                         _session->trustchainId(),
                         localUser.deviceId(),
-                        localUser.deviceKeys().signatureKeyPair.privateKey,
+                        localUser.deviceSigner(),
                         _session->pusher(),
                         {{encryptor.symmetricKey(), encryptor.resourceId()}},
                         spublicIdentitiesWithUs,
@@ -551,10 +575,18 @@ tc::cotask<Streams::DecryptionStreamAdapter> Core::makeDecryptionStream(
       TC_RETURN(TC_AWAIT(this->getResourceKey(resourceId)));
     };
 
-    auto streamDecryptor = TC_AWAIT(Streams::DecryptionStream::create(
-        std::move(peekableSource), std::move(resourceKeyFinder)));
-    TC_RETURN(Streams::DecryptionStreamAdapter(std::move(streamDecryptor),
-                                               streamDecryptor.resourceId()));
+    // shared by the adapter's InputSource and BufferedReader
+    auto const streamDecryptor = std::make_shared<Streams::DecryptionStream>(
+        TC_AWAIT(Streams::DecryptionStream::create(
+            std::move(peekableSource), std::move(resourceKeyFinder))));
+    TC_RETURN(Streams::DecryptionStreamAdapter(
+        [streamDecryptor](std::uint8_t* out, std::int64_t n) {
+          return (*streamDecryptor)(out, n);
+        },
+        streamDecryptor->resourceId(),
+        [streamDecryptor](std::uint8_t* out, std::int64_t n) {
+          return streamDecryptor->readBuffered(out, n);
+        }));
   }
   else
   {
@@ -581,12 +613,12 @@ tc::cotask<EncryptionSession> Core::makeEncryptionSession(
   TC_AWAIT(_session->storage().resourceKeyStore.putKey(sess.resourceId(),
                                                        sess.sessionKey()));
 
-  auto const& localUser = _session->accessors().localUserAccessor.get();
+  auto const localUser = _session->accessors().localUserAccessor.get();
   TC_AWAIT(Share::share(_session->accessors().userAccessor,
                         _session->accessors().groupAccessor,
                         _session->trustchainId(),
                         localUser.deviceId(),
-                        localUser.deviceKeys().signatureKeyPair.privateKey,
+                        localUser.deviceSigner(),
                         _session->pusher(),
                         {{sess.sessionKey(), sess.resourceId()}},
                         spublicIdentitiesWithUs,
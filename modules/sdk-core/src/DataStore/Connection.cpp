@@ -54,6 +54,24 @@ void makeExclusive(ConnPtr& db)
   (*db)(update(access).set(access.last_access = 0).unconditionally());
 }
 
+void applyProfile(ConnPtr& db, ConnectionProfile profile, bool isEncrypted)
+{
+  if (profile != ConnectionProfile::WriteAheadLog)
+    return;
+
+  // SQLCipher fixes the page size of encrypted databases, and sqlite only
+  // honors it before the first table is created
+  if (!isEncrypted)
+    db->execute("PRAGMA page_size = 8192");
+  // readers no longer block the writer, and commits only fsync on checkpoints
+  db->execute("PRAGMA journal_mode = WAL");
+  db->execute("PRAGMA synchronous = NORMAL");
+  // 16MiB of page cache (negative values are in KiB)
+  db->execute("PRAGMA cache_size = -16384");
+  // SQLCipher ignores this one, pages have to go through decryption
+  db->execute("PRAGMA mmap_size = 268435456");
+}
+
 bool isEncryptedDb(std::string const& dbPath)
 {
   using namespace std::string_literals;
@@ -83,7 +101,8 @@ std::string hexUserSecret(
 
 ConnPtr createConnection(std::string const& dbPath,
                          std::optional<Crypto::SymmetricKey> userSecret,
-                         bool exclusive)
+                         bool exclusive,
+                         ConnectionProfile profile)
 {
   TINFO("creating database {}", dbPath);
   auto const isEncrypted = isEncryptedDb(dbPath);
@@ -134,6 +153,7 @@ ConnPtr createConnection(std::string const& dbPath,
 
     // Check the open succeeded
     db->execute("SELECT count(*) FROM sqlite_master");
+    applyProfile(db, profile, shouldEncrypt || shouldMigrate);
     if (exclusive)
       makeExclusive(db);
     return db;
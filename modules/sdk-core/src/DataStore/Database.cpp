@@ -28,12 +28,16 @@
 
 #include <optional>
 #include <sqlpp11/insert.h>
+#include <sqlpp11/parameter.h>
 #include <sqlpp11/select.h>
 #include <sqlpp11/sqlite3/insert_or.h>
+#include <tconcurrent/async.hpp>
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 TLOG_CATEGORY(Database);
@@ -101,6 +105,17 @@ Group rowToGroup(T const& row)
   else
     return rowToExternalGroup(row);
 }
+
+template <typename T>
+Tanker::ProvisionalUserKeys rowToProvisionalUserKeys(T const& row)
+{
+  return {
+      {DataStore::extractBlob<Crypto::PublicEncryptionKey>(row.app_enc_pub),
+       DataStore::extractBlob<Crypto::PrivateEncryptionKey>(row.app_enc_priv)},
+      {DataStore::extractBlob<Crypto::PublicEncryptionKey>(row.tanker_enc_pub),
+       DataStore::extractBlob<Crypto::PrivateEncryptionKey>(
+           row.tanker_enc_priv)}};
+}
 }
 
 using UserKeysTable = DbModels::user_keys::user_keys;
@@ -113,11 +128,124 @@ using GroupsTable = DbModels::groups::groups;
 using VersionTable = DbModels::version::version;
 using OldVersionsTable = DbModels::versions::versions;
 
+namespace
+{
+auto findResourceKeyQuery()
+{
+  ResourceKeysTable tab{};
+  return select(tab.resource_key)
+      .from(tab)
+      .where(tab.mac == parameter(tab.mac));
+}
+
+auto putResourceKeyQuery()
+{
+  ResourceKeysTable tab{};
+  return sqlpp::sqlite3::insert_or_ignore_into(tab).set(
+      tab.mac = parameter(tab.mac),
+      tab.resource_key = parameter(tab.resource_key));
+}
+
+auto findProvisionalUserKeysQuery()
+{
+  ProvisionalUserKeysTable tab{};
+  return select(tab.app_enc_priv,
+                tab.app_enc_pub,
+                tab.tanker_enc_priv,
+                tab.tanker_enc_pub)
+      .from(tab)
+      .where(tab.app_pub_sig_key == parameter(tab.app_pub_sig_key) and
+             tab.tanker_pub_sig_key == parameter(tab.tanker_pub_sig_key));
+}
+
+auto findProvisionalUserKeysByAppEncKeyQuery()
+{
+  ProvisionalUserKeysTable tab{};
+  return select(tab.app_enc_priv,
+                tab.app_enc_pub,
+                tab.tanker_enc_priv,
+                tab.tanker_enc_pub)
+      .from(tab)
+      .where(tab.app_enc_pub == parameter(tab.app_enc_pub));
+}
+
+auto findGroupByIdQuery()
+{
+  GroupsTable groups{};
+  return select(all_of(groups))
+      .from(groups)
+      .where(groups.group_id == parameter(groups.group_id));
+}
+
+auto findGroupByEncKeyQuery()
+{
+  GroupsTable groups{};
+  return select(all_of(groups))
+      .from(groups)
+      .where(groups.public_encryption_key ==
+             parameter(groups.public_encryption_key));
+}
+
+template <typename Query>
+using Prepared =
+    decltype(std::declval<Connection&>().prepare(std::declval<Query>()));
+}
+
+struct Database::Statements
+{
+  explicit Statements(Connection& db)
+    : findResourceKey(db.prepare(findResourceKeyQuery())),
+      putResourceKey(db.prepare(putResourceKeyQuery())),
+      findProvisionalUserKeys(db.prepare(findProvisionalUserKeysQuery())),
+      findProvisionalUserKeysByAppEncKey(
+          db.prepare(findProvisionalUserKeysByAppEncKeyQuery())),
+      findGroupById(db.prepare(findGroupByIdQuery())),
+      findGroupByEncKey(db.prepare(findGroupByEncKeyQuery()))
+  {
+  }
+
+  Prepared<decltype(findResourceKeyQuery())> findResourceKey;
+  Prepared<decltype(putResourceKeyQuery())> putResourceKey;
+  Prepared<decltype(findProvisionalUserKeysQuery())> findProvisionalUserKeys;
+  Prepared<decltype(findProvisionalUserKeysByAppEncKeyQuery())>
+      findProvisionalUserKeysByAppEncKey;
+  Prepared<decltype(findGroupByIdQuery())> findGroupById;
+  Prepared<decltype(findGroupByEncKeyQuery())> findGroupByEncKey;
+
+  // Blob parameters own a std::vector, sqlpp11 cannot bind a span. Copying
+  // this buffer into them reuses their capacity, so lookups do not allocate.
+  template <typename Parameter, typename T>
+  void bindBlob(Parameter& parameter, T const& value)
+  {
+    blobBuffer.assign(value.begin(), value.end());
+    parameter = blobBuffer;
+  }
+
+  std::vector<std::uint8_t> blobBuffer;
+};
+
 Database::Database(std::string const& dbPath,
                    std::optional<Crypto::SymmetricKey> const& userSecret,
-                   bool exclusive)
-  : _db(createConnection(dbPath, userSecret, exclusive))
+                   bool exclusive,
+                   ConnectionProfile profile)
+  : _dbPath(dbPath),
+    _userSecret(userSecret),
+    _exclusive(exclusive),
+    _profile(profile)
+{
+  _dbThread.start(1);
+}
+
+Database::~Database()
 {
+  // wait for in-flight statements before the connection goes away
+  _dbThread.stop();
+}
+
+template <typename F>
+tc::cotask<std::invoke_result_t<F>> Database::runOnDbThread(F&& f)
+{
+  TC_RETURN(TC_AWAIT(tc::async(_dbThread, std::forward<F>(f))));
 }
 
 template <typename Table>
@@ -222,19 +350,28 @@ void Database::performOldMigration()
 
 tc::cotask<void> Database::migrate()
 {
+  TC_AWAIT(runOnDbThread([this] {
+    _db = createConnection(_dbPath, _userSecret, _exclusive, _profile);
+    _userSecret.reset();
+  }));
   TC_AWAIT(inTransaction([&]() -> tc::cotask<void> {
-    // We used to have a version per table.
-    // We now have a unique version for the db.
-    // To migrate from the old system, we first create/migrate tables that
-    // existed in previous versions.
-    // Then we drop the old multiple-versions table, and set the global version
-    // to 3, which was the maximum version before.
-    // Finally, calling performUnifiedMigration will create new tables.
-    if (!tableExists<VersionTable>(*_db) && tableExists<OldVersionsTable>(*_db))
-      performOldMigration();
-    performUnifiedMigration();
-    TC_RETURN();
+    TC_AWAIT(runOnDbThread([this] {
+      // We used to have a version per table.
+      // We now have a unique version for the db.
+      // To migrate from the old system, we first create/migrate tables that
+      // existed in previous versions.
+      // Then we drop the old multiple-versions table, and set the global
+      // version to 3, which was the maximum version before.
+      // Finally, calling performUnifiedMigration will create new tables.
+      if (!tableExists<VersionTable>(*_db) &&
+          tableExists<OldVersionsTable>(*_db))
+        performOldMigration();
+      performUnifiedMigration();
+    }));
   }));
+  // prepare against the migrated schema
+  TC_AWAIT(runOnDbThread(
+      [this] { _statements = std::make_unique<Statements>(*_db); }));
 }
 
 void Database::setDatabaseVersion(int version)
@@ -281,138 +418,155 @@ void Database::dropTable()
 tc::cotask<void> Database::nuke()
 {
   FUNC_TIMER(DB);
-  flushAllCaches();
-  {
+  TC_AWAIT(runOnDbThread([this] {
+    flushAllCaches();
     DeviceKeysTable tab{};
     (*_db)(remove_from(tab).unconditionally());
-  }
-  TC_RETURN();
+  }));
 }
 
 tc::cotask<void> Database::startTransaction()
 {
   FUNC_TIMER(DB);
-  _transactions.push_back(start_transaction(*_db));
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread(
+      [this] { _transactions.push_back(start_transaction(*_db)); }));
 }
 
 tc::cotask<void> Database::commitTransaction()
 {
   FUNC_TIMER(DB);
-  assert(!_transactions.empty());
-  auto t = std::move(_transactions.back());
-  _transactions.pop_back();
-  t.commit();
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread([this] {
+    assert(!_transactions.empty());
+    auto t = std::move(_transactions.back());
+    _transactions.pop_back();
+    t.commit();
+  }));
 }
 
 tc::cotask<void> Database::rollbackTransaction()
 {
   FUNC_TIMER(DB);
-  assert(!_transactions.empty());
-  _transactions.pop_back();
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread([this] {
+    assert(!_transactions.empty());
+    _transactions.pop_back();
+  }));
 }
 
 tc::cotask<void> Database::putUserPrivateKey(
     Crypto::EncryptionKeyPair const& userKeyPair)
 {
   FUNC_TIMER(DB);
-  UserKeysTable tab{};
-  (*_db)(sqlpp::sqlite3::insert_or_ignore_into(tab).set(
-      tab.public_encryption_key = userKeyPair.publicKey.base(),
-      tab.private_encryption_key = userKeyPair.privateKey.base()));
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread([this, userKeyPair] {
+    UserKeysTable tab{};
+    (*_db)(sqlpp::sqlite3::insert_or_ignore_into(tab).set(
+        tab.public_encryption_key = userKeyPair.publicKey.base(),
+        tab.private_encryption_key = userKeyPair.privateKey.base()));
+  }));
 }
 
 tc::cotask<void> Database::putUserKeyPairs(
     gsl::span<Crypto::EncryptionKeyPair const> userKeyPairs)
 {
   FUNC_TIMER(DB);
-  UserKeysTable tab{};
-  auto multi_insert = sqlpp::sqlite3::insert_or_ignore_into(tab).columns(
-      tab.public_encryption_key, tab.private_encryption_key);
-  for (auto const& [pK, sK] : userKeyPairs)
-    multi_insert.values.add(tab.public_encryption_key = pK.base(),
-                            tab.private_encryption_key = sK.base());
-  (*_db)(multi_insert);
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread([this,
+                          userKeyPairs = std::vector<Crypto::EncryptionKeyPair>(
+                              userKeyPairs.begin(), userKeyPairs.end())] {
+    UserKeysTable tab{};
+    auto multi_insert = sqlpp::sqlite3::insert_or_ignore_into(tab).columns(
+        tab.public_encryption_key, tab.private_encryption_key);
+    for (auto const& [pK, sK] : userKeyPairs)
+      multi_insert.values.add(tab.public_encryption_key = pK.base(),
+                              tab.private_encryption_key = sK.base());
+    (*_db)(multi_insert);
+  }));
 }
 
 tc::cotask<std::vector<Crypto::EncryptionKeyPair>> Database::getUserKeyPairs()
 {
   FUNC_TIMER(DB);
-  UserKeysTable tab{};
-
-  auto rows =
-      (*_db)(select(tab.public_encryption_key, tab.private_encryption_key)
-                 .from(tab)
-                 .unconditionally());
-  std::vector<Crypto::EncryptionKeyPair> keys;
-  std::transform(rows.begin(),
-                 rows.end(),
-                 std::back_inserter(keys),
-                 [](auto&& row) -> Crypto::EncryptionKeyPair {
-                   return {DataStore::extractBlob<Crypto::PublicEncryptionKey>(
-                               row.public_encryption_key),
-                           DataStore::extractBlob<Crypto::PrivateEncryptionKey>(
-                               row.private_encryption_key)};
-                 });
-  TC_RETURN(keys);
+  TC_RETURN(TC_AWAIT(runOnDbThread([this] {
+    UserKeysTable tab{};
+
+    auto rows =
+        (*_db)(select(tab.public_encryption_key, tab.private_encryption_key)
+                   .from(tab)
+                   .unconditionally());
+    std::vector<Crypto::EncryptionKeyPair> keys;
+    std::transform(
+        rows.begin(),
+        rows.end(),
+        std::back_inserter(keys),
+        [](auto&& row) -> Crypto::EncryptionKeyPair {
+          return {DataStore::extractBlob<Crypto::PublicEncryptionKey>(
+                      row.public_encryption_key),
+                  DataStore::extractBlob<Crypto::PrivateEncryptionKey>(
+                      row.private_encryption_key)};
+        });
+    return keys;
+  })));
 }
 
 tc::cotask<std::optional<Crypto::PublicSignatureKey>>
 Database::findTrustchainPublicSignatureKey()
 {
   FUNC_TIMER(DB);
-  TrustchainInfoTable tab{};
-  auto rows = (*_db)(
-      select(tab.trustchain_public_signature_key).from(tab).unconditionally());
-  if (rows.empty())
-  {
-    throw Errors::AssertionError(
-        "trustchain_info table must have a single row");
-  }
-  if (rows.front().trustchain_public_signature_key.is_null())
-    TC_RETURN(std::nullopt);
-  TC_RETURN(DataStore::extractBlob<Crypto::PublicSignatureKey>(
-      rows.front().trustchain_public_signature_key));
+  TC_RETURN(TC_AWAIT(
+      runOnDbThread([this]() -> std::optional<Crypto::PublicSignatureKey> {
+        TrustchainInfoTable tab{};
+        auto rows = (*_db)(select(tab.trustchain_public_signature_key)
+                               .from(tab)
+                               .unconditionally());
+        if (rows.empty())
+        {
+          throw Errors::AssertionError(
+              "trustchain_info table must have a single row");
+        }
+        if (rows.front().trustchain_public_signature_key.is_null())
+          return std::nullopt;
+        return DataStore::extractBlob<Crypto::PublicSignatureKey>(
+            rows.front().trustchain_public_signature_key);
+      })));
 }
 
 tc::cotask<void> Database::setTrustchainPublicSignatureKey(
     Crypto::PublicSignatureKey const& key)
 {
   FUNC_TIMER(DB);
-  TrustchainInfoTable tab{};
-  (*_db)(update(tab)
-             .set(tab.trustchain_public_signature_key = key.base())
-             .unconditionally());
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread([this, key] {
+    TrustchainInfoTable tab{};
+    (*_db)(update(tab)
+               .set(tab.trustchain_public_signature_key = key.base())
+               .unconditionally());
+  }));
 }
 
 tc::cotask<void> Database::putResourceKey(ResourceId const& resourceId,
                                           Crypto::SymmetricKey const& key)
 {
   FUNC_TIMER(DB);
-  ResourceKeysTable tab{};
-
-  (*_db)(sqlpp::sqlite3::insert_or_ignore_into(tab).set(
-      tab.mac = resourceId.base(), tab.resource_key = key.base()));
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread([this, resourceId, key] {
+    auto& statement = _statements->putResourceKey;
+    _statements->bindBlob(statement.params.mac, resourceId);
+    _statements->bindBlob(statement.params.resource_key, key);
+    (*_db)(statement);
+  }));
 }
 
 tc::cotask<std::optional<Crypto::SymmetricKey>> Database::findResourceKey(
     ResourceId const& resourceId)
 {
   FUNC_TIMER(DB);
-  ResourceKeysTable tab{};
-  auto rows = (*_db)(
-      select(tab.resource_key).from(tab).where(tab.mac == resourceId.base()));
-  if (rows.empty())
-    TC_RETURN(std::nullopt);
-  auto const& row = rows.front();
+  TC_RETURN(TC_AWAIT(runOnDbThread(
+      [this, resourceId]() -> std::optional<Crypto::SymmetricKey> {
+        auto& statement = _statements->findResourceKey;
+        _statements->bindBlob(statement.params.mac, resourceId);
+        auto rows = (*_db)(statement);
+        if (rows.empty())
+          return std::nullopt;
+        auto const& row = rows.front();
 
-  TC_RETURN(DataStore::extractBlob<Crypto::SymmetricKey>(row.resource_key));
+        return DataStore::extractBlob<Crypto::SymmetricKey>(row.resource_key);
+      })));
 }
 
 tc::cotask<void> Database::putProvisionalUserKeys(
@@ -421,16 +575,20 @@ tc::cotask<void> Database::putProvisionalUserKeys(
     Tanker::ProvisionalUserKeys const& provisionalUserKeys)
 {
   FUNC_TIMER(DB);
-  ProvisionalUserKeysTable tab{};
-
-  (*_db)(sqlpp::sqlite3::insert_or_ignore_into(tab).set(
-      tab.app_pub_sig_key = appPublicSigKey.base(),
-      tab.tanker_pub_sig_key = tankerPublicSigKey.base(),
-      tab.app_enc_priv = provisionalUserKeys.appKeys.privateKey.base(),
-      tab.app_enc_pub = provisionalUserKeys.appKeys.publicKey.base(),
-      tab.tanker_enc_priv = provisionalUserKeys.tankerKeys.privateKey.base(),
-      tab.tanker_enc_pub = provisionalUserKeys.tankerKeys.publicKey.base()));
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread(
+      [this, appPublicSigKey, tankerPublicSigKey, provisionalUserKeys] {
+        ProvisionalUserKeysTable tab{};
+
+        (*_db)(sqlpp::sqlite3::insert_or_ignore_into(tab).set(
+            tab.app_pub_sig_key = appPublicSigKey.base(),
+            tab.tanker_pub_sig_key = tankerPublicSigKey.base(),
+            tab.app_enc_priv = provisionalUserKeys.appKeys.privateKey.base(),
+            tab.app_enc_pub = provisionalUserKeys.appKeys.publicKey.base(),
+            tab.tanker_enc_priv =
+                provisionalUserKeys.tankerKeys.privateKey.base(),
+            tab.tanker_enc_pub =
+                provisionalUserKeys.tankerKeys.publicKey.base()));
+      }));
 }
 
 tc::cotask<std::optional<Tanker::ProvisionalUserKeys>>
@@ -439,25 +597,19 @@ Database::findProvisionalUserKeys(
     Crypto::PublicSignatureKey const& tankerPublicSigKey)
 {
   FUNC_TIMER(DB);
-  ProvisionalUserKeysTable tab{};
-  auto rows =
-      (*_db)(select(tab.app_enc_priv,
-                    tab.app_enc_pub,
-                    tab.tanker_enc_priv,
-                    tab.tanker_enc_pub)
-                 .from(tab)
-                 .where(tab.app_pub_sig_key == appPublicSigKey.base() and
-                        tab.tanker_pub_sig_key == tankerPublicSigKey.base()));
-  if (rows.empty())
-    TC_RETURN(std::nullopt);
-  auto const& row = rows.front();
-  Tanker::ProvisionalUserKeys ret{
-      {DataStore::extractBlob<Crypto::PublicEncryptionKey>(row.app_enc_pub),
-       DataStore::extractBlob<Crypto::PrivateEncryptionKey>(row.app_enc_priv)},
-      {DataStore::extractBlob<Crypto::PublicEncryptionKey>(row.tanker_enc_pub),
-       DataStore::extractBlob<Crypto::PrivateEncryptionKey>(
-           row.tanker_enc_priv)}};
-  TC_RETURN(ret);
+  TC_RETURN(TC_AWAIT(runOnDbThread(
+      [this, appPublicSigKey, tankerPublicSigKey]()
+          -> std::optional<Tanker::ProvisionalUserKeys> {
+        auto& statement = _statements->findProvisionalUserKeys;
+        _statements->bindBlob(statement.params.app_pub_sig_key,
+                              appPublicSigKey);
+        _statements->bindBlob(statement.params.tanker_pub_sig_key,
+                              tankerPublicSigKey);
+        auto rows = (*_db)(statement);
+        if (rows.empty())
+          return std::nullopt;
+        return rowToProvisionalUserKeys(rows.front());
+      })));
 }
 
 tc::cotask<std::optional<Tanker::ProvisionalUserKeys>>
@@ -465,156 +617,161 @@ Database::findProvisionalUserKeysByAppPublicEncryptionKey(
     Crypto::PublicEncryptionKey const& appPublicEncryptionKey)
 {
   FUNC_TIMER(DB);
-  ProvisionalUserKeysTable tab{};
-  auto rows =
-      (*_db)(select(tab.app_enc_priv,
-                    tab.app_enc_pub,
-                    tab.tanker_enc_priv,
-                    tab.tanker_enc_pub)
-                 .from(tab)
-                 .where(tab.app_enc_pub == appPublicEncryptionKey.base()));
-  if (rows.empty())
-    TC_RETURN(std::nullopt);
-  auto const& row = rows.front();
-  Tanker::ProvisionalUserKeys ret{
-      {DataStore::extractBlob<Crypto::PublicEncryptionKey>(row.app_enc_pub),
-       DataStore::extractBlob<Crypto::PrivateEncryptionKey>(row.app_enc_priv)},
-      {DataStore::extractBlob<Crypto::PublicEncryptionKey>(row.tanker_enc_pub),
-       DataStore::extractBlob<Crypto::PrivateEncryptionKey>(
-           row.tanker_enc_priv)}};
-  TC_RETURN(ret);
+  TC_RETURN(TC_AWAIT(runOnDbThread(
+      [this,
+       appPublicEncryptionKey]() -> std::optional<Tanker::ProvisionalUserKeys> {
+        auto& statement = _statements->findProvisionalUserKeysByAppEncKey;
+        _statements->bindBlob(statement.params.app_enc_pub,
+                              appPublicEncryptionKey);
+        auto rows = (*_db)(statement);
+        if (rows.empty())
+          return std::nullopt;
+        return rowToProvisionalUserKeys(rows.front());
+      })));
 }
 
 tc::cotask<std::optional<DeviceKeys>> Database::getDeviceKeys()
 {
   FUNC_TIMER(DB);
-  DeviceKeysTable tab{};
-  auto rows = (*_db)(select(tab.private_signature_key,
-                            tab.public_signature_key,
-                            tab.private_encryption_key,
-                            tab.public_encryption_key,
-                            tab.device_id)
-                         .from(tab)
-                         .unconditionally());
-  if (rows.empty())
-    TC_RETURN(std::nullopt);
-
-  auto const& row = rows.front();
-  TC_RETURN((DeviceKeys{{DataStore::extractBlob<Crypto::PublicSignatureKey>(
-                             row.public_signature_key),
-                         DataStore::extractBlob<Crypto::PrivateSignatureKey>(
-                             row.private_signature_key)},
-                        {DataStore::extractBlob<Crypto::PublicEncryptionKey>(
-                             row.public_encryption_key),
-                         DataStore::extractBlob<Crypto::PrivateEncryptionKey>(
-                             row.private_encryption_key)}}));
+  TC_RETURN(TC_AWAIT(runOnDbThread([this]() -> std::optional<DeviceKeys> {
+    DeviceKeysTable tab{};
+    auto rows = (*_db)(select(tab.private_signature_key,
+                              tab.public_signature_key,
+                              tab.private_encryption_key,
+                              tab.public_encryption_key,
+                              tab.device_id)
+                           .from(tab)
+                           .unconditionally());
+    if (rows.empty())
+      return std::nullopt;
+
+    auto const& row = rows.front();
+    return DeviceKeys{{DataStore::extractBlob<Crypto::PublicSignatureKey>(
+                           row.public_signature_key),
+                       DataStore::extractBlob<Crypto::PrivateSignatureKey>(
+                           row.private_signature_key)},
+                      {DataStore::extractBlob<Crypto::PublicEncryptionKey>(
+                           row.public_encryption_key),
+                       DataStore::extractBlob<Crypto::PrivateEncryptionKey>(
+                           row.private_encryption_key)}};
+  })));
 }
 
 tc::cotask<void> Database::setDeviceKeys(DeviceKeys const& deviceKeys)
 {
   FUNC_TIMER(DB);
-  DeviceKeysTable tab{};
-  (*_db)(insert_into(tab).set(
-      tab.private_signature_key = deviceKeys.signatureKeyPair.privateKey.base(),
-      tab.public_signature_key = deviceKeys.signatureKeyPair.publicKey.base(),
-      tab.private_encryption_key =
-          deviceKeys.encryptionKeyPair.privateKey.base(),
-      tab.public_encryption_key =
-          deviceKeys.encryptionKeyPair.publicKey.base()));
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread([this, deviceKeys] {
+    DeviceKeysTable tab{};
+    (*_db)(insert_into(tab).set(
+        tab.private_signature_key =
+            deviceKeys.signatureKeyPair.privateKey.base(),
+        tab.public_signature_key = deviceKeys.signatureKeyPair.publicKey.base(),
+        tab.private_encryption_key =
+            deviceKeys.encryptionKeyPair.privateKey.base(),
+        tab.public_encryption_key =
+            deviceKeys.encryptionKeyPair.publicKey.base()));
+  }));
 }
 
 tc::cotask<void> Database::setDeviceId(Trustchain::DeviceId const& deviceId)
 {
   FUNC_TIMER(DB);
-  DeviceKeysTable tab{};
-  (*_db)(update(tab).set(tab.device_id = deviceId.base()).unconditionally());
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread([this, deviceId] {
+    DeviceKeysTable tab{};
+    (*_db)(update(tab).set(tab.device_id = deviceId.base()).unconditionally());
+  }));
 }
 
 tc::cotask<std::optional<Trustchain::DeviceId>> Database::getDeviceId()
 {
   FUNC_TIMER(DB);
-  DeviceKeysTable tab{};
-  auto rows = (*_db)(select(tab.device_id).from(tab).unconditionally());
-  if (rows.empty())
-    TC_RETURN(std::nullopt);
-  auto const& row = rows.front();
-  if (row.device_id.len == 0)
-    TC_RETURN(std::nullopt);
-  TC_RETURN((DataStore::extractBlob<Trustchain::DeviceId>(row.device_id)));
+  TC_RETURN(TC_AWAIT(
+      runOnDbThread([this]() -> std::optional<Trustchain::DeviceId> {
+        DeviceKeysTable tab{};
+        auto rows = (*_db)(select(tab.device_id).from(tab).unconditionally());
+        if (rows.empty())
+          return std::nullopt;
+        auto const& row = rows.front();
+        if (row.device_id.len == 0)
+          return std::nullopt;
+        return DataStore::extractBlob<Trustchain::DeviceId>(row.device_id);
+      })));
 }
 
 tc::cotask<void> Database::putInternalGroup(InternalGroup const& group)
 {
   FUNC_TIMER(DB);
-  GroupsTable groups;
-
-  (*_db)(sqlpp::sqlite3::insert_or_replace_into(groups).set(
-      groups.group_id = group.id.base(),
-      groups.public_signature_key = group.signatureKeyPair.publicKey.base(),
-      groups.private_signature_key = group.signatureKeyPair.privateKey.base(),
-      groups.encrypted_private_signature_key = sqlpp::null,
-      groups.public_encryption_key = group.encryptionKeyPair.publicKey.base(),
-      groups.private_encryption_key = group.encryptionKeyPair.privateKey.base(),
-      groups.last_group_block_hash = group.lastBlockHash.base()));
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread([this, group] {
+    GroupsTable groups;
+
+    (*_db)(sqlpp::sqlite3::insert_or_replace_into(groups).set(
+        groups.group_id = group.id.base(),
+        groups.public_signature_key = group.signatureKeyPair.publicKey.base(),
+        groups.private_signature_key =
+            group.signatureKeyPair.privateKey.base(),
+        groups.encrypted_private_signature_key = sqlpp::null,
+        groups.public_encryption_key =
+            group.encryptionKeyPair.publicKey.base(),
+        groups.private_encryption_key =
+            group.encryptionKeyPair.privateKey.base(),
+        groups.last_group_block_hash = group.lastBlockHash.base()));
+  }));
 }
 
 tc::cotask<void> Database::putExternalGroup(ExternalGroup const& group)
 {
   FUNC_TIMER(DB);
-
-  GroupsTable groups;
-
-  (*_db)(sqlpp::sqlite3::insert_or_replace_into(groups).set(
-      groups.group_id = group.id.base(),
-      groups.public_signature_key = group.publicSignatureKey.base(),
-      groups.private_signature_key = sqlpp::null,
-      groups.encrypted_private_signature_key =
-          group.encryptedPrivateSignatureKey.base(),
-      groups.public_encryption_key = group.publicEncryptionKey.base(),
-      groups.private_encryption_key = sqlpp::null,
-      groups.last_group_block_hash = group.lastBlockHash.base()));
-
-  TC_RETURN();
+  TC_AWAIT(runOnDbThread([this, group] {
+    GroupsTable groups;
+
+    (*_db)(sqlpp::sqlite3::insert_or_replace_into(groups).set(
+        groups.group_id = group.id.base(),
+        groups.public_signature_key = group.publicSignatureKey.base(),
+        groups.private_signature_key = sqlpp::null,
+        groups.encrypted_private_signature_key =
+            group.encryptedPrivateSignatureKey.base(),
+        groups.public_encryption_key = group.publicEncryptionKey.base(),
+        groups.private_encryption_key = sqlpp::null,
+        groups.last_group_block_hash = group.lastBlockHash.base()));
+  }));
 }
 
 tc::cotask<std::optional<Group>> Database::findGroupByGroupId(
     GroupId const& groupId)
 {
   FUNC_TIMER(DB);
-  GroupsTable groups{};
-
-  auto rows = (*_db)(select(all_of(groups))
-                         .from(groups)
-                         .where(groups.group_id == groupId.base()));
+  TC_RETURN(TC_AWAIT(runOnDbThread([this, groupId]() -> std::optional<Group> {
+    auto& statement = _statements->findGroupById;
+    _statements->bindBlob(statement.params.group_id, groupId);
+    auto rows = (*_db)(statement);
 
-  if (rows.empty())
-    TC_RETURN(std::nullopt);
+    if (rows.empty())
+      return std::nullopt;
 
-  auto const& row = *rows.begin();
+    auto const& row = *rows.begin();
 
-  TC_RETURN(rowToGroup(row));
+    return rowToGroup(row);
+  })));
 }
 
 tc::cotask<std::optional<Group>> Database::findGroupByGroupPublicEncryptionKey(
     Crypto::PublicEncryptionKey const& publicEncryptionKey)
 {
   FUNC_TIMER(DB);
-  GroupsTable groups{};
-
-  auto rows = (*_db)(
-      select(all_of(groups))
-          .from(groups)
-          .where(groups.public_encryption_key == publicEncryptionKey.base()));
+  TC_RETURN(TC_AWAIT(
+      runOnDbThread([this, publicEncryptionKey]() -> std::optional<Group> {
+        auto& statement = _statements->findGroupByEncKey;
+        _statements->bindBlob(statement.params.public_encryption_key,
+                              publicEncryptionKey);
+        auto rows = (*_db)(statement);
 
-  if (rows.empty())
-    TC_RETURN(std::nullopt);
+        if (rows.empty())
+          return std::nullopt;
 
-  auto const& row = *rows.begin();
+        auto const& row = *rows.begin();
 
-  TC_RETURN(rowToGroup(row));
+        return rowToGroup(row);
+      })));
 }
 }
 }
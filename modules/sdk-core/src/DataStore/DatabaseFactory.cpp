@@ -6,6 +6,7 @@
 #include <Tanker/DataStore/JsDatabase.hpp>
 #endif
 
+#include <Tanker/DataStore/MemoryDatabase.hpp>
 #include <Tanker/Log/Log.hpp>
 
 #include <Tanker/Tracer/ScopeTimer.hpp>
@@ -19,11 +20,15 @@ namespace DataStore
 tc::cotask<DatabasePtr> createDatabase(
     std::string const& dbPath,
     std::optional<Crypto::SymmetricKey> const& userSecret,
-    bool exclusive)
+    bool exclusive,
+    ConnectionProfile profile)
 {
   FUNC_TIMER(DB);
+  if (dbPath == ephemeralDbPath)
+    TC_RETURN(std::make_unique<MemoryDatabase>());
 #ifndef EMSCRIPTEN
-  auto db = std::make_unique<Database>(dbPath, userSecret, exclusive);
+  auto db =
+      std::make_unique<Database>(dbPath, userSecret, exclusive, profile);
   TC_AWAIT(db->migrate());
   TC_RETURN(std::move(db));
 #else
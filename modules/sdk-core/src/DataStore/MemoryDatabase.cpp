@@ -0,0 +1,235 @@
+#include <Tanker/DataStore/MemoryDatabase.hpp>
+
+#include <Tanker/Tracer/ScopeTimer.hpp>
+
+#include <boost/variant2/variant.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+using namespace Tanker::Trustchain;
+
+namespace Tanker
+{
+namespace DataStore
+{
+tc::cotask<void> MemoryDatabase::putUserPrivateKey(
+    Crypto::EncryptionKeyPair const& userKeyPair)
+{
+  TC_AWAIT(putUserKeyPairs(gsl::make_span(&userKeyPair, 1)));
+}
+
+tc::cotask<void> MemoryDatabase::putUserKeyPairs(
+    gsl::span<Crypto::EncryptionKeyPair const> userKeyPairs)
+{
+  FUNC_TIMER(DB);
+  auto& keyPairs = _state.userKeyPairs;
+  for (auto const& userKeyPair : userKeyPairs)
+  {
+    auto const known = std::any_of(
+        keyPairs.begin(), keyPairs.end(), [&](auto const& keyPair) {
+          return keyPair.publicKey == userKeyPair.publicKey;
+        });
+    if (!known)
+      keyPairs.push_back(userKeyPair);
+  }
+  TC_RETURN();
+}
+
+tc::cotask<std::vector<Crypto::EncryptionKeyPair>>
+MemoryDatabase::getUserKeyPairs()
+{
+  FUNC_TIMER(DB);
+  TC_RETURN(_state.userKeyPairs);
+}
+
+tc::cotask<std::optional<Crypto::PublicSignatureKey>>
+MemoryDatabase::findTrustchainPublicSignatureKey()
+{
+  FUNC_TIMER(DB);
+  TC_RETURN(_state.trustchainPublicSignatureKey);
+}
+
+tc::cotask<void> MemoryDatabase::setTrustchainPublicSignatureKey(
+    Crypto::PublicSignatureKey const& key)
+{
+  FUNC_TIMER(DB);
+  _state.trustchainPublicSignatureKey = key;
+  TC_RETURN();
+}
+
+tc::cotask<void> MemoryDatabase::putResourceKey(ResourceId const& resourceId,
+                                                Crypto::SymmetricKey const& key)
+{
+  FUNC_TIMER(DB);
+  _state.resourceKeys.emplace(resourceId, key);
+  TC_RETURN();
+}
+
+tc::cotask<std::optional<Crypto::SymmetricKey>> MemoryDatabase::findResourceKey(
+    ResourceId const& resourceId)
+{
+  FUNC_TIMER(DB);
+  auto const it = _state.resourceKeys.find(resourceId);
+  if (it == _state.resourceKeys.end())
+    TC_RETURN(std::nullopt);
+  TC_RETURN(it->second);
+}
+
+tc::cotask<void> MemoryDatabase::putProvisionalUserKeys(
+    Crypto::PublicSignatureKey const& appPublicSigKey,
+    Crypto::PublicSignatureKey const& tankerPublicSigKey,
+    ProvisionalUserKeys const& provisionalUserKeys)
+{
+  FUNC_TIMER(DB);
+  auto const inserted = _state.provisionalUserKeys
+                            .emplace(std::make_pair(appPublicSigKey,
+                                                    tankerPublicSigKey),
+                                     provisionalUserKeys)
+                            .second;
+  if (inserted)
+  {
+    _state.provisionalUserKeysByAppEncKey.emplace(
+        provisionalUserKeys.appKeys.publicKey, provisionalUserKeys);
+  }
+  TC_RETURN();
+}
+
+tc::cotask<std::optional<ProvisionalUserKeys>>
+MemoryDatabase::findProvisionalUserKeys(
+    Crypto::PublicSignatureKey const& appPublicSigKey,
+    Crypto::PublicSignatureKey const& tankerPublicSigKey)
+{
+  FUNC_TIMER(DB);
+  auto const it = _state.provisionalUserKeys.find(
+      std::make_pair(appPublicSigKey, tankerPublicSigKey));
+  if (it == _state.provisionalUserKeys.end())
+    TC_RETURN(std::nullopt);
+  TC_RETURN(it->second);
+}
+
+tc::cotask<std::optional<ProvisionalUserKeys>>
+MemoryDatabase::findProvisionalUserKeysByAppPublicEncryptionKey(
+    Crypto::PublicEncryptionKey const& appPublicEncryptionKey)
+{
+  FUNC_TIMER(DB);
+  auto const it =
+      _state.provisionalUserKeysByAppEncKey.find(appPublicEncryptionKey);
+  if (it == _state.provisionalUserKeysByAppEncKey.end())
+    TC_RETURN(std::nullopt);
+  TC_RETURN(it->second);
+}
+
+tc::cotask<std::optional<DeviceKeys>> MemoryDatabase::getDeviceKeys()
+{
+  FUNC_TIMER(DB);
+  TC_RETURN(_state.deviceKeys);
+}
+
+tc::cotask<void> MemoryDatabase::setDeviceKeys(DeviceKeys const& deviceKeys)
+{
+  FUNC_TIMER(DB);
+  // the database keeps the first row too
+  if (!_state.deviceKeys)
+    _state.deviceKeys = deviceKeys;
+  TC_RETURN();
+}
+
+tc::cotask<void> MemoryDatabase::setDeviceId(DeviceId const& deviceId)
+{
+  FUNC_TIMER(DB);
+  // the device id is a column of the device keys row
+  if (_state.deviceKeys)
+    _state.deviceId = deviceId;
+  TC_RETURN();
+}
+
+tc::cotask<std::optional<DeviceId>> MemoryDatabase::getDeviceId()
+{
+  FUNC_TIMER(DB);
+  TC_RETURN(_state.deviceId);
+}
+
+void MemoryDatabase::putGroup(Group const& group)
+{
+  auto const base = extractBaseGroup(group);
+  // replace the group, and any other group using the same key
+  if (auto const it = _state.groups.find(base.id()); it != _state.groups.end())
+  {
+    _state.groupIdsByEncKey.erase(
+        extractBaseGroup(it->second).publicEncryptionKey());
+  }
+  if (auto const it = _state.groupIdsByEncKey.find(base.publicEncryptionKey());
+      it != _state.groupIdsByEncKey.end())
+  {
+    _state.groups.erase(it->second);
+  }
+  _state.groups.insert_or_assign(base.id(), group);
+  _state.groupIdsByEncKey.insert_or_assign(base.publicEncryptionKey(),
+                                           base.id());
+}
+
+tc::cotask<void> MemoryDatabase::putInternalGroup(InternalGroup const& group)
+{
+  FUNC_TIMER(DB);
+  putGroup(group);
+  TC_RETURN();
+}
+
+tc::cotask<void> MemoryDatabase::putExternalGroup(ExternalGroup const& group)
+{
+  FUNC_TIMER(DB);
+  putGroup(group);
+  TC_RETURN();
+}
+
+tc::cotask<std::optional<Group>> MemoryDatabase::findGroupByGroupId(
+    GroupId const& groupId)
+{
+  FUNC_TIMER(DB);
+  auto const it = _state.groups.find(groupId);
+  if (it == _state.groups.end())
+    TC_RETURN(std::nullopt);
+  TC_RETURN(it->second);
+}
+
+tc::cotask<std::optional<Group>>
+MemoryDatabase::findGroupByGroupPublicEncryptionKey(
+    Crypto::PublicEncryptionKey const& publicEncryptionKey)
+{
+  FUNC_TIMER(DB);
+  auto const it = _state.groupIdsByEncKey.find(publicEncryptionKey);
+  if (it == _state.groupIdsByEncKey.end())
+    TC_RETURN(std::nullopt);
+  TC_RETURN(_state.groups.at(it->second));
+}
+
+tc::cotask<void> MemoryDatabase::nuke()
+{
+  FUNC_TIMER(DB);
+  _state = State{};
+  TC_RETURN();
+}
+
+tc::cotask<void> MemoryDatabase::startTransaction()
+{
+  _transactions.push_back(_state);
+  TC_RETURN();
+}
+
+tc::cotask<void> MemoryDatabase::commitTransaction()
+{
+  assert(!_transactions.empty());
+  _transactions.pop_back();
+  TC_RETURN();
+}
+
+tc::cotask<void> MemoryDatabase::rollbackTransaction()
+{
+  assert(!_transactions.empty());
+  _state = std::move(_transactions.back());
+  _transactions.pop_back();
+  TC_RETURN();
+}
+}
+}
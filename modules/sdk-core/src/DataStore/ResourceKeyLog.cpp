@@ -0,0 +1,569 @@
+#include <Tanker/DataStore/ResourceKeyLog.hpp>
+
+#include <Tanker/Crypto/AeadIv.hpp>
+#include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/Crypto/Mac.hpp>
+#include <Tanker/DataStore/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+#include <Tanker/Format/Format.hpp>
+#include <Tanker/Log/Log.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+TLOG_CATEGORY(ResourceKeyLog);
+
+namespace bip = boost::interprocess;
+
+namespace Tanker
+{
+namespace DataStore
+{
+namespace
+{
+constexpr std::string_view logMagic = "TKRKLOG1";
+constexpr std::string_view indexMagic = "TKRKIDX2";
+constexpr std::uint32_t logVersion = 1;
+
+// all integers are stored in native byte order, the files never leave the
+// device
+struct LogHeader
+{
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t recordSize;
+  std::uint64_t count;
+  // records before this one are known to be on disk
+  std::uint64_t verifiedCount;
+  std::uint8_t secretCheck[16];
+};
+
+struct IndexHeader
+{
+  char magic[8];
+  std::uint64_t capacity;
+  std::uint64_t count;
+  // records that are not duplicates of a previous one
+  std::uint64_t keys;
+  // 1 when the index was flushed and closed, it is not trusted otherwise
+  std::uint64_t clean;
+};
+
+constexpr std::uint64_t logHeaderSize = 64;
+// keeps the slots 8-byte aligned
+constexpr std::uint64_t indexHeaderSize = 64;
+static_assert(sizeof(LogHeader) <= logHeaderSize);
+static_assert(sizeof(IndexHeader) <= indexHeaderSize);
+
+// idHash | iv | encrypted(resourceId | key) | mac
+constexpr std::uint64_t idHashSize = 16;
+constexpr std::uint64_t recordClearSize =
+    Trustchain::ResourceId::arraySize + Crypto::SymmetricKey::arraySize;
+constexpr std::uint64_t recordSize = idHashSize + Crypto::AeadIv::arraySize +
+                                     recordClearSize + Crypto::Mac::arraySize;
+
+constexpr std::uint64_t minLogCapacity = 4096;
+constexpr std::uint64_t minIndexCapacity = 8192;
+
+template <typename T>
+T derive(std::string_view context, Crypto::SymmetricKey const& userSecret)
+{
+  std::vector<std::uint8_t> buffer(context.begin(), context.end());
+  buffer.insert(buffer.end(), userSecret.begin(), userSecret.end());
+  return Crypto::generichash<T>(buffer);
+}
+
+std::uint64_t nextPowerOfTwo(std::uint64_t n)
+{
+  std::uint64_t res = 1;
+  while (res < n)
+    res <<= 1;
+  return res;
+}
+
+// the index is kept at most half full
+std::uint64_t indexCapacityFor(std::uint64_t count)
+{
+  return std::max(minIndexCapacity, nextPowerOfTwo(count * 2 + 1));
+}
+
+void createIfMissing(std::string const& path)
+{
+  std::ofstream{path, std::ios::binary | std::ios::app};
+}
+
+template <typename Header>
+Header readHeader(std::uint8_t const* data)
+{
+  Header header;
+  std::memcpy(&header, data, sizeof(header));
+  return header;
+}
+
+template <typename Header>
+void writeHeader(std::uint8_t* data, Header const& header)
+{
+  std::memcpy(data, &header, sizeof(header));
+}
+}
+
+std::uint8_t* ResourceKeyLog::MappedFile::data() const
+{
+  return static_cast<std::uint8_t*>(region.get_address());
+}
+
+std::uint64_t ResourceKeyLog::MappedFile::size() const
+{
+  return region.get_size();
+}
+
+void ResourceKeyLog::MappedFile::remap(std::uint64_t size)
+{
+  // Windows refuses to resize a mapped file
+  unmap();
+  boost::filesystem::resize_file(path, size);
+  file = bip::file_mapping(path.c_str(), bip::read_write);
+  region = bip::mapped_region(file, bip::read_write);
+}
+
+void ResourceKeyLog::MappedFile::unmap()
+{
+  region = bip::mapped_region();
+  file = bip::file_mapping();
+}
+
+ResourceKeyLog::ResourceKeyLog(std::string const& path,
+                               Crypto::SymmetricKey const& userSecret)
+  : _encryptionKey(derive<Crypto::SymmetricKey>(
+        "tanker resource key log encryption", userSecret)),
+    _idKey(derive<Crypto::SymmetricKey>("tanker resource key log id",
+                                        userSecret))
+{
+  auto const check =
+      derive<Crypto::Mac>("tanker resource key log check", userSecret);
+  std::copy(check.begin(), check.end(), _secretCheck.begin());
+  _log.path = path;
+  _index.path = path + ".index";
+  open();
+  if (needsCompaction())
+    compact();
+}
+
+ResourceKeyLog::~ResourceKeyLog()
+{
+  if (!_log.data())
+    return;
+  try
+  {
+    markVerified();
+    setIndexClean(true);
+  }
+  catch (std::exception const& e)
+  {
+    TERROR("could not flush resource key log {}: {}", _log.path, e.what());
+  }
+}
+
+void ResourceKeyLog::open()
+{
+  try
+  {
+    openLog();
+    openIndex();
+  }
+  catch (bip::interprocess_exception const& e)
+  {
+    throw Errors::formatEx(Errc::DatabaseError,
+                           TFMT("could not map resource key log {:s}: {:s}"),
+                           _log.path,
+                           e.what());
+  }
+  catch (boost::filesystem::filesystem_error const& e)
+  {
+    throw Errors::formatEx(Errc::DatabaseError,
+                           TFMT("could not open resource key log {:s}: {:s}"),
+                           _log.path,
+                           e.what());
+  }
+}
+
+void ResourceKeyLog::openLog()
+{
+  createIfMissing(_log.path);
+  if (boost::filesystem::file_size(_log.path) == 0)
+  {
+    TINFO("creating resource key log {}", _log.path);
+    _log.remap(logHeaderSize + minLogCapacity * recordSize);
+    LogHeader header{};
+    std::copy(logMagic.begin(), logMagic.end(), header.magic);
+    header.version = logVersion;
+    header.recordSize = recordSize;
+    header.count = 0;
+    header.verifiedCount = 0;
+    std::copy(_secretCheck.begin(), _secretCheck.end(), header.secretCheck);
+    writeHeader(_log.data(), header);
+    markVerified();
+    return;
+  }
+
+  _log.remap(boost::filesystem::file_size(_log.path));
+  if (_log.size() < logHeaderSize)
+    throw Errors::Exception(Errc::DatabaseError, "truncated resource key log");
+  auto const header = readHeader<LogHeader>(_log.data());
+  if (std::string_view(header.magic, sizeof(header.magic)) != logMagic ||
+      header.version != logVersion || header.recordSize != recordSize)
+  {
+    throw Errors::formatEx(Errc::InvalidDatabaseVersion,
+                           "unsupported resource key log version {}",
+                           header.version);
+  }
+  if (!std::equal(
+          _secretCheck.begin(), _secretCheck.end(), header.secretCheck))
+  {
+    throw Errors::Exception(
+        Errc::DatabaseError,
+        "resource key log is encrypted with another user secret");
+  }
+  if (header.count > logCapacity())
+    throw Errors::Exception(Errc::DatabaseError, "truncated resource key log");
+
+  if (header.verifiedCount != header.count)
+  {
+    // The log was not closed, the records of the last session may not have
+    // reached the disk. Keep them up to the first one that does not decrypt.
+    auto count = std::min(header.verifiedCount, header.count);
+    std::array<std::uint8_t, recordClearSize> clear;
+    while (count < header.count && decryptRecord(count, clear))
+      ++count;
+    std::fill(clear.begin(), clear.end(), 0);
+    if (count != header.count)
+    {
+      TERROR("dropping {} unwritten records from resource key log {}",
+             header.count - count,
+             _log.path);
+      setLogCount(count);
+    }
+    markVerified();
+  }
+}
+
+void ResourceKeyLog::markVerified()
+{
+  // the records must be on disk before the header says so
+  _log.region.flush(0, 0, true);
+  auto header = readHeader<LogHeader>(_log.data());
+  header.verifiedCount = header.count;
+  writeHeader(_log.data(), header);
+  _log.region.flush(0, logHeaderSize, true);
+}
+
+void ResourceKeyLog::openIndex()
+{
+  createIfMissing(_index.path);
+  auto const fileSize = boost::filesystem::file_size(_index.path);
+  if (fileSize >= indexHeaderSize)
+  {
+    _index.remap(fileSize);
+    auto const header = readHeader<IndexHeader>(_index.data());
+    auto const valid =
+        std::string_view(header.magic, sizeof(header.magic)) == indexMagic &&
+        header.capacity >= minIndexCapacity &&
+        nextPowerOfTwo(header.capacity) == header.capacity &&
+        fileSize == indexHeaderSize + header.capacity * sizeof(std::uint64_t) &&
+        header.clean == 1 && header.keys <= header.count &&
+        header.count <= logCount() && logCount() * 2 <= header.capacity;
+    if (valid)
+    {
+      // catch up with records kept by the log after the last clean close
+      for (auto i = header.count; i < logCount(); ++i)
+        indexRecord(i);
+      setIndexCount(logCount());
+      setIndexClean(false);
+      return;
+    }
+  }
+  TINFO("rebuilding resource key log index {}", _index.path);
+  rebuildIndex(indexCapacityFor(logCount()));
+}
+
+void ResourceKeyLog::setIndexClean(bool clean)
+{
+  // the slots must be on disk before the header says so
+  if (clean)
+    _index.region.flush(0, 0, true);
+  auto header = readHeader<IndexHeader>(_index.data());
+  header.clean = clean ? 1 : 0;
+  writeHeader(_index.data(), header);
+  _index.region.flush(0, indexHeaderSize, true);
+}
+
+bool ResourceKeyLog::needsCompaction() const
+{
+  auto const count = logCount();
+  auto const duplicates = count - readHeader<IndexHeader>(_index.data()).keys;
+  if (duplicates * 4 > count)
+    return true;
+  // a log that lost most of its records to a crash keeps its capacity
+  return logCapacity() > minLogCapacity && count * 4 < logCapacity();
+}
+
+void ResourceKeyLog::rebuildIndex(std::uint64_t capacity)
+{
+  // truncate first, so that every slot is zeroed
+  _index.unmap();
+  boost::filesystem::resize_file(_index.path, 0);
+  _index.remap(indexHeaderSize + capacity * sizeof(std::uint64_t));
+  IndexHeader header{};
+  std::copy(indexMagic.begin(), indexMagic.end(), header.magic);
+  header.capacity = capacity;
+  header.count = 0;
+  header.keys = 0;
+  header.clean = 0;
+  writeHeader(_index.data(), header);
+  for (std::uint64_t i = 0; i < logCount(); ++i)
+    indexRecord(i);
+  setIndexCount(logCount());
+  _index.region.flush(0, 0, true);
+}
+
+ResourceKeyLog::IdHash ResourceKeyLog::hashId(
+    Trustchain::ResourceId const& resourceId) const
+{
+  constexpr auto bufferSize =
+      Crypto::SymmetricKey::arraySize + Trustchain::ResourceId::arraySize;
+  std::array<std::uint8_t, bufferSize> buffer;
+  auto const it = std::copy(_idKey.begin(), _idKey.end(), buffer.begin());
+  std::copy(resourceId.begin(), resourceId.end(), it);
+  IdHash idHash;
+  Crypto::generichash16(buffer, idHash);
+  return idHash;
+}
+
+std::uint8_t* ResourceKeyLog::record(std::uint64_t index) const
+{
+  return _log.data() + logHeaderSize + index * recordSize;
+}
+
+std::uint64_t ResourceKeyLog::logCount() const
+{
+  return readHeader<LogHeader>(_log.data()).count;
+}
+
+std::uint64_t ResourceKeyLog::logCapacity() const
+{
+  return (_log.size() - logHeaderSize) / recordSize;
+}
+
+std::uint64_t* ResourceKeyLog::slots() const
+{
+  return reinterpret_cast<std::uint64_t*>(_index.data() + indexHeaderSize);
+}
+
+std::uint64_t ResourceKeyLog::indexCount() const
+{
+  return readHeader<IndexHeader>(_index.data()).count;
+}
+
+std::uint64_t ResourceKeyLog::indexCapacity() const
+{
+  return readHeader<IndexHeader>(_index.data()).capacity;
+}
+
+bool ResourceKeyLog::decryptRecord(std::uint64_t index,
+                                   gsl::span<std::uint8_t> clear) const
+{
+  auto const rec = gsl::make_span(record(index), recordSize);
+  try
+  {
+    Crypto::decryptAead(_encryptionKey,
+                        clear,
+                        rec.subspan(idHashSize),
+                        rec.subspan(0, idHashSize));
+    return true;
+  }
+  catch (Errors::Exception const&)
+  {
+    return false;
+  }
+}
+
+std::optional<std::uint64_t> ResourceKeyLog::findRecord(
+    IdHash const& idHash) const
+{
+  std::uint64_t bucket;
+  std::memcpy(&bucket, idHash.data(), sizeof(bucket));
+  auto const mask = indexCapacity() - 1;
+  auto const count = logCount();
+  auto const slotArray = slots();
+  for (auto i = bucket & mask;; i = (i + 1) & mask)
+  {
+    auto const slot = slotArray[i];
+    if (slot == 0)
+      return std::nullopt;
+    auto const index = slot - 1;
+    if (index < count &&
+        std::equal(idHash.begin(), idHash.end(), record(index)))
+      return index;
+  }
+}
+
+void ResourceKeyLog::indexRecord(std::uint64_t index)
+{
+  IdHash idHash;
+  std::copy_n(record(index), idHash.size(), idHash.begin());
+  // keep the first record, like the database ignores duplicate inserts
+  if (findRecord(idHash))
+    return;
+
+  std::uint64_t bucket;
+  std::memcpy(&bucket, idHash.data(), sizeof(bucket));
+  auto const mask = indexCapacity() - 1;
+  auto const slotArray = slots();
+  auto i = bucket & mask;
+  while (slotArray[i] != 0)
+    i = (i + 1) & mask;
+  slotArray[i] = index + 1;
+
+  auto header = readHeader<IndexHeader>(_index.data());
+  ++header.keys;
+  writeHeader(_index.data(), header);
+}
+
+void ResourceKeyLog::setLogCount(std::uint64_t count)
+{
+  auto header = readHeader<LogHeader>(_log.data());
+  header.count = count;
+  writeHeader(_log.data(), header);
+}
+
+void ResourceKeyLog::setIndexCount(std::uint64_t count)
+{
+  auto header = readHeader<IndexHeader>(_index.data());
+  header.count = count;
+  writeHeader(_index.data(), header);
+}
+
+tc::cotask<void> ResourceKeyLog::putResourceKey(
+    Trustchain::ResourceId const& resourceId, Crypto::SymmetricKey const& key)
+{
+  std::scoped_lock lock(_mutex);
+
+  auto const idHash = hashId(resourceId);
+  if (findRecord(idHash))
+    TC_RETURN();
+
+  auto const count = logCount();
+  if (count == logCapacity())
+    _log.remap(logHeaderSize + count * 2 * recordSize);
+  if ((count + 1) * 2 > indexCapacity())
+    rebuildIndex(indexCapacityFor(count + 1));
+
+  std::array<std::uint8_t, recordClearSize> clear;
+  auto const it =
+      std::copy(resourceId.begin(), resourceId.end(), clear.begin());
+  std::copy(key.begin(), key.end(), it);
+
+  auto const rec = gsl::make_span(record(count), recordSize);
+  std::copy(idHash.begin(), idHash.end(), rec.begin());
+  Crypto::encryptAead(_encryptionKey, rec.subspan(idHashSize), clear, idHash);
+  std::fill(clear.begin(), clear.end(), 0);
+
+  // left to the page cache, see markVerified()
+  setLogCount(count + 1);
+
+  indexRecord(count);
+  setIndexCount(count + 1);
+}
+
+tc::cotask<std::optional<Crypto::SymmetricKey>>
+ResourceKeyLog::findResourceKey(Trustchain::ResourceId const& resourceId)
+{
+  std::scoped_lock lock(_mutex);
+
+  auto const idHash = hashId(resourceId);
+  auto const index = findRecord(idHash);
+  if (!index)
+    TC_RETURN(std::nullopt);
+
+  std::array<std::uint8_t, recordClearSize> clear;
+  if (!decryptRecord(*index, clear) ||
+      !std::equal(resourceId.begin(), resourceId.end(), clear.begin()))
+  {
+    throw Errors::formatEx(Errc::DatabaseError,
+                           "corrupted record {} in resource key log",
+                           *index);
+  }
+  Crypto::SymmetricKey key(
+      gsl::make_span(clear).subspan(Trustchain::ResourceId::arraySize));
+  std::fill(clear.begin(), clear.end(), 0);
+  TC_RETURN(key);
+}
+
+std::uint64_t ResourceKeyLog::size() const
+{
+  std::scoped_lock lock(_mutex);
+  return logCount();
+}
+
+void ResourceKeyLog::clear()
+{
+  std::scoped_lock lock(_mutex);
+  _log.unmap();
+  _index.unmap();
+  boost::filesystem::remove(_log.path);
+  boost::filesystem::remove(_index.path);
+  open();
+}
+
+void ResourceKeyLog::compact()
+{
+  std::scoped_lock lock(_mutex);
+
+  auto const count = logCount();
+  MappedFile compacted{_log.path + ".compact"};
+  createIfMissing(compacted.path);
+  compacted.remap(logHeaderSize +
+                  std::max(count, minLogCapacity) * recordSize);
+
+  std::uint64_t kept = 0;
+  for (std::uint64_t i = 0; i < count; ++i)
+  {
+    IdHash idHash;
+    std::copy_n(record(i), idHash.size(), idHash.begin());
+    // the id hash is the associated data, records can move as they are
+    if (findRecord(idHash) == i)
+    {
+      std::copy_n(record(i),
+                  recordSize,
+                  compacted.data() + logHeaderSize + kept * recordSize);
+      ++kept;
+    }
+  }
+  auto header = readHeader<LogHeader>(_log.data());
+  header.count = kept;
+  header.verifiedCount = kept;
+  writeHeader(compacted.data(), header);
+  compacted.region.flush(0, 0, true);
+  compacted.unmap();
+  boost::filesystem::resize_file(
+      compacted.path,
+      logHeaderSize + std::max(kept, minLogCapacity) * recordSize);
+
+  TINFO("compacted resource key log {}: {} records kept out of {}",
+        _log.path,
+        kept,
+        count);
+  _log.unmap();
+  _index.unmap();
+  boost::filesystem::rename(compacted.path, _log.path);
+  boost::filesystem::remove(_index.path);
+  open();
+}
+}
+}
@@ -1,5 +1,6 @@
 #include <Tanker/EncryptionSession.hpp>
 
+#include <Tanker/Compute.hpp>
 #include <Tanker/Crypto/Crypto.hpp>
 #include <Tanker/Encryptor/v5.hpp>
 #include <Tanker/Errors/Exception.hpp>
@@ -54,7 +55,26 @@ tconcurrent::cotask<Tanker::EncryptionMetadata> EncryptionSession::encrypt(
     std::uint8_t* encryptedData, gsl::span<const std::uint8_t> clearData)
 {
   assertSession("encrypt");
-  TC_RETURN(TC_AWAIT(EncryptorV5::encrypt(
-      encryptedData, clearData, _resourceId, _sessionKey)));
+  if (clearData.size() < Compute::minOffloadedBytes())
+  {
+    TC_RETURN(TC_AWAIT(EncryptorV5::encrypt(
+        encryptedData, clearData, _resourceId, _sessionKey)));
+  }
+  TC_RETURN(TC_AWAIT(Compute::runResumable(
+      [encryptedData,
+       clearData,
+       resourceId = _resourceId,
+       sessionKey = _sessionKey] {
+        return EncryptorV5::encrypt(
+            encryptedData, clearData, resourceId, sessionKey);
+      })));
+}
+
+Tanker::EncryptionMetadata EncryptionSession::encryptSync(
+    std::uint8_t* encryptedData, gsl::span<const std::uint8_t> clearData)
+{
+  assertSession("encryptSync");
+  return EncryptorV5::encryptSync(
+      encryptedData, clearData, _resourceId, _sessionKey);
 }
 }
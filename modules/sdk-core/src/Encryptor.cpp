@@ -1,5 +1,6 @@
 #include <Tanker/Encryptor.hpp>
 
+#include <Tanker/Compute.hpp>
 #include <Tanker/Crypto/Crypto.hpp>
 #include <Tanker/Encryptor/v2.hpp>
 #include <Tanker/Encryptor/v3.hpp>
@@ -62,17 +63,19 @@ uint64_t decryptedSize(gsl::span<uint8_t const> encryptedData)
   });
 }
 
-tc::cotask<EncryptionMetadata> encrypt(uint8_t* encryptedData,
-                                       gsl::span<uint8_t const> clearData)
+namespace
+{
+tc::cotask<EncryptionMetadata> encryptInline(
+    uint8_t* encryptedData, gsl::span<uint8_t const> clearData)
 {
   if (isHugeClearData(clearData.size()))
     TC_RETURN(TC_AWAIT(EncryptorV4::encrypt(encryptedData, clearData)));
   TC_RETURN(TC_AWAIT(EncryptorV3::encrypt(encryptedData, clearData)));
 }
 
-tc::cotask<void> decrypt(uint8_t* decryptedData,
-                         Crypto::SymmetricKey const& key,
-                         gsl::span<uint8_t const> encryptedData)
+tc::cotask<void> decryptInline(uint8_t* decryptedData,
+                               Crypto::SymmetricKey const& key,
+                               gsl::span<uint8_t const> encryptedData)
 {
   auto const version = Serialization::varint_read(encryptedData).first;
 
@@ -80,6 +83,63 @@ tc::cotask<void> decrypt(uint8_t* decryptedData,
     return encryptor.decrypt(decryptedData, key, encryptedData);
   });
 }
+}
+
+tc::cotask<EncryptionMetadata> encrypt(uint8_t* encryptedData,
+                                       gsl::span<uint8_t const> clearData)
+{
+  if (clearData.size() < Compute::minOffloadedBytes())
+    TC_RETURN(TC_AWAIT(encryptInline(encryptedData, clearData)));
+  TC_RETURN(TC_AWAIT(Compute::runResumable(
+      [&] { return encryptInline(encryptedData, clearData); })));
+}
+
+tc::cotask<void> decrypt(uint8_t* decryptedData,
+                         Crypto::SymmetricKey const& key,
+                         gsl::span<uint8_t const> encryptedData)
+{
+  if (encryptedData.size() < Compute::minOffloadedBytes())
+    TC_AWAIT(decryptInline(decryptedData, key, encryptedData));
+  else
+    TC_AWAIT(Compute::runResumable(
+        [&] { return decryptInline(decryptedData, key, encryptedData); }));
+}
+
+bool hasSynchronousFormat(gsl::span<uint8_t const> encryptedData)
+{
+  // these versions fit in the first byte of the varint
+  if (encryptedData.empty())
+    return false;
+  switch (encryptedData[0])
+  {
+  case EncryptorV2::version():
+    return encryptedData.size() >= EncryptorV2::encryptedSize(0);
+  case EncryptorV3::version():
+    return encryptedData.size() >= EncryptorV3::encryptedSize(0);
+  case EncryptorV5::version():
+    return encryptedData.size() >= EncryptorV5::encryptedSize(0);
+  default:
+    return false;
+  }
+}
+
+void decryptSync(uint8_t* decryptedData,
+                 Crypto::SymmetricKey const& key,
+                 gsl::span<uint8_t const> encryptedData)
+{
+  switch (Serialization::varint_read(encryptedData).first)
+  {
+  case EncryptorV2::version():
+    return EncryptorV2::decryptSync(decryptedData, key, encryptedData);
+  case EncryptorV3::version():
+    return EncryptorV3::decryptSync(decryptedData, key, encryptedData);
+  case EncryptorV5::version():
+    return EncryptorV5::decryptSync(decryptedData, key, encryptedData);
+  default:
+    throw formatEx(Errc::InvalidArgument,
+                   "this encrypted buffer cannot be decrypted synchronously");
+  }
+}
 
 tc::cotask<std::vector<uint8_t>> decryptFallbackAead(
     Crypto::SymmetricKey const& key, gsl::span<uint8_t const> encryptedData)
@@ -71,6 +71,14 @@ tc::cotask<void> EncryptorV2::decrypt(
     std::uint8_t* decryptedData,
     Crypto::SymmetricKey const& key,
     gsl::span<std::uint8_t const> encryptedData)
+{
+  decryptSync(decryptedData, key, encryptedData);
+  TC_RETURN();
+}
+
+void EncryptorV2::decryptSync(std::uint8_t* decryptedData,
+                              Crypto::SymmetricKey const& key,
+                              gsl::span<std::uint8_t const> encryptedData)
 {
   try
   {
@@ -81,7 +89,6 @@ tc::cotask<void> EncryptorV2::decrypt(
     auto const iv = versionRemoved.data();
     auto const cipherText = versionRemoved.subspan(Crypto::AeadIv::arraySize);
     Crypto::decryptAead(key, iv, decryptedData, cipherText, {});
-    TC_RETURN();
   }
   catch (gsl::fail_fast const&)
   {
@@ -62,13 +62,20 @@ tc::cotask<void> EncryptorV3::decrypt(
     std::uint8_t* decryptedData,
     Crypto::SymmetricKey const& key,
     gsl::span<std::uint8_t const> encryptedData)
+{
+  decryptSync(decryptedData, key, encryptedData);
+  TC_RETURN();
+}
+
+void EncryptorV3::decryptSync(std::uint8_t* decryptedData,
+                              Crypto::SymmetricKey const& key,
+                              gsl::span<std::uint8_t const> encryptedData)
 {
   checkEncryptedFormat(encryptedData);
 
   auto const versionResult = Serialization::varint_read(encryptedData);
   auto const iv = Crypto::AeadIv{};
   Crypto::decryptAead(key, iv.data(), decryptedData, versionResult.second, {});
-  TC_RETURN();
 }
 
 ResourceId EncryptorV3::extractResourceId(
@@ -56,6 +56,24 @@ tc::cotask<EncryptionMetadata> EncryptorV5::encrypt(
     gsl::span<std::uint8_t const> clearData,
     ResourceId const& resourceId,
     Crypto::SymmetricKey const& key)
+{
+  TC_RETURN(encryptSync(encryptedData, clearData, resourceId, key));
+}
+
+tc::cotask<void> EncryptorV5::decrypt(
+    std::uint8_t* decryptedData,
+    Crypto::SymmetricKey const& key,
+    gsl::span<std::uint8_t const> encryptedData)
+{
+  decryptSync(decryptedData, key, encryptedData);
+  TC_RETURN();
+}
+
+EncryptionMetadata EncryptorV5::encryptSync(
+    std::uint8_t* encryptedData,
+    gsl::span<std::uint8_t const> clearData,
+    ResourceId const& resourceId,
+    Crypto::SymmetricKey const& key)
 {
   Serialization::varint_write(encryptedData, version());
   std::copy(resourceId.begin(), resourceId.end(), encryptedData + versionSize);
@@ -67,13 +85,12 @@ tc::cotask<EncryptionMetadata> EncryptorV5::encrypt(
                           Crypto::AeadIv::arraySize,
                       clearData,
                       resourceId);
-  TC_RETURN((EncryptionMetadata{resourceId, key}));
+  return EncryptionMetadata{resourceId, key};
 }
 
-tc::cotask<void> EncryptorV5::decrypt(
-    std::uint8_t* decryptedData,
-    Crypto::SymmetricKey const& key,
-    gsl::span<std::uint8_t const> encryptedData)
+void EncryptorV5::decryptSync(std::uint8_t* decryptedData,
+                              Crypto::SymmetricKey const& key,
+                              gsl::span<std::uint8_t const> encryptedData)
 {
   checkEncryptedFormat(encryptedData);
 
@@ -83,7 +100,6 @@ tc::cotask<void> EncryptorV5::decrypt(
   auto const data = encryptedData.subspan(versionSize + ResourceId::arraySize +
                                           Crypto::AeadIv::arraySize);
   Crypto::decryptAead(key, iv.data(), decryptedData, data, resourceId);
-  TC_RETURN();
 }
 
 ResourceId EncryptorV5::extractResourceId(
@@ -6,6 +6,7 @@
 #include <Tanker/Groups/Store.hpp>
 #include <Tanker/Groups/Updater.hpp>
 #include <Tanker/Log/Log.hpp>
+#include <Tanker/Subscriptions.hpp>
 #include <Tanker/Trustchain/Actions/UserGroupCreation.hpp>
 #include <Tanker/Users/ILocalUserAccessor.hpp>
 
@@ -21,12 +22,14 @@ Accessor::Accessor(Groups::IRequester* requester,
                    Users::IUserAccessor* accessor,
                    Store* groupStore,
                    Users::ILocalUserAccessor* localUserAccessor,
-                   ProvisionalUsers::IAccessor* provisionalUserAccessor)
+                   ProvisionalUsers::IAccessor* provisionalUserAccessor,
+                   Subscriptions* subscriptions)
   : _requester(requester),
     _userAccessor(accessor),
     _groupStore(groupStore),
     _localUserAccessor(localUserAccessor),
-    _provisionalUserAccessor(provisionalUserAccessor)
+    _provisionalUserAccessor(provisionalUserAccessor),
+    _subscriptions(subscriptions)
 {
 }
 
@@ -34,20 +37,42 @@ tc::cotask<Accessor::InternalGroupPullResult> Accessor::getInternalGroups(
     std::vector<Trustchain::GroupId> const& groupIds)
 {
   // This function is only called when updating group members, and in that
-  // case we need the last block of the group. Since there is no way to know
-  // if we are up to date, just pull the group again
-  auto groupPullResult = TC_AWAIT(getGroups(groupIds));
-
+  // case we need the last block of the group. The cached group is only used
+  // if the server did not tell that it changed since it was pulled.
   InternalGroupPullResult out;
-  out.notFound = std::move(groupPullResult.notFound);
-  for (auto const& group : groupPullResult.found)
+  std::vector<Trustchain::GroupId> groupIdsToPull;
+  for (auto const& groupId : groupIds)
   {
-    if (auto const internalGroup =
-            boost::variant2::get_if<InternalGroup>(&group))
-      out.found.push_back(*internalGroup);
-    else if (auto const externalGroup =
-                 boost::variant2::get_if<ExternalGroup>(&group))
-      out.notFound.push_back(externalGroup->id);
+    std::optional<Group> group;
+    if (_subscriptions && _subscriptions->isFresh(groupId))
+      group = TC_AWAIT(_groupStore->findById(groupId));
+    if (group && boost::variant2::holds_alternative<InternalGroup>(*group))
+      out.found.push_back(boost::variant2::get<InternalGroup>(*group));
+    else
+      groupIdsToPull.push_back(groupId);
+  }
+
+  if (!groupIdsToPull.empty())
+  {
+    auto groupPullResult = TC_AWAIT(getGroups(groupIdsToPull));
+    out.notFound = std::move(groupPullResult.notFound);
+    for (auto const& group : groupPullResult.found)
+    {
+      if (auto const internalGroup =
+              boost::variant2::get_if<InternalGroup>(&group))
+        out.found.push_back(*internalGroup);
+      else if (auto const externalGroup =
+                   boost::variant2::get_if<ExternalGroup>(&group))
+        out.notFound.push_back(externalGroup->id);
+    }
+  }
+
+  // the caller adds a block to these groups, our copy will be stale before
+  // the server tells us
+  if (_subscriptions)
+  {
+    for (auto const& group : out.found)
+      _subscriptions->invalidate(group.id);
   }
 
   TC_RETURN(out);
@@ -144,6 +169,10 @@ GroupMap partitionGroups(std::vector<Trustchain::ServerEntry> const& entries)
 tc::cotask<Accessor::GroupPullResult> Accessor::getGroups(
     std::vector<Trustchain::GroupId> const& groupIds)
 {
+  // a member added during the pull would be missed otherwise
+  Subscriptions::Generation generation = 0;
+  if (_subscriptions)
+    generation = TC_AWAIT(_subscriptions->subscribe(groupIds));
   auto const entries = TC_AWAIT(_requester->getGroupBlocks(groupIds));
   auto const groupMap = partitionGroups(entries);
 
@@ -169,8 +198,14 @@ tc::cotask<Accessor::GroupPullResult> Accessor::getGroups(
   }
 
   // add all the groups to cache
+  std::vector<Trustchain::GroupId> foundGroupIds;
   for (auto const& group : out.found)
+  {
     TC_AWAIT(_groupStore->put(group));
+    foundGroupIds.push_back(extractBaseGroup(group).id());
+  }
+  if (_subscriptions)
+    _subscriptions->markFresh(foundGroupIds, generation);
 
   TC_RETURN(out);
 }
@@ -15,7 +15,7 @@ ClientEntry createUserGroupCreationV1Entry(
         sealedPrivateEncryptionKeysForUsers,
     TrustchainId const& trustchainId,
     DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey)
+    Crypto::SigningContext const& deviceSigner)
 {
   auto const encryptedPrivateSignatureKey = Crypto::sealEncrypt(
       groupSignatureKeyPair.privateKey, groupPublicEncryptionKey);
@@ -28,7 +28,7 @@ ClientEntry createUserGroupCreationV1Entry(
   return ClientEntry::create(trustchainId,
                              static_cast<Crypto::Hash>(deviceId),
                              ugc,
-                             deviceSignatureKey);
+                             deviceSigner);
 }
 
 ClientEntry createUserGroupCreationV2Entry(
@@ -38,7 +38,7 @@ ClientEntry createUserGroupCreationV2Entry(
     UserGroupCreation::v2::ProvisionalMembers const& groupProvisionalMembers,
     TrustchainId const& trustchainId,
     DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey)
+    Crypto::SigningContext const& deviceSigner)
 {
   auto const encryptedPrivateSignatureKey = Crypto::sealEncrypt(
       groupSignatureKeyPair.privateKey, groupPublicEncryptionKey);
@@ -52,7 +52,7 @@ ClientEntry createUserGroupCreationV2Entry(
   return ClientEntry::create(trustchainId,
                              static_cast<Crypto::Hash>(deviceId),
                              ugc,
-                             deviceSignatureKey);
+                             deviceSigner);
 }
 
 ClientEntry createUserGroupAdditionV1Entry(
@@ -62,7 +62,7 @@ ClientEntry createUserGroupAdditionV1Entry(
         sealedPrivateEncryptionKeysForUsers,
     TrustchainId const& trustchainId,
     DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey)
+    Crypto::SigningContext const& deviceSigner)
 {
   GroupId const groupId{groupSignatureKeyPair.publicKey.base()};
   UserGroupAddition::v1 uga{
@@ -72,7 +72,7 @@ ClientEntry createUserGroupAdditionV1Entry(
   return ClientEntry::create(trustchainId,
                              static_cast<Crypto::Hash>(deviceId),
                              uga,
-                             deviceSignatureKey);
+                             deviceSigner);
 }
 
 ClientEntry createUserGroupAdditionV2Entry(
@@ -83,7 +83,7 @@ ClientEntry createUserGroupAdditionV2Entry(
         provisionalMembers,
     TrustchainId const& trustchainId,
     DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey)
+    Crypto::SigningContext const& deviceSigner)
 {
   GroupId const groupId{groupSignatureKeyPair.publicKey.base()};
   UserGroupAddition::v2 uga{
@@ -93,7 +93,7 @@ ClientEntry createUserGroupAdditionV2Entry(
   return ClientEntry::create(trustchainId,
                              static_cast<Crypto::Hash>(deviceId),
                              uga,
-                             deviceSignatureKey);
+                             deviceSigner);
 }
 
 ClientEntry createKeyPublishToGroupEntry(
@@ -102,13 +102,13 @@ ClientEntry createKeyPublishToGroupEntry(
     Crypto::PublicEncryptionKey const& recipientPublicEncryptionKey,
     TrustchainId const& trustchainId,
     DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey)
+    Crypto::SigningContext const& deviceSigner)
 {
   KeyPublishToUserGroup kp{recipientPublicEncryptionKey, resourceId, symKey};
 
   return ClientEntry::create(trustchainId,
                              static_cast<Crypto::Hash>(deviceId),
                              kp,
-                             deviceSignatureKey);
+                             deviceSigner);
 }
 }
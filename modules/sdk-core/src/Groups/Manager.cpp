@@ -1,5 +1,6 @@
 #include <Tanker/Groups/Manager.hpp>
 
+#include <Tanker/Compute.hpp>
 #include <Tanker/Crypto/Crypto.hpp>
 #include <Tanker/Crypto/Format/Format.hpp>
 #include <Tanker/Errors/AssertionError.hpp>
@@ -52,6 +53,12 @@ tc::cotask<MembersToAdd> fetchFutureMembers(
 
 namespace
 {
+bool isLargeGroupChange(MembersToAdd const& members)
+{
+  return members.users.size() + members.provisionalUsers.size() >=
+         Compute::minOffloadedItems;
+}
+
 UserGroupCreation::v2::Members generateGroupKeysForUsers2(
     Crypto::PrivateEncryptionKey const& groupPrivateEncryptionKey,
     std::vector<Users::User> const& users)
@@ -97,7 +104,7 @@ Trustchain::ClientEntry makeUserGroupCreationEntry(
     Crypto::EncryptionKeyPair const& groupEncryptionKeyPair,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey)
+    Crypto::SigningContext const& deviceSigner)
 {
   auto const groupSize = memberUsers.size() + memberProvisionalUsers.size();
   if (groupSize == 0)
@@ -120,7 +127,7 @@ Trustchain::ClientEntry makeUserGroupCreationEntry(
                                         groupProvisionalMembers,
                                         trustchainId,
                                         deviceId,
-                                        deviceSignatureKey);
+                                        deviceSigner);
 }
 
 tc::cotask<SGroupId> create(
@@ -129,7 +136,7 @@ tc::cotask<SGroupId> create(
     std::vector<SPublicIdentity> const& spublicIdentities,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& privateSignatureKey)
+    std::shared_ptr<Crypto::SigningContext const> deviceSigner)
 {
   auto const members =
       TC_AWAIT(fetchFutureMembers(userAccessor, spublicIdentities));
@@ -137,13 +144,22 @@ tc::cotask<SGroupId> create(
   auto const groupEncryptionKeyPair = Crypto::makeEncryptionKeyPair();
   auto const groupSignatureKeyPair = Crypto::makeSignatureKeyPair();
 
-  auto const groupEntry = makeUserGroupCreationEntry(members.users,
-                                                     members.provisionalUsers,
-                                                     groupSignatureKeyPair,
-                                                     groupEncryptionKeyPair,
-                                                     trustchainId,
-                                                     deviceId,
-                                                     privateSignatureKey);
+  auto const makeEntry = [members,
+                          groupSignatureKeyPair,
+                          groupEncryptionKeyPair,
+                          trustchainId,
+                          deviceId,
+                          deviceSigner] {
+    return makeUserGroupCreationEntry(members.users,
+                                      members.provisionalUsers,
+                                      groupSignatureKeyPair,
+                                      groupEncryptionKeyPair,
+                                      trustchainId,
+                                      deviceId,
+                                      *deviceSigner);
+  };
+  auto const groupEntry =
+      TC_AWAIT(Compute::runIf(isLargeGroupChange(members), makeEntry));
   TC_AWAIT(pusher.pushBlock(groupEntry));
 
   TC_RETURN(cppcodec::base64_rfc4648::encode(groupSignatureKeyPair.publicKey));
@@ -155,7 +171,7 @@ Trustchain::ClientEntry makeUserGroupAdditionEntry(
     InternalGroup const& group,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& privateSignatureKey)
+    Crypto::SigningContext const& deviceSigner)
 {
   auto const groupSize = memberUsers.size() + memberProvisionalUsers.size();
   if (groupSize == 0)
@@ -181,7 +197,7 @@ Trustchain::ClientEntry makeUserGroupAdditionEntry(
                                         provisionalMembers,
                                         trustchainId,
                                         deviceId,
-                                        privateSignatureKey);
+                                        deviceSigner);
 }
 
 tc::cotask<void> updateMembers(
@@ -192,7 +208,7 @@ tc::cotask<void> updateMembers(
     std::vector<SPublicIdentity> const& spublicIdentitiesToAdd,
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& privateSignatureKey)
+    std::shared_ptr<Crypto::SigningContext const> deviceSigner)
 {
   auto const members =
       TC_AWAIT(fetchFutureMembers(userAccessor, spublicIdentitiesToAdd));
@@ -201,12 +217,20 @@ tc::cotask<void> updateMembers(
   if (groups.found.empty())
     throw formatEx(Errc::InvalidArgument, "no such group: {:s}", groupId);
 
-  auto const groupEntry = makeUserGroupAdditionEntry(members.users,
-                                                     members.provisionalUsers,
-                                                     groups.found[0],
-                                                     trustchainId,
-                                                     deviceId,
-                                                     privateSignatureKey);
+  auto const makeEntry = [members,
+                          group = groups.found[0],
+                          trustchainId,
+                          deviceId,
+                          deviceSigner] {
+    return makeUserGroupAdditionEntry(members.users,
+                                      members.provisionalUsers,
+                                      group,
+                                      trustchainId,
+                                      deviceId,
+                                      *deviceSigner);
+  };
+  auto const groupEntry =
+      TC_AWAIT(Compute::runIf(isLargeGroupChange(members), makeEntry));
   TC_AWAIT(pusher.pushBlock(groupEntry));
 }
 }
@@ -1,6 +1,7 @@
 #include <Tanker/Groups/Requester.hpp>
 
 #include <Tanker/Client.hpp>
+#include <Tanker/Retry.hpp>
 
 #include <nlohmann/json.hpp>
 #include <tconcurrent/coroutine.hpp>
@@ -14,10 +15,11 @@ namespace
 tc::cotask<std::vector<Trustchain::ServerEntry>> doBlockRequest(
     Client* client, nlohmann::json const& req)
 {
-  auto const response = TC_AWAIT(client->emit("get groups blocks", req));
-  auto const ret = Trustchain::fromBlocksToServerEntries(
-      response.get<std::vector<std::string>>());
-  TC_RETURN(ret);
+  TC_RETURN(TC_AWAIT(retry(
+      [&]() -> tc::cotask<std::vector<Trustchain::ServerEntry>> {
+        TC_RETURN(TC_AWAIT(client->emitForBlocks("get groups blocks", req)));
+      },
+      client->readPolicy())));
 }
 }
 
@@ -4,6 +4,7 @@
 #include <Tanker/ProvisionalUsers/IRequester.hpp>
 #include <Tanker/ProvisionalUsers/ProvisionalUserKeysStore.hpp>
 #include <Tanker/ProvisionalUsers/Updater.hpp>
+#include <Tanker/Subscriptions.hpp>
 
 TLOG_CATEGORY("ProvisionalUsersAccessor");
 
@@ -14,11 +15,13 @@ namespace Tanker::ProvisionalUsers
 Accessor::Accessor(IRequester* requester,
                    Users::IUserAccessor* userAccessor,
                    Users::ILocalUserAccessor* localUserAccessor,
-                   ProvisionalUserKeysStore* provisionalUserKeysStore)
+                   ProvisionalUserKeysStore* provisionalUserKeysStore,
+                   Subscriptions* subscriptions)
   : _requester(requester),
     _userAccessor(userAccessor),
     _localUserAccessor(localUserAccessor),
-    _provisionalUserKeysStore(provisionalUserKeysStore)
+    _provisionalUserKeysStore(provisionalUserKeysStore),
+    _subscriptions(subscriptions)
 {
 }
 
@@ -49,6 +52,14 @@ tc::cotask<std::optional<ProvisionalUserKeys>> Accessor::pullEncryptionKeys(
 
 tc::cotask<void> Accessor::refreshKeys()
 {
+  Subscriptions::Generation generation = 0;
+  if (_subscriptions)
+  {
+    if (_subscriptions->areClaimsFresh())
+      TC_RETURN();
+    generation = TC_AWAIT(_subscriptions->subscribeToClaims());
+  }
+
   auto const blocks = TC_AWAIT(_requester->getClaimBlocks());
   auto const toStore = TC_AWAIT(Updater::processClaimEntries(
       *_localUserAccessor, *_userAccessor, blocks));
@@ -61,5 +72,14 @@ tc::cotask<void> Accessor::refreshKeys()
         appSignaturePublicKey,
         tankerSignaturePublicKey,
         {appEncryptionKeyPair, tankerEncryptionKeyPair}));
+
+  if (_subscriptions)
+    _subscriptions->markClaimsFresh(generation);
+}
+
+void Accessor::invalidateKeys()
+{
+  if (_subscriptions)
+    _subscriptions->invalidateClaims();
 }
 }
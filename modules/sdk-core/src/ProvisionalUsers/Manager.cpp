@@ -66,7 +66,7 @@ tc::cotask<AttachResult> Manager::attachProvisionalIdentity(
       auto const clientEntry = Users::createProvisionalIdentityClaimEntry(
           _trustchainId,
           localUser.deviceId(),
-          localUser.deviceKeys().signatureKeyPair.privateKey,
+          *localUser.deviceSigner(),
           localUser.userId(),
           ProvisionalUsers::SecretUser{provisionalIdentity.target,
                                        provisionalIdentity.value,
@@ -107,7 +107,7 @@ tc::cotask<void> Manager::verifyProvisionalIdentity(
   auto const clientEntry = Users::createProvisionalIdentityClaimEntry(
       _trustchainId,
       localUser.deviceId(),
-      localUser.deviceKeys().signatureKeyPair.privateKey,
+      *localUser.deviceSigner(),
       localUser.userId(),
       ProvisionalUsers::SecretUser{_provisionalIdentity->target,
                                    _provisionalIdentity->value,
@@ -119,6 +119,8 @@ tc::cotask<void> Manager::verifyProvisionalIdentity(
   TC_AWAIT(_pusher->pushBlock(clientEntry));
 
   _provisionalIdentity.reset();
+  // the event of our own claim may not have arrived yet
+  _provisionalUsersAccessor->invalidateKeys();
   TC_AWAIT(_provisionalUsersAccessor->refreshKeys());
 }
 
@@ -1,8 +1,7 @@
 #include <Tanker/ProvisionalUsers/Requester.hpp>
 
 #include <Tanker/Client.hpp>
-
-#include <cppcodec/base64_rfc4648.hpp>
+#include <Tanker/Retry.hpp>
 
 #include <nlohmann/json.hpp>
 
@@ -14,10 +13,11 @@ Requester::Requester(Client* client) : _client(client)
 
 tc::cotask<std::vector<Trustchain::ServerEntry>> Requester::getClaimBlocks()
 {
-  auto const response = TC_AWAIT(_client->emit("get my claim blocks", {}));
-  auto const ret = Trustchain::fromBlocksToServerEntries(
-      response.get<std::vector<std::string>>());
-  TC_RETURN(ret);
+  TC_RETURN(TC_AWAIT(retry(
+      [&]() -> tc::cotask<std::vector<Trustchain::ServerEntry>> {
+        TC_RETURN(TC_AWAIT(_client->emitForBlocks("get my claim blocks", {})));
+      },
+      _client->readPolicy())));
 }
 
 tc::cotask<std::optional<TankerSecretProvisionalIdentity>>
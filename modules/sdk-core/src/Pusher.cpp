@@ -3,8 +3,8 @@
 #include <Tanker/Client.hpp>
 #include <Tanker/Serialization/Serialization.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
-#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <vector>
 
 namespace Tanker
 {
@@ -14,20 +14,18 @@ Pusher::Pusher(Client* client) : _client(client)
 
 tc::cotask<void> Pusher::pushBlock(Trustchain::ClientEntry const& entry)
 {
-  TC_AWAIT(_client->emit(
-      "push block",
-      cppcodec::base64_rfc4648::encode(Serialization::serialize(entry))));
+  TC_AWAIT(
+      _client->pushBlocks("push block", {Serialization::serialize(entry)}));
 }
 
 tc::cotask<void> Pusher::pushKeys(
     gsl::span<Trustchain::ClientEntry const> entries)
 {
-  std::vector<std::string> sb;
-  sb.reserve(entries.size());
+  std::vector<std::vector<std::uint8_t>> blocks;
+  blocks.reserve(entries.size());
   for (auto const& entry : entries)
-    sb.push_back(
-        cppcodec::base64_rfc4648::encode(Serialization::serialize(entry)));
-  TC_AWAIT(_client->emit("push keys", sb));
+    blocks.push_back(Serialization::serialize(entry));
+  TC_AWAIT(_client->pushBlocks("push keys", blocks));
 }
 
 }
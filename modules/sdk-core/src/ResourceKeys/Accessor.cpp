@@ -35,8 +35,8 @@ tc::cotask<std::optional<Crypto::SymmetricKey>> Accessor::findKey(
   auto key = (TC_AWAIT(_resourceKeyStore->findKey(resourceId)));
   if (!key)
   {
-    auto const entries = Trustchain::fromBlocksToServerEntries(
-        TC_AWAIT(_requester->getKeyPublishes(gsl::make_span(&resourceId, 1))));
+    auto const entries =
+        TC_AWAIT(_requester->getKeyPublishes(gsl::make_span(&resourceId, 1)));
     for (auto const& entry : entries)
     {
       if (auto const kp =
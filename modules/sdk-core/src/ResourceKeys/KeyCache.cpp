@@ -0,0 +1,60 @@
+#include <Tanker/ResourceKeys/KeyCache.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+
+namespace Tanker::ResourceKeys
+{
+KeyCache::KeyCache(std::size_t capacity) : _capacity(capacity)
+{
+  if (capacity == 0)
+  {
+    throw Errors::formatEx(Errors::Errc::InvalidArgument,
+                           "the resource key cache needs a capacity");
+  }
+}
+
+std::size_t KeyCache::capacity() const
+{
+  return _capacity;
+}
+
+std::size_t KeyCache::size() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _entries.size();
+}
+
+std::optional<Crypto::SymmetricKey> KeyCache::find(
+    Trustchain::ResourceId const& resourceId)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto const it = _entries.find(resourceId);
+  if (it == _entries.end())
+    return std::nullopt;
+  _lru.splice(_lru.begin(), _lru, it->second.lruPosition);
+  return it->second.key;
+}
+
+void KeyCache::put(Trustchain::ResourceId const& resourceId,
+                   Crypto::SymmetricKey const& key)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_entries.count(resourceId))
+    return;
+  if (_entries.size() == _capacity)
+  {
+    _entries.erase(_lru.back());
+    _lru.pop_back();
+  }
+  _lru.push_front(resourceId);
+  _entries.emplace(resourceId, Entry{key, _lru.begin()});
+}
+
+void KeyCache::clear()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _entries.clear();
+  _lru.clear();
+}
+}
@@ -1,10 +1,11 @@
 #include <Tanker/ResourceKeys/Store.hpp>
 
 #include <Tanker/Crypto/Format/Format.hpp>
-#include <Tanker/DataStore/ADatabase.hpp>
+#include <Tanker/DataStore/AResourceKeyStore.hpp>
 #include <Tanker/Errors/Errc.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Log/Log.hpp>
+#include <Tanker/ResourceKeys/KeyCache.hpp>
 #include <Tanker/Trustchain/ResourceId.hpp>
 
 TLOG_CATEGORY(ResourceKeys::Store);
@@ -13,7 +14,8 @@ using Tanker::Trustchain::ResourceId;
 
 namespace Tanker::ResourceKeys
 {
-Store::Store(DataStore::ADatabase* dbConn) : _db(dbConn)
+Store::Store(DataStore::AResourceKeyStore* dbConn, KeyCache* cache)
+  : _db(dbConn), _cache(cache)
 {
 }
 
@@ -21,6 +23,8 @@ tc::cotask<void> Store::putKey(ResourceId const& resourceId,
                                Crypto::SymmetricKey const& key)
 {
   TINFO("Adding key for {}", resourceId);
+  // the cache is only filled on reads: the database keeps the first key of a
+  // resource, which might not be this one
   TC_AWAIT(_db->putResourceKey(resourceId, key));
 }
 
@@ -51,6 +55,14 @@ tc::cotask<KeysResult> Store::getKeys(
 tc::cotask<std::optional<Crypto::SymmetricKey>> Store::findKey(
     ResourceId const& resourceId) const
 {
-  TC_RETURN(TC_AWAIT(_db->findResourceKey(resourceId)));
+  if (_cache)
+  {
+    if (auto const key = _cache->find(resourceId))
+      TC_RETURN(key);
+  }
+  auto const key = TC_AWAIT(_db->findResourceKey(resourceId));
+  if (key && _cache)
+    _cache->put(resourceId, *key);
+  TC_RETURN(key);
 }
 }
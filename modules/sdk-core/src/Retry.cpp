@@ -4,25 +4,50 @@
 
 #include <tconcurrent/async_wait.hpp>
 
+#include <algorithm>
 #include <random>
 
 namespace Tanker
 {
-DelayList exponentialDelays(int retries)
+namespace
+{
+std::mt19937& generator()
 {
   static std::mt19937 generator{std::random_device()()};
+  return generator;
+}
+}
+
+DelayList exponentialDelays(int retries)
+{
   std::uniform_int_distribution<int> uniform(0, 1000);
 
   DelayList ret;
   for (auto attempts = 0; attempts < retries; ++attempts)
   {
     auto const seconds = std::chrono::seconds(1 << attempts);
-    auto const rand = std::chrono::milliseconds(uniform(generator));
+    auto const rand = std::chrono::milliseconds(uniform(generator()));
     ret.push_back(seconds + rand);
   }
   return ret;
 }
 
+DelayList decorrelatedJitterDelays(int retries,
+                                   std::chrono::milliseconds base,
+                                   std::chrono::milliseconds cap)
+{
+  DelayList ret;
+  auto previous = base;
+  for (auto attempts = 0; attempts < retries; ++attempts)
+  {
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> uniform(
+        base.count(), std::max(base, previous * 3).count());
+    previous = std::min(cap, std::chrono::milliseconds{uniform(generator())});
+    ret.push_back(previous);
+  }
+  return ret;
+}
+
 tc::cotask<void> retry(std::function<tc::cotask<void>()> f,
                        DelayList const& delays)
 {
@@ -46,4 +71,49 @@ tc::cotask<void> retry(std::function<tc::cotask<void>()> f,
     ++i;
   }
 }
+
+CircuitBreaker::CircuitBreaker(Options options) : _options(options)
+{
+}
+
+void CircuitBreaker::throwIfOpen()
+{
+  if (!_openedAt)
+    return;
+  if (!_probing &&
+      std::chrono::steady_clock::now() - *_openedAt >= _options.openDuration)
+  {
+    _probing = true;
+    return;
+  }
+  throw Errors::Exception(Errors::Errc::NetworkError,
+                          "the server is unreachable, retry later");
+}
+
+void CircuitBreaker::recordSuccess()
+{
+  _failures = 0;
+  _openedAt.reset();
+  _probing = false;
+}
+
+void CircuitBreaker::recordFailure()
+{
+  ++_failures;
+  if (_probing || _failures >= _options.failureThreshold)
+  {
+    _openedAt = std::chrono::steady_clock::now();
+    _probing = false;
+  }
+}
+
+void CircuitBreaker::abandonProbe()
+{
+  _probing = false;
+}
+
+bool CircuitBreaker::isOpen() const
+{
+  return _openedAt.has_value();
+}
 }
@@ -1,6 +1,7 @@
 #include <Tanker/Revocation.hpp>
 
 #include <Tanker/Client.hpp>
+#include <Tanker/Compute.hpp>
 #include <Tanker/Crypto/Crypto.hpp>
 #include <Tanker/Crypto/Format/Format.hpp>
 #include <Tanker/Errors/Errc.hpp>
@@ -86,7 +87,7 @@ Trustchain::ClientEntry makeRevokeDeviceEntry(
   return Users::revokeDeviceEntry(
       trustchainId,
       localUser.deviceId(),
-      localUser.deviceKeys().signatureKeyPair.privateKey,
+      *localUser.deviceSigner(),
       targetDeviceId,
       newUserKey.publicKey,
       encryptedKeyForPreviousUserKey,
@@ -106,8 +107,17 @@ tc::cotask<void> revokeDevice(DeviceId const& deviceId,
 
   auto const newUserKey = Crypto::makeEncryptionKeyPair();
 
-  auto clientEntry = makeRevokeDeviceEntry(
-      deviceId, trustchainId, localUser, user.devices(), newUserKey);
+  // the new user key is sealed for every remaining device
+  auto const clientEntry = TC_AWAIT(Compute::runIf(
+      user.devices().size() >= Compute::minOffloadedItems,
+      [deviceId,
+       trustchainId,
+       localUser,
+       devices = user.devices(),
+       newUserKey] {
+        return makeRevokeDeviceEntry(
+            deviceId, trustchainId, localUser, devices, newUserKey);
+      }));
   TC_AWAIT(pusher.pushBlock(clientEntry));
 }
 
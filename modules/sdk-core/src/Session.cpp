@@ -3,6 +3,8 @@
 #include <Tanker/Crypto/Format/Format.hpp>
 #include <Tanker/Groups/Manager.hpp>
 #include <Tanker/Groups/Requester.hpp>
+#include <Tanker/Network/BatchingConnection.hpp>
+#include <Tanker/Network/CompressingConnection.hpp>
 #include <Tanker/Network/ConnectionFactory.hpp>
 #include <Tanker/ProvisionalUsers/Requester.hpp>
 #include <Tanker/Unlock/Requester.hpp>
@@ -19,17 +21,50 @@ namespace
 std::string getDbPath(std::string const& writablePath,
                       Trustchain::UserId const& userId)
 {
-  if (writablePath == ":memory:")
+  if (writablePath == ":memory:" || writablePath == DataStore::ephemeralDbPath)
     return writablePath;
   return fmt::format(TFMT("{:s}/tanker-{:S}.db"), writablePath, userId);
 }
+
+Network::ConnectionPtr makeConnection(std::string url,
+                                      Network::SdkInfo info,
+                                      SessionOptions const& options)
+{
+  auto connection =
+      Network::ConnectionFactory::create(std::move(url), std::move(info));
+  // batches are compressed as a whole
+  if (options.compression)
+  {
+    connection = std::make_unique<Network::CompressingConnection>(
+        std::move(connection),
+        Network::CompressingConnection::defaultThreshold,
+        options.negotiationTimeout);
+  }
+  if (!options.batching)
+    return connection;
+  return std::make_unique<Network::BatchingConnection>(
+      std::move(connection), options.negotiationTimeout);
+}
+
+DataStore::AResourceKeyStore* selectResourceKeyStore(
+    DataStore::ADatabase* db, DataStore::ResourceKeyLog* resourceKeyLog)
+{
+  if (resourceKeyLog)
+    return resourceKeyLog;
+  return db;
+}
 }
 
-Session::Storage::Storage(DataStore::DatabasePtr pdb)
+Session::Storage::Storage(
+    DataStore::DatabasePtr pdb,
+    std::unique_ptr<DataStore::ResourceKeyLog> presourceKeyLog)
   : db(std::move(pdb)),
+    resourceKeyLog(std::move(presourceKeyLog)),
     localUserStore(db.get()),
     groupStore(db.get()),
-    resourceKeyStore(db.get()),
+    resourceKeyCache(std::make_shared<ResourceKeys::KeyCache>()),
+    resourceKeyStore(selectResourceKeyStore(db.get(), resourceKeyLog.get()),
+                     resourceKeyCache.get()),
     provisionalUserKeysStore(db.get())
 {
 }
@@ -37,13 +72,15 @@ Session::Storage::Storage(DataStore::DatabasePtr pdb)
 Session::Accessors::Accessors(Storage& storage,
                               Pusher* pusher,
                               Requesters* requesters,
+                              Subscriptions* subscriptions,
                               Users::LocalUserAccessor plocalUserAccessor)
   : localUserAccessor(std::move(plocalUserAccessor)),
-    userAccessor(localUserAccessor.getContext(), requesters),
+    userAccessor(localUserAccessor.getContext(), requesters, subscriptions),
     provisionalUsersAccessor(requesters,
                              &userAccessor,
                              &localUserAccessor,
-                             &storage.provisionalUserKeysStore),
+                             &storage.provisionalUserKeysStore,
+                             subscriptions),
     provisionalUsersManager(&localUserAccessor,
                             pusher,
                             requesters,
@@ -54,7 +91,8 @@ Session::Accessors::Accessors(Storage& storage,
                   &userAccessor,
                   &storage.groupStore,
                   &localUserAccessor,
-                  &provisionalUsersAccessor),
+                  &provisionalUsersAccessor,
+                  subscriptions),
     resourceKeyAccessor(requesters,
                         &localUserAccessor,
                         &groupAccessor,
@@ -76,9 +114,12 @@ Client& Session::client()
   return *_client;
 }
 
-Session::Session(std::string url, Network::SdkInfo info)
-  : _client(std::make_unique<Client>(
-        Network::ConnectionFactory::create(std::move(url), std::move(info)))),
+Session::Session(std::string url,
+                 Network::SdkInfo info,
+                 SessionOptions const& options)
+  : _options(options),
+    _client(std::make_unique<Client>(makeConnection(url, info, options))),
+    _subscriptions(_client.get(), options.subscriptions),
     _pusher(_client.get()),
     _requesters(_client.get()),
     _storage(nullptr),
@@ -86,16 +127,35 @@ Session::Session(std::string url, Network::SdkInfo info)
     _identity(std::nullopt),
     _status(Status::Stopped)
 {
-  _client->setConnectionHandler([this]() -> tc::cotask<void> {
-    _taskCanceler.add(tc::async_resumable(
-        [this]() -> tc::cotask<void> { TC_AWAIT(authenticate()); }));
+  _client->setBinaryBlocksEnabled(options.binaryBlocks);
+  _client->setNegotiationTimeout(options.negotiationTimeout);
+  for (auto i = 1u; i < options.connectionPoolSize; ++i)
+    _client->addConnection(makeConnection(url, info, options));
+  _client->setConnectionHandler([this](std::size_t connection) {
+    // the server sends its events on the main connection
+    if (connection == 0)
+      _subscriptions.reset();
+    _taskCanceler.add(
+        tc::async_resumable([this, connection]() -> tc::cotask<void> {
+          TC_AWAIT(authenticate(connection));
+        }));
   });
 }
 
 void Session::createStorage(std::string const& writablePath)
 {
-  _storage = std::make_unique<Storage>(TC_AWAIT(DataStore::createDatabase(
-      getDbPath(writablePath, userId()), userSecret())));
+  auto const dbPath = getDbPath(writablePath, userId());
+  auto db = TC_AWAIT(DataStore::createDatabase(dbPath, userSecret()));
+  std::unique_ptr<DataStore::ResourceKeyLog> resourceKeyLog;
+  // there is no file to put the log next to with an in-memory database
+  if (_options.resourceKeyBackend == ResourceKeys::Backend::MappedLog &&
+      dbPath != ":memory:" && dbPath != DataStore::ephemeralDbPath)
+  {
+    resourceKeyLog = std::make_unique<DataStore::ResourceKeyLog>(
+        dbPath + ".rkeys", userSecret());
+  }
+  _storage =
+      std::make_unique<Storage>(std::move(db), std::move(resourceKeyLog));
 }
 
 Session::Storage const& Session::storage() const
@@ -131,6 +191,7 @@ tc::cotask<void> Session::createAccessors()
       storage(),
       &pusher(),
       &requesters(),
+      &_subscriptions,
       TC_AWAIT(Users::LocalUserAccessor::create(
           userId(), trustchainId(), &_requesters, &storage().localUserStore)));
 }
@@ -197,6 +258,15 @@ tc::cotask<void> Session::authenticate()
       TC_AWAIT(storage().localUserStore.getDeviceKeys()).signatureKeyPair));
 }
 
+tc::cotask<void> Session::authenticate(std::size_t connection)
+{
+  TC_AWAIT(_requesters.authenticateConnection(
+      connection,
+      trustchainId(),
+      userId(),
+      TC_AWAIT(storage().localUserStore.getDeviceKeys()).signatureKeyPair));
+}
+
 tc::cotask<void> Session::finalizeOpening()
 {
   TC_AWAIT(authenticate());
@@ -1,7 +1,10 @@
 #include <Tanker/Share.hpp>
 
+#include <Tanker/Compute.hpp>
 #include <Tanker/Crypto/Crypto.hpp>
 #include <Tanker/Crypto/Format/Format.hpp>
+#include <Tanker/Crypto/SealedSymmetricKey.hpp>
+#include <Tanker/Crypto/TwoTimesSealedSymmetricKey.hpp>
 #include <Tanker/Errors/AssertionError.hpp>
 #include <Tanker/Errors/Errc.hpp>
 #include <Tanker/Errors/Exception.hpp>
@@ -32,7 +35,7 @@ namespace
 std::vector<Trustchain::ClientEntry> generateShareBlocksToUsers(
     TrustchainId const& trustchainId,
     DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     ResourceKeys::KeysResult const& resourceKeys,
     std::vector<Crypto::PublicEncryptionKey> const& recipientUserKeys)
 {
@@ -43,7 +46,7 @@ std::vector<Trustchain::ClientEntry> generateShareBlocksToUsers(
       out.push_back(
           makeKeyPublishToUser(trustchainId,
                                deviceId,
-                               signatureKey,
+                               deviceSigner,
                                recipientKey,
                                std::get<Trustchain::ResourceId>(keyResource),
                                std::get<Crypto::SymmetricKey>(keyResource)));
@@ -53,7 +56,7 @@ std::vector<Trustchain::ClientEntry> generateShareBlocksToUsers(
 std::vector<Trustchain::ClientEntry> generateShareBlocksToProvisionalUsers(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     ResourceKeys::KeysResult const& resourceKeys,
     std::vector<ProvisionalUsers::PublicUser> const&
         recipientProvisionalUserKeys)
@@ -65,7 +68,7 @@ std::vector<Trustchain::ClientEntry> generateShareBlocksToProvisionalUsers(
       out.push_back(makeKeyPublishToProvisionalUser(
           trustchainId,
           deviceId,
-          signatureKey,
+          deviceSigner,
           recipientKey,
           std::get<ResourceId>(keyResource),
           std::get<Crypto::SymmetricKey>(keyResource)));
@@ -75,7 +78,7 @@ std::vector<Trustchain::ClientEntry> generateShareBlocksToProvisionalUsers(
 std::vector<Trustchain::ClientEntry> generateShareBlocksToGroups(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     ResourceKeys::KeysResult const& resourceKeys,
     std::vector<Crypto::PublicEncryptionKey> const& recipientUserKeys)
 {
@@ -86,7 +89,7 @@ std::vector<Trustchain::ClientEntry> generateShareBlocksToGroups(
       out.push_back(
           makeKeyPublishToGroup(trustchainId,
                                 deviceId,
-                                signatureKey,
+                                deviceSigner,
                                 recipientKey,
                                 std::get<Trustchain::ResourceId>(keyResource),
                                 std::get<Crypto::SymmetricKey>(keyResource)));
@@ -150,17 +153,17 @@ KeyRecipients toKeyRecipients(
 Trustchain::ClientEntry makeKeyPublishToUser(
     TrustchainId const& trustchainId,
     DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Crypto::PublicEncryptionKey const& recipientPublicEncryptionKey,
     ResourceId const& resourceId,
     Crypto::SymmetricKey const& resourceKey)
 {
-  auto const encryptedKey =
-      Crypto::sealEncrypt(resourceKey, recipientPublicEncryptionKey);
+  Crypto::SealedSymmetricKey encryptedKey;
+  Crypto::sealEncrypt(resourceKey, encryptedKey, recipientPublicEncryptionKey);
 
   return Users::createKeyPublishToUserEntry(trustchainId,
                                             deviceId,
-                                            signatureKey,
+                                            deviceSigner,
                                             encryptedKey,
                                             resourceId,
                                             recipientPublicEncryptionKey);
@@ -169,39 +172,43 @@ Trustchain::ClientEntry makeKeyPublishToUser(
 Trustchain::ClientEntry makeKeyPublishToGroup(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Crypto::PublicEncryptionKey const& recipientPublicEncryptionKey,
     ResourceId const& resourceId,
     Crypto::SymmetricKey const& resourceKey)
 {
-  auto const encryptedKey = Crypto::sealEncrypt<Crypto::SealedSymmetricKey>(
-      resourceKey, recipientPublicEncryptionKey);
+  Crypto::SealedSymmetricKey encryptedKey;
+  Crypto::sealEncrypt(resourceKey, encryptedKey, recipientPublicEncryptionKey);
 
   return Groups::createKeyPublishToGroupEntry(encryptedKey,
                                               resourceId,
                                               recipientPublicEncryptionKey,
                                               trustchainId,
                                               deviceId,
-                                              signatureKey);
+                                              deviceSigner);
 }
 
 Trustchain::ClientEntry makeKeyPublishToProvisionalUser(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     ProvisionalUsers::PublicUser const& recipientProvisionalUser,
     ResourceId const& resourceId,
     Crypto::SymmetricKey const& resourceKey)
 {
-  auto const encryptedKeyOnce = Crypto::sealEncrypt(
-      resourceKey, recipientProvisionalUser.appEncryptionPublicKey);
-  auto const encryptedKeyTwice = Crypto::sealEncrypt(
-      encryptedKeyOnce, recipientProvisionalUser.tankerEncryptionPublicKey);
+  Crypto::SealedSymmetricKey encryptedKeyOnce;
+  Crypto::sealEncrypt(resourceKey,
+                      encryptedKeyOnce,
+                      recipientProvisionalUser.appEncryptionPublicKey);
+  Crypto::TwoTimesSealedSymmetricKey encryptedKeyTwice;
+  Crypto::sealEncrypt(encryptedKeyOnce,
+                      encryptedKeyTwice,
+                      recipientProvisionalUser.tankerEncryptionPublicKey);
 
   return Users::createKeyPublishToProvisionalUserEntry(
       trustchainId,
       deviceId,
-      signatureKey,
+      deviceSigner,
       recipientProvisionalUser.appSignaturePublicKey,
       recipientProvisionalUser.tankerSignaturePublicKey,
       resourceId,
@@ -245,26 +252,26 @@ tc::cotask<KeyRecipients> generateRecipientList(
 std::vector<Trustchain::ClientEntry> generateShareBlocks(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     ResourceKeys::KeysResult const& resourceKeys,
     KeyRecipients const& keyRecipients)
 {
   auto keyPublishesToUsers =
       generateShareBlocksToUsers(trustchainId,
                                  deviceId,
-                                 signatureKey,
+                                 deviceSigner,
                                  resourceKeys,
                                  keyRecipients.recipientUserKeys);
   auto keyPublishesToProvisionalUsers = generateShareBlocksToProvisionalUsers(
       trustchainId,
       deviceId,
-      signatureKey,
+      deviceSigner,
       resourceKeys,
       keyRecipients.recipientProvisionalUserKeys);
   auto keyPublishesToGroups =
       generateShareBlocksToGroups(trustchainId,
                                   deviceId,
-                                  signatureKey,
+                                  deviceSigner,
                                   resourceKeys,
                                   keyRecipients.recipientGroupKeys);
 
@@ -277,21 +284,35 @@ std::vector<Trustchain::ClientEntry> generateShareBlocks(
   return out;
 }
 
-tc::cotask<void> share(Users::IUserAccessor& userAccessor,
-                       Groups::IAccessor& groupAccessor,
-                       Trustchain::TrustchainId const& trustchainId,
-                       Trustchain::DeviceId const& deviceId,
-                       Crypto::PrivateSignatureKey const& signatureKey,
-                       Pusher& pusher,
-                       ResourceKeys::KeysResult const& resourceKeys,
-                       std::vector<SPublicIdentity> const& publicIdentities,
-                       std::vector<SGroupId> const& groupIds)
+tc::cotask<void> share(
+    Users::IUserAccessor& userAccessor,
+    Groups::IAccessor& groupAccessor,
+    Trustchain::TrustchainId const& trustchainId,
+    Trustchain::DeviceId const& deviceId,
+    std::shared_ptr<Crypto::SigningContext const> deviceSigner,
+    Pusher& pusher,
+    ResourceKeys::KeysResult const& resourceKeys,
+    std::vector<SPublicIdentity> const& publicIdentities,
+    std::vector<SGroupId> const& groupIds)
 {
   auto const keyRecipients = TC_AWAIT(generateRecipientList(
       userAccessor, groupAccessor, publicIdentities, groupIds));
 
-  auto const ks = generateShareBlocks(
-      trustchainId, deviceId, signatureKey, resourceKeys, keyRecipients);
+  auto const recipientCount =
+      keyRecipients.recipientUserKeys.size() +
+      keyRecipients.recipientProvisionalUserKeys.size() +
+      keyRecipients.recipientGroupKeys.size();
+  auto const generate =
+      [trustchainId, deviceId, deviceSigner, resourceKeys, keyRecipients] {
+        return generateShareBlocks(trustchainId,
+                                   deviceId,
+                                   *deviceSigner,
+                                   resourceKeys,
+                                   keyRecipients);
+      };
+  auto const ks = TC_AWAIT(Compute::runIf(
+      resourceKeys.size() * recipientCount >= Compute::minOffloadedItems,
+      generate));
 
   if (!ks.empty())
     TC_AWAIT(pusher.pushKeys(ks));
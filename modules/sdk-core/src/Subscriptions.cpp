@@ -0,0 +1,197 @@
+#include <Tanker/Subscriptions.hpp>
+
+#include <Tanker/Client.hpp>
+#include <Tanker/Crypto/Json/Json.hpp>
+#include <Tanker/Errors/Exception.hpp>
+#include <Tanker/Log/Log.hpp>
+#include <Tanker/Network/Negotiation.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+#include <vector>
+
+TLOG_CATEGORY(Subscriptions);
+
+namespace Tanker
+{
+namespace
+{
+template <typename Id>
+std::vector<Id> notIn(boost::container::flat_set<Id> const& set,
+                      gsl::span<Id const> ids)
+{
+  std::vector<Id> out;
+  for (auto const& id : ids)
+  {
+    if (!set.count(id))
+      out.push_back(id);
+  }
+  return out;
+}
+
+template <typename Id>
+void insertIn(boost::container::flat_set<Id>& set,
+              boost::container::flat_set<Id> const& subscribed,
+              gsl::span<Id const> ids)
+{
+  for (auto const& id : ids)
+  {
+    if (subscribed.count(id))
+      set.insert(id);
+  }
+}
+}
+
+Subscriptions::Subscriptions(Client* client, bool enabled)
+  : _client(client), _enabled(enabled)
+{
+  auto const userChanged = [this](std::string const& data) {
+    invalidate(nlohmann::json::parse(data)
+                   .at("user_id")
+                   .get<Trustchain::UserId>());
+  };
+  _client->on("device created", userChanged);
+  _client->on("device revoked", userChanged);
+  _client->on("group members added", [this](std::string const& data) {
+    invalidate(nlohmann::json::parse(data)
+                   .at("group_id")
+                   .get<Trustchain::GroupId>());
+  });
+  _client->on("provisional identity claimed",
+              [this](std::string const&) { invalidateClaims(); });
+}
+
+tc::cotask<Subscriptions::Generation> Subscriptions::subscribe(
+    gsl::span<Trustchain::UserId const> userIds)
+{
+  auto const generation = _generation;
+  if (!enabled())
+    TC_RETURN(generation);
+  auto const userIdsToAdd = notIn(_subscribedUsers, userIds);
+  if (!userIdsToAdd.empty() &&
+      TC_AWAIT(emitSubscribe({{"user_ids", userIdsToAdd}})) &&
+      generation == _generation)
+    _subscribedUsers.insert(userIdsToAdd.begin(), userIdsToAdd.end());
+  TC_RETURN(generation);
+}
+
+tc::cotask<Subscriptions::Generation> Subscriptions::subscribe(
+    gsl::span<Trustchain::GroupId const> groupIds)
+{
+  auto const generation = _generation;
+  if (!enabled())
+    TC_RETURN(generation);
+  auto const groupIdsToAdd = notIn(_subscribedGroups, groupIds);
+  if (!groupIdsToAdd.empty() &&
+      TC_AWAIT(emitSubscribe({{"group_ids", groupIdsToAdd}})) &&
+      generation == _generation)
+    _subscribedGroups.insert(groupIdsToAdd.begin(), groupIdsToAdd.end());
+  TC_RETURN(generation);
+}
+
+tc::cotask<Subscriptions::Generation> Subscriptions::subscribeToClaims()
+{
+  auto const generation = _generation;
+  if (!enabled() || _claimsSubscribed)
+    TC_RETURN(generation);
+  if (TC_AWAIT(emitSubscribe({{"claims", true}})) && generation == _generation)
+    _claimsSubscribed = true;
+  TC_RETURN(generation);
+}
+
+tc::cotask<bool> Subscriptions::emitSubscribe(nlohmann::json const& request)
+{
+  if (_subscribeUnanswered)
+    TC_RETURN(false);
+  // a subscription that failed only costs the pulls it would have saved
+  try
+  {
+    auto const reply = TC_AWAIT(Network::negotiate<nlohmann::json>(
+        [&]() -> tc::cotask<nlohmann::json> {
+          TC_RETURN(TC_AWAIT(_client->emit("subscribe", request)));
+        },
+        _client->negotiationTimeout()));
+    if (reply)
+      TC_RETURN(true);
+    TINFO("subscribe was not answered, not subscribing until reconnection");
+    _subscribeUnanswered = true;
+  }
+  catch (Errors::Exception const& e)
+  {
+    TINFO("cannot subscribe: {}", e.what());
+  }
+  TC_RETURN(false);
+}
+
+void Subscriptions::markFresh(gsl::span<Trustchain::UserId const> userIds,
+                              Generation generation)
+{
+  if (generation == _generation)
+    insertIn(_freshUsers, _subscribedUsers, userIds);
+}
+
+void Subscriptions::markFresh(gsl::span<Trustchain::GroupId const> groupIds,
+                              Generation generation)
+{
+  if (generation == _generation)
+    insertIn(_freshGroups, _subscribedGroups, groupIds);
+}
+
+void Subscriptions::markClaimsFresh(Generation generation)
+{
+  if (generation == _generation && _claimsSubscribed)
+    _claimsFresh = true;
+}
+
+bool Subscriptions::isFresh(Trustchain::UserId const& userId) const
+{
+  return _freshUsers.count(userId) > 0;
+}
+
+bool Subscriptions::isFresh(Trustchain::GroupId const& groupId) const
+{
+  return _freshGroups.count(groupId) > 0;
+}
+
+bool Subscriptions::areClaimsFresh() const
+{
+  return _claimsFresh;
+}
+
+bool Subscriptions::enabled() const
+{
+  return _enabled;
+}
+
+void Subscriptions::invalidate(Trustchain::UserId const& userId)
+{
+  ++_generation;
+  _freshUsers.erase(userId);
+}
+
+void Subscriptions::invalidate(Trustchain::GroupId const& groupId)
+{
+  ++_generation;
+  _freshGroups.erase(groupId);
+}
+
+void Subscriptions::invalidateClaims()
+{
+  ++_generation;
+  _claimsFresh = false;
+}
+
+void Subscriptions::reset()
+{
+  ++_generation;
+  _subscribedUsers.clear();
+  _freshUsers.clear();
+  _subscribedGroups.clear();
+  _freshGroups.clear();
+  _claimsSubscribed = false;
+  _claimsFresh = false;
+  // the server may have changed
+  _subscribeUnanswered = false;
+}
+}
@@ -0,0 +1,179 @@
+#include <Tanker/TenantHost.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+#include <Tanker/Format/Enum.hpp>
+#include <Tanker/Log/Log.hpp>
+#include <Tanker/Status.hpp>
+
+#include <tconcurrent/async.hpp>
+
+#include <utility>
+
+TLOG_CATEGORY(TenantHost);
+
+namespace Tanker
+{
+namespace
+{
+tc::cotask<void> startTenant(
+    Core& core,
+    std::string const& identity,
+    std::optional<Unlock::Verification> const& verification)
+{
+  auto const status = TC_AWAIT(core.start(identity));
+  if (status == Status::Ready)
+    TC_RETURN();
+
+  if (!verification)
+  {
+    throw Errors::formatEx(
+        Errors::Errc::PreconditionFailed,
+        TFMT("a verification is needed to host a tenant with status {:e}"),
+        status);
+  }
+  if (status == Status::IdentityRegistrationNeeded)
+    TC_AWAIT(core.registerIdentity(*verification));
+  else
+    TC_AWAIT(core.verifyIdentity(*verification));
+}
+}
+
+TenantHost::TenantHost(std::string url,
+                       Network::SdkInfo info,
+                       std::string writablePath,
+                       Options options)
+  : _url(std::move(url)),
+    _info(std::move(info)),
+    _writablePath(std::move(writablePath)),
+    _options(options)
+{
+}
+
+// Releases the Cores of the tenants: a start that is running keeps its Core
+// until it is done, one that did not run yet does nothing, and the Cores
+// returned by open() stay with their callers
+TenantHost::~TenantHost() = default;
+
+tc::cotask<std::shared_ptr<Core>> TenantHost::open(
+    std::string const& identity,
+    std::optional<Unlock::Verification> const& verification)
+{
+  evictIdle();
+
+  auto it = _tenants.find(identity);
+  if (it == _tenants.end())
+  {
+    makeRoom();
+    auto core = std::make_shared<Core>(_url, _info, _writablePath);
+    // the task must not own the Core, or it would never look idle
+    auto started = tc::async_resumable(
+                       [weakCore = std::weak_ptr<Core>(core),
+                        identity,
+                        verification]() -> tc::cotask<void> {
+                         if (auto const core = weakCore.lock())
+                           TC_AWAIT(startTenant(*core, identity, verification));
+                       })
+                       .to_shared();
+    _lru.push_front(identity);
+    it = _tenants
+             .emplace(identity,
+                      Tenant{core,
+                             std::move(started),
+                             Clock::now(),
+                             _lru.begin()})
+             .first;
+    ++_loads;
+    TINFO("loading tenant, {} resident", _tenants.size());
+  }
+  else
+  {
+    touch(it->second);
+  }
+
+  // the map may change while we wait, don't keep the iterator
+  auto const core = it->second.core;
+  auto const started = it->second.started;
+  try
+  {
+    TC_AWAIT(started);
+  }
+  catch (...)
+  {
+    forget(identity, core);
+    throw;
+  }
+
+  if (auto const tenant = _tenants.find(identity);
+      tenant != _tenants.end() && tenant->second.core == core)
+    touch(tenant->second);
+  TC_RETURN(core);
+}
+
+void TenantHost::evictIdle()
+{
+  auto const deadline = Clock::now() - _options.idleTimeout;
+  auto it = _lru.end();
+  while (it != _lru.begin())
+  {
+    --it;
+    auto const tenant = _tenants.find(*it);
+    // the rest of the list was used more recently
+    if (tenant->second.lastUsed > deadline)
+      break;
+    if (isIdle(tenant->second))
+      it = evict(tenant);
+  }
+}
+
+TenantHost::Stats TenantHost::stats() const
+{
+  return {_tenants.size(), _loads, _evictions};
+}
+
+bool TenantHost::isIdle(Tenant const& tenant) const
+{
+  // callers of open() share the Core until they are done with it
+  return tenant.started.is_ready() && tenant.core.use_count() == 1;
+}
+
+void TenantHost::touch(Tenant& tenant)
+{
+  tenant.lastUsed = Clock::now();
+  _lru.splice(_lru.begin(), _lru, tenant.lruPosition);
+}
+
+TenantHost::LruList::iterator TenantHost::evict(Tenants::iterator it)
+{
+  // dropping the last reference closes the connection and the database
+  auto const next = _lru.erase(it->second.lruPosition);
+  _tenants.erase(it);
+  ++_evictions;
+  return next;
+}
+
+void TenantHost::makeRoom()
+{
+  // tenants in use can't be stopped, the host goes over the limit until they
+  // are released
+  auto it = _lru.end();
+  while (_tenants.size() >= _options.maxResidentTenants && it != _lru.begin())
+  {
+    --it;
+    auto const tenant = _tenants.find(*it);
+    if (isIdle(tenant->second))
+      it = evict(tenant);
+  }
+}
+
+void TenantHost::forget(std::string const& identity,
+                        std::shared_ptr<Core> const& core)
+{
+  // another open() may have forgotten it already
+  auto const it = _tenants.find(identity);
+  if (it == _tenants.end() || it->second.core != core)
+    return;
+  _lru.erase(it->second.lruPosition);
+  _tenants.erase(it);
+}
+}
@@ -1,4 +1,5 @@
 #include <Tanker/Client.hpp>
+#include <Tanker/Retry.hpp>
 #include <Tanker/Unlock/Requester.hpp>
 
 #include <nlohmann/json.hpp>
@@ -32,7 +33,11 @@ tc::cotask<UserStatusResult> Requester::userStatus(
       {"device_public_signature_key", publicSignatureKey},
   };
 
-  auto const reply = TC_AWAIT(_client->emit("get user status", request));
+  auto const reply = TC_AWAIT(retry(
+      [&]() -> tc::cotask<nlohmann::json> {
+        TC_RETURN(TC_AWAIT(_client->emit("get user status", request)));
+      },
+      _client->readPolicy()));
 
   TC_RETURN(reply.get<UserStatusResult>());
 }
@@ -74,8 +79,11 @@ Requester::fetchVerificationMethods(
   auto const request =
       nlohmann::json{{"trustchain_id", trustchainId}, {"user_id", userId}};
 
-  auto const reply =
-      TC_AWAIT(_client->emit("get verification methods", request));
+  auto const reply = TC_AWAIT(retry(
+      [&]() -> tc::cotask<nlohmann::json> {
+        TC_RETURN(TC_AWAIT(_client->emit("get verification methods", request)));
+      },
+      _client->readPolicy()));
   auto methods = reply.at("verification_methods")
                      .get<std::vector<Unlock::VerificationMethod>>();
   TC_RETURN(methods);
@@ -108,7 +108,7 @@ ClientEntry createNewGhostDeviceEntry(
 ClientEntry revokeDeviceEntry(
     TrustchainId const& trustchainId,
     DeviceId const& author,
-    Crypto::PrivateSignatureKey const& signatureKey,
+    Crypto::SigningContext const& deviceSigner,
     DeviceId const& toBeRevoked,
     Crypto::PublicEncryptionKey const& publicEncryptionKey,
     Crypto::SealedPrivateEncryptionKey const& encryptedKeyForPreviousUserKey,
@@ -121,23 +121,23 @@ ClientEntry revokeDeviceEntry(
                         previousPublicEncryptionKey,
                         userKeys};
   return ClientEntry::create(
-      trustchainId, static_cast<Crypto::Hash>(author), dr2, signatureKey);
+      trustchainId, static_cast<Crypto::Hash>(author), dr2, deviceSigner);
 }
 
 ClientEntry revokeDeviceV1Entry(TrustchainId const& trustchainId,
                                 DeviceId const& author,
-                                Crypto::PrivateSignatureKey const& signatureKey,
+                                Crypto::SigningContext const& deviceSigner,
                                 DeviceId const& toBeRevoked)
 {
   DeviceRevocation1 dr1{toBeRevoked};
   return ClientEntry::create(
-      trustchainId, static_cast<Crypto::Hash>(author), dr1, signatureKey);
+      trustchainId, static_cast<Crypto::Hash>(author), dr1, deviceSigner);
 }
 
 ClientEntry createProvisionalIdentityClaimEntry(
     TrustchainId const& trustchainId,
     DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey,
+    Crypto::SigningContext const& deviceSigner,
     UserId const& userId,
     ProvisionalUsers::SecretUser const& provisionalUser,
     Crypto::EncryptionKeyPair const& userKeyPair)
@@ -170,13 +170,13 @@ ClientEntry createProvisionalIdentityClaimEntry(
   return ClientEntry::create(trustchainId,
                              static_cast<Crypto::Hash>(deviceId),
                              claim,
-                             deviceSignatureKey);
+                             deviceSigner);
 }
 
 ClientEntry createKeyPublishToProvisionalUserEntry(
     TrustchainId const& trustchainId,
     DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Crypto::PublicSignatureKey const& appPublicSignatureKey,
     Crypto::PublicSignatureKey const& tankerPublicSignatureKey,
     ResourceId const& resourceId,
@@ -188,13 +188,13 @@ ClientEntry createKeyPublishToProvisionalUserEntry(
   return ClientEntry::create(trustchainId,
                              static_cast<Crypto::Hash>(deviceId),
                              kp,
-                             deviceSignatureKey);
+                             deviceSigner);
 }
 
 ClientEntry createKeyPublishToUserEntry(
     TrustchainId const& trustchainId,
     DeviceId const& deviceId,
-    Crypto::PrivateSignatureKey const& deviceSignatureKey,
+    Crypto::SigningContext const& deviceSigner,
     Crypto::SealedSymmetricKey const& symKey,
     ResourceId const& resourceId,
     Crypto::PublicEncryptionKey const& recipientPublicEncryptionKey)
@@ -205,6 +205,6 @@ ClientEntry createKeyPublishToUserEntry(
   return ClientEntry::create(trustchainId,
                              static_cast<Crypto::Hash>(deviceId),
                              kp,
-                             deviceSignatureKey);
+                             deviceSigner);
 }
 }
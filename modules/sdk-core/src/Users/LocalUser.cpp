@@ -15,6 +15,8 @@ LocalUser::LocalUser(Trustchain::UserId const& userId,
   : _userId(userId),
     _deviceId(deviceId),
     _deviceKeys(deviceKeys),
+    _deviceSigner(std::make_shared<Crypto::SigningContext const>(
+        deviceKeys.signatureKeyPair.privateKey)),
     _userKeys(userKeys.begin(), userKeys.end())
 {
 }
@@ -29,6 +31,11 @@ DeviceKeys const& LocalUser::deviceKeys() const
   return _deviceKeys;
 }
 
+std::shared_ptr<Crypto::SigningContext const> LocalUser::deviceSigner() const
+{
+  return _deviceSigner;
+}
+
 Trustchain::UserId const& LocalUser::userId() const
 {
   return _userId;
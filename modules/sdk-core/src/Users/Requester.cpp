@@ -5,12 +5,21 @@
 #include <Tanker/Errors/Errc.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Errors/ServerErrcCategory.hpp>
+#include <Tanker/Retry.hpp>
 #include <Tanker/Serialization/Serialization.hpp>
 #include <Tanker/Tracer/ScopeTimer.hpp>
 
 #include <boost/algorithm/string/predicate.hpp>
-#include <cppcodec/base64_rfc4648.hpp>
 #include <nlohmann/json.hpp>
+#include <tconcurrent/async.hpp>
+#include <tconcurrent/promise.hpp>
+#include <tconcurrent/when.hpp>
+
+#include <chrono>
+#include <exception>
+#include <iterator>
+#include <string>
+#include <vector>
 
 namespace Tanker::Users
 {
@@ -22,6 +31,19 @@ Crypto::Hash hashField(T const& field)
   return Crypto::generichash(
       gsl::make_span(field).template as_span<std::uint8_t const>());
 }
+
+tc::cotask<std::vector<Trustchain::ServerEntry>> readBlocks(
+    Client* client,
+    std::string const& event,
+    nlohmann::json const& request,
+    std::chrono::milliseconds hedgeAfter = std::chrono::milliseconds{0})
+{
+  TC_RETURN(TC_AWAIT(retry(
+      [&]() -> tc::cotask<std::vector<Trustchain::ServerEntry>> {
+        TC_RETURN(TC_AWAIT(client->emitForBlocks(event, request)));
+      },
+      client->readPolicy(hedgeAfter))));
+}
 }
 
 Requester::Requester(Client* client) : _client(client)
@@ -30,49 +52,85 @@ Requester::Requester(Client* client) : _client(client)
 
 tc::cotask<std::vector<Trustchain::ServerEntry>> Requester::getMe()
 {
-  auto const response = TC_AWAIT(_client->emit("get my user blocks", {}));
-  auto const ret = Trustchain::fromBlocksToServerEntries(
-      response.get<std::vector<std::string>>());
-  TC_RETURN(ret);
+  TC_RETURN(TC_AWAIT(readBlocks(_client, "get my user blocks", {})));
 }
 
 tc::cotask<std::vector<Trustchain::ServerEntry>> Requester::getUsers(
     gsl::span<Trustchain::UserId const> userIds)
 {
-  auto const response =
-      TC_AWAIT(_client->emit("get users blocks", {{"user_ids", userIds}}));
-  auto const ret = Trustchain::fromBlocksToServerEntries(
-      response.get<std::vector<std::string>>());
-  TC_RETURN(ret);
+  TC_RETURN(TC_AWAIT(
+      readBlocks(_client, "get users blocks", {{"user_ids", userIds}})));
 }
 
 tc::cotask<std::vector<Trustchain::ServerEntry>> Requester::getUsers(
     gsl::span<Trustchain::DeviceId const> deviceIds)
 {
-  auto const response =
-      TC_AWAIT(_client->emit("get users blocks", {{"device_ids", deviceIds}}));
-  auto const ret = Trustchain::fromBlocksToServerEntries(
-      response.get<std::vector<std::string>>());
-  TC_RETURN(ret);
+  TC_RETURN(TC_AWAIT(
+      readBlocks(_client, "get users blocks", {{"device_ids", deviceIds}})));
 }
 
-tc::cotask<std::vector<std::string>> Requester::getKeyPublishes(
+tc::cotask<std::vector<Trustchain::ServerEntry>> Requester::getKeyPublishes(
     gsl::span<Trustchain::ResourceId const> resourceIds)
 {
-  auto const json = TC_AWAIT(
-      _client->emit("get key publishes", {{"resource_ids", resourceIds}}));
-  TC_RETURN(json.get<std::vector<std::string>>());
+  using namespace std::chrono_literals;
+  // on the path of a decrypt
+  TC_RETURN(TC_AWAIT(readBlocks(
+      _client, "get key publishes", {{"resource_ids", resourceIds}}, 500ms)));
 }
 
 tc::cotask<void> Requester::authenticate(
     Trustchain::TrustchainId const& trustchainId,
     Trustchain::UserId const& userId,
     Crypto::SignatureKeyPair const& userSignatureKeyPair)
+{
+  std::vector<tc::future<void>> authentications;
+  for (auto i = 0u; i < _client->connectionCount(); ++i)
+  {
+    // the tasks may outlive this coroutine if it is canceled, the requester
+    // cancels them before the client goes away
+    tc::promise<void> authenticated;
+    authentications.push_back(authenticated.get_future());
+    _taskCanceler.add(tc::async_resumable(
+        [this,
+         i,
+         trustchainId,
+         userId,
+         userSignatureKeyPair,
+         authenticated]() mutable -> tc::cotask<void> {
+          std::exception_ptr error;
+          try
+          {
+            TC_AWAIT(authenticateConnection(
+                i, trustchainId, userId, userSignatureKeyPair));
+          }
+          catch (...)
+          {
+            error = std::current_exception();
+          }
+          if (error)
+            authenticated.set_exception(error);
+          else
+            authenticated.set_value({});
+        }));
+  }
+  auto done = TC_AWAIT(
+      tc::when_all(std::make_move_iterator(authentications.begin()),
+                   std::make_move_iterator(authentications.end())));
+  for (auto& authentication : done)
+    authentication.get();
+}
+
+tc::cotask<void> Requester::authenticateConnection(
+    std::size_t connection,
+    Trustchain::TrustchainId const& trustchainId,
+    Trustchain::UserId const& userId,
+    Crypto::SignatureKeyPair const& userSignatureKeyPair)
 {
   FUNC_TIMER(Net);
-  auto const challenge = TC_AWAIT(_client->emit("request auth challenge", {}))
-                             .at("challenge")
-                             .get<std::string>();
+  auto const challenge =
+      TC_AWAIT(_client->emitOn(connection, "request auth challenge", {}))
+          .at("challenge")
+          .get<std::string>();
   // NOTE: It is MANDATORY to check this prefix is valid, or the server could
   // get us to sign anything!
   if (!boost::algorithm::starts_with(
@@ -93,7 +151,7 @@ tc::cotask<void> Requester::authenticate(
                      {"user_id", userId}};
   try
   {
-    TC_AWAIT(_client->emit("authenticate device", request));
+    TC_AWAIT(_client->emitOn(connection, "authenticate device", request));
   }
   catch (Errors::Exception const& ex)
   {
@@ -117,8 +175,12 @@ Requester::getPublicProvisionalIdentities(gsl::span<Email const> emails)
   for (auto const& email : emails)
     message.push_back({{"type", "email"}, {"hashed_email", hashField(email)}});
 
-  auto const result = TC_AWAIT(_client->emit(
-      "get public provisional identities", nlohmann::json(message)));
+  auto const result = TC_AWAIT(retry(
+      [&]() -> tc::cotask<nlohmann::json> {
+        TC_RETURN(TC_AWAIT(
+            _client->emit("get public provisional identities", message)));
+      },
+      _client->readPolicy()));
 
   ret.reserve(result.size());
   for (auto const& elem : result)
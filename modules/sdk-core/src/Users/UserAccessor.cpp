@@ -1,10 +1,12 @@
 #include <Tanker/Users/UserAccessor.hpp>
 
+#include <Tanker/Compute.hpp>
 #include <Tanker/Entry.hpp>
 #include <Tanker/Errors/AssertionError.hpp>
 #include <Tanker/Errors/Errc.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Log/Log.hpp>
+#include <Tanker/Subscriptions.hpp>
 #include <Tanker/Types/Email.hpp>
 #include <Tanker/Users/Updater.hpp>
 #include <Tanker/Verif/DeviceCreation.hpp>
@@ -14,6 +16,9 @@
 
 #include <tconcurrent/coroutine.hpp>
 
+#include <tuple>
+#include <utility>
+
 TLOG_CATEGORY(UserAccessor);
 
 using Tanker::Trustchain::DeviceId;
@@ -26,15 +31,31 @@ namespace Tanker::Users
 {
 
 UserAccessor::UserAccessor(Trustchain::Context trustchainContext,
-                           Users::IRequester* requester)
-  : _context(std::move(trustchainContext)), _requester(requester)
+                           Users::IRequester* requester,
+                           Subscriptions* subscriptions)
+  : _context(std::move(trustchainContext)),
+    _requester(requester),
+    _subscriptions(subscriptions)
 {
 }
 
 auto UserAccessor::pull(gsl::span<UserId const> userIds)
     -> tc::cotask<PullResult>
 {
-  auto const userIdsMap = TC_AWAIT(fetch(userIds));
+  UsersMap userIdsMap;
+  std::vector<UserId> userIdsToFetch;
+  for (auto const& userId : userIds)
+  {
+    if (isFresh(userId))
+      userIdsMap.insert(*_cachedUsers.find(userId));
+    else
+      userIdsToFetch.push_back(userId);
+  }
+  if (!userIdsToFetch.empty())
+  {
+    auto const fetched = TC_AWAIT(fetchAndCache(userIdsToFetch));
+    userIdsMap.insert(fetched.begin(), fetched.end());
+  }
 
   PullResult ret;
   ret.found.reserve(userIds.size());
@@ -51,7 +72,21 @@ auto UserAccessor::pull(gsl::span<UserId const> userIds)
 tc::cotask<BasicPullResult<Device, Trustchain::DeviceId>> UserAccessor::pull(
     gsl::span<Trustchain::DeviceId const> deviceIds)
 {
-  auto const deviceIdsMap = TC_AWAIT(fetch(deviceIds));
+  DevicesMap deviceIdsMap;
+  std::vector<DeviceId> deviceIdsToFetch;
+  for (auto const& deviceId : deviceIds)
+  {
+    auto const it = _cachedDevices.find(deviceId);
+    if (it != _cachedDevices.end() && isFresh(it->second.userId()))
+      deviceIdsMap.insert(*it);
+    else
+      deviceIdsToFetch.push_back(deviceId);
+  }
+  if (!deviceIdsToFetch.empty())
+  {
+    auto const fetched = TC_AWAIT(fetch(deviceIdsToFetch));
+    deviceIdsMap.insert(fetched.begin(), fetched.end());
+  }
 
   BasicPullResult<Device, Trustchain::DeviceId> ret;
   ret.found.reserve(deviceIds.size());
@@ -131,6 +166,18 @@ auto processUserEntries(Trustchain::Context const& context,
   }
   return std::make_tuple(usersMap, devicesMap);
 }
+
+// Verifying a block checks its signature, offload long histories
+tc::cotask<std::tuple<UsersMap, DevicesMap>> verifyUserEntries(
+    Trustchain::Context const& context,
+    gsl::span<Trustchain::ServerEntry const> serverEntries)
+{
+  TC_RETURN(TC_AWAIT(
+      Compute::runIf(serverEntries.size() >= Compute::minOffloadedItems,
+                     [context, serverEntries] {
+                       return processUserEntries(context, serverEntries);
+                     })));
+}
 }
 
 tc::cotask<std::vector<ProvisionalUsers::PublicUser>>
@@ -189,7 +236,8 @@ auto UserAccessor::fetch(gsl::span<Trustchain::UserId const> userIds)
   if (userIds.empty())
     TC_RETURN(UsersMap{});
   auto const serverEntries = TC_AWAIT(_requester->getUsers(userIds));
-  TC_RETURN(std::get<UsersMap>(processUserEntries(_context, serverEntries)));
+  TC_RETURN(
+      std::get<UsersMap>(TC_AWAIT(verifyUserEntries(_context, serverEntries))));
 }
 
 auto UserAccessor::fetch(gsl::span<Trustchain::DeviceId const> deviceIds)
@@ -198,6 +246,58 @@ auto UserAccessor::fetch(gsl::span<Trustchain::DeviceId const> deviceIds)
   if (deviceIds.empty())
     TC_RETURN(DevicesMap{});
   auto const serverEntries = TC_AWAIT(_requester->getUsers(deviceIds));
-  TC_RETURN(std::get<DevicesMap>(processUserEntries(_context, serverEntries)));
+  TC_RETURN(std::get<DevicesMap>(
+      TC_AWAIT(verifyUserEntries(_context, serverEntries))));
+}
+
+auto UserAccessor::fetchAndCache(std::vector<UserId> const& userIds)
+    -> tc::cotask<UsersMap>
+{
+  if (!_subscriptions || !_subscriptions->enabled())
+    TC_RETURN(TC_AWAIT(fetch(userIds)));
+
+  evictStale();
+  // a device created during the pull would be missed otherwise
+  auto const generation = TC_AWAIT(_subscriptions->subscribe(userIds));
+  auto usersMap = TC_AWAIT(fetch(userIds));
+  std::vector<UserId> fetchedUserIds;
+  fetchedUserIds.reserve(usersMap.size());
+  for (auto const& [userId, user] : usersMap)
+  {
+    _cachedUsers[userId] = user;
+    for (auto const& device : user.devices())
+      _cachedDevices[device.id()] = device;
+    fetchedUserIds.push_back(userId);
+  }
+  _subscriptions->markFresh(fetchedUserIds, generation);
+  TC_RETURN(usersMap);
+}
+
+bool UserAccessor::isFresh(UserId const& userId) const
+{
+  return _subscriptions && _subscriptions->isFresh(userId) &&
+         _cachedUsers.count(userId);
+}
+
+void UserAccessor::evictStale()
+{
+  // rebuilt in order rather than erased from, each flat_map erasure moves
+  // the entries after it
+  UsersMap users;
+  users.reserve(_cachedUsers.size());
+  for (auto& [userId, user] : _cachedUsers)
+  {
+    if (_subscriptions->isFresh(userId))
+      users.emplace_hint(users.end(), userId, std::move(user));
+  }
+  DevicesMap devices;
+  devices.reserve(_cachedDevices.size());
+  for (auto& [deviceId, device] : _cachedDevices)
+  {
+    if (users.count(device.userId()))
+      devices.emplace_hint(devices.end(), deviceId, std::move(device));
+  }
+  _cachedUsers = std::move(users);
+  _cachedDevices = std::move(devices);
 }
 }
@@ -94,6 +94,11 @@ DeviceKeys Device::keys() const
                     {publicEncryptionKey(), privateEncryptionKey}};
 }
 
+Crypto::SigningContext Device::signer() const
+{
+  return Crypto::SigningContext(privateSignatureKey);
+}
+
 // ============ Users
 
 User::User(Trustchain::UserId const& id,
@@ -162,7 +167,7 @@ Trustchain::ClientEntry User::claim(
   return Users::createProvisionalIdentityClaimEntry(
       _tid,
       lastDevice.id(),
-      lastDevice.keys().signatureKeyPair.privateKey,
+      lastDevice.signer(),
       id(),
       provisionalUser,
       userKeys().back());
@@ -225,7 +230,7 @@ Trustchain::ClientEntry User::revokeDeviceV1(Device& target)
   auto const& source = devices().front();
   return Users::revokeDeviceV1Entry(_tid,
                                     source.id(),
-                                    source.keys().signatureKeyPair.privateKey,
+                                    source.signer(),
                                     target.id());
 }
 
@@ -243,7 +248,7 @@ Trustchain::ClientEntry User::revokeDeviceForMigration(Device const& sender,
   auto const entry =
       Users::revokeDeviceEntry(_tid,
                                sender.id(),
-                               sender.keys().signatureKeyPair.privateKey,
+                               sender.signer(),
                                target.id(),
                                newUserKey.publicKey,
                                {},
@@ -271,7 +276,7 @@ auto createGroupEntry(Trustchain::TrustchainId const& tid,
       encKp,
       tid,
       author.id(),
-      author.keys().signatureKeyPair.privateKey);
+      author.signer());
 }
 
 using SealedPrivateEncryptionKeysForUsers = Trustchain::Actions::
@@ -309,7 +314,7 @@ auto createGroupEntry(Trustchain::TrustchainId const& tid,
       keysForUsers,
       tid,
       author.id(),
-      author.keys().signatureKeyPair.privateKey);
+      author.signer());
 }
 }
 
@@ -401,7 +406,7 @@ Trustchain::ClientEntry const& Group::addUsers(
       *this,
       _tid,
       author.id(),
-      author.keys().signatureKeyPair.privateKey));
+      author.signer()));
 }
 
 Trustchain::ClientEntry const& Group::addUsersV1(Device const& author,
@@ -416,7 +421,7 @@ Trustchain::ClientEntry const& Group::addUsersV1(Device const& author,
       keysForUsers,
       _tid,
       author.id(),
-      author.keys().signatureKeyPair.privateKey));
+      author.signer()));
 }
 
 // ================ ProvisionalUser
@@ -599,7 +604,7 @@ Trustchain::ClientEntry Generator::shareWith(Device const& sender,
 {
   return Share::makeKeyPublishToUser(context().id(),
                                      sender.id(),
-                                     sender.keys().signatureKeyPair.privateKey,
+                                     sender.signer(),
                                      receiver.userKeys().back().publicKey,
                                      res.id(),
                                      res.key());
@@ -611,7 +616,7 @@ Trustchain::ClientEntry Generator::shareWith(Device const& sender,
 {
   return Share::makeKeyPublishToGroup(context().id(),
                                       sender.id(),
-                                      sender.keys().signatureKeyPair.privateKey,
+                                      sender.signer(),
                                       receiver.currentEncKp().publicKey,
                                       res.id(),
                                       res.key());
@@ -624,7 +629,7 @@ Trustchain::ClientEntry Generator::shareWith(Device const& sender,
   return Share::makeKeyPublishToProvisionalUser(
       context().id(),
       sender.id(),
-      sender.keys().signatureKeyPair.privateKey,
+      sender.signer(),
       receiver,
       res.id(),
       res.key());
@@ -1,6 +1,7 @@
 
 #include <Tanker/Crypto/SealedPrivateSignatureKey.hpp>
 #include <Tanker/Crypto/SignatureKeyPair.hpp>
+#include <Tanker/Crypto/SigningContext.hpp>
 #include <Tanker/DeviceKeys.hpp>
 #include <Tanker/Groups/Group.hpp>
 #include <Tanker/Identity/SecretProvisionalIdentity.hpp>
@@ -33,6 +34,7 @@ struct Device : Users::Device
   Crypto::PrivateSignatureKey privateSignatureKey;
   Trustchain::ClientEntry entry;
   DeviceKeys keys() const;
+  Crypto::SigningContext signer() const;
 };
 
 struct User;
@@ -29,7 +29,7 @@ public:
                  gsl::span<Trustchain::DeviceId const> deviceIds),
              override);
   MAKE_MOCK1(getKeyPublishes,
-             tc::cotask<std::vector<std::string>>(
+             tc::cotask<std::vector<Trustchain::ServerEntry>>(
                  gsl::span<Trustchain::ResourceId const> resourceIds),
              override);
   MAKE_MOCK1(getPublicProvisionalIdentities,
@@ -0,0 +1,106 @@
+#include <Tanker/Compute.hpp>
+
+#include <Tanker/Encryptor.hpp>
+
+#include <Helpers/Await.hpp>
+
+#include <boost/scope_exit.hpp>
+#include <doctest.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Tanker;
+
+TEST_CASE("Compute")
+{
+  SUBCASE("runs tasks on another thread")
+  {
+    auto const offloaded =
+        tc::async_resumable([]() -> tc::cotask<bool> {
+          auto const caller = std::this_thread::get_id();
+          TC_RETURN(TC_AWAIT(Compute::run([] {
+                      return std::this_thread::get_id();
+                    })) != caller);
+        }).get();
+    CHECK(offloaded);
+  }
+
+  SUBCASE("runs small tasks inline")
+  {
+    auto const offloaded =
+        tc::async_resumable([]() -> tc::cotask<bool> {
+          auto const caller = std::this_thread::get_id();
+          TC_RETURN(TC_AWAIT(Compute::runIf(false, [] {
+                      return std::this_thread::get_id();
+                    })) != caller);
+        }).get();
+    CHECK_FALSE(offloaded);
+  }
+
+  SUBCASE("forwards exceptions")
+  {
+    CHECK_THROWS_AS(AWAIT(Compute::run([]() -> int {
+                      throw std::runtime_error("failure");
+                    })),
+                    std::runtime_error);
+  }
+
+  SUBCASE("runs coroutines")
+  {
+    auto const result = AWAIT(Compute::runResumable([]() -> tc::cotask<int> {
+      TC_RETURN(42);
+    }));
+    CHECK(result == 42);
+  }
+
+  SUBCASE("records every task")
+  {
+    auto const before = Compute::metrics();
+    AWAIT(Compute::run([] { return 0; }));
+    auto const after = Compute::metrics();
+    CHECK(after.tasks == before.tasks + 1);
+    CHECK(after.executionTime >= before.executionTime);
+  }
+
+  SUBCASE("refuses to resize a started pool")
+  {
+    Compute::pool();
+    CHECK_THROWS(Compute::setThreadCount(2));
+  }
+
+  SUBCASE("encrypts and decrypts large buffers on the pool")
+  {
+    std::vector<std::uint8_t> clearData(Compute::minOffloadedBytes() + 1, 'a');
+    std::vector<std::uint8_t> encryptedData(
+        Encryptor::encryptedSize(clearData.size()));
+    std::vector<std::uint8_t> decryptedData(clearData.size());
+
+    auto const before = Compute::metrics();
+    auto const metadata =
+        AWAIT(Encryptor::encrypt(encryptedData.data(), clearData));
+    AWAIT_VOID(Encryptor::decrypt(
+        decryptedData.data(), metadata.key, encryptedData));
+
+    CHECK(decryptedData == clearData);
+    CHECK(Compute::metrics().tasks == before.tasks + 2);
+  }
+
+  SUBCASE("offloads small buffers once the threshold is lowered")
+  {
+    auto const defaultThreshold = Compute::minOffloadedBytes();
+    Compute::setMinOffloadedBytes(0);
+    BOOST_SCOPE_EXIT_ALL(&)
+    {
+      Compute::setMinOffloadedBytes(defaultThreshold);
+    };
+
+    std::vector<std::uint8_t> clearData(16, 'a');
+    std::vector<std::uint8_t> encryptedData(
+        Encryptor::encryptedSize(clearData.size()));
+    auto const before = Compute::metrics();
+    AWAIT(Encryptor::encrypt(encryptedData.data(), clearData));
+    CHECK(Compute::metrics().tasks == before.tasks + 1);
+  }
+}
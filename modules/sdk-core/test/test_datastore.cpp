@@ -5,14 +5,22 @@
 
 #include <Tanker/Crypto/Crypto.hpp>
 #include <Tanker/DataStore/Connection.hpp>
+#include <Tanker/DataStore/DatabaseFactory.hpp>
 #include <Tanker/DataStore/Errors/Errc.hpp>
 #include <Tanker/DataStore/Table.hpp>
 #include <Tanker/DbModels/TrustchainInfo.hpp>
 #include <Tanker/Log/Log.hpp>
 
+#include <Helpers/Await.hpp>
+#include <Helpers/Buffers.hpp>
 #include <Helpers/Errors.hpp>
 #include <Helpers/UniquePath.hpp>
 
+#include <tconcurrent/async.hpp>
+#include <tconcurrent/coroutine.hpp>
+
+#include <vector>
+
 TLOG_CATEGORY(DataStoreTest);
 
 using namespace Tanker::DataStore;
@@ -175,3 +183,67 @@ TEST_CASE("Migration" * doctest::test_suite("DataStore"))
     CHECK_EQ(value, 84);
   }
 }
+
+TEST_CASE("Database" * doctest::test_suite("DataStore"))
+{
+  Tanker::UniquePath testtmp("testtmp");
+  auto const dbfile = fmt::format("{}/datastore.db", testtmp.path);
+
+  SUBCASE("reports connection errors when migrating")
+  {
+    auto dbPtr = createConnection(dbfile);
+    TANKER_CHECK_THROWS_WITH_CODE(AWAIT(createDatabase(dbfile, {}, true)),
+                                  Errc::DatabaseError);
+  }
+
+  SUBCASE("serves concurrent coroutines")
+  {
+    auto const db = AWAIT(createDatabase(dbfile, {}, true));
+
+    std::vector<Tanker::Trustchain::ResourceId> resourceIds;
+    std::vector<tc::future<void>> futures;
+    for (auto i = 0; i < 20; ++i)
+    {
+      auto const resourceId = Tanker::make<Tanker::Trustchain::ResourceId>(
+          fmt::format("resource {}", i));
+      resourceIds.push_back(resourceId);
+      futures.push_back(
+          tc::async_resumable([&db, resourceId]() -> tc::cotask<void> {
+            TC_AWAIT(db->putResourceKey(
+                resourceId, Tanker::make<Tanker::Crypto::SymmetricKey>("key")));
+          }));
+    }
+    for (auto& future : futures)
+      REQUIRE_NOTHROW(future.get());
+
+    for (auto const& resourceId : resourceIds)
+    {
+      auto const key = AWAIT(db->findResourceKey(resourceId));
+      REQUIRE(key.has_value());
+      CHECK(*key == Tanker::make<Tanker::Crypto::SymmetricKey>("key"));
+    }
+  }
+
+  SUBCASE("stores and reopens with the write-ahead log profile")
+  {
+    auto const resourceId =
+        Tanker::make<Tanker::Trustchain::ResourceId>("resource");
+    auto const key = Tanker::make<Tanker::Crypto::SymmetricKey>("key");
+    {
+      auto const db = AWAIT(createDatabase(
+          dbfile, {}, true, ConnectionProfile::WriteAheadLog));
+      AWAIT_VOID(db->putResourceKey(resourceId, key));
+      // inserting the same resource id again is ignored
+      AWAIT_VOID(db->putResourceKey(
+          resourceId, Tanker::make<Tanker::Crypto::SymmetricKey>("other")));
+      CHECK(AWAIT(db->findResourceKey(resourceId)) == key);
+    }
+
+    auto const db =
+        AWAIT(createDatabase(dbfile, {}, true, ConnectionProfile::Default));
+    CHECK(AWAIT(db->findResourceKey(resourceId)) == key);
+    CHECK_FALSE(AWAIT(db->findResourceKey(
+                          Tanker::make<Tanker::Trustchain::ResourceId>("none")))
+                    .has_value());
+  }
+}
@@ -84,6 +84,24 @@ TEST_SUITE("Ecryption session tests")
     CHECK(clearData == decryptedData);
   }
 
+  TEST_CASE_FIXTURE(FixtureEncrytionSession,
+                    "encryptSync should give the same format as encrypt")
+  {
+    auto clearData = make_buffer("this is the data to encrypt");
+    std::vector<uint8_t> encryptedData(
+        EncryptionSession::encryptedSize(clearData.size()));
+
+    auto const metadata =
+        encSession.encryptSync(encryptedData.data(), clearData);
+
+    CHECK(metadata.resourceId == encSession.resourceId());
+    std::vector<uint8_t> decryptedData(
+        EncryptionSession::decryptedSize(encryptedData));
+    AWAIT_VOID(
+        Encryptor::decrypt(decryptedData.data(), metadata.key, encryptedData));
+    CHECK(clearData == decryptedData);
+  }
+
   TEST_CASE_FIXTURE(FixtureEncrytionSession,
                     "encrypt should never give the same result twice")
   {
@@ -183,6 +201,9 @@ TEST_SUITE("Ecryption session tests")
     TANKER_CHECK_THROWS_WITH_CODE(
         AWAIT(encSession.encrypt(encryptedData.data(), clearData)),
         Errc::PreconditionFailed);
+    TANKER_CHECK_THROWS_WITH_CODE(
+        encSession.encryptSync(encryptedData.data(), clearData),
+        Errc::PreconditionFailed);
 
     TANKER_CHECK_THROWS_WITH_CODE(encSession.resourceId(),
                                   Errc::PreconditionFailed);
@@ -153,6 +153,20 @@ void commonEncryptorTests(TestContext<T> ctx)
     CHECK(clearData == decryptedData);
   }
 
+  SUBCASE("decryptSync should decrypt a buffer without a coroutine")
+  {
+    auto clearData = make_buffer("this is the data to encrypt");
+    std::vector<uint8_t> encryptedData(T::encryptedSize(clearData.size()));
+
+    auto const metadata = AWAIT(ctx.encrypt(encryptedData.data(), clearData));
+
+    REQUIRE(Encryptor::hasSynchronousFormat(encryptedData));
+    std::vector<uint8_t> decryptedData(T::decryptedSize(encryptedData));
+    Encryptor::decryptSync(decryptedData.data(), metadata.key, encryptedData);
+
+    CHECK(clearData == decryptedData);
+  }
+
   SUBCASE("decrypt should work with a test vector")
   {
     auto const clearData = make_buffer("this is very secret");
@@ -259,3 +273,14 @@ TEST_CASE("extractResourceId should throw on a truncated buffer")
   TANKER_CHECK_THROWS_WITH_CODE(Encryptor::extractResourceId(encryptedData),
                                 Errc::InvalidArgument);
 }
+
+TEST_CASE("hasSynchronousFormat should reject truncated and chunked buffers")
+{
+  CHECK_FALSE(Encryptor::hasSynchronousFormat(make_buffer("")));
+  CHECK_FALSE(Encryptor::hasSynchronousFormat(
+      std::vector<uint8_t>(1, EncryptorV3::version())));
+  CHECK_FALSE(Encryptor::hasSynchronousFormat(std::vector<uint8_t>(
+      EncryptorV5::encryptedSize(0) - 1, EncryptorV5::version())));
+  // version 4 is a chunked stream
+  CHECK_FALSE(Encryptor::hasSynchronousFormat(std::vector<uint8_t>(1024, 4)));
+}
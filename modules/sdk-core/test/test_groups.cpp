@@ -39,7 +39,7 @@ TEST_CASE("Can't create an empty group")
           Crypto::makeEncryptionKeyPair(),
           generator.context().id(),
           userDevice.id(),
-          userDevice.keys().signatureKeyPair.privateKey),
+          userDevice.signer()),
       Errc::InvalidArgument);
 }
 
@@ -61,7 +61,7 @@ TEST_CASE("Can create a group with two users")
       groupEncryptionKey,
       generator.context().id(),
       userDevice.id(),
-      userDevice.keys().signatureKeyPair.privateKey);
+      userDevice.signer());
 
   auto const serverEntry = clientToServerEntry(clientEntry);
   auto group = serverEntry.action()
@@ -111,7 +111,7 @@ TEST_CASE("Can create a group with two provisional users")
       groupEncryptionKey,
       generator.context().id(),
       userDevice.id(),
-      userDevice.keys().signatureKeyPair.privateKey);
+      userDevice.signer());
 
   auto const serverEntry = clientToServerEntry(clientEntry);
   auto group = serverEntry.action()
@@ -181,7 +181,7 @@ TEST_CASE("Fails to add 0 users to a group")
           group,
           generator.context().id(),
           userDevice.id(),
-          userDevice.keys().signatureKeyPair.privateKey),
+          userDevice.signer()),
       Errc::InvalidArgument);
 }
 
@@ -201,7 +201,7 @@ TEST_CASE("Can add users to a group")
       group,
       generator.context().id(),
       userDevice.id(),
-      userDevice.keys().signatureKeyPair.privateKey);
+      userDevice.signer());
 
   auto const serverEntry = clientToServerEntry(clientEntry);
   auto groupAdd = serverEntry.action()
@@ -248,7 +248,7 @@ TEST_CASE("Can add provisional users to a group")
       group,
       generator.context().id(),
       userDevice.id(),
-      userDevice.keys().signatureKeyPair.privateKey);
+      userDevice.signer());
 
   auto const serverEntry = clientToServerEntry(clientEntry);
   auto groupAdd = serverEntry.action()
@@ -0,0 +1,134 @@
+#include <Tanker/DataStore/MemoryDatabase.hpp>
+
+#include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/DataStore/DatabaseFactory.hpp>
+#include <Tanker/DeviceKeys.hpp>
+
+#include <Helpers/Await.hpp>
+#include <Helpers/Buffers.hpp>
+
+#include <doctest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace Tanker;
+using Tanker::Trustchain::GroupId;
+
+TEST_CASE("MemoryDatabase" * doctest::test_suite("DataStore"))
+{
+  auto const dbPtr =
+      AWAIT(DataStore::createDatabase(DataStore::ephemeralDbPath));
+  auto& db = *dbPtr;
+
+  CHECK(dynamic_cast<DataStore::MemoryDatabase*>(dbPtr.get()));
+
+  SUBCASE("it should keep user key pairs in insertion order")
+  {
+    auto const keyPair1 = Crypto::makeEncryptionKeyPair();
+    auto const keyPair2 = Crypto::makeEncryptionKeyPair();
+    AWAIT_VOID(db.putUserPrivateKey(keyPair1));
+    AWAIT_VOID(db.putUserKeyPairs(
+        std::vector<Crypto::EncryptionKeyPair>{keyPair2, keyPair1}));
+
+    CHECK(AWAIT(db.getUserKeyPairs()) ==
+          std::vector<Crypto::EncryptionKeyPair>{keyPair1, keyPair2});
+  }
+
+  SUBCASE("it should keep the first resource key")
+  {
+    auto const resourceId = make<Trustchain::ResourceId>("resource");
+    auto const key = make<Crypto::SymmetricKey>("key");
+    CHECK_FALSE(AWAIT(db.findResourceKey(resourceId)));
+
+    AWAIT_VOID(db.putResourceKey(resourceId, key));
+    AWAIT_VOID(
+        db.putResourceKey(resourceId, make<Crypto::SymmetricKey>("other")));
+    CHECK(AWAIT(db.findResourceKey(resourceId)) == key);
+  }
+
+  SUBCASE("it should find provisional user keys")
+  {
+    auto const appSigKey = make<Crypto::PublicSignatureKey>("app sig");
+    auto const tankerSigKey = make<Crypto::PublicSignatureKey>("tanker sig");
+    ProvisionalUserKeys const keys{Crypto::makeEncryptionKeyPair(),
+                                   Crypto::makeEncryptionKeyPair()};
+    AWAIT_VOID(db.putProvisionalUserKeys(appSigKey, tankerSigKey, keys));
+
+    auto const found =
+        AWAIT(db.findProvisionalUserKeys(appSigKey, tankerSigKey));
+    REQUIRE(found);
+    CHECK(found->appKeys == keys.appKeys);
+    CHECK(found->tankerKeys == keys.tankerKeys);
+    CHECK(AWAIT(db.findProvisionalUserKeysByAppPublicEncryptionKey(
+                    keys.appKeys.publicKey))
+              .has_value());
+    CHECK_FALSE(AWAIT(db.findProvisionalUserKeys(tankerSigKey, appSigKey)));
+  }
+
+  SUBCASE("it should only set the device id of stored device keys")
+  {
+    auto const deviceId = make<Trustchain::DeviceId>("device");
+    AWAIT_VOID(db.setDeviceId(deviceId));
+    CHECK_FALSE(AWAIT(db.getDeviceId()));
+
+    auto const deviceKeys = DeviceKeys::create();
+    AWAIT_VOID(db.setDeviceKeys(deviceKeys));
+    AWAIT_VOID(db.setDeviceId(deviceId));
+    CHECK(AWAIT(db.getDeviceKeys()) == deviceKeys);
+    CHECK(AWAIT(db.getDeviceId()) == deviceId);
+  }
+
+  SUBCASE("it should replace groups")
+  {
+    auto const group = InternalGroup{
+        make<GroupId>("group id"),
+        Crypto::makeSignatureKeyPair(),
+        Crypto::makeEncryptionKeyPair(),
+        make<Crypto::Hash>("last block hash"),
+    };
+    auto group2 = group;
+    group2.encryptionKeyPair = Crypto::makeEncryptionKeyPair();
+
+    AWAIT_VOID(db.putInternalGroup(group));
+    AWAIT_VOID(db.putInternalGroup(group2));
+
+    CHECK(AWAIT(db.findGroupByGroupId(group.id)) == Group{group2});
+    CHECK(AWAIT(db.findGroupByGroupPublicEncryptionKey(
+              group2.encryptionKeyPair.publicKey)) == Group{group2});
+    CHECK_FALSE(AWAIT(db.findGroupByGroupPublicEncryptionKey(
+        group.encryptionKeyPair.publicKey)));
+  }
+
+  SUBCASE("it should roll back failed transactions")
+  {
+    auto const resourceId = make<Trustchain::ResourceId>("resource");
+    auto const key = make<Crypto::SymmetricKey>("key");
+
+    AWAIT_VOID(db.inTransaction([&]() -> tc::cotask<void> {
+      TC_AWAIT(db.putResourceKey(resourceId, key));
+    }));
+    CHECK_THROWS_AS(
+        AWAIT_VOID(db.inTransaction([&]() -> tc::cotask<void> {
+          TC_AWAIT(db.putResourceKey(make<Trustchain::ResourceId>("other"),
+                                     key));
+          throw std::runtime_error("failure");
+        })),
+        std::runtime_error);
+
+    CHECK(AWAIT(db.findResourceKey(resourceId)) == key);
+    CHECK_FALSE(
+        AWAIT(db.findResourceKey(make<Trustchain::ResourceId>("other"))));
+  }
+
+  SUBCASE("it should remove everything when nuked")
+  {
+    auto const resourceId = make<Trustchain::ResourceId>("resource");
+    AWAIT_VOID(db.putResourceKey(resourceId, make<Crypto::SymmetricKey>("k")));
+    AWAIT_VOID(db.setDeviceKeys(DeviceKeys::create()));
+    AWAIT_VOID(db.nuke());
+
+    CHECK_FALSE(AWAIT(db.findResourceKey(resourceId)));
+    CHECK_FALSE(AWAIT(db.getDeviceKeys()));
+  }
+}
@@ -2,17 +2,55 @@
 
 #include <Tanker/Crypto/Crypto.hpp>
 #include <Tanker/DataStore/ADatabase.hpp>
+#include <Tanker/DataStore/Errors/Errc.hpp>
+#include <Tanker/DataStore/ResourceKeyLog.hpp>
 #include <Tanker/Errors/Errc.hpp>
+#include <Tanker/ResourceKeys/KeyCache.hpp>
 
 #include <Helpers/Await.hpp>
 #include <Helpers/Buffers.hpp>
 #include <Helpers/Errors.hpp>
+#include <Helpers/UniquePath.hpp>
 
+#include <boost/filesystem/operations.hpp>
 #include <cppcodec/base64_rfc4648.hpp>
 #include <doctest.h>
+#include <fmt/format.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
 
 using namespace Tanker;
 
+namespace
+{
+// Appends a copy of every record of the log, like an index that lost track
+// of them would have
+void duplicateLogRecords(std::string const& path)
+{
+  std::vector<char> log;
+  {
+    std::ifstream file(path, std::ios::binary);
+    log.assign(std::istreambuf_iterator<char>(file), {});
+  }
+  // see LogHeader in ResourceKeyLog.cpp
+  std::uint32_t recordSize;
+  std::uint64_t count;
+  std::memcpy(&recordSize, log.data() + 12, sizeof(recordSize));
+  std::memcpy(&count, log.data() + 16, sizeof(count));
+  auto const records = log.data() + 64;
+  std::memcpy(records + count * recordSize, records, count * recordSize);
+  count *= 2;
+  std::memcpy(log.data() + 16, &count, sizeof(count));
+  std::memcpy(log.data() + 24, &count, sizeof(count));
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(log.data(), log.size());
+}
+}
+
 #ifndef EMSCRIPTEN
 #include <Tanker/DataStore/Connection.hpp>
 #include <Tanker/DataStore/Table.hpp>
@@ -120,6 +158,159 @@ TEST_CASE("Resource Keys Store")
   }
 }
 
+TEST_CASE("Resource key cache")
+{
+  auto const resourceId = make<Trustchain::ResourceId>("mymac");
+  auto const key = make<Crypto::SymmetricKey>("mykey");
+
+  SUBCASE("it should keep the first key of a resource")
+  {
+    ResourceKeys::KeyCache cache;
+    cache.put(resourceId, key);
+    cache.put(resourceId, make<Crypto::SymmetricKey>("mykey2"));
+    CHECK(cache.find(resourceId) == key);
+    CHECK_FALSE(cache.find(make<Trustchain::ResourceId>("unexistent")));
+  }
+
+  SUBCASE("it should evict the least recently used key")
+  {
+    ResourceKeys::KeyCache cache(2);
+    auto const resourceId2 = make<Trustchain::ResourceId>("mymac2");
+    auto const resourceId3 = make<Trustchain::ResourceId>("mymac3");
+    cache.put(resourceId, key);
+    cache.put(resourceId2, key);
+    cache.find(resourceId);
+    cache.put(resourceId3, key);
+
+    CHECK(cache.size() == 2);
+    CHECK(cache.find(resourceId));
+    CHECK_FALSE(cache.find(resourceId2));
+    CHECK(cache.find(resourceId3));
+  }
+
+  SUBCASE("the store should fill it with the keys it reads")
+  {
+    auto const dbPtr = AWAIT(DataStore::createDatabase(":memory:"));
+    ResourceKeys::KeyCache cache;
+    ResourceKeys::Store keys(dbPtr.get(), &cache);
+
+    AWAIT_VOID(keys.putKey(resourceId, key));
+    CHECK(cache.size() == 0);
+    CHECK(AWAIT(keys.getKey(resourceId)) == key);
+    CHECK(cache.find(resourceId) == key);
+  }
+}
+
+TEST_CASE("Resource key log")
+{
+  UniquePath testtmp("testtmp");
+  auto const path = fmt::format("{}/keys.rkeys", testtmp.path);
+  auto const userSecret = Crypto::makeSymmetricKey();
+  auto const resourceId = make<Trustchain::ResourceId>("mymac");
+  auto const key = make<Crypto::SymmetricKey>("mykey");
+
+  SUBCASE("it should keep keys across reopenings")
+  {
+    {
+      DataStore::ResourceKeyLog log(path, userSecret);
+      ResourceKeys::Store keys(&log);
+      AWAIT_VOID(keys.putKey(resourceId, key));
+      AWAIT_VOID(
+          keys.putKey(resourceId, make<Crypto::SymmetricKey>("mykey2")));
+      CHECK(log.size() == 1);
+    }
+
+    DataStore::ResourceKeyLog log(path, userSecret);
+    ResourceKeys::Store keys(&log);
+    CHECK(AWAIT(keys.getKey(resourceId)) == key);
+    CHECK_FALSE(
+        AWAIT(keys.findKey(make<Trustchain::ResourceId>("unexistent"))));
+  }
+
+  SUBCASE("it should rebuild a missing index")
+  {
+    {
+      DataStore::ResourceKeyLog log(path, userSecret);
+      AWAIT_VOID(log.putResourceKey(resourceId, key));
+    }
+    boost::filesystem::remove(path + ".index");
+
+    DataStore::ResourceKeyLog log(path, userSecret);
+    CHECK(AWAIT(log.findResourceKey(resourceId)) == key);
+  }
+
+  SUBCASE("it should rebuild an index that was not closed")
+  {
+    {
+      DataStore::ResourceKeyLog log(path, userSecret);
+      boost::filesystem::copy_file(path + ".index", path + ".crashed");
+      AWAIT_VOID(log.putResourceKey(resourceId, key));
+    }
+    boost::filesystem::remove(path + ".index");
+    boost::filesystem::rename(path + ".crashed", path + ".index");
+
+    DataStore::ResourceKeyLog log(path, userSecret);
+    CHECK(log.size() == 1);
+    CHECK(AWAIT(log.findResourceKey(resourceId)) == key);
+  }
+
+  SUBCASE("it should compact a log full of duplicates when opening")
+  {
+    {
+      DataStore::ResourceKeyLog log(path, userSecret);
+      for (auto i = 0; i < 10; ++i)
+      {
+        AWAIT_VOID(log.putResourceKey(
+            make<Trustchain::ResourceId>(fmt::format("mac {}", i)), key));
+      }
+    }
+    duplicateLogRecords(path);
+    boost::filesystem::remove(path + ".index");
+
+    DataStore::ResourceKeyLog log(path, userSecret);
+    CHECK(log.size() == 10);
+    CHECK(AWAIT(log.findResourceKey(make<Trustchain::ResourceId>("mac 4"))) ==
+          key);
+  }
+
+  SUBCASE("it should keep keys when compacting")
+  {
+    DataStore::ResourceKeyLog log(path, userSecret);
+    for (auto i = 0; i < 10000; ++i)
+    {
+      AWAIT_VOID(log.putResourceKey(
+          make<Trustchain::ResourceId>(fmt::format("mac {}", i)), key));
+    }
+    log.compact();
+
+    CHECK(log.size() == 10000);
+    CHECK(AWAIT(log.findResourceKey(
+              make<Trustchain::ResourceId>("mac 4242"))) == key);
+    AWAIT_VOID(log.putResourceKey(resourceId, key));
+    CHECK(AWAIT(log.findResourceKey(resourceId)) == key);
+  }
+
+  SUBCASE("it should remove every key when cleared")
+  {
+    DataStore::ResourceKeyLog log(path, userSecret);
+    AWAIT_VOID(log.putResourceKey(resourceId, key));
+    log.clear();
+
+    CHECK(log.size() == 0);
+    CHECK_FALSE(AWAIT(log.findResourceKey(resourceId)));
+  }
+
+  SUBCASE("it should refuse another user secret")
+  {
+    {
+      DataStore::ResourceKeyLog log(path, userSecret);
+    }
+    TANKER_CHECK_THROWS_WITH_CODE(
+        DataStore::ResourceKeyLog(path, Crypto::makeSymmetricKey()),
+        DataStore::Errc::DatabaseError);
+  }
+}
+
 #ifndef EMSCRIPTEN
 TEST_CASE("Migration")
 {
@@ -0,0 +1,172 @@
+#include <Tanker/Retry.hpp>
+
+#include <Tanker/Errors/Errc.hpp>
+#include <Tanker/Errors/Exception.hpp>
+
+#include <Helpers/Await.hpp>
+#include <Helpers/Errors.hpp>
+
+#include <doctest.h>
+
+#include <tconcurrent/async.hpp>
+#include <tconcurrent/promise.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace Tanker;
+using namespace std::chrono_literals;
+
+namespace
+{
+Errors::Exception networkError()
+{
+  return Errors::Exception(Errors::Errc::NetworkError, "unreachable");
+}
+
+RetryPolicy fastPolicy(CircuitBreaker* circuitBreaker = nullptr)
+{
+  return {DelayList(3, 1ms), 0ms, 0ms, 0ms, circuitBreaker};
+}
+}
+
+TEST_CASE("decorrelated jitter delays grow from the base up to the cap")
+{
+  auto const delays = decorrelatedJitterDelays(20, 20ms, 500ms);
+  REQUIRE(delays.size() == 20);
+  auto previous = 20ms;
+  for (auto const delay : delays)
+  {
+    CHECK(delay >= 20ms);
+    CHECK(delay <= 500ms);
+    CHECK(delay <= previous * 3);
+    previous = delay;
+  }
+}
+
+TEST_CASE("retry")
+{
+  auto calls = 0;
+
+  SUBCASE("retries network errors")
+  {
+    auto const result = AWAIT(retry(
+        [&]() -> tc::cotask<int> {
+          if (++calls < 3)
+            throw networkError();
+          TC_RETURN(42);
+        },
+        fastPolicy()));
+    CHECK(result == 42);
+    CHECK(calls == 3);
+  }
+
+  SUBCASE("gives up after the last delay")
+  {
+    TANKER_CHECK_THROWS_WITH_CODE(AWAIT(retry(
+                                      [&]() -> tc::cotask<int> {
+                                        ++calls;
+                                        throw networkError();
+                                      },
+                                      fastPolicy())),
+                                  Errors::Errc::NetworkError);
+    CHECK(calls == 4);
+  }
+
+  SUBCASE("does not retry other errors")
+  {
+    TANKER_CHECK_THROWS_WITH_CODE(
+        AWAIT(retry(
+            [&]() -> tc::cotask<int> {
+              ++calls;
+              throw Errors::Exception(Errors::Errc::InvalidArgument, "");
+            },
+            fastPolicy())),
+        Errors::Errc::InvalidArgument);
+    CHECK(calls == 1);
+  }
+
+  SUBCASE("times out attempts that are never answered")
+  {
+    auto policy = fastPolicy();
+    policy.attemptTimeout = 10ms;
+    TANKER_CHECK_THROWS_WITH_CODE(AWAIT(retry(
+                                      [&]() -> tc::cotask<int> {
+                                        ++calls;
+                                        tc::promise<int> never;
+                                        TC_RETURN(TC_AWAIT(never.get_future()));
+                                      },
+                                      policy)),
+                                  Errors::Errc::NetworkError);
+    CHECK(calls == 4);
+  }
+
+  SUBCASE("the hedged attempt answers when the first one hangs")
+  {
+    auto policy = fastPolicy();
+    policy.hedgeAfter = 10ms;
+    auto const result = AWAIT(retry(
+        [&]() -> tc::cotask<int> {
+          if (++calls == 1)
+          {
+            tc::promise<int> never;
+            TC_RETURN(TC_AWAIT(never.get_future()));
+          }
+          TC_RETURN(42);
+        },
+        policy));
+    CHECK(result == 42);
+    CHECK(calls == 2);
+  }
+}
+
+TEST_CASE("the circuit breaker fails fast while the server is down")
+{
+  CircuitBreaker breaker({2, 50ms});
+  auto calls = 0;
+  auto const failing = [&]() -> tc::cotask<int> {
+    ++calls;
+    throw networkError();
+  };
+
+  auto policy = fastPolicy(&breaker);
+  policy.delays.clear();
+  CHECK_THROWS(AWAIT(retry(failing, policy)));
+  CHECK_FALSE(breaker.isOpen());
+  CHECK_THROWS(AWAIT(retry(failing, policy)));
+  CHECK(breaker.isOpen());
+
+  CHECK_THROWS(AWAIT(retry(failing, policy)));
+  CHECK(calls == 2);
+
+  // after openDuration, one call probes the server
+  std::this_thread::sleep_for(50ms);
+  auto const result =
+      AWAIT(retry([]() -> tc::cotask<int> { TC_RETURN(42); }, policy));
+  CHECK(result == 42);
+  CHECK_FALSE(breaker.isOpen());
+}
+
+TEST_CASE("the circuit breaker probes again after an inconclusive probe")
+{
+  CircuitBreaker breaker({1, 50ms});
+  auto const failing = []() -> tc::cotask<int> { throw networkError(); };
+  auto const malformed = []() -> tc::cotask<int> {
+    throw std::runtime_error("malformed reply");
+  };
+
+  auto policy = fastPolicy(&breaker);
+  policy.delays.clear();
+  CHECK_THROWS(AWAIT(retry(failing, policy)));
+  REQUIRE(breaker.isOpen());
+
+  std::this_thread::sleep_for(50ms);
+  CHECK_THROWS_AS(AWAIT(retry(malformed, policy)), std::runtime_error);
+  CHECK(breaker.isOpen());
+
+  auto const result =
+      AWAIT(retry([]() -> tc::cotask<int> { TC_RETURN(42); }, policy));
+  CHECK(result == 42);
+  CHECK_FALSE(breaker.isOpen());
+}
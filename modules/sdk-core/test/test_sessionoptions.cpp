@@ -0,0 +1,277 @@
+#include <Tanker/AsyncCore.hpp>
+
+#include <Tanker/DataStore/ADatabase.hpp>
+#include <Tanker/FakeServer/Server.hpp>
+#include <Tanker/Identity/PublicIdentity.hpp>
+#include <Tanker/Identity/SecretPermanentIdentity.hpp>
+#include <Tanker/Network/CompressingConnection.hpp>
+#include <Tanker/Network/ConnectionFactory.hpp>
+#include <Tanker/SessionOptions.hpp>
+#include <Tanker/Types/SUserId.hpp>
+
+#include <Helpers/Buffers.hpp>
+#include <Helpers/UniquePath.hpp>
+
+#include <doctest.h>
+
+#include <nlohmann/json.hpp>
+#include <tconcurrent/future.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace Tanker;
+
+namespace
+{
+// destroy() deletes the session
+AsyncCore* makeCore(FakeServer::Server const& server,
+                    SessionOptions const& options)
+{
+  return new AsyncCore(
+      "fake-server",
+      Network::SdkInfo{"sdk-native-test", server.trustchainId(), "0.0.1"},
+      DataStore::ephemeralDbPath,
+      options);
+}
+
+std::string makeIdentity(FakeServer::Server const& server,
+                         std::string const& userId)
+{
+  return to_string(
+      Identity::createIdentity(server.trustchainId(),
+                               server.trustchainKeyPair().privateKey,
+                               obfuscateUserId(SUserId{userId},
+                                               server.trustchainId())));
+}
+}
+
+TEST_CASE("sessions work through batching connections")
+{
+  SessionOptions options;
+  options.batching = true;
+  FakeServer::Server server;
+  server.install();
+
+  auto const aliceIdentity = makeIdentity(server, "alice");
+  auto const bobIdentity = makeIdentity(server, "bob");
+  auto alice = makeCore(server, options);
+  alice->start(aliceIdentity).get();
+  alice->registerIdentity(alice->generateVerificationKey().get()).get();
+  auto bob = makeCore(server, options);
+  bob->start(bobIdentity).get();
+  bob->registerIdentity(bob->generateVerificationKey().get()).get();
+
+  // concurrent calls make concurrent emits
+  auto const clearData = make_buffer("my clear data");
+  std::vector<tc::shared_future<std::vector<std::uint8_t>>> encrypts;
+  for (auto i = 0; i < 4; ++i)
+  {
+    encrypts.push_back(alice->encrypt(
+        clearData,
+        {SPublicIdentity{Identity::getPublicIdentity(bobIdentity)}}));
+  }
+  std::vector<tc::shared_future<std::vector<std::uint8_t>>> decrypts;
+  for (auto& encrypted : encrypts)
+    decrypts.push_back(bob->decrypt(encrypted.get()));
+  for (auto& decrypted : decrypts)
+    CHECK(decrypted.get() == clearData);
+
+  bob->destroy().get();
+  alice->destroy().get();
+}
+
+TEST_CASE("sessions exchange binary blocks when the server negotiates them")
+{
+  SessionOptions options;
+  options.binaryBlocks = true;
+  FakeServer::Server server;
+  server.install();
+
+  auto const aliceIdentity = makeIdentity(server, "alice");
+  auto const bobIdentity = makeIdentity(server, "bob");
+  auto bob = makeCore(server, options);
+  bob->start(bobIdentity).get();
+  bob->registerIdentity(bob->generateVerificationKey().get()).get();
+
+  UniquePath captureDir("testtmp");
+  auto const capturePath = captureDir.path + "/capture.jsonl";
+  Network::ConnectionFactory::record(capturePath);
+  auto alice = makeCore(server, options);
+  alice->start(aliceIdentity).get();
+  alice->registerIdentity(alice->generateVerificationKey().get()).get();
+  auto const clearData = make_buffer("my clear data");
+  auto const encrypted =
+      alice
+          ->encrypt(clearData,
+                    {SPublicIdentity{Identity::getPublicIdentity(bobIdentity)}})
+          .get();
+  alice->destroy().get();
+  Network::ConnectionFactory::stopRecording();
+
+  CHECK(bob->decrypt(encrypted).get() == clearData);
+  bob->destroy().get();
+
+  auto binaryEmits = 0;
+  std::ifstream capture(capturePath);
+  for (std::string line; std::getline(capture, line);)
+  {
+    auto const record = nlohmann::json::parse(line);
+    if (record.value("bin", false))
+      ++binaryEmits;
+  }
+  // the key publish for bob at least
+  CHECK(binaryEmits > 0);
+}
+
+TEST_CASE("sessions compress their emits when the server negotiates it")
+{
+  SessionOptions options;
+  options.compression = true;
+  FakeServer::Server server;
+  server.install();
+
+  auto const before = Network::CompressingConnection::metrics();
+  auto const aliceIdentity = makeIdentity(server, "alice");
+  auto const bobIdentity = makeIdentity(server, "bob");
+  auto alice = makeCore(server, options);
+  alice->start(aliceIdentity).get();
+  alice->registerIdentity(alice->generateVerificationKey().get()).get();
+  auto bob = makeCore(server, options);
+  bob->start(bobIdentity).get();
+  bob->registerIdentity(bob->generateVerificationKey().get()).get();
+
+  auto const clearData = make_buffer("my clear data");
+  auto const encrypted =
+      alice
+          ->encrypt(clearData,
+                    {SPublicIdentity{Identity::getPublicIdentity(bobIdentity)}})
+          .get();
+  CHECK(bob->decrypt(encrypted).get() == clearData);
+  bob->destroy().get();
+  alice->destroy().get();
+  auto const after = Network::CompressingConnection::metrics();
+
+  // the requests are small, the user blocks are not
+  CHECK(after.skippedPayloads > before.skippedPayloads);
+  CHECK(after.compressedPayloads > before.compressedPayloads);
+  CHECK(after.compressedBytes - before.compressedBytes <
+        after.uncompressedBytes - before.uncompressedBytes);
+}
+
+TEST_CASE("bulk requests go to the other connections of the pool")
+{
+  SessionOptions options;
+  options.connectionPoolSize = 3;
+  FakeServer::Server server;
+  server.install();
+
+  UniquePath captureDir("testtmp");
+  auto const capturePath = captureDir.path + "/capture.jsonl";
+  Network::ConnectionFactory::record(capturePath);
+  auto const aliceIdentity = makeIdentity(server, "alice");
+  auto const bobIdentity = makeIdentity(server, "bob");
+  auto const alicePublicIdentity =
+      SPublicIdentity{Identity::getPublicIdentity(aliceIdentity)};
+  auto const bobPublicIdentity =
+      SPublicIdentity{Identity::getPublicIdentity(bobIdentity)};
+  auto alice = makeCore(server, options);
+  alice->start(aliceIdentity).get();
+  alice->registerIdentity(alice->generateVerificationKey().get()).get();
+  auto bob = makeCore(server, options);
+  bob->start(bobIdentity).get();
+  bob->registerIdentity(bob->generateVerificationKey().get()).get();
+
+  auto const groupId =
+      alice->createGroup({alicePublicIdentity, bobPublicIdentity}).get();
+  auto const clearData = make_buffer("my clear data");
+  auto const encrypted = alice->encrypt(clearData, {}, {groupId}).get();
+  CHECK(bob->decrypt(encrypted).get() == clearData);
+  bob->destroy().get();
+  alice->destroy().get();
+  Network::ConnectionFactory::stopRecording();
+
+  std::map<std::size_t, std::set<std::string>> emitsByConnection;
+  std::ifstream capture(capturePath);
+  for (std::string line; std::getline(capture, line);)
+  {
+    auto const record = nlohmann::json::parse(line);
+    if (record.contains("emit"))
+    {
+      emitsByConnection[record.at("cx").get<std::size_t>()].insert(
+          record.at("emit").get<std::string>());
+    }
+  }
+  auto bulkConnections = 0;
+  for (auto const& [connection, emits] : emitsByConnection)
+  {
+    if (!emits.count("get groups blocks") && !emits.count("get users blocks"))
+      continue;
+    ++bulkConnections;
+    CHECK(emits.count("authenticate device"));
+    CHECK_FALSE(emits.count("get key publishes"));
+  }
+  CHECK(bulkConnections > 0);
+}
+
+TEST_CASE("cached users are pulled again only once the server invalidates them")
+{
+  SessionOptions options;
+  options.subscriptions = true;
+  FakeServer::Server server;
+  server.install();
+
+  auto const aliceIdentity = makeIdentity(server, "alice");
+  auto const bobIdentity = makeIdentity(server, "bob");
+  auto const bobPublicIdentity =
+      SPublicIdentity{Identity::getPublicIdentity(bobIdentity)};
+  auto bob = makeCore(server, options);
+  bob->start(bobIdentity).get();
+  auto const bobVerificationKey = bob->generateVerificationKey().get();
+  bob->registerIdentity(bobVerificationKey).get();
+  bob->destroy().get();
+
+  UniquePath captureDir("testtmp");
+  auto const capturePath = captureDir.path + "/capture.jsonl";
+  Network::ConnectionFactory::record(capturePath);
+  auto alice = makeCore(server, options);
+  alice->start(aliceIdentity).get();
+  alice->registerIdentity(alice->generateVerificationKey().get()).get();
+  // alice has the first connection of the capture
+  auto const aliceUserPulls = [&] {
+    auto pulls = 0;
+    std::ifstream capture(capturePath);
+    for (std::string line; std::getline(capture, line);)
+    {
+      auto const record = nlohmann::json::parse(line);
+      if (record.at("cx") == 0 &&
+          record.value("emit", std::string{}) == "get users blocks")
+        ++pulls;
+    }
+    return pulls;
+  };
+
+  auto const clearData = make_buffer("my clear data");
+  alice->encrypt(clearData, {bobPublicIdentity}).get();
+  auto const pulls = aliceUserPulls();
+  CHECK(pulls > 0);
+  alice->encrypt(clearData, {bobPublicIdentity}).get();
+  CHECK(aliceUserPulls() == pulls);
+
+  // the event of the new device is handled before the next encrypt
+  auto bobLaptop = makeCore(server, options);
+  bobLaptop->start(bobIdentity).get();
+  bobLaptop->verifyIdentity(bobVerificationKey).get();
+  auto const encrypted = alice->encrypt(clearData, {bobPublicIdentity}).get();
+  CHECK(aliceUserPulls() > pulls);
+  CHECK(bobLaptop->decrypt(encrypted).get() == clearData);
+
+  bobLaptop->destroy().get();
+  alice->destroy().get();
+  Network::ConnectionFactory::stopRecording();
+}
@@ -307,7 +307,7 @@ TEST_CASE("generateShareBlocks")
     auto const blocks = Share::generateShareBlocks(
         generator.context().id(),
         keySenderDevice.id(),
-        keySenderDevice.keys().signatureKeyPair.privateKey,
+        keySenderDevice.signer(),
         resourceKeys,
         keyRecipients);
 
@@ -329,7 +329,7 @@ TEST_CASE("generateShareBlocks")
     auto const blocks = Share::generateShareBlocks(
         generator.context().id(),
         keySenderDevice.id(),
-        keySenderDevice.keys().signatureKeyPair.privateKey,
+        keySenderDevice.signer(),
         resourceKeys,
         keyRecipients);
 
@@ -351,7 +351,7 @@ TEST_CASE("generateShareBlocks")
     auto const blocks = Share::generateShareBlocks(
         generator.context().id(),
         keySenderDevice.id(),
-        keySenderDevice.keys().signatureKeyPair.privateKey,
+        keySenderDevice.signer(),
         resourceKeys,
         keyRecipients);
 
@@ -0,0 +1,188 @@
+#include <Tanker/Subscriptions.hpp>
+
+#include <Tanker/Client.hpp>
+#include <Tanker/Crypto/Json/Json.hpp>
+#include <Tanker/Network/AConnection.hpp>
+#include <Tanker/Trustchain/GroupId.hpp>
+#include <Tanker/Trustchain/UserId.hpp>
+
+#include <Helpers/Await.hpp>
+#include <Helpers/Buffers.hpp>
+
+#include <doctest.h>
+
+#include <nlohmann/json.hpp>
+#include <tconcurrent/async_wait.hpp>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Tanker;
+using namespace std::chrono_literals;
+
+namespace
+{
+// Acknowledges the subscriptions, or never answers them
+class SubscribingConnection : public Network::AConnection
+{
+public:
+  bool isOpen() const override
+  {
+    return true;
+  }
+
+  void connect() override
+  {
+  }
+
+  void close() override
+  {
+  }
+
+  std::string id() const override
+  {
+    return "subscribing";
+  }
+
+  tc::cotask<std::string> emit(std::string const& eventName,
+                               std::string const&) override
+  {
+    if (eventName == "subscribe")
+    {
+      ++subscribeCount;
+      if (ignoresSubscribe)
+        TC_AWAIT(tc::async_wait(24h));
+    }
+    TC_RETURN("{}");
+  }
+
+  void on(std::string const& eventName, Handler handler) override
+  {
+    handlers[eventName] = std::move(handler);
+  }
+
+  void userChanged(Trustchain::UserId const& userId)
+  {
+    handlers.at("device created")(
+        nlohmann::json{{"user_id", userId}}.dump());
+  }
+
+  std::map<std::string, Handler> handlers;
+  int subscribeCount = 0;
+  bool ignoresSubscribe = false;
+};
+
+struct Fixture
+{
+  Fixture()
+  {
+    auto cx = std::make_unique<SubscribingConnection>();
+    connection = cx.get();
+    client = std::make_unique<Client>(std::move(cx));
+    subscriptions = std::make_unique<Subscriptions>(client.get(), true);
+  }
+
+  SubscribingConnection* connection;
+  std::unique_ptr<Client> client;
+  std::unique_ptr<Subscriptions> subscriptions;
+
+  std::vector<Trustchain::UserId> const alice{
+      make<Trustchain::UserId>("alice")};
+  std::vector<Trustchain::UserId> const bob{make<Trustchain::UserId>("bob")};
+  std::vector<Trustchain::GroupId> const group{
+      make<Trustchain::GroupId>("group")};
+};
+}
+
+TEST_CASE_FIXTURE(Fixture, "subscribed users are fresh once marked")
+{
+  auto const generation = AWAIT(subscriptions->subscribe(alice));
+  CHECK_FALSE(subscriptions->isFresh(alice[0]));
+  subscriptions->markFresh(alice, generation);
+  CHECK(subscriptions->isFresh(alice[0]));
+  CHECK(connection->subscribeCount == 1);
+
+  SUBCASE("a subscribed user is not subscribed again")
+  {
+    AWAIT(subscriptions->subscribe(alice));
+    CHECK(connection->subscribeCount == 1);
+  }
+
+  SUBCASE("a change of a user only makes this user stale")
+  {
+    auto const bobGeneration = AWAIT(subscriptions->subscribe(bob));
+    subscriptions->markFresh(bob, bobGeneration);
+    connection->userChanged(alice[0]);
+    CHECK_FALSE(subscriptions->isFresh(alice[0]));
+    CHECK(subscriptions->isFresh(bob[0]));
+  }
+}
+
+TEST_CASE_FIXTURE(Fixture, "users that were not subscribed are never fresh")
+{
+  auto const generation = AWAIT(subscriptions->subscribe(alice));
+  subscriptions->markFresh(bob, generation);
+  CHECK_FALSE(subscriptions->isFresh(bob[0]));
+}
+
+TEST_CASE_FIXTURE(Fixture,
+                  "a change made while pulling is not hidden by markFresh")
+{
+  auto const generation = AWAIT(subscriptions->subscribe(alice));
+  connection->userChanged(alice[0]);
+  subscriptions->markFresh(alice, generation);
+  CHECK_FALSE(subscriptions->isFresh(alice[0]));
+
+  SUBCASE("the next pull makes the user fresh")
+  {
+    auto const nextGeneration = AWAIT(subscriptions->subscribe(alice));
+    CHECK(nextGeneration > generation);
+    subscriptions->markFresh(alice, nextGeneration);
+    CHECK(subscriptions->isFresh(alice[0]));
+  }
+}
+
+TEST_CASE_FIXTURE(Fixture, "a reset makes everything stale")
+{
+  auto const usersGeneration = AWAIT(subscriptions->subscribe(alice));
+  subscriptions->markFresh(alice, usersGeneration);
+  auto const groupsGeneration = AWAIT(subscriptions->subscribe(group));
+  subscriptions->markFresh(group, groupsGeneration);
+  auto const claimsGeneration = AWAIT(subscriptions->subscribeToClaims());
+  subscriptions->markClaimsFresh(claimsGeneration);
+  REQUIRE(subscriptions->areClaimsFresh());
+
+  subscriptions->reset();
+  CHECK_FALSE(subscriptions->isFresh(alice[0]));
+  CHECK_FALSE(subscriptions->isFresh(group[0]));
+  CHECK_FALSE(subscriptions->areClaimsFresh());
+
+  SUBCASE("the subscriptions are made again")
+  {
+    auto const generation = AWAIT(subscriptions->subscribe(alice));
+    CHECK(connection->subscribeCount == 4);
+    subscriptions->markFresh(alice, generation);
+    CHECK(subscriptions->isFresh(alice[0]));
+  }
+}
+
+TEST_CASE_FIXTURE(Fixture,
+                  "subscriptions are given up when the server never answers")
+{
+  client->setNegotiationTimeout(50ms);
+  connection->ignoresSubscribe = true;
+
+  auto const generation = AWAIT(subscriptions->subscribe(alice));
+  subscriptions->markFresh(alice, generation);
+  CHECK_FALSE(subscriptions->isFresh(alice[0]));
+  AWAIT(subscriptions->subscribe(bob));
+  CHECK(connection->subscribeCount == 1);
+
+  subscriptions->reset();
+  AWAIT(subscriptions->subscribe(bob));
+  CHECK(connection->subscribeCount == 2);
+}
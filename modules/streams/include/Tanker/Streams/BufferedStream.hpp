@@ -6,6 +6,7 @@
 #include <tconcurrent/coroutine.hpp>
 
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,9 @@ public:
   explicit BufferedStream(InputSource);
 
   tc::cotask<std::int64_t> operator()(std::uint8_t* out, std::int64_t n);
+  // Same as operator(), but only serves reads that need no input processing.
+  // Returns nullopt otherwise.
+  std::optional<std::int64_t> readBuffered(std::uint8_t* out, std::int64_t n);
 
 protected:
   // returns a view to the read input, which size can be at most n
@@ -36,8 +40,7 @@ private:
     Error,
   };
 
-  tc::cotask<std::int64_t> copyBufferedOutput(std::uint8_t* out,
-                                              std::int64_t n);
+  std::int64_t copyBufferedOutput(std::uint8_t* out, std::int64_t n);
 
   InputSource _cb;
   std::vector<std::uint8_t> _input;
@@ -28,6 +28,7 @@ public:
       Trustchain::ResourceId const&)>;
 
   using BufferedStream<DecryptionStream>::operator();
+  using BufferedStream<DecryptionStream>::readBuffered;
 
   Crypto::SymmetricKey const& symmetricKey() const;
   Trustchain::ResourceId const& resourceId() const;
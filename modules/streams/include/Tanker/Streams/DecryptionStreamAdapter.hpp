@@ -6,6 +6,7 @@
 #include <tconcurrent/coroutine.hpp>
 
 #include <cstdint>
+#include <optional>
 
 namespace Tanker
 {
@@ -15,15 +16,20 @@ class DecryptionStreamAdapter
 {
 public:
   explicit DecryptionStreamAdapter(InputSource source,
-                                   Trustchain::ResourceId const& resourceId);
+                                   Trustchain::ResourceId const& resourceId,
+                                   BufferedReader bufferedReader = nullptr);
 
   Trustchain::ResourceId const& resourceId() const;
 
   tc::cotask<std::int64_t> operator()(std::uint8_t* buffer, std::size_t size);
+  // Always nullopt when the adapter was built without a BufferedReader
+  std::optional<std::int64_t> readBuffered(std::uint8_t* buffer,
+                                           std::int64_t size);
 
 private:
   InputSource _source;
   Trustchain::ResourceId _resourceId;
+  BufferedReader _bufferedReader;
 };
 }
 }
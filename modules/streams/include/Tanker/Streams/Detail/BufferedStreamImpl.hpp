@@ -18,8 +18,8 @@ BufferedStream<Derived>::BufferedStream(InputSource cb) : _cb(std::move(cb))
 }
 
 template <typename Derived>
-tc::cotask<std::int64_t> BufferedStream<Derived>::copyBufferedOutput(
-    std::uint8_t* out, std::int64_t n)
+std::int64_t BufferedStream<Derived>::copyBufferedOutput(std::uint8_t* out,
+                                                        std::int64_t n)
 {
   auto const toRead =
       std::min<std::int64_t>(n, _output.size() - _currentPosition);
@@ -32,7 +32,7 @@ tc::cotask<std::int64_t> BufferedStream<Derived>::copyBufferedOutput(
     else
       _state = State::EndOfStream;
   }
-  TC_RETURN(toRead);
+  return toRead;
 }
 
 template <typename Derived>
@@ -77,7 +77,7 @@ tc::cotask<std::int64_t> BufferedStream<Derived>::operator()(std::uint8_t* out,
       _currentPosition = 0;
       // fallthrough
     case State::BufferedOutput:
-      TC_RETURN(TC_AWAIT(copyBufferedOutput(out, n)));
+      TC_RETURN(copyBufferedOutput(out, n));
     }
   }
   catch (std::exception const&)
@@ -88,5 +88,22 @@ tc::cotask<std::int64_t> BufferedStream<Derived>::operator()(std::uint8_t* out,
   }
   throw AssertionError("unknown state");
 }
+
+template <typename Derived>
+std::optional<std::int64_t> BufferedStream<Derived>::readBuffered(
+    std::uint8_t* out, std::int64_t n)
+{
+  switch (_state)
+  {
+  case State::EndOfStream:
+    return 0;
+  case State::BufferedOutput:
+    return copyBufferedOutput(out, n);
+  case State::NoOutput:
+  case State::Error:
+    return std::nullopt;
+  }
+  throw AssertionError("unknown state");
+}
 }
 }
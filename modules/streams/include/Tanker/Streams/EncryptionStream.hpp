@@ -28,6 +28,7 @@ public:
                    Crypto::SymmetricKey const& key);
 
   using BufferedStream<EncryptionStream>::operator();
+  using BufferedStream<EncryptionStream>::readBuffered;
 
   Trustchain::ResourceId const& resourceId() const;
   Crypto::SymmetricKey const& symmetricKey() const;
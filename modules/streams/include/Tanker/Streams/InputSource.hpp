@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <optional>
 
 namespace Tanker
 {
@@ -16,5 +17,10 @@ namespace Streams
 // Throws if an error occurred.
 using InputSource =
     std::function<tc::cotask<std::int64_t>(std::uint8_t* out, std::int64_t n)>;
+
+// Reads at most n bytes of a stream's already processed output, without
+// awaiting. Returns nullopt when more input must be processed first.
+using BufferedReader = std::function<std::optional<std::int64_t>(
+    std::uint8_t* out, std::int64_t n)>;
 }
 }
@@ -5,8 +5,12 @@ namespace Tanker
 namespace Streams
 {
 DecryptionStreamAdapter::DecryptionStreamAdapter(
-    Streams::InputSource source, Trustchain::ResourceId const& resourceId)
-  : _source(std::move(source)), _resourceId(resourceId)
+    Streams::InputSource source,
+    Trustchain::ResourceId const& resourceId,
+    BufferedReader bufferedReader)
+  : _source(std::move(source)),
+    _resourceId(resourceId),
+    _bufferedReader(std::move(bufferedReader))
 {
 }
 
@@ -20,5 +24,13 @@ tc::cotask<std::int64_t> DecryptionStreamAdapter::operator()(
 {
   return _source(buffer, size);
 }
+
+std::optional<std::int64_t> DecryptionStreamAdapter::readBuffered(
+    std::uint8_t* buffer, std::int64_t size)
+{
+  if (!_bufferedReader)
+    return std::nullopt;
+  return _bufferedReader(buffer, size);
+}
 }
 }
@@ -0,0 +1,99 @@
+#include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/Streams/DecryptionStream.hpp>
+#include <Tanker/Streams/EncryptionStream.hpp>
+#include <Tanker/Streams/Header.hpp>
+#include <Tanker/Streams/Helpers.hpp>
+
+#include <Helpers/Await.hpp>
+
+#include <doctest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace Tanker;
+using namespace Tanker::Streams;
+
+namespace
+{
+std::atomic<std::size_t> allocationCount{0};
+
+constexpr std::uint32_t encryptedChunkSize = 64 * 1024;
+constexpr std::uint32_t clearChunkSize =
+    encryptedChunkSize - Header::serializedSize - Crypto::Mac::arraySize;
+constexpr auto chunkCount = 16;
+
+// Reads the whole stream one chunk at a time, and returns the allocations
+// made after the first chunk
+template <typename Stream>
+tc::cotask<std::size_t> readCountingAllocations(Stream& stream,
+                                                std::vector<std::uint8_t>& out)
+{
+  auto position = out.data();
+  // the first chunk sizes the buffers of the stream
+  position += TC_AWAIT(stream(position, encryptedChunkSize));
+  auto const before = allocationCount.load();
+  while (auto const nbRead = TC_AWAIT(stream(position, encryptedChunkSize)))
+    position += nbRead;
+  auto const allocations = allocationCount.load() - before;
+  out.resize(position - out.data());
+  TC_RETURN(allocations);
+}
+
+tc::cotask<std::size_t> decryptCountingAllocations(
+    std::vector<std::uint8_t> const& encrypted,
+    Crypto::SymmetricKey const& key,
+    std::vector<std::uint8_t>& decrypted)
+{
+  auto decryptor = TC_AWAIT(DecryptionStream::create(
+      bufferViewToInputSource(encrypted),
+      [&](auto const&) -> tc::cotask<Crypto::SymmetricKey> {
+        TC_RETURN(key);
+      }));
+  TC_RETURN(TC_AWAIT(readCountingAllocations(decryptor, decrypted)));
+}
+}
+
+// Counts every allocation made by this test executable. The array and nothrow
+// forms end up calling this one.
+void* operator new(std::size_t size)
+{
+  ++allocationCount;
+  if (auto const p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+TEST_CASE("streams do not allocate per chunk")
+{
+  std::vector<std::uint8_t> clear(clearChunkSize * chunkCount + 42);
+  Crypto::randomFill(clear);
+
+  EncryptionStream encryptor(bufferViewToInputSource(clear),
+                             encryptedChunkSize);
+  std::vector<std::uint8_t> encrypted((chunkCount + 1) * encryptedChunkSize);
+  auto const encryptAllocations =
+      AWAIT(readCountingAllocations(encryptor, encrypted));
+
+  std::vector<std::uint8_t> decrypted(clear.size());
+  auto const decryptAllocations = AWAIT(decryptCountingAllocations(
+      encrypted, encryptor.symmetricKey(), decrypted));
+
+  CHECK(encryptAllocations == 0);
+  CHECK(decryptAllocations == 0);
+  CHECK(decrypted == clear);
+}
@@ -190,6 +190,42 @@ TEST_SUITE("Stream encryption")
     CHECK(timesCallbackCalled == 2);
   }
 
+  TEST_CASE("Serves reads from the buffered output without processing input")
+  {
+    std::vector<std::uint8_t> buffer(
+        2 * Streams::Header::defaultEncryptedChunkSize);
+    Crypto::randomFill(buffer);
+    EncryptionStream encryptor(bufferViewToInputSource(buffer));
+
+    auto const readAll = [](auto& stream) {
+      std::vector<std::uint8_t> out;
+      std::vector<std::uint8_t> chunk(64 * 1024);
+      while (true)
+      {
+        auto nbRead = stream.readBuffered(chunk.data(), chunk.size());
+        if (!nbRead)
+          nbRead = AWAIT(stream(chunk.data(), chunk.size()));
+        if (*nbRead == 0)
+          break;
+        out.insert(out.end(), chunk.begin(), chunk.begin() + *nbRead);
+      }
+      CHECK(stream.readBuffered(chunk.data(), chunk.size()) == 0);
+      return out;
+    };
+
+    std::vector<std::uint8_t> encryptedBuffer(1024);
+    CHECK_FALSE(encryptor.readBuffered(encryptedBuffer.data(), 1024));
+    auto const encrypted = readAll(encryptor);
+
+    auto decryptor = AWAIT(DecryptionStream::create(
+        bufferViewToInputSource(encrypted),
+        [key = encryptor.symmetricKey()](Trustchain::ResourceId const&)
+            -> tc::cotask<Crypto::SymmetricKey> { TC_RETURN(key); }));
+    // the first chunk is decrypted on creation
+    CHECK(decryptor.readBuffered(encryptedBuffer.data(), 0) == 0);
+    CHECK(readAll(decryptor) == buffer);
+  }
+
   TEST_CASE("Decrypt test vector")
   {
     auto clearData = make_buffer("this is a secret");
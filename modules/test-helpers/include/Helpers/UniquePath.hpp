@@ -18,4 +18,8 @@ struct UniquePath
 
   ~UniquePath();
 };
+
+// Copies the files of the from directory to the to directory, e.g. to start
+// sessions from a snapshot of their storage
+void copyFiles(std::string const& from, std::string const& to);
 }
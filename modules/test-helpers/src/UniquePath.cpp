@@ -24,5 +24,19 @@ UniquePath::~UniquePath()
 {
   boost::filesystem::remove_all(path);
 }
+
+void copyFiles(std::string const& from, std::string const& to)
+{
+  for (auto const& entry : boost::filesystem::directory_iterator(from))
+  {
+    if (boost::filesystem::is_regular_file(entry.status()))
+    {
+      boost::filesystem::copy_file(
+          entry.path(),
+          to / entry.path().filename(),
+          boost::filesystem::copy_option::overwrite_if_exists);
+    }
+  }
+}
 #endif
 }
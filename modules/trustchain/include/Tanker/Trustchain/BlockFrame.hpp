@@ -0,0 +1,23 @@
+#pragma once
+
+#include <gsl-lite.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace Tanker
+{
+namespace Trustchain
+{
+// Carries serialized blocks as raw bytes on the binary transport, instead of
+// a json array of base64 blocks: a version byte, the varint block count, then
+// each block prefixed by its varint size
+inline constexpr std::uint8_t blockFrameVersion = 1;
+
+std::vector<std::uint8_t> frameBlocks(
+    gsl::span<gsl::span<std::uint8_t const> const> blocks);
+// The spans point into frame
+std::vector<gsl::span<std::uint8_t const>> unframeBlocks(
+    gsl::span<std::uint8_t const> frame);
+}
+}
@@ -3,6 +3,7 @@
 #include <Tanker/Crypto/Hash.hpp>
 #include <Tanker/Crypto/PrivateSignatureKey.hpp>
 #include <Tanker/Crypto/Signature.hpp>
+#include <Tanker/Crypto/SigningContext.hpp>
 #include <Tanker/Trustchain/Actions/Nature.hpp>
 #include <Tanker/Trustchain/TrustchainId.hpp>
 
@@ -33,6 +34,10 @@ public:
                             Crypto::Hash const&,
                             Action const&,
                             Crypto::PrivateSignatureKey const&);
+  static ClientEntry create(TrustchainId const&,
+                            Crypto::Hash const&,
+                            Action const&,
+                            Crypto::SigningContext const&);
 
   TrustchainId const& trustchainId() const;
   Crypto::Hash const& author() const;
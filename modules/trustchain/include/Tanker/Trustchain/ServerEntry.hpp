@@ -10,6 +10,9 @@
 #include <nlohmann/json_fwd.hpp>
 
 #include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
 
 namespace Tanker
 {
@@ -51,6 +54,14 @@ void from_serialized(Serialization::SerializedSource& ss, ServerEntry& se);
 
 std::vector<ServerEntry> fromBlocksToServerEntries(
     gsl::span<std::string const>);
+// Decodes a json array of base64 blocks while it is parsed, without building a
+// json document. Returns std::nullopt if the json is not an array of strings,
+// e.g. an error reply.
+std::optional<std::vector<ServerEntry>> fromJsonBlocksToServerEntries(
+    std::string const& json);
+// Decodes the blocks of a frame of the binary transport, see BlockFrame.hpp
+std::vector<ServerEntry> fromBinaryBlocksToServerEntries(
+    gsl::span<std::uint8_t const> frame);
 
 void to_json(nlohmann::json& j, ServerEntry const& se);
 }
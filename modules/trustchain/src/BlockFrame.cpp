@@ -0,0 +1,69 @@
+#include <Tanker/Trustchain/BlockFrame.hpp>
+
+#include <Tanker/Errors/Exception.hpp>
+#include <Tanker/Serialization/Errors/Errc.hpp>
+#include <Tanker/Serialization/Varint.hpp>
+#include <Tanker/Trustchain/Errors/Errc.hpp>
+
+#include <algorithm>
+
+namespace Tanker
+{
+namespace Trustchain
+{
+std::vector<std::uint8_t> frameBlocks(
+    gsl::span<gsl::span<std::uint8_t const> const> blocks)
+{
+  auto size = 1 + Serialization::varint_size(blocks.size());
+  for (auto const& block : blocks)
+    size += Serialization::varint_size(block.size()) + block.size();
+
+  std::vector<std::uint8_t> frame(size);
+  frame[0] = blockFrameVersion;
+  auto it = Serialization::varint_write(frame.data() + 1, blocks.size());
+  for (auto const& block : blocks)
+  {
+    it = Serialization::varint_write(it, block.size());
+    it = std::copy(block.begin(), block.end(), it);
+  }
+  return frame;
+}
+
+std::vector<gsl::span<std::uint8_t const>> unframeBlocks(
+    gsl::span<std::uint8_t const> frame)
+{
+  if (frame.empty())
+  {
+    throw Errors::Exception(Serialization::Errc::TruncatedInput,
+                            "empty block frame");
+  }
+  if (frame[0] != blockFrameVersion)
+  {
+    throw Errors::formatEx(Errc::InvalidBlockVersion,
+                           "unsupported block frame version: {}",
+                           frame[0]);
+  }
+  auto [count, rest] = Serialization::varint_read(frame.subspan(1));
+  std::vector<gsl::span<std::uint8_t const>> blocks;
+  // each block takes at least one byte, do not trust count for the capacity
+  blocks.reserve(std::min<std::size_t>(count, rest.size()));
+  for (auto i = 0u; i < count; ++i)
+  {
+    auto const [size, block] = Serialization::varint_read(rest);
+    if (block.size() < size)
+    {
+      throw Errors::Exception(Serialization::Errc::TruncatedInput,
+                              "truncated block frame");
+    }
+    blocks.push_back(block.subspan(0, size));
+    rest = block.subspan(size);
+  }
+  if (!rest.empty())
+  {
+    throw Errors::Exception(Serialization::Errc::TrailingInput,
+                            "trailing bytes after a block frame");
+  }
+  return blocks;
+}
+}
+}
@@ -46,6 +46,23 @@ ClientEntry ClientEntry::create(TrustchainId const& trustchainId,
           signature};
 }
 
+ClientEntry ClientEntry::create(TrustchainId const& trustchainId,
+                                Crypto::Hash const& author,
+                                Action const& action,
+                                Crypto::SigningContext const& signer)
+{
+  auto const serializedPayload = Serialization::serialize(action);
+  auto const hash = computeHash(action.nature(), author, serializedPayload);
+  auto const signature = signer.sign(hash);
+
+  return {trustchainId,
+          author,
+          action.nature(),
+          serializedPayload,
+          hash,
+          signature};
+}
+
 TrustchainId const& ClientEntry::trustchainId() const
 {
   return _trustchainId;
@@ -1,23 +1,119 @@
 #include <Tanker/Trustchain/ServerEntry.hpp>
 
 #include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/Encoding/Base64.hpp>
 #include <Tanker/Errors/Exception.hpp>
 #include <Tanker/Serialization/Serialization.hpp>
 #include <Tanker/Trustchain/Action.hpp>
+#include <Tanker/Trustchain/BlockFrame.hpp>
 #include <Tanker/Trustchain/ComputeHash.hpp>
 #include <Tanker/Trustchain/Errors/Errc.hpp>
 
-#include <cppcodec/base64_rfc4648.hpp>
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <utility>
 
 namespace Tanker
 {
 namespace Trustchain
 {
+namespace
+{
+// buffer is reused from one block to the next to avoid an allocation per block
+ServerEntry decodeBlock(std::string_view block,
+                        std::vector<std::uint8_t>& buffer)
+{
+  buffer.resize(std::max(buffer.size(), Encoding::base64DecodedSize(block)));
+  auto const size = Encoding::base64Decode(block, buffer);
+  return Serialization::deserialize<ServerEntry>(
+      gsl::make_span(buffer).first(size));
+}
+
+// Accepts a flat array of strings, anything else stops the parsing.
+class BlockListSaxHandler : public nlohmann::json_sax<nlohmann::json>
+{
+public:
+  std::vector<ServerEntry> entries;
+
+  bool null() override
+  {
+    return false;
+  }
+
+  bool boolean(bool) override
+  {
+    return false;
+  }
+
+  bool number_integer(number_integer_t) override
+  {
+    return false;
+  }
+
+  bool number_unsigned(number_unsigned_t) override
+  {
+    return false;
+  }
+
+  bool number_float(number_float_t, string_t const&) override
+  {
+    return false;
+  }
+
+  bool string(string_t& block) override
+  {
+    if (!_inArray)
+      return false;
+    entries.push_back(decodeBlock(block, _buffer));
+    return true;
+  }
+
+  bool start_object(std::size_t) override
+  {
+    return false;
+  }
+
+  bool key(string_t&) override
+  {
+    return false;
+  }
+
+  bool end_object() override
+  {
+    return false;
+  }
+
+  bool start_array(std::size_t) override
+  {
+    if (_inArray)
+      return false;
+    _inArray = true;
+    return true;
+  }
+
+  bool end_array() override
+  {
+    // nested arrays are rejected, this is the end of the top-level one
+    return true;
+  }
+
+  bool parse_error(std::size_t,
+                   std::string const&,
+                   nlohmann::detail::exception const&) override
+  {
+    return false;
+  }
+
+private:
+  bool _inArray = false;
+  std::vector<std::uint8_t> _buffer;
+};
+}
+
 ServerEntry::ServerEntry(TrustchainId const& trustchainId,
                          std::uint64_t index,
                          Crypto::Hash const& author,
@@ -119,13 +215,29 @@ std::vector<ServerEntry> fromBlocksToServerEntries(
 {
   std::vector<ServerEntry> entries;
   entries.reserve(blocks.size());
-  std::transform(std::begin(blocks),
-                 std::end(blocks),
-                 std::back_inserter(entries),
-                 [](auto const& block) {
-                   return (Serialization::deserialize<Trustchain::ServerEntry>(
-                       cppcodec::base64_rfc4648::decode(block)));
-                 });
+  std::vector<std::uint8_t> buffer;
+  for (auto const& block : blocks)
+    entries.push_back(decodeBlock(block, buffer));
+  return entries;
+}
+
+std::optional<std::vector<ServerEntry>> fromJsonBlocksToServerEntries(
+    std::string const& json)
+{
+  BlockListSaxHandler handler;
+  if (!nlohmann::json::sax_parse(json, &handler))
+    return std::nullopt;
+  return std::move(handler.entries);
+}
+
+std::vector<ServerEntry> fromBinaryBlocksToServerEntries(
+    gsl::span<std::uint8_t const> frame)
+{
+  auto const blocks = unframeBlocks(frame);
+  std::vector<ServerEntry> entries;
+  entries.reserve(blocks.size());
+  for (auto const& block : blocks)
+    entries.push_back(Serialization::deserialize<ServerEntry>(block));
   return entries;
 }
 }
@@ -1,8 +1,12 @@
 #include <Tanker/Trustchain/ServerEntry.hpp>
 
 #include <Tanker/Crypto/Crypto.hpp>
+#include <Tanker/Encoding/Base64.hpp>
+#include <Tanker/Encoding/Errors/Errc.hpp>
+#include <Tanker/Serialization/Errors/Errc.hpp>
 #include <Tanker/Serialization/Serialization.hpp>
 #include <Tanker/Trustchain/Action.hpp>
+#include <Tanker/Trustchain/BlockFrame.hpp>
 #include <Tanker/Trustchain/ComputeHash.hpp>
 #include <Tanker/Trustchain/Errors/Errc.hpp>
 
@@ -10,68 +14,74 @@
 #include <Helpers/Errors.hpp>
 
 #include <doctest.h>
+#include <fmt/format.h>
 #include <gsl-lite.hpp>
 
 using namespace Tanker;
 using namespace Tanker::Trustchain;
 
+namespace
+{
+// clang-format off
+std::vector<std::uint8_t> const serializedBlock = {
+    // varint version
+    0x01,
+    // varint index
+    0x02,
+    // trustchain id
+    0x74, 0x72, 0x75, 0x73, 0x74, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x69,
+    0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // varint nature
+    0x01,
+    // varint payload size
+    0x20,
+    // TrustchainCreation: public signature key
+    0x70, 0x75, 0x62, 0x6c, 0x69, 0x63, 0x20, 0x73, 0x69, 0x67, 0x6e, 0x61,
+    0x74, 0x75, 0x72, 0x65, 0x20, 0x6b, 0x65, 0x79, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // author
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // signature
+    0x73, 0x69, 0x67, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+};
+
+std::vector<std::uint8_t> const serializedBlockPayload = {
+    0x70, 0x75, 0x62, 0x6c, 0x69, 0x63, 0x20, 0x73, 0x69, 0x67, 0x6e, 0x61,
+    0x74, 0x75, 0x72, 0x65, 0x20, 0x6b, 0x65, 0x79, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+// clang-format on
+
+ServerEntry makeBlockEntry()
+{
+  auto const trustchainId = make<TrustchainId>("trustchain id");
+  auto const nature = Actions::Nature::TrustchainCreation;
+  Crypto::Hash const author{};
+  auto const signature = make<Crypto::Signature>("sig");
+
+  return ServerEntry{trustchainId,
+                     2,
+                     author,
+                     Action::deserialize(nature, serializedBlockPayload),
+                     computeHash(nature, author, serializedBlockPayload),
+                     signature};
+}
+}
+
 TEST_CASE("Serialization test vectors")
 {
   SUBCASE("it should deserialize a ServerEntry")
   {
-    // clang-format off
-    std::vector<std::uint8_t> const serializedServerEntry = {
-      // varint version
-      0x01,
-      // varint index
-      0x02,
-      // trustchain id
-      0x74, 0x72, 0x75, 0x73, 0x74, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x20, 0x69,
-      0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      // varint nature
-      0x01,
-      // varint payload size
-      0x20,
-      // TrustchainCreation: public signature key
-      0x70, 0x75, 0x62, 0x6c, 0x69, 0x63, 0x20, 0x73, 0x69, 0x67, 0x6e, 0x61,
-      0x74, 0x75, 0x72, 0x65, 0x20, 0x6b, 0x65, 0x79, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      // author
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      // signature
-      0x73, 0x69, 0x67, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00,
-    };
-
-    std::vector<std::uint8_t> const serializedPayload = {
-      0x70, 0x75, 0x62, 0x6c, 0x69, 0x63, 0x20, 0x73, 0x69, 0x67, 0x6e, 0x61,
-      0x74, 0x75, 0x72, 0x65, 0x20, 0x6b, 0x65, 0x79, 0x00, 0x00, 0x00, 0x00,
-      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    };
-    // clang-format on
-
-    auto const trustchainId = make<TrustchainId>("trustchain id");
-    auto const nature = Actions::Nature::TrustchainCreation;
-    Crypto::Hash const author{};
-    auto const signature = make<Crypto::Signature>("sig");
-
-    ServerEntry const serverEntry{
-        trustchainId,
-        2,
-        author,
-        Action::deserialize(nature, serializedPayload),
-        computeHash(nature, author, serializedPayload),
-        signature};
-
-    CHECK(Serialization::deserialize<ServerEntry>(serializedServerEntry) ==
-          serverEntry);
+    CHECK(Serialization::deserialize<ServerEntry>(serializedBlock) ==
+          makeBlockEntry());
   }
 
   SUBCASE("it should throw when block version is unsupported")
@@ -86,3 +96,82 @@ TEST_CASE("Serialization test vectors")
         Errc::InvalidBlockVersion);
   }
 }
+
+TEST_CASE("fromJsonBlocksToServerEntries")
+{
+  auto const block = fmt::format(
+      "\"{}\"", Encoding::base64Encode(serializedBlock));
+
+  SUBCASE("it should decode an array of blocks")
+  {
+    auto const entries = fromJsonBlocksToServerEntries(
+        fmt::format("[{}, {}, {}]", block, block, block));
+
+    REQUIRE(entries.has_value());
+    CHECK(*entries == std::vector<ServerEntry>(3, makeBlockEntry()));
+  }
+
+  SUBCASE("it should decode an empty array")
+  {
+    auto const entries = fromJsonBlocksToServerEntries("[]");
+
+    REQUIRE(entries.has_value());
+    CHECK(entries->empty());
+  }
+
+  SUBCASE("it should give up on anything but an array of strings")
+  {
+    CHECK_FALSE(fromJsonBlocksToServerEntries(
+        R"({"error": {"code": "internal_error", "message": "oops"}})"));
+    CHECK_FALSE(fromJsonBlocksToServerEntries(fmt::format("[{}, 1]", block)));
+    CHECK_FALSE(fromJsonBlocksToServerEntries(fmt::format("[[{}]]", block)));
+    CHECK_FALSE(fromJsonBlocksToServerEntries(fmt::format("[{}", block)));
+    CHECK_FALSE(fromJsonBlocksToServerEntries(block));
+  }
+
+  SUBCASE("it should throw when a block is invalid")
+  {
+    TANKER_CHECK_THROWS_WITH_CODE(fromJsonBlocksToServerEntries(R"(["AA=="])"),
+                                  Errc::InvalidBlockVersion);
+    TANKER_CHECK_THROWS_WITH_CODE(fromJsonBlocksToServerEntries(R"(["A"])"),
+                                  Encoding::Errc::InvalidBase64);
+  }
+}
+
+TEST_CASE("fromBinaryBlocksToServerEntries")
+{
+  gsl::span<std::uint8_t const> const block = serializedBlock;
+
+  SUBCASE("it should decode a frame of blocks")
+  {
+    auto const frame = frameBlocks(
+        std::vector<gsl::span<std::uint8_t const>>{block, block, block});
+
+    CHECK(frame.size() == 2 + 3 * (2 + block.size()));
+    CHECK(fromBinaryBlocksToServerEntries(frame) ==
+          std::vector<ServerEntry>(3, makeBlockEntry()));
+  }
+
+  SUBCASE("it should decode an empty frame")
+  {
+    CHECK(fromBinaryBlocksToServerEntries(frameBlocks({})).empty());
+  }
+
+  SUBCASE("it should throw when the frame is invalid")
+  {
+    auto frame = frameBlocks(std::vector<gsl::span<std::uint8_t const>>{block});
+
+    TANKER_CHECK_THROWS_WITH_CODE(
+        fromBinaryBlocksToServerEntries(
+            gsl::make_span(frame).subspan(0, frame.size() - 1)),
+        Serialization::Errc::TruncatedInput);
+
+    frame.push_back(0);
+    TANKER_CHECK_THROWS_WITH_CODE(fromBinaryBlocksToServerEntries(frame),
+                                  Serialization::Errc::TrailingInput);
+
+    frame[0] = 42;
+    TANKER_CHECK_THROWS_WITH_CODE(fromBinaryBlocksToServerEntries(frame),
+                                  Errc::InvalidBlockVersion);
+  }
+}